@@ -0,0 +1,87 @@
+#!/usr/bin/env python
+
+import sys
+import struct
+from array import array
+
+def read_line(file):
+    """Scans the input file and ignores comment lines and blank lines."""
+
+    buff = file.readline()
+    if len(buff) == 0: return None
+    while len(buff.strip()) == 0 or buff.strip()[0] in '#/*':
+        buff = file.readline()
+        if len(buff) == 0: return None
+    return buff
+
+if __name__ == "__main__":
+
+    if len(sys.argv) != 3:
+        print("Usage:  text_to_binary_discretization.py <discretization_file.txt> <discretization_file.bin>\n")
+        print("The discretization file lists the nodes as (x, y, z, block_id, volume)")
+        print("The binary file may be read by a \"Binary\" discretization, or by a \"Text File\" discretization with Input Mesh Format set to \"Binary\"\n")
+        sys.exit(1)
+
+    textFileName = sys.argv[1]
+    binaryFileName = sys.argv[2]
+
+    coordinates = array('d')
+    blockIds = array('i')
+    volumes = array('d')
+
+    textFile = open(textFileName)
+    buff = read_line(textFile)
+    while buff != None:
+        vals = buff.split()
+        if len(vals) != 5:
+            print("Error parsing text file, invalid line: " + buff)
+            sys.exit(1)
+        coordinates.append(float(vals[0]))
+        coordinates.append(float(vals[1]))
+        coordinates.append(float(vals[2]))
+        blockIds.append(int(float(vals[3])))
+        volumes.append(float(vals[4]))
+        buff = read_line(textFile)
+    textFile.close()
+
+    # Peridigm binary discretization file, see Peridigm_BinaryDiscretization.cpp
+    # The header and offset table are followed by the sections, each aligned on a 64-byte boundary
+    # Points are numbered in file order, and block n is named block_n, as for a text file discretization
+    numPoints = len(volumes)
+    globalIds = array('i', range(numPoints))
+    blockNames = b''
+    for blockId in sorted(set(blockIds)):
+        name = ('block_' + str(blockId)).encode('ascii')
+        blockNames += struct.pack('<ii', blockId, len(name)) + name
+    if sys.byteorder != 'little':
+        globalIds.byteswap()
+        coordinates.byteswap()
+        blockIds.byteswap()
+        volumes.byteswap()
+    toBytes = lambda a: a.tobytes() if hasattr(a, 'tobytes') else a.tostring()
+    # (section id, element size, data):  GLOBAL_IDS, COORDINATES, VOLUMES, BLOCK_IDS, BLOCK_NAMES
+    sections = [(1, 4, toBytes(globalIds)),
+                (2, 8, toBytes(coordinates)),
+                (3, 8, toBytes(volumes)),
+                (4, 4, toBytes(blockIds)),
+                (8, 1, blockNames)]
+    headerSize = 32
+    sectionEntrySize = 24
+    align = lambda offset: ((offset + 63)//64)*64
+    offset = align(headerSize + len(sections)*sectionEntrySize)
+    header = b'PDBINDSC' + struct.pack('<iiqq', 1, len(sections), numPoints, 0)
+    offsets = []
+    for (sectionId, elementSize, data) in sections:
+        header += struct.pack('<iiqq', sectionId, elementSize, offset, len(data))
+        offsets.append(offset)
+        offset = align(offset + len(data))
+
+    binaryFile = open(binaryFileName, 'wb')
+    binaryFile.write(header)
+    for (section, sectionOffset) in zip(sections, offsets):
+        binaryFile.write(b'\0'*(sectionOffset - binaryFile.tell()))
+        binaryFile.write(section[2])
+    binaryFile.write(b'\0'*(offset - binaryFile.tell()))
+    binaryFile.close()
+
+    print("Wrote " + str(numPoints) + " points to " + binaryFileName)
@@ -48,6 +48,7 @@
 #ifndef PERIDIGM_COMPUTE_HPP
 #define PERIDIGM_COMPUTE_HPP
 
+#include <vector>
 #include <Epetra_Comm.h>
 #include <Teuchos_RCP.hpp>
 
@@ -85,9 +86,40 @@ namespace PeridigmNS {
     //! Pre compute initialization
     virtual int pre_compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks  ) const {return 0;}
 
+    //! Returns true if the compute class implements computeLocalContribution() and finalizeGlobalContribution(), allowing its global reductions to be batched with those of adjacent compute classes.
+    virtual bool batchesGlobalReductions() const { return false; }
+
+    //! Returns false if compute() involves no communication across processors, which allows the ComputeManager to evaluate it without completing the pending batch of global reductions.
+    virtual bool performsGlobalCommunication() const { return true; }
+
+    //! Perform the processor-local part of the computation, appending values that must be summed or maximized across processors to the given buffers.
+    //! The number of values appended must be identical on all processors.  The default implementation performs the full computation.
+    virtual int computeLocalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                          std::vector<double>& localSums,
+                                          std::vector<double>& localMaxima ) const { return compute(blocks); }
+
+    //! Complete the computation given the globally-reduced values, which begin at this compute class's offset into the reduction buffers.
+    virtual int finalizeGlobalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                            const double* globalSums,
+                                            const double* globalMaxima ) const { return 0; }
+
 
   protected:
 
+    //! Perform the full computation by calling computeLocalContribution(), reducing across processors, and calling finalizeGlobalContribution().
+    int computeWithGlobalReduction( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks ) const {
+      std::vector<double> localSums, localMaxima;
+      int result = computeLocalContribution(blocks, localSums, localMaxima);
+      std::vector<double> globalSums(localSums.size()), globalMaxima(localMaxima.size());
+      if(localSums.size() > 0)
+        epetraComm->SumAll(&localSums[0], &globalSums[0], static_cast<int>(localSums.size()));
+      if(localMaxima.size() > 0)
+        epetraComm->MaxAll(&localMaxima[0], &globalMaxima[0], static_cast<int>(localMaxima.size()));
+      const double* globalSumsPtr = globalSums.size() > 0 ? &globalSums[0] : NULL;
+      const double* globalMaximaPtr = globalMaxima.size() > 0 ? &globalMaxima[0] : NULL;
+      return result + finalizeGlobalContribution(blocks, globalSumsPtr, globalMaximaPtr);
+    }
+
     //! Copy constructor.
     Compute( const Compute& C );
 
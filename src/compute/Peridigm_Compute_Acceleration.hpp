@@ -73,6 +73,9 @@ namespace PeridigmNS {
     //! Returns a vector of field IDs corresponding to the variables associated with the compute class.
     virtual std::vector<int> FieldIds() const { return m_fieldIds; }
 
+    //! The computation is processor-local and involves no global communication.
+    virtual bool performsGlobalCommunication() const { return false; }
+
     //! Perform computation
     int compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks  ) const;
 
@@ -80,11 +80,10 @@ int PeridigmNS::Compute_Angular_Momentum::compute( Teuchos::RCP< std::vector<Per
 }        
 
 //! Fill the angular momentum vector
-int PeridigmNS::Compute_Angular_Momentum::computeAngularMomentum( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, bool storeLocal  ) const
+int PeridigmNS::Compute_Angular_Momentum::computeAngularMomentum( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, bool storeLocal, std::vector<double>& localSums  ) const
 {
   int retval;
 
-  double globalAM = 0.0;
   Teuchos::RCP<Epetra_Vector> velocity,  arm, volume, angular_momentum;
   std::vector<Block>::iterator blockIt;
   for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++)
@@ -142,24 +141,27 @@ int PeridigmNS::Compute_Angular_Momentum::computeAngularMomentum( Teuchos::RCP<
       }
     }
     
+    // Defer the reduction across processors to the caller so that it can be batched with other compute classes
     if (!storeLocal)
     {
-      // Update info across processors
-      std::vector<double> localAngularMomentum(3), globalAngularMomentum(3);
-      localAngularMomentum[0] = angular_momentum_x;
-      localAngularMomentum[1] = angular_momentum_y;
-      localAngularMomentum[2] = angular_momentum_z;
-	
-      epetraComm->SumAll(&localAngularMomentum[0], &globalAngularMomentum[0], 3);
-		
-      globalAM += sqrt(globalAngularMomentum[0]*globalAngularMomentum[0] + globalAngularMomentum[1]*globalAngularMomentum[1] + globalAngularMomentum[2]*globalAngularMomentum[2]);
+      localSums.push_back(angular_momentum_x);
+      localSums.push_back(angular_momentum_y);
+      localSums.push_back(angular_momentum_z);
     }
   }
 
-  // Store global angular momentum
-  if (!storeLocal)  
-    (*(blocks->begin()->getData(m_globalAngularMomentumFieldId, PeridigmField::STEP_NONE)))[0] = globalAM;
-
   return(0);
 
 }
+
+void PeridigmNS::Compute_Angular_Momentum::storeGlobalAngularMomentum( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, const double* globalSums ) const
+{
+  double globalAM = 0.0;
+  for(unsigned int iBlock=0 ; iBlock<blocks->size() ; ++iBlock){
+    const double* globalAngularMomentum = &globalSums[3*iBlock];
+    globalAM += sqrt(globalAngularMomentum[0]*globalAngularMomentum[0] + globalAngularMomentum[1]*globalAngularMomentum[1] + globalAngularMomentum[2]*globalAngularMomentum[2]);
+  }
+
+  // Store global angular momentum
+  (*(blocks->begin()->getData(m_globalAngularMomentumFieldId, PeridigmField::STEP_NONE)))[0] = globalAM;
+}
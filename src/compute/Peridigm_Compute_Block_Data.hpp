@@ -80,6 +80,19 @@ namespace PeridigmNS {
     //! Perform computation
     virtual int compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks ) const;
 
+    //! The global reductions are carried out by the ComputeManager.
+    virtual bool batchesGlobalReductions() const { return true; }
+
+    //! Compute the processor-local contribution to the global reduction
+    virtual int computeLocalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                          std::vector<double>& localSums,
+                                          std::vector<double>& localMaxima ) const;
+
+    //! Store the results of the global reduction
+    virtual int finalizeGlobalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                            const double* globalSums,
+                                            const double* globalMaxima ) const;
+
   private:
 
     //! Name of variable to be tracked
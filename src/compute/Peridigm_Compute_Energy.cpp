@@ -89,10 +89,17 @@ PeridigmNS::Compute_Energy::~Compute_Energy(){}
 
 //! Fill the energy vectors
 int PeridigmNS::Compute_Energy::compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks  ) const
+{
+  return computeWithGlobalReduction(blocks);
+}
+
+int PeridigmNS::Compute_Energy::computeLocalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                                          std::vector<double>& localSums,
+                                                          std::vector<double>& localMaxima ) const
 {
   int retval;
-  double globalKE, globalSE, globalSEDensity;
-  globalKE = globalSE = globalSEDensity = 0.0;
+  double localKE, localSE;
+  localKE = localSE = 0.0;
   Teuchos::RCP<Epetra_Vector> velocity, volume, force, ref, coord, w_volume, dilatation, numNeighbors, neighborID, kinetic_energy, strain_energy, strain_energy_density;
   std::vector<Block>::iterator blockIt;
   for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
@@ -196,24 +203,27 @@ int PeridigmNS::Compute_Energy::compute( Teuchos::RCP< std::vector<PeridigmNS::B
         kinetic_energy_values[i] = 0.5*vol*density*(v1*v1 + v2*v2 + v3*v3);	
       }
     
-    // Update info across processors
-    double localKE, localSE, globalBlockKE, globalBlockSE;
-    localKE = KE;
-    localSE = SE;
-    
-    epetraComm->SumAll(&localKE, &globalBlockKE, 1);
-    epetraComm->SumAll(&localSE, &globalBlockSE, 1);
-
-    globalKE += globalBlockKE;
-    globalSE += globalBlockSE;
+    localKE += KE;
+    localSE += SE;
 	}
 
+  // The reduction across processors is performed by the caller
+  localSums.push_back(localKE);
+  localSums.push_back(localSE);
+
+  return(0);
+}
+
+int PeridigmNS::Compute_Energy::finalizeGlobalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                                            const double* globalSums,
+                                                            const double* globalMaxima ) const
+{
   // Store global values
   Teuchos::RCP<Epetra_Vector> data;
   data = blocks->begin()->getData(m_globalKineticEnergyFieldId, PeridigmField::STEP_NONE);
-  (*data)[0] = globalKE;
+  (*data)[0] = globalSums[0];
   data = blocks->begin()->getData(m_globalStrainEnergyFieldId, PeridigmField::STEP_NONE);
-  (*data)[0] = globalSE;
+  (*data)[0] = globalSums[1];
 
   return(0);
 }
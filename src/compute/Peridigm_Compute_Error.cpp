@@ -93,7 +93,14 @@ PeridigmNS::Compute_Error::~Compute_Error(){}
 //! Fill the energy vectors
 int PeridigmNS::Compute_Error::compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks  ) const
 {
-  double globalError = 0.0;
+  return computeWithGlobalReduction(blocks);
+}
+
+int PeridigmNS::Compute_Error::computeLocalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                                         std::vector<double>& localSums,
+                                                         std::vector<double>& localMaxima ) const
+{
+  double localError = 0.0;
 
   for(std::vector<Block>::iterator blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
 
@@ -201,17 +208,23 @@ int PeridigmNS::Compute_Error::compute( Teuchos::RCP< std::vector<PeridigmNS::Bl
       double errorVal = computeError_1(dispX, dispY, dispZ, x1, x2, y1, y2, z1, z2);
 
       error[localId] = errorVal;
-      globalError += errorVal;
+      localError += errorVal;
     }
   }
 
-  // Sum the global error across processors
-  double temp = globalError;
-  epetraComm->SumAll(&temp, &globalError, 1);
+  // The sum across processors is performed by the caller
+  localSums.push_back(localError);
 
+  return(0);
+}
+
+int PeridigmNS::Compute_Error::finalizeGlobalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                                           const double* globalSums,
+                                                           const double* globalMaxima ) const
+{
   // Store global value
   Teuchos::RCP<Epetra_Vector> data = blocks->begin()->getData(m_globalErrorFieldId, PeridigmField::STEP_NONE);
-  (*data)[0] = globalError;
+  (*data)[0] = globalSums[0];
 
   return(0);
 }
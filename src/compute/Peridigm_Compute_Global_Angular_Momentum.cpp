@@ -59,8 +59,23 @@ PeridigmNS::Compute_Global_Angular_Momentum::~Compute_Global_Angular_Momentum(){
 
 //! Compute the global angular momentum
 int PeridigmNS::Compute_Global_Angular_Momentum::compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks  ) const
+{
+  return computeWithGlobalReduction(blocks);
+}
+
+int PeridigmNS::Compute_Global_Angular_Momentum::computeLocalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                                                           std::vector<double>& localSums,
+                                                                           std::vector<double>& localMaxima ) const
 {
   bool storeLocal = false;
-  int result = computeAngularMomentum(blocks, storeLocal);
+  int result = computeAngularMomentum(blocks, storeLocal, localSums);
   return result;
 }
+
+int PeridigmNS::Compute_Global_Angular_Momentum::finalizeGlobalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                                                             const double* globalSums,
+                                                                             const double* globalMaxima ) const
+{
+  storeGlobalAngularMomentum(blocks, globalSums);
+  return 0;
+}
@@ -79,6 +79,22 @@ namespace PeridigmNS {
 
     //! Perform computation
     int compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks  ) const;
+
+    //! The global reductions are carried out by the ComputeManager.
+    bool batchesGlobalReductions() const { return true; }
+
+    //! Unlike the processor-local base class, compute() reduces across processors.
+    virtual bool performsGlobalCommunication() const { return true; }
+
+    //! Compute the processor-local angular momentum of each block
+    int computeLocalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                  std::vector<double>& localSums,
+                                  std::vector<double>& localMaxima ) const;
+
+    //! Store the global angular momentum
+    int finalizeGlobalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                    const double* globalSums,
+                                    const double* globalMaxima ) const;
   };
 }
 
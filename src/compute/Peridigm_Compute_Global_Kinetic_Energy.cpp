@@ -61,8 +61,23 @@ PeridigmNS::Compute_Global_Kinetic_Energy::~Compute_Global_Kinetic_Energy(){}
 
 //! Compute the global kinetic energy
 int PeridigmNS::Compute_Global_Kinetic_Energy::compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks  ) const
+{
+  	return computeWithGlobalReduction(blocks);
+}
+
+int PeridigmNS::Compute_Global_Kinetic_Energy::computeLocalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                                                         std::vector<double>& localSums,
+                                                                         std::vector<double>& localMaxima ) const
 {
   	bool storeLocal = false;
-  	int result = computeKineticEnergy(blocks, storeLocal);
+  	int result = computeKineticEnergy(blocks, storeLocal, localSums);
   	return result;
 }
+
+int PeridigmNS::Compute_Global_Kinetic_Energy::finalizeGlobalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                                                           const double* globalSums,
+                                                                           const double* globalMaxima ) const
+{
+  	storeGlobalKineticEnergy(blocks, globalSums[0]);
+  	return 0;
+}
@@ -76,6 +76,22 @@ namespace PeridigmNS {
     //! Perform computation
     virtual int compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks  ) const;
 
+    //! The global reductions are carried out by the ComputeManager.
+    virtual bool batchesGlobalReductions() const { return true; }
+
+    //! Unlike the processor-local base class, compute() reduces across processors.
+    virtual bool performsGlobalCommunication() const { return true; }
+
+    //! Compute the processor-local kinetic energy
+    virtual int computeLocalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                          std::vector<double>& localSums,
+                                          std::vector<double>& localMaxima ) const;
+
+    //! Store the global kinetic energy
+    virtual int finalizeGlobalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                            const double* globalSums,
+                                            const double* globalMaxima ) const;
+
     //! Returns a vector of field IDs corresponding to the variables associated with the compute class.
     virtual std::vector<int> FieldIds() const { return Compute_Kinetic_Energy::FieldIds(); }
   };
@@ -61,8 +61,23 @@ PeridigmNS::Compute_Global_Linear_Momentum::~Compute_Global_Linear_Momentum(){}
 
 //! Calculate the global linear momentum
 int PeridigmNS::Compute_Global_Linear_Momentum::compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks  ) const
+{
+  return computeWithGlobalReduction(blocks);
+}
+
+int PeridigmNS::Compute_Global_Linear_Momentum::computeLocalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                                                          std::vector<double>& localSums,
+                                                                          std::vector<double>& localMaxima ) const
 {
   bool storeLocal = false;
-  int result = computeLinearMomentum(blocks, storeLocal);
+  int result = computeLinearMomentum(blocks, storeLocal, localSums);
   return result;
 }
+
+int PeridigmNS::Compute_Global_Linear_Momentum::finalizeGlobalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                                                            const double* globalSums,
+                                                                            const double* globalMaxima ) const
+{
+  storeGlobalLinearMomentum(blocks, globalSums);
+  return 0;
+}
@@ -76,11 +76,11 @@ int PeridigmNS::Compute_Kinetic_Energy::compute( Teuchos::RCP< std::vector<Perid
 	return 0;
 }
 
-int PeridigmNS::Compute_Kinetic_Energy::computeKineticEnergy( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, bool storeLocal ) const
+int PeridigmNS::Compute_Kinetic_Energy::computeKineticEnergy( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, bool storeLocal, std::vector<double>& localSums ) const
 { 
 	int retval;
 	
-	double globalKE = 0.0;
+	double localKE = 0.0;
 	Teuchos::RCP<Epetra_Vector> velocity, volume, force, numNeighbors, neighborID, kinetic_energy;
 	std::vector<Block>::iterator blockIt;
 	for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++)
@@ -138,23 +138,20 @@ int PeridigmNS::Compute_Kinetic_Energy::computeKineticEnergy( Teuchos::RCP< std:
 		}
 
 		if (!storeLocal)
-		{
-			// Update info across processors
-			double localKE, globalBlockKE;
-			localKE = KE;
-
-			epetraComm->SumAll(&localKE, &globalBlockKE, 1);
-
-			globalKE += globalBlockKE;
-		}
+			localKE += KE;
 	}
 	
-	// Store global energy in block (block globals are static, so only need to assign data to first block)
-	if (!storeLocal){
-      Teuchos::RCP<Epetra_Vector> data = blocks->begin()->getData(m_globalKineticEnergyFieldId, PeridigmField::STEP_NONE);
-      (*data)[0] = globalKE;
-    }
+	// The sum across processors is carried out by the caller
+	if (!storeLocal)
+		localSums.push_back(localKE);
 
 	return(0);
 
 }
+
+void PeridigmNS::Compute_Kinetic_Energy::storeGlobalKineticEnergy( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, double globalKE ) const
+{
+	// Store global energy in block (block globals are static, so only need to assign data to first block)
+	Teuchos::RCP<Epetra_Vector> data = blocks->begin()->getData(m_globalKineticEnergyFieldId, PeridigmField::STEP_NONE);
+	(*data)[0] = globalKE;
+}
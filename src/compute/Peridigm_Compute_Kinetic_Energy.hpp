@@ -74,11 +74,19 @@ namespace PeridigmNS {
     //! Returns a vector of field IDs corresponding to the variables associated with the compute class.
     virtual std::vector<int> FieldIds() const { return m_fieldIds; }
 
+    //! The computation is processor-local and involves no global communication.
+    virtual bool performsGlobalCommunication() const { return false; }
+
     //! Perform computation
     virtual int compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks  ) const;
 
-    //! Compute the kinetic energy and optionally store the nodal values. 
-    int computeKineticEnergy( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, bool storeLocal ) const ;
+    //! Compute the kinetic energy and either store the nodal values or append the processor-local total to localSums.
+    int computeKineticEnergy( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, bool storeLocal, std::vector<double>& localSums ) const ;
+
+  protected:
+
+    //! Store the globally-reduced kinetic energy.
+    void storeGlobalKineticEnergy( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, double globalKE ) const ;
 
   private:
 
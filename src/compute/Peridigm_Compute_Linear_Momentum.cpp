@@ -78,11 +78,10 @@ int PeridigmNS::Compute_Linear_Momentum::compute( Teuchos::RCP< std::vector<Peri
 }
  
 //! Fill the linear momentum vector
-int PeridigmNS::Compute_Linear_Momentum::computeLinearMomentum( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, bool storeLocal  ) const
+int PeridigmNS::Compute_Linear_Momentum::computeLinearMomentum( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, bool storeLocal, std::vector<double>& localSums  ) const
 {
   int retval;
 
-  double globalLM = 0.0;
   Teuchos::RCP<Epetra_Vector> velocity, volume, linear_momentum;
   std::vector<Block>::iterator blockIt;
   for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++)
@@ -135,37 +134,28 @@ int PeridigmNS::Compute_Linear_Momentum::computeLinearMomentum( Teuchos::RCP< st
       }
     }
 
+    // Defer the reduction across processors to the caller so that it can be batched with other compute classes
     if (!storeLocal)
     {
-      // Update info across processors
-      std::vector<double> localLinearMomentum(3), globalLinearMomentum(3);
-      localLinearMomentum[0] = linear_momentum_x;
-      localLinearMomentum[1] = linear_momentum_y;
-      localLinearMomentum[2] = linear_momentum_z;
-
-      epetraComm->SumAll(&localLinearMomentum[0], &globalLinearMomentum[0], 3);
-
-      globalLM += sqrt(globalLinearMomentum[0]*globalLinearMomentum[0] + globalLinearMomentum[1]*globalLinearMomentum[1] + globalLinearMomentum[2]*globalLinearMomentum[2]);
+      localSums.push_back(linear_momentum_x);
+      localSums.push_back(linear_momentum_y);
+      localSums.push_back(linear_momentum_z);
     }
   }
 
-/*
-	if ((params, epetraComm)->MyPID() == 0)
-	{
-	std::cout << "Hello!" << std::endl;
-
-	std::cout << "Total Linear Momentum =  " << "("  << globalLinearMomentum[0]
-                                                 << ", " << globalLinearMomentum[1]
-                                                 << ", " << globalLinearMomentum[2] << ")" << std::endl;
-	}
-*/
-
-  // Store global energy in block (block globals are static, so only need to assign data to first block)
-  if (!storeLocal){
-    Teuchos::RCP<Epetra_Vector> data = blocks->begin()->getData(m_globalLinearMomentumFieldId, PeridigmField::STEP_NONE);
-    (*data)[0] = globalLM;
-  }
-
   return(0);
 
 }
+
+void PeridigmNS::Compute_Linear_Momentum::storeGlobalLinearMomentum( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, const double* globalSums ) const
+{
+  double globalLM = 0.0;
+  for(unsigned int iBlock=0 ; iBlock<blocks->size() ; ++iBlock){
+    const double* globalLinearMomentum = &globalSums[3*iBlock];
+    globalLM += sqrt(globalLinearMomentum[0]*globalLinearMomentum[0] + globalLinearMomentum[1]*globalLinearMomentum[1] + globalLinearMomentum[2]*globalLinearMomentum[2]);
+  }
+
+  // Store global linear momentum in block (block globals are static, so only need to assign data to first block)
+  Teuchos::RCP<Epetra_Vector> data = blocks->begin()->getData(m_globalLinearMomentumFieldId, PeridigmField::STEP_NONE);
+  (*data)[0] = globalLM;
+}
@@ -74,11 +74,19 @@ namespace PeridigmNS {
     //! Returns a vector of field IDs corresponding to the variables associated with the compute class.
     virtual std::vector<int> FieldIds() const { return m_fieldIds; }
 
+    //! The computation is processor-local and involves no global communication.
+    virtual bool performsGlobalCommunication() const { return false; }
+
     //! Perform computation
     virtual int compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks  ) const;
 
-    //! Compute the linear momentum and optionally store the nodal values. 
-    int computeLinearMomentum( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, bool storeLocal ) const ;
+    //! Compute the linear momentum and optionally store the nodal values; if storeLocal is false, the processor-local momentum of each block is appended to localSums.
+    int computeLinearMomentum( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, bool storeLocal, std::vector<double>& localSums ) const ;
+
+  protected:
+
+    //! Store the global linear momentum given the globally-reduced momentum vector of each block.
+    void storeGlobalLinearMomentum( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, const double* globalSums ) const ;
 
   private:
 
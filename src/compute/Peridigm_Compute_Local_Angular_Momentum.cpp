@@ -62,6 +62,7 @@ PeridigmNS::Compute_Local_Angular_Momentum::~Compute_Local_Angular_Momentum(){}
 //! Fill the angular momentum vector
 int PeridigmNS::Compute_Local_Angular_Momentum::compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks  ) const {
   bool storeLocal = true;
-  int result = computeAngularMomentum(blocks, storeLocal);
+  std::vector<double> localSums;
+  int result = computeAngularMomentum(blocks, storeLocal, localSums);
   return result;
 }
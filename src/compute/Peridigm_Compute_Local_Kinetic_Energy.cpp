@@ -63,6 +63,7 @@ PeridigmNS::Compute_Local_Kinetic_Energy::~Compute_Local_Kinetic_Energy(){}
 int PeridigmNS::Compute_Local_Kinetic_Energy::compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks  ) const
 {
   	bool storeLocal = true;
-  	int result = computeKineticEnergy(blocks, storeLocal);
+  	std::vector<double> localSums;
+  	int result = computeKineticEnergy(blocks, storeLocal, localSums);
   	return result;
 }
@@ -63,6 +63,7 @@ PeridigmNS::Compute_Local_Linear_Momentum::~Compute_Local_Linear_Momentum(){}
 int PeridigmNS::Compute_Local_Linear_Momentum::compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks  ) const
 {
   bool storeLocal = true;
-  int result = computeLinearMomentum(blocks, storeLocal);
+  std::vector<double> localSums;
+  int result = computeLinearMomentum(blocks, storeLocal, localSums);
   return result;
 }
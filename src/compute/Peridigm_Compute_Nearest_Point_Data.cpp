@@ -198,13 +198,18 @@ void PeridigmNS::Compute_Nearest_Point_Data::initialize( Teuchos::RCP< std::vect
 }
 
 int PeridigmNS::Compute_Nearest_Point_Data::compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks ) const {
+  return computeWithGlobalReduction(blocks);
+}
+
+int PeridigmNS::Compute_Nearest_Point_Data::computeLocalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                                                      std::vector<double>& localSums,
+                                                                      std::vector<double>& localMaxima ) const {
 
   PeridigmField::Step step = PeridigmField::STEP_NONE;
   if(m_variableIsStated)
     step = PeridigmField::STEP_NP1;
   
-  std::vector<double> localData(3), globalData(3);
-  localData[0] = 0.0;
+  std::vector<double> localData(3, 0.0);
 
   for(std::vector<Block>::iterator blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
     if(blockIt->getID() == m_blockId){
@@ -223,17 +228,20 @@ int PeridigmNS::Compute_Nearest_Point_Data::compute( Teuchos::RCP< std::vector<P
     }
   }
 
+  // Only the owning processor contributes a nonzero value; the sum across processors is performed by the caller
+  for(int i=0 ; i<m_variableLength ; ++i)
+    localSums.push_back(localData[i]);
+
+  return 0;
+}
+
+int PeridigmNS::Compute_Nearest_Point_Data::finalizeGlobalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                                                        const double* globalSums,
+                                                                        const double* globalMaxima ) const {
+
   Teuchos::RCP<Epetra_Vector> outputData = blocks->begin()->getData(m_outputFieldId, PeridigmField::STEP_NONE);
-  if(m_variableLength == 1){
-    epetraComm()->SumAll(&localData[0], &globalData[0], 1);
-    (*outputData)[0] = globalData[0];
-  }
-  else if(m_variableLength == 3){
-    epetraComm()->SumAll(&localData[0], &globalData[0], 3);
-    (*outputData)[0] = globalData[0];
-    (*outputData)[1] = globalData[1];
-    (*outputData)[2] = globalData[2];
-  }
+  for(int i=0 ; i<m_variableLength ; ++i)
+    (*outputData)[i] = globalSums[i];
 
   return 0;
 }
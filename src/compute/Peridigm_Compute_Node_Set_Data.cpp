@@ -136,12 +136,18 @@ void PeridigmNS::Compute_Node_Set_Data::initialize( Teuchos::RCP< std::vector<Pe
 }
 
 int PeridigmNS::Compute_Node_Set_Data::compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks ) const {
+  return computeWithGlobalReduction(blocks);
+}
+
+int PeridigmNS::Compute_Node_Set_Data::computeLocalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                                                 std::vector<double>& localSums,
+                                                                 std::vector<double>& localMaxima ) const {
 
   PeridigmField::Step step = PeridigmField::STEP_NONE;
   if(m_variableIsStated)
     step = PeridigmField::STEP_NP1;
   
-  std::vector<double> localData(3), globalData(3);
+  std::vector<double> localData(3);
 
   if(m_calculationType == MINIMUM){
     for(int i=0 ; i<3 ; ++i)
@@ -213,26 +219,31 @@ int PeridigmNS::Compute_Node_Set_Data::compute( Teuchos::RCP< std::vector<Peridi
     }
   }
 
-  Teuchos::RCP<Epetra_Vector> outputData = blocks->begin()->getData(m_outputFieldId, PeridigmField::STEP_NONE);
-  if(m_variableLength == 1){
+  // The reduction across processors is performed by the caller; minima are reduced as negated maxima
+  for(int i=0 ; i<m_variableLength ; ++i){
     if(m_calculationType == MINIMUM)
-      epetraComm()->MinAll(&localData[0], &globalData[0], 1);
+      localMaxima.push_back(-localData[i]);
     else if(m_calculationType == MAXIMUM)
-      epetraComm()->MaxAll(&localData[0], &globalData[0], 1);
+      localMaxima.push_back(localData[i]);
     else if(m_calculationType == SUM)
-      epetraComm()->SumAll(&localData[0], &globalData[0], 1);
-    (*outputData)[0] = globalData[0];
+      localSums.push_back(localData[i]);
   }
-  else if(m_variableLength == 3){
+
+  return 0;
+}
+
+int PeridigmNS::Compute_Node_Set_Data::finalizeGlobalContribution( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks,
+                                                                   const double* globalSums,
+                                                                   const double* globalMaxima ) const {
+
+  Teuchos::RCP<Epetra_Vector> outputData = blocks->begin()->getData(m_outputFieldId, PeridigmField::STEP_NONE);
+  for(int i=0 ; i<m_variableLength ; ++i){
     if(m_calculationType == MINIMUM)
-      epetraComm()->MinAll(&localData[0], &globalData[0], 3);
+      (*outputData)[i] = -globalMaxima[i];
     else if(m_calculationType == MAXIMUM)
-      epetraComm()->MaxAll(&localData[0], &globalData[0], 3);
+      (*outputData)[i] = globalMaxima[i];
     else if(m_calculationType == SUM)
-      epetraComm()->SumAll(&localData[0], &globalData[0], 3);
-    (*outputData)[0] = globalData[0];
-    (*outputData)[1] = globalData[1];
-    (*outputData)[2] = globalData[2];
+      (*outputData)[i] = globalSums[i];
   }
 
   return 0;
@@ -74,6 +74,9 @@ namespace PeridigmNS {
     //! Returns a vector of field IDs corresponding to the variables associated with the compute class.
     virtual std::vector<int> FieldIds() const { return m_fieldIds; }
 
+    //! The computation is processor-local and involves no global communication.
+    virtual bool performsGlobalCommunication() const { return false; }
+
     //! Initialize the compute class
     virtual void initialize( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks  );
 
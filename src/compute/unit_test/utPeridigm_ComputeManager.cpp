@@ -0,0 +1,209 @@
+/*! \file utPeridigm_ComputeManager.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <Peridigm_Discretization.hpp>
+#include <Peridigm_ComputeManager.hpp>
+#include <Teuchos_ParameterList.hpp>
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_GlobalMPISession.hpp"
+#include <Epetra_ConfigDefs.h> // used to define HAVE_MPI
+#ifdef HAVE_MPI
+  #include <Epetra_MpiComm.h>
+#else
+  #include <Epetra_SerialComm.h>
+#endif
+#include <vector>
+#include "Peridigm.hpp"
+#include "Peridigm_Field.hpp"
+
+using namespace Teuchos;
+using namespace PeridigmNS;
+
+#ifdef HAVE_MPI
+  typedef Epetra_MpiComm BaseComm;
+#else
+  typedef Epetra_SerialComm BaseComm;
+#endif
+
+//! Communicator that counts the floating-point reductions carried out through it.
+class CountingComm : public BaseComm {
+
+public:
+
+#ifdef HAVE_MPI
+  CountingComm() : BaseComm(MPI_COMM_WORLD), numSumAll(0), numMaxAll(0) {}
+#else
+  CountingComm() : BaseComm(), numSumAll(0), numMaxAll(0) {}
+#endif
+
+  using BaseComm::SumAll;
+  using BaseComm::MaxAll;
+
+  int SumAll(double* partialSums, double* globalSums, int count) const {
+    numSumAll++;
+    return BaseComm::SumAll(partialSums, globalSums, count);
+  }
+
+  int MaxAll(double* partialMaxs, double* globalMaxs, int count) const {
+    numMaxAll++;
+    return BaseComm::MaxAll(partialMaxs, globalMaxs, count);
+  }
+
+  mutable int numSumAll;
+  mutable int numMaxAll;
+};
+
+Teuchos::RCP<Peridigm> createFourPointModel(Teuchos::RCP<Teuchos::ParameterList> outputVariables) {
+
+  // set up parameter lists
+  // these data would normally be read from an input xml file
+  Teuchos::RCP<Teuchos::ParameterList> peridigmParams = rcp(new Teuchos::ParameterList());
+
+  // material parameters
+  Teuchos::ParameterList& materialParams = peridigmParams->sublist("Materials");
+  Teuchos::ParameterList& linearElasticMaterialParams = materialParams.sublist("My Elastic Material");
+  linearElasticMaterialParams.set("Material Model", "Elastic");
+  linearElasticMaterialParams.set("Density", 7800.0);
+  linearElasticMaterialParams.set("Bulk Modulus", 130.0e9);
+  linearElasticMaterialParams.set("Shear Modulus", 78.0e9);
+
+  // blocks
+  Teuchos::ParameterList& blockParams = peridigmParams->sublist("Blocks");
+  Teuchos::ParameterList& blockOneParams = blockParams.sublist("My Group of Blocks");
+  blockOneParams.set("Block Names", "block_1");
+  blockOneParams.set("Material", "My Elastic Material");
+  blockOneParams.set("Horizon", 5.0);
+
+  // Set up discretization parameterlist
+  Teuchos::ParameterList& discretizationParams = peridigmParams->sublist("Discretization");
+  discretizationParams.set("Type", "PdQuickGrid");
+
+  // pdQuickGrid tensor product mesh generator parameters
+  Teuchos::ParameterList& pdQuickGridParams = discretizationParams.sublist("TensorProduct3DMeshGenerator");
+  pdQuickGridParams.set("Type", "PdQuickGrid");
+  pdQuickGridParams.set("X Origin",  0.0);
+  pdQuickGridParams.set("Y Origin",  0.0);
+  pdQuickGridParams.set("Z Origin",  0.0);
+  pdQuickGridParams.set("X Length",  6.0);
+  pdQuickGridParams.set("Y Length",  1.0);
+  pdQuickGridParams.set("Z Length",  1.0);
+  pdQuickGridParams.set("Number Points X", 4);
+  pdQuickGridParams.set("Number Points Y", 1);
+  pdQuickGridParams.set("Number Points Z", 1);
+
+  // output parameters (to force instantiation of data storage for compute classes in DataManager)
+  Teuchos::ParameterList& outputParams = peridigmParams->sublist("Output");
+  outputParams.sublist("Output Variables") = *outputVariables;
+
+  Teuchos::RCP<Discretization> nullDiscretization;
+  Teuchos::RCP<Peridigm> peridigm = Teuchos::rcp(new Peridigm(MPI_COMM_WORLD, peridigmParams, nullDiscretization));
+
+  return peridigm;
+}
+
+TEUCHOS_UNIT_TEST(ComputeManager, CollectiveCount)
+{
+  // Reduction-free and reducing compute classes, interleaved
+  Teuchos::RCP<Teuchos::ParameterList> computeParams = rcp(new Teuchos::ParameterList("Compute Manager"));
+  Teuchos::RCP<Teuchos::ParameterList> outputVariables = rcpFromRef(computeParams->sublist("Output Variables"));
+  outputVariables->set("Force", true);
+  outputVariables->set("Global_Kinetic_Energy", true);
+  outputVariables->set("Number_Of_Neighbors", true);
+  outputVariables->set("Kinetic_Energy", true);
+  outputVariables->set("Global_Linear_Momentum", true);
+  outputVariables->set("Radius", true);
+
+  Teuchos::RCP<Peridigm> peridigm = createFourPointModel(outputVariables);
+  Teuchos::RCP< std::vector<Block> > blocks = peridigm->getBlocks();
+
+  FieldManager& fieldManager = FieldManager::self();
+  Teuchos::RCP<Epetra_Vector> velocity = blocks->begin()->getData(fieldManager.getFieldId("Velocity"), PeridigmField::STEP_NP1);
+  int* myGIDs = velocity->Map().MyGlobalElements();
+  for(int i=0 ; i<velocity->Map().NumMyElements() ; ++i){
+    int ID = myGIDs[i];
+    (*velocity)[3*i]   = 3.0*ID;
+    (*velocity)[3*i+1] = 3.0*ID + 1.0;
+    (*velocity)[3*i+2] = 3.0*ID + 2.0;
+  }
+
+  Teuchos::RCP<CountingComm> comm = rcp(new CountingComm);
+  Teuchos::RCP<Teuchos::ParameterList> computeClassGlobalData = rcp(new Teuchos::ParameterList);
+
+  // The mixed list is reduced in a single batch, regardless of the interleaving
+  ComputeManager mixedComputeManager(computeParams, comm, computeClassGlobalData);
+  mixedComputeManager.initialize(blocks);
+  comm->numSumAll = 0;
+  comm->numMaxAll = 0;
+  mixedComputeManager.compute(blocks);
+  TEST_EQUALITY(comm->numSumAll, 1);
+  TEST_COMPARE(comm->numMaxAll, <=, 1);
+
+  double globalKE = (*blocks->begin()->getData(fieldManager.getFieldId("Global_Kinetic_Energy"), PeridigmField::STEP_NONE))[0];
+  TEST_FLOATING_EQUALITY(globalKE, 2960100.0, 1.0e-15);
+
+  // A list of reduction-free compute classes does not communicate at all
+  Teuchos::RCP<Teuchos::ParameterList> localComputeParams = rcp(new Teuchos::ParameterList("Compute Manager"));
+  Teuchos::ParameterList& localOutputVariables = localComputeParams->sublist("Output Variables");
+  localOutputVariables.set("Force", true);
+  localOutputVariables.set("Number_Of_Neighbors", true);
+  localOutputVariables.set("Kinetic_Energy", true);
+  localOutputVariables.set("Radius", true);
+
+  ComputeManager localComputeManager(localComputeParams, comm, computeClassGlobalData);
+  localComputeManager.initialize(blocks);
+  comm->numSumAll = 0;
+  comm->numMaxAll = 0;
+  localComputeManager.compute(blocks);
+  TEST_EQUALITY(comm->numSumAll, 0);
+  TEST_EQUALITY(comm->numMaxAll, 0);
+}
+
+int main (int argc, char* argv[])
+{
+  Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+  return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
@@ -56,6 +56,7 @@ PeridigmNS::ShortRangeForceContactModel::ShortRangeForceContactModel(const Teuch
     m_springConstant(0.0),
     m_frictionCoefficient(0.0),
     m_horizon(0.0),
+    m_useHalfNeighborList(false),
     m_volumeFieldId(-1),
     m_coordinatesFieldId(-1),
     m_velocityFieldId(-1),
@@ -74,6 +75,8 @@ PeridigmNS::ShortRangeForceContactModel::ShortRangeForceContactModel(const Teuch
   if(!params.isParameter("Horizon"))
     TEUCHOS_TEST_FOR_EXCEPTION(true, Teuchos::Exceptions::InvalidParameter, "Short range force contact parameter \"Horizon\" not specified.");
   m_horizon = params.get<double>("Horizon");
+  if(params.isParameter("Use Half Neighbor List"))
+    m_useHalfNeighborList = params.get<bool>("Use Half Neighbor List");
 
   PeridigmNS::FieldManager& fieldManager = PeridigmNS::FieldManager::self();
   m_volumeFieldId = fieldManager.getFieldId("Volume");
@@ -110,7 +113,16 @@ PeridigmNS::ShortRangeForceContactModel::computeForce(const double dt,
   dataManager.getData(m_velocityFieldId, PeridigmField::STEP_NP1)->ExtractView(&velocity);
   dataManager.getData(m_contactForceDensityFieldId, PeridigmField::STEP_NP1)->ExtractView(&contactForce);
 
-  int neighborhoodListIndex(0), numNeighbors, nodeID, neighborID, iID, iNID;
+  // With the half neighbor list, a pair that appears in both neighborhoods is evaluated only once with the full force
+  const int* neighborhoodList = contactNeighborhoodList;
+  const int* reverseBondIndices = 0;
+  if(m_useHalfNeighborList){
+    m_halfNeighborhoodList.update(numOwnedPoints, ownedIDs, contactNeighborhoodList, dataManager.getNeighborhoodVersion());
+    neighborhoodList = m_halfNeighborhoodList.NeighborhoodList();
+    reverseBondIndices = m_halfNeighborhoodList.ReverseBondIndices();
+  }
+
+  int neighborhoodListIndex(0), bondIndex(0), numNeighbors, nodeID, neighborID, iID, iNID;
   double nodeCurrentX[3], nodeCurrentV[3], nodeVolume, currentDistance, c, temp, neighborVolume;
   double normal[3], currentDotNormal, currentDotNeighbor, nodeCurrentVperp[3], nodeNeighborVperp[3], Vcm[3], nodeCurrentVrel[3], nodeNeighborVrel[3];
   double normCurrentVrel, normNeighborVrel, currentNormalForce[3], neighborNormalForce[3], normCurrentNormalForce, normNeighborNormalForce, currentFrictionForce[3], neighborFrictionForce[3];
@@ -121,7 +133,7 @@ PeridigmNS::ShortRangeForceContactModel::computeForce(const double dt,
   const double pi = boost::math::constants::pi<double>();
 
   for(iID=0 ; iID<numOwnedPoints ; ++iID){
-    numNeighbors = contactNeighborhoodList[neighborhoodListIndex++];
+    numNeighbors = neighborhoodList[neighborhoodListIndex++];
     if(numNeighbors > 0){
       nodeID = ownedIDs[iID];
       nodeCurrentX[0] = y[nodeID*3];
@@ -131,8 +143,8 @@ PeridigmNS::ShortRangeForceContactModel::computeForce(const double dt,
       nodeCurrentV[1] = velocity[nodeID*3+1];
       nodeCurrentV[2] = velocity[nodeID*3+2];
       nodeVolume = cellVolume[nodeID];
-      for(iNID=0 ; iNID<numNeighbors ; ++iNID){
-        neighborID = contactNeighborhoodList[neighborhoodListIndex++];
+      for(iNID=0 ; iNID<numNeighbors ; ++iNID, ++bondIndex){
+        neighborID = neighborhoodList[neighborhoodListIndex++];
         TEUCHOS_TEST_FOR_EXCEPT_MSG(neighborID < 0, "Invalid neighbor list\n");
 	currentDistanceSquared =  distanceSquared(nodeCurrentX[0], nodeCurrentX[1], nodeCurrentX[2],
 						  y[neighborID*3], y[neighborID*3+1], y[neighborID*3+2]);
@@ -140,6 +152,8 @@ PeridigmNS::ShortRangeForceContactModel::computeForce(const double dt,
 	  currentDistance = distance(nodeCurrentX[0], nodeCurrentX[1], nodeCurrentX[2],
 				     y[neighborID*3], y[neighborID*3+1], y[neighborID*3+2]);
           c = 9.0*m_springConstant/(pi*m_horizon*m_horizon*m_horizon*m_horizon);	// half value (of 18) due to force being applied to both nodes
+          if(reverseBondIndices != 0 && reverseBondIndices[bondIndex] != -1)
+            c *= 2.0;
           temp = c*(m_contactRadius - currentDistance)/m_horizon;
           neighborVolume = cellVolume[neighborID];
           
@@ -49,6 +49,7 @@
 #define PERIDIGM_SHORTRANGEFORCECONTACTMODEL_HPP
 
 #include "Peridigm_ContactModel.hpp"
+#include "Peridigm_HalfNeighborhoodList.hpp"
 
 namespace PeridigmNS {
 
@@ -99,6 +100,7 @@ namespace PeridigmNS {
 	double m_springConstant;
 	double m_frictionCoefficient;
     double m_horizon;
+    bool m_useHalfNeighborList;
 
     // field ids for all relevant data
     std::vector<int> m_fieldIds;
@@ -106,6 +108,9 @@ namespace PeridigmNS {
     int m_coordinatesFieldId;
     int m_velocityFieldId;
     int m_contactForceDensityFieldId;
+
+    //! Half neighbor list, in which each pair of owned points is evaluated once
+    mutable PeridigmNS::HalfNeighborhoodList m_halfNeighborhoodList;
   };
 }
 
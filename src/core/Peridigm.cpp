@@ -52,11 +52,11 @@
 //
 #include <iostream>
 #include <sstream>
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <string>
 
-#include <boost/unordered_set.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
 
 #include "Peridigm_Field.hpp"
@@ -69,6 +69,9 @@
 #include "Peridigm_BoundaryAndInitialConditionManager.hpp"
 #include "Peridigm_CriticalTimeStep.hpp"
 #include "Peridigm_Timer.hpp"
+#include "Peridigm_LoadStepPredictor.hpp"
+#include "Peridigm_BlockJacobiPreconditioner.hpp"
+#include "Peridigm_MultigridPreconditioner.hpp"
 #include "Peridigm_MaterialFactory.hpp"
 #include "Peridigm_DamageModelFactory.hpp"
 #include "Peridigm_InterfaceAwareDamageModel.hpp"
@@ -78,11 +81,17 @@
 #include "Peridigm.hpp"
 #include "correspondence.h" // For Invert3by3Matrix
 #include "Peridigm_DataManager.hpp" //For readBlocktoDisk & writeBlocktoDisk
+#ifdef PERIDIGM_KOKKOS
+  #include "elastic_kokkos.h"
+#endif
 #ifdef PERIDIGM_PV
   #include "Peridigm_PartialVolumeCalculator.hpp"
 #endif
+#include "Peridigm_AnalyticPartialVolume.hpp"
 
 #include <Epetra_Import.h>
+#include <Epetra_Export.h>
+#include <Epetra_CrsGraph.h>
 #include <Epetra_LinearProblem.h>
 #include <EpetraExt_MultiVectorOut.h>
 #include <EpetraExt_RowMatrixOut.h>
@@ -108,7 +117,11 @@ PeridigmNS::Peridigm::Peridigm(const MPI_Comm& comm,
     analysisHasContact(false),
     analysisHasMultiphysics(false),
     computeIntersections(false),
+    computeAnalyticPartialVolumes(false),
     constructInterfaces(false),
+    preconditionerLagRatio(0.0),
+    preconditionerReferenceIterations(-1),
+    linearSolverIterations(0),
     blockIdFieldId(-1),
     horizonFieldId(-1),
     volumeFieldId(-1),
@@ -144,6 +157,18 @@ PeridigmNS::Peridigm::Peridigm(const MPI_Comm& comm,
   Memstat * memstat = Memstat::Instance();
   memstat->setComm(peridigmComm);
 
+  // Optional profiling output:  JSON report and per-step time series
+  if(peridigmParams->isSublist("Timing")){
+    Teuchos::ParameterList& timingParams = peridigmParams->sublist("Timing");
+    PeridigmNS::Timer::self().setJSONFilename(timingParams.get<string>("JSON Filename", "timing.json"));
+    PeridigmNS::Timer::self().setTimeSeriesFrequency(timingParams.get<int>("Time Series Frequency", 0));
+  }
+
+#ifdef PERIDIGM_KOKKOS
+  // Initialize the Kokkos execution space once for the entire run (zero threads indicates all available cores)
+  MATERIAL_EVALUATION::initializeKokkos(peridigmParams->get<int>("Kokkos Threads", 0));
+#endif
+
   // Tracker for recording the total number of iterations taken by the nonlinear solver
   nonlinearSolverIterations = Teuchos::rcp(new int);
   *nonlinearSolverIterations = 0;
@@ -197,6 +222,12 @@ PeridigmNS::Peridigm::Peridigm(const MPI_Comm& comm,
   TEUCHOS_TEST_FOR_EXCEPT_MSG(computeIntersections, "\n**** Error:  Horizon-Element intersections not enabled, recompile with -DUSE_PV.\n");
 #endif
 
+  // Check for command to compute analytic approximations of the partial volumes
+  if(discParams->isParameter("Compute Analytic Partial Volumes"))
+    computeAnalyticPartialVolumes = discParams->get<bool>("Compute Analytic Partial Volumes");
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(computeAnalyticPartialVolumes && computeIntersections,
+                              "\n**** Error:  \"Compute Analytic Partial Volumes\" and \"Compute Element-Horizon Intersections\" may not be used together.\n");
+
   // Pass the blockParams to the HorizonManager
   Teuchos::ParameterList& blockParams = peridigmParams->sublist("Blocks", true);
   PeridigmNS::HorizonManager& horizonManager = PeridigmNS::HorizonManager::self();
@@ -392,6 +423,12 @@ PeridigmNS::Peridigm::Peridigm(const MPI_Comm& comm,
     if(constantHorizon)
       matParams.set("Horizon", blockHorizon);
 
+    // The partial volume bond fields are filled only if they are computed at setup, otherwise they remain zero
+    bool usePartialVolume = matParams.isParameter("Use Partial Volume") && matParams.get<bool>("Use Partial Volume");
+    string partialVolumeError = "\n**** Error, material " + materialName + " in block " + blockName + " sets \"Use Partial Volume\" but partial volumes are not computed.\n";
+    partialVolumeError +=         "****        Set \"Compute Analytic Partial Volumes\" or \"Compute Element-Horizon Intersections\" in the Discretization section.\n";
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(usePartialVolume && !computeAnalyticPartialVolumes && !computeIntersections, partialVolumeError);
+
     // Assign the finite difference probe length
     if(!matParams.isParameter("Finite Difference Probe Length"))
       matParams.set("Finite Difference Probe Length", defaultFiniteDifferenceProbeLength);
@@ -463,11 +500,24 @@ PeridigmNS::Peridigm::Peridigm(const MPI_Comm& comm,
     tempFieldId = fieldManager.getFieldId(PeridigmField::BOND, PeridigmField::SCALAR, PeridigmField::CONSTANT, "Self_Centroid_Z");
     auxiliaryFieldIds.push_back(tempFieldId);
   }
+  if(computeAnalyticPartialVolumes){
+    int tempFieldId;
+    tempFieldId = fieldManager.getFieldId(PeridigmField::BOND, PeridigmField::SCALAR, PeridigmField::CONSTANT, "Neighbor_Volume");
+    auxiliaryFieldIds.push_back(tempFieldId);
+    tempFieldId = fieldManager.getFieldId(PeridigmField::BOND, PeridigmField::SCALAR, PeridigmField::CONSTANT, "Self_Volume");
+    auxiliaryFieldIds.push_back(tempFieldId);
+  }
 
   // Add fields from compute classes to auxiliary field vector
   vector<int> computeManagerFieldIds = computeManager->FieldIds();
   auxiliaryFieldIds.insert(auxiliaryFieldIds.end(), computeManagerFieldIds.begin(), computeManagerFieldIds.end());
 
+  // Add fields required by time-history probes
+  if(peridigmParams->isSublist("Time History")){
+    vector<int> probeFieldIds = PeridigmNS::ProbeManager::FieldIds(peridigmParams->sublist("Time History"));
+    auxiliaryFieldIds.insert(auxiliaryFieldIds.end(), probeFieldIds.begin(), probeFieldIds.end());
+  }
+
   for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++)
     blockIt->setAuxiliaryFieldIds(auxiliaryFieldIds);
 
@@ -556,6 +606,13 @@ PeridigmNS::Peridigm::Peridigm(const MPI_Comm& comm,
   }
 #endif
 
+  // Compute analytic approximations of the partial volumes
+  if(computeAnalyticPartialVolumes){
+    PeridigmNS::Timer::self().startTimer("Analytic Partial Volumes");
+    computeAnalyticPartialVolume(blocks);
+    PeridigmNS::Timer::self().stopTimer("Analytic Partial Volumes");
+  }
+
   // Store the locations of the original Exodus nodes for each element.
   // This is only done if the fields "Exodus_Node_1", "Exodus_Node_2", etc., have been registered.
   // The point of storing the node positions as element variables is to make them available in
@@ -673,6 +730,9 @@ PeridigmNS::Peridigm::Peridigm(const MPI_Comm& comm,
   // Initialize output manager
   initializeOutputManager();
 
+  // Initialize time-history probes
+  initializeProbeManager();
+
   // Call rebalance function if analysis has contact
   // this is required to set up proper contact neighbor list
   if(analysisHasContact)
@@ -1197,6 +1257,15 @@ void PeridigmNS::Peridigm::initializeOutputManager() {
   }
 }
 
+void PeridigmNS::Peridigm::initializeProbeManager() {
+
+  // Time-history probes are lightweight per-step output that does not trigger a full data dump
+  Teuchos::RCP<Teuchos::ParameterList> probeParams;
+  if(peridigmParams->isSublist("Time History"))
+    probeParams = Teuchos::rcp( new Teuchos::ParameterList( peridigmParams->sublist("Time History") ) );
+  probeManager = Teuchos::rcp(new PeridigmNS::ProbeManager(probeParams, this));
+}
+
 void PeridigmNS::Peridigm::execute(Teuchos::RCP<Teuchos::ParameterList> solverParams) {
 
   TEUCHOS_TEST_FOR_EXCEPT_MSG(solverParams.is_null(), "Error in Peridigm::execute, solverParams is null.\n");
@@ -1205,11 +1274,13 @@ void PeridigmNS::Peridigm::execute(Teuchos::RCP<Teuchos::ParameterList> solverPa
   if(solverParams->isSublist("Verlet")){
     executeExplicit(solverParams);}
 
-  // allowable implicit time integration schemes:  Implicit, QuasiStatic
+  // allowable implicit time integration schemes:  Implicit, QuasiStatic, NOXQuasiStatic, Adaptive Dynamic Relaxation
   else if(solverParams->isSublist("QuasiStatic"))    
     executeQuasiStatic(solverParams);
   else if(solverParams->isSublist("NOXQuasiStatic"))    
     executeNOXQuasiStatic(solverParams);
+  else if(solverParams->isSublist("Adaptive Dynamic Relaxation"))
+    executeAdaptiveDynamicRelaxation(solverParams);
   else if(solverParams->isSublist("Implicit"))    
     executeImplicit(solverParams);
 
@@ -1253,6 +1324,10 @@ void PeridigmNS::Peridigm::executeExplicit(Teuchos::RCP<Teuchos::ParameterList>
     safetyFactor = verletParams->get<double>("Safety Factor");
     dt *= safetyFactor;
   }
+  // The force, external force, and contact force are checked for non-finite values once every finiteValueCheckInterval
+  // steps; non-finite values propagate into the acceleration and velocity, so a sparser check still catches them
+  int finiteValueCheckInterval = verletParams->get("Finite Value Check Interval", 1);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(finiteValueCheckInterval < 0, "**** Error:  Finite Value Check Interval must be zero (no check) or positive.\n");
   double timeInitial = solverParams->get("Initial Time", 0.0);
   double timeFinal   = solverParams->get("Final Time", 1.0);
   double timeCurrent = timeInitial;
@@ -1287,12 +1362,18 @@ void PeridigmNS::Peridigm::executeExplicit(Teuchos::RCP<Teuchos::ParameterList>
   }
 
   // Pointer index into sub-vectors for use with BLAS
-  double *xPtr, *uPtr, *yPtr, *vPtr, *aPtr;
+  double *xPtr, *uPtr, *yPtr, *vPtr, *aPtr, *forcePtr, *externalForcePtr, *densityPtr, *contactForcePtr;
   x->ExtractView( &xPtr );
   u->ExtractView( &uPtr );
   y->ExtractView( &yPtr );
   v->ExtractView( &vPtr );
   a->ExtractView( &aPtr );
+  force->ExtractView( &forcePtr );
+  externalForce->ExtractView( &externalForcePtr );
+  density->ExtractView( &densityPtr );
+  contactForcePtr = 0;
+  if(analysisHasContact)
+    contactForce->ExtractView( &contactForcePtr );
   int length = a->MyLength();
 
   // Set the prescribed displacements (allow for nonzero initial displacements).
@@ -1351,6 +1432,7 @@ void PeridigmNS::Peridigm::executeExplicit(Teuchos::RCP<Teuchos::ParameterList>
   synchDataManagers();
   outputManager->write(blocks, timeCurrent);
   PeridigmNS::Timer::self().stopTimer("Output");
+  probeManager->record(timeCurrent);
 
   int displayTrigger = nsteps/100;
   if(displayTrigger == 0)
@@ -1364,6 +1446,14 @@ void PeridigmNS::Peridigm::executeExplicit(Teuchos::RCP<Teuchos::ParameterList>
   double currentValue = 0.0;
   double previousValue = 0.0;
 
+  // Timer handles, to avoid string lookups in the time loop
+  const int rebalanceTimerId = PeridigmNS::Timer::self().getTimerId("Rebalance");
+  const int applyKinematicBCTimerId = PeridigmNS::Timer::self().getTimerId("Apply Kinematic B.C.");
+  const int applyBodyForcesTimerId = PeridigmNS::Timer::self().getTimerId("Apply Body Forces");
+  const int gatherScatterTimerId = PeridigmNS::Timer::self().getTimerId("Gather/Scatter");
+  const int internalForceTimerId = PeridigmNS::Timer::self().getTimerId("Internal Force");
+  const int outputTimerId = PeridigmNS::Timer::self().getTimerId("Output");
+
   for(int step=1; step<=nsteps; step++){
 
     double timePrevious = timeCurrent;
@@ -1386,11 +1476,11 @@ void PeridigmNS::Peridigm::executeExplicit(Teuchos::RCP<Teuchos::ParameterList>
       displayProgress("Explicit time integration", (step-1)*100.0/nsteps);
 
     // rebalance, if requested
-    PeridigmNS::Timer::self().startTimer("Rebalance");
+    PeridigmNS::Timer::self().startTimer(rebalanceTimerId);
     // \todo Should we load updated information first?  If so, only do this if we're really going to rebalance.
     if(analysisHasContact)
       contactManager->rebalance(step);
-    PeridigmNS::Timer::self().stopTimer("Rebalance");
+    PeridigmNS::Timer::self().stopTimer(rebalanceTimerId);
 
     // Do one step of velocity-Verlet
 
@@ -1401,28 +1491,27 @@ void PeridigmNS::Peridigm::executeExplicit(Teuchos::RCP<Teuchos::ParameterList>
     // Set the velocities for dof with kinematic boundary conditions.
     // This will propagate through the Verlet integrator and result in the proper
     // displacement boundary conditions on y and consistent values for v and u.
-    PeridigmNS::Timer::self().startTimer("Apply Kinematic B.C.");
+    PeridigmNS::Timer::self().startTimer(applyKinematicBCTimerId);
     boundaryAndInitialConditionManager->applyBoundaryConditions(timeCurrent, timePrevious);
-    PeridigmNS::Timer::self().stopTimer("Apply Kinematic B.C.");
+    PeridigmNS::Timer::self().stopTimer(applyKinematicBCTimerId);
 
     // evaluate the external (body) forces:
-    PeridigmNS::Timer::self().startTimer("Apply Body Forces");
+    PeridigmNS::Timer::self().startTimer(applyBodyForcesTimerId);
     boundaryAndInitialConditionManager->applyForceContributions(timeCurrent, 0.0); // external forces are dirichlet BCs so the previous time is defaulted to 0.0
-    PeridigmNS::Timer::self().stopTimer("Apply Body Forces");
+    PeridigmNS::Timer::self().stopTimer(applyBodyForcesTimerId);
 
     // Y^{n+1} = X_{o} + U^{n} + (dt)*V^{n+1/2}
-    // \todo Replace with blas call
-    for(int i=0 ; i<y->MyLength() ; ++i)
-      yPtr[i] = xPtr[i] + uPtr[i] + dt*vPtr[i];
-
     // U^{n+1} = U^{n} + (dt)*V^{n+1/2}
-    // blas.AXPY(const int N, const double ALPHA, const double *X, double *Y, const int INCX=1, const int INCY=1) const
-    blas.AXPY(length, dt, vPtr, uPtr, 1, 1);
+    for(int i=0 ; i<length ; ++i){
+      double increment = dt*vPtr[i];
+      yPtr[i] = xPtr[i] + uPtr[i] + increment;
+      uPtr[i] += increment;
+    }
 
     // \todo The velocity copied into the DataManager is actually the midstep velocity, not the NP1 velocity; this can be fixed by creating a midstep velocity field in the DataManager and setting the NP1 value as invalid.
 
     // Copy data from mothership vectors to overlap vectors in data manager
-    PeridigmNS::Timer::self().startTimer("Gather/Scatter");
+    PeridigmNS::Timer::self().startTimer(gatherScatterTimerId);
     for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
       blockIt->importData(*u, displacementFieldId, PeridigmField::STEP_NP1, Insert);
       blockIt->importData(*y, coordinatesFieldId, PeridigmField::STEP_NP1, Insert);
@@ -1437,57 +1526,61 @@ void PeridigmNS::Peridigm::executeExplicit(Teuchos::RCP<Teuchos::ParameterList>
       } 
       contactManager->importData(volume, y, v);
     }
-    PeridigmNS::Timer::self().stopTimer("Gather/Scatter");
+    PeridigmNS::Timer::self().stopTimer(gatherScatterTimerId);
 
     // Update forces based on new positions
-    PeridigmNS::Timer::self().startTimer("Internal Force");
+    PeridigmNS::Timer::self().startTimer(internalForceTimerId);
     modelEvaluator->evalModel(workset);
-    PeridigmNS::Timer::self().stopTimer("Internal Force");
+    PeridigmNS::Timer::self().stopTimer(internalForceTimerId);
 
     // Copy force from the data manager to the mothership vector
-    PeridigmNS::Timer::self().startTimer("Gather/Scatter");
+    PeridigmNS::Timer::self().startTimer(gatherScatterTimerId);
     force->PutScalar(0.0);
     for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
       scratch->PutScalar(0.0);
       blockIt->exportData(*scratch, forceDensityFieldId, PeridigmField::STEP_NP1, Add);
       force->Update(1.0, *scratch, 1.0);
     }
-    PeridigmNS::Timer::self().stopTimer("Gather/Scatter");    
+    PeridigmNS::Timer::self().stopTimer(gatherScatterTimerId);    
 
-    // Check for NaNs in force evaluation
-    // We'd like to know now because a NaN will likely cause a difficult-to-unravel crash downstream.
-    for(int i=0 ; i<force->MyLength() ; ++i)
-      TEUCHOS_TEST_FOR_EXCEPT_MSG(!boost::math::isfinite((*force)[i]), "**** NaN returned by force evaluation.\n");
-
-    // Check for NaNs in force evaluation
-    // We'd like to know now because a NaN will likely cause a difficult-to-unravel crash downstream.
-    for(int i=0 ; i<externalForce->MyLength() ; ++i)
-      TEUCHOS_TEST_FOR_EXCEPT_MSG(!boost::math::isfinite((*externalForce)[i]), "**** NaN returned by external force evaluation.\n");
-
-    if(analysisHasContact){
+    if(analysisHasContact)
       contactManager->exportData(contactForce);
-      // Check for NaNs in contact force evaluation
-      for(int i=0 ; i<contactForce->MyLength() ; ++i)
-        TEUCHOS_TEST_FOR_EXCEPT_MSG(!boost::math::isfinite((*contactForce)[i]), "**** NaN returned by contact force evaluation.\n");
-      // Add contact forces to forces
-      force->Update(1.0, *contactForce, 1.0);
-    }
 
-    // fill the acceleration vector
-    (*a) = (*force);
-    for(int i=0 ; i<a->MyLength() ; ++i){
-      (*a)[i] += (*externalForce)[i];
-      (*a)[i] /= (*density)[i/3];
+    // Add the contact forces to the forces, fill the acceleration vector, and complete the step in a single pass
+    // A^{n+1} = (F^{n+1} + F_{contact}^{n+1} + F_{external}^{n+1}) / rho
+    // V^{n+1} = V^{n+1/2} + (dt/2)*A^{n+1}
+    // A NaN or Inf in any of the forces makes the acceleration non-finite, which is detected by summing 0.0*A^{n+1}
+    double finiteValueCheck = 0.0;
+    for(int i=0 ; i<length ; ++i){
+      double f = forcePtr[i];
+      if(contactForcePtr){
+        f += contactForcePtr[i];
+        forcePtr[i] = f;
+      }
+      double acceleration = (f + externalForcePtr[i]) / densityPtr[i/3];
+      aPtr[i] = acceleration;
+      vPtr[i] += dt2*acceleration;
+      finiteValueCheck += 0.0*acceleration;
     }
 
-    // V^{n+1}   = V^{n+1/2} + (dt/2)*A^{n+1}
-    //blas.AXPY(const int N, const double ALPHA, const double *X, double *Y, const int INCX=1, const int INCY=1) const
-    blas.AXPY(length, dt2, aPtr, vPtr, 1, 1);
+    // Check for NaNs in force evaluation
+    // We'd like to know now because a NaN will likely cause a difficult-to-unravel crash downstream.
+    if(finiteValueCheckInterval > 0 && step%finiteValueCheckInterval == 0 && !boost::math::isfinite(finiteValueCheck)){
+      // Identify the source of the non-finite value
+      for(int i=0 ; i<length ; ++i){
+        TEUCHOS_TEST_FOR_EXCEPT_MSG(contactForcePtr && !boost::math::isfinite(contactForcePtr[i]), "**** NaN returned by contact force evaluation.\n");
+        TEUCHOS_TEST_FOR_EXCEPT_MSG(!boost::math::isfinite(externalForcePtr[i]), "**** NaN returned by external force evaluation.\n");
+        TEUCHOS_TEST_FOR_EXCEPT_MSG(!boost::math::isfinite(forcePtr[i]), "**** NaN returned by force evaluation.\n");
+      }
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(true, "**** NaN detected in acceleration.\n");
+    }
 
-    PeridigmNS::Timer::self().startTimer("Output");
+    PeridigmNS::Timer::self().startTimer(outputTimerId);
     synchDataManagers();
     outputManager->write(blocks, timeCurrent);
-    PeridigmNS::Timer::self().stopTimer("Output");
+    PeridigmNS::Timer::self().stopTimer(outputTimerId);
+    probeManager->record(timeCurrent);
+    PeridigmNS::Timer::self().markStep();
 
     // swap state N and state NP1
     for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++)
@@ -1944,6 +2037,9 @@ void PeridigmNS::Peridigm::executeNOXQuasiStatic(Teuchos::RCP<Teuchos::Parameter
   // Create a print class for controlling output below 
   NOX::Utils noxPrinting(printParams);
 
+  // Predictor for the initial guess at each load step, extrapolated from the converged increments of previous load steps
+  LoadStepPredictor loadStepPredictor(LoadStepPredictor::orderFromString(noxQuasiStaticParams->get<string>("Load Step Predictor", "Linear")));
+
   // Create list of time steps
   // Case 1:  User provided initial time, final time, and number of load steps
   vector<double> timeSteps;
@@ -1974,6 +2070,7 @@ void PeridigmNS::Peridigm::executeNOXQuasiStatic(Teuchos::RCP<Teuchos::Parameter
   synchDataManagers();
   outputManager->write(blocks, timeCurrent);
   PeridigmNS::Timer::self().stopTimer("Output");
+  probeManager->record(timeCurrent);
 
   // Functionality for updating the Jacobian at a user-specified interval
   // This does not appear to be available for nonlinear CG in NOX, but it's important for peridynamics, so
@@ -2005,21 +2102,10 @@ void PeridigmNS::Peridigm::executeNOXQuasiStatic(Teuchos::RCP<Teuchos::Parameter
 			fluidPressureDeltaU->PutScalar(0.0);
     }
     
-    if(analysisHasMultiphysics){
-			// Ensure that information from v and fluidPressureV is in combinedV
-			for(int i=0 ; i<initialGuess->MyLength() ; i+=(3+numMultiphysDoFs)){
-				for(int j = 0; j<3; ++j){
-					(*initialGuess)[i+j] = (*v)[i/(3+numMultiphysDoFs)*3+j]*timeIncrement;
-				}
-				(*initialGuess)[i+3] = (*fluidPressureV)[i/(3+numMultiphysDoFs)]*timeIncrement;
-			}
-    }
-    else{
-        // Use a predictor based on the velocity from the previous load step
-				//
-        for(int i=0 ; i<initialGuess->MyLength() ; ++i)
-            (*initialGuess)[i] = (*v)[i]*timeIncrement;
-    }
+    // Use a predictor based on the velocities from the previous load steps
+    // The predictor is laid out as the combined vectors if multiphysics is enabled
+    initialGuess->PutScalar(0.0);
+    loadStepPredictor.predict(*initialGuess, timeIncrement);
 
     v->PutScalar(0.0); 
     if(analysisHasMultiphysics){
@@ -2338,11 +2424,19 @@ void PeridigmNS::Peridigm::executeNOXQuasiStatic(Teuchos::RCP<Teuchos::Parameter
             (*u)[i] += finalSolution[i];
     }
 
+    // Store the velocity for use as a predictor in the next load step
+    if(analysisHasMultiphysics)
+      loadStepPredictor.recordConvergedStep(*combinedV, timeIncrement);
+    else
+      loadStepPredictor.recordConvergedStep(*v, timeIncrement);
+
     // Write output for completed load step
     PeridigmNS::Timer::self().startTimer("Output");
     synchDataManagers();
     outputManager->write(blocks, timeCurrent);
     PeridigmNS::Timer::self().stopTimer("Output");
+    probeManager->record(timeCurrent);
+    PeridigmNS::Timer::self().markStep();
 
     // swap state N and state NP1
     for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++)
@@ -2370,19 +2464,15 @@ void PeridigmNS::Peridigm::executeQuasiStatic(Teuchos::RCP<Teuchos::ParameterLis
   if(disableHeuristics && peridigmComm->MyPID() == 0)
     cout << "\nUser has disabled solver heuristics.\n" << endl;
 
-  // Vector for predictor
-  //Epetra_Vector predictor(v->Map());
-  Teuchos::RCP<Epetra_Vector> predictor;
-  if(analysisHasMultiphysics)
-  	predictor = Teuchos::rcp(new Epetra_Vector(combinedV->Map()));
-  else
-  	predictor = Teuchos::rcp(new Epetra_Vector(v->Map()));
-
   bool solverVerbose = solverParams->get("Verbose", false);
   Teuchos::RCP<Teuchos::ParameterList> quasiStaticParams = sublist(solverParams, "QuasiStatic", true);
   int maxSolverIterations = quasiStaticParams->get("Maximum Solver Iterations", 10);
   double dampedNewtonDiagonalScaleFactor = quasiStaticParams->get("Damped Newton Diagonal Scale Factor", 1.0001);
   double dampedNewtonDiagonalShiftFactor = quasiStaticParams->get("Damped Newton Diagonal Shift Factor", 0.00001);
+  setLinearSolverPreconditioner(quasiStaticParams);
+
+  // Predictor for the first iteration of each load step, extrapolated from the converged increments of previous load steps
+  LoadStepPredictor loadStepPredictor(LoadStepPredictor::orderFromString(quasiStaticParams->get<string>("Load Step Predictor", "Linear")));
 
   // Determine tolerance
   double tolerance = quasiStaticParams->get("Relative Tolerance", 1.0e-6);
@@ -2474,21 +2564,43 @@ void PeridigmNS::Peridigm::executeQuasiStatic(Teuchos::RCP<Teuchos::ParameterLis
 
   double timeCurrent = timeSteps[0];
 
+  // Adaptive load stepping:  a load step of the schedule may be subdivided, with the increment reduced by the cutback
+  // factor and retried from the last converged state when the nonlinear solver fails, and increased by the growth
+  // factor (up to the size of the scheduled load step) when the nonlinear solver converges in few iterations
+  const bool adaptiveLoadStepping = quasiStaticParams->get("Adaptive Load Stepping", false);
+  const int maxLoadStepCutbacks = quasiStaticParams->get("Maximum Load Step Cutbacks", 8);
+  const double loadStepCutbackFactor = quasiStaticParams->get("Load Step Cutback Factor", 0.5);
+  const double loadStepGrowthFactor = quasiStaticParams->get("Load Step Growth Factor", 1.5);
+  const int loadStepGrowthIterations = quasiStaticParams->get("Load Step Growth Iterations", 3);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(loadStepCutbackFactor <= 0.0 || loadStepCutbackFactor >= 1.0,
+                              "**** Error:  Load Step Cutback Factor must be greater than zero and less than one.\n");
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(loadStepGrowthFactor < 1.0, "**** Error:  Load Step Growth Factor must be greater than or equal to one.\n");
+  double adaptiveTimeIncrement = timeSteps.size() > 1 ? timeSteps[1] - timeSteps[0] : 0.0;
+  int numLoadStepCutbacks = 0;
+
   // Write initial configuration to disk
   PeridigmNS::Timer::self().startTimer("Output");
   synchDataManagers();
   outputManager->write(blocks, timeCurrent);
   PeridigmNS::Timer::self().stopTimer("Output");
+  probeManager->record(timeCurrent);
 
   Epetra_Time loadStepCPUTime(*peridigmComm);
   double cumulativeLoadStepCPUTime = 0.0;
 
-  for(int step=1 ; step<(int)timeSteps.size() ; step++){
+  int step = 1;
+  while(step < (int)timeSteps.size()){
 
     loadStepCPUTime.ResetStartTime();
 
     double timePrevious = timeCurrent;
     timeCurrent = timeSteps[step];
+    if(adaptiveLoadStepping){
+      adaptiveTimeIncrement = std::min(adaptiveTimeIncrement, timeSteps[step] - timeSteps[step-1]);
+      // Take the remainder of the scheduled load step if it is only slightly larger than the adaptive increment
+      if(timeSteps[step] - timePrevious > (1.0 + 1.0e-10)*adaptiveTimeIncrement)
+        timeCurrent = timePrevious + adaptiveTimeIncrement;
+    }
     double timeIncrement = timeCurrent - timePrevious;
     workset->timeStep = timeIncrement;
 
@@ -2569,8 +2681,11 @@ void PeridigmNS::Peridigm::executeQuasiStatic(Teuchos::RCP<Teuchos::ParameterLis
 
     int solverIteration = 1;
     bool dampedNewton = false;
-    bool usePreconditioner = false; // \todo Determine why ifpack preconditioners started exhibiting problems with Trilinos 11.2.5 (Jul-11-2013).
-                                    //       For the record, Trilinos 11.2.4 (Jun-20-2013) works.
+    // \todo Determine why ifpack preconditioners started exhibiting problems with Trilinos 11.2.5 (Jul-11-2013).
+    //       For the record, Trilinos 11.2.4 (Jun-20-2013) works.
+    bool usePreconditioner = (linearSolverPreconditioner != "None");
+    // The multigrid preconditioner remains effective for poorly-conditioned tangents and is not subject to the heuristics below
+    const bool applyPreconditionerHeuristics = (linearSolverPreconditioner == "Ifpack");
     int numPureNewtonSteps = 50;//8;
     int numPreconditionerSteps = 24;
     int dampedNewtonNumStepsBetweenTangentUpdates = 8;
@@ -2592,10 +2707,9 @@ void PeridigmNS::Peridigm::executeQuasiStatic(Teuchos::RCP<Teuchos::ParameterLis
           cout << "  iteration " << solverIteration << ": residual = " << residualNorm << ", residual L2 = " << residualL2 << ", residual inf = " << residualInf << ", alpha = " << alpha << endl;
       }
 
-      // On the first iteration, use a predictor based on the velocity from the previous load step
-      if(solverIteration == 1 && step > 1 && !disableHeuristics) {
-        for(int i=0 ; i<lhs->MyLength() ; ++i)
-          (*lhs)[i] = (*predictor)[i]*timeIncrement;
+      // On the first iteration, use a predictor based on the velocities from the previous load steps
+      if(solverIteration == 1 && loadStepPredictor.NumRecordedSteps() > 0 && !disableHeuristics) {
+        loadStepPredictor.predict(*lhs, timeIncrement);
         boundaryAndInitialConditionManager->applyKinematicBC_InsertZeros(lhs, numMultiphysDoFs);
         isConverged = Belos::Converged;
       }
@@ -2609,14 +2723,14 @@ void PeridigmNS::Peridigm::executeQuasiStatic(Teuchos::RCP<Teuchos::ParameterLis
         }
 
         // If we reach the specified maximum number of iterations of the nonlinear solver, disable the preconditioner
-        if(solverIteration > numPreconditionerSteps && usePreconditioner){
+        if(solverIteration > numPreconditionerSteps && usePreconditioner && applyPreconditionerHeuristics){
           if(peridigmComm->MyPID() == 0)
             cout << "  --disabling preconditioner--" << endl;
           usePreconditioner = false;
         }
 
         // Disable the preconditioner if the user specifies disable heuristics
-        if(disableHeuristics) usePreconditioner = false;
+        if(disableHeuristics && applyPreconditionerHeuristics) usePreconditioner = false;
 
         // Compute the tangent
         if( !dampedNewton || (solverIteration-numPureNewtonSteps-1)%dampedNewtonNumStepsBetweenTangentUpdates==0 ){
@@ -2710,6 +2824,17 @@ void PeridigmNS::Peridigm::executeQuasiStatic(Teuchos::RCP<Teuchos::ParameterLis
     if(solverIteration >= maxSolverIterations && peridigmComm->MyPID() == 0)
       cout << "\nWarning:  Nonlinear solver failed to converge in maximum allowable iterations." << endl;
 
+    // If adaptive load stepping is enabled, discard the unconverged increment and retry with a smaller increment.
+    // The converged state is untouched:  the displacement is updated and the block states are swapped only after convergence.
+    if(residualNorm > tolerance*toleranceMultiplier && adaptiveLoadStepping && numLoadStepCutbacks < maxLoadStepCutbacks){
+      numLoadStepCutbacks += 1;
+      adaptiveTimeIncrement = loadStepCutbackFactor*timeIncrement;
+      timeCurrent = timePrevious;
+      if(peridigmComm->MyPID() == 0)
+        cout << "  --reducing load step size to " << adaptiveTimeIncrement << " and retrying (cutback " << numLoadStepCutbacks << " of " << maxLoadStepCutbacks << ")--\n" << endl;
+      continue;
+    }
+
     // If the maximum allowable number of load step reductions has been reached and the residual
     // is within a reasonable tolerance, then just accept the solution and forge ahead.
     // If not, abort the analysis.
@@ -2759,23 +2884,308 @@ void PeridigmNS::Peridigm::executeQuasiStatic(Teuchos::RCP<Teuchos::ParameterLis
 					(*fluidPressureU)[i/(3+numMultiphysDoFs)] += (*combinedDeltaU)[i+3];
 					(*fluidPressureDeltaU)[i/(3+numMultiphysDoFs)] = (*combinedDeltaU)[i+3];
 			}
-			// Store the velocity for use as a predictor in the next load step
-			for(int i=0 ; i<combinedV->MyLength() ; ++i){
-				(*predictor)[i] = (*combinedV)[i];
-			}
     }
     else{
-	    for(int i=0 ; i<u->MyLength() ; ++i){
+	    for(int i=0 ; i<u->MyLength() ; ++i)
 	      (*u)[i] += (*deltaU)[i];
-				(*predictor)[i] = (*v)[i];
-			}
 		}
 
+    // Store the velocity for use as a predictor in the next load step
+    if(analysisHasMultiphysics)
+      loadStepPredictor.recordConvergedStep(*combinedV, timeIncrement);
+    else
+      loadStepPredictor.recordConvergedStep(*v, timeIncrement);
+
+    // Increase the load step size if the nonlinear solver converged in few iterations
+    if(adaptiveLoadStepping){
+      numLoadStepCutbacks = 0;
+      adaptiveTimeIncrement = timeIncrement;
+      if(solverIteration - 1 <= loadStepGrowthIterations)
+        adaptiveTimeIncrement *= loadStepGrowthFactor;
+    }
+
+    // Write output for completed load step; if the load step was subdivided, output is written only at the scheduled time
+    if(timeCurrent == timeSteps[step]){
+      PeridigmNS::Timer::self().startTimer("Output");
+      synchDataManagers();
+      outputManager->write(blocks, timeCurrent);
+      PeridigmNS::Timer::self().stopTimer("Output");
+      probeManager->record(timeCurrent);
+      step++;
+    }
+    PeridigmNS::Timer::self().markStep();
+
+    // swap state N and state NP1
+    for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++)
+      blockIt->updateState();
+
+  } // end loop over load steps
+
+  if(peridigmComm->MyPID() == 0)
+    cout << endl;
+}
+
+void PeridigmNS::Peridigm::executeAdaptiveDynamicRelaxation(Teuchos::RCP<Teuchos::ParameterList> solverParams) {
+
+  // Adaptive dynamic relaxation (Underwood 1983, Kilic and Madenci 2010)
+  // The static solution is obtained as the steady state of a fictitious, damped dynamic system,
+  //   lambda * d^2u/dt^2 + c * lambda * du/dt = F(u),
+  // where lambda is a diagonal fictitious mass chosen so that a unit time step is stable
+  // and c is recomputed every iteration from the local (diagonal) stiffness estimate.
+  // No tangent matrix or linear solver is required.
+
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(analysisHasMultiphysics, "**** Error:  Adaptive Dynamic Relaxation does not support multiphysics analyses.\n");
+
+  Teuchos::RCP<Teuchos::ParameterList> adrParams = sublist(solverParams, "Adaptive Dynamic Relaxation", true);
+  int maxSolverIterations = adrParams->get("Maximum Solver Iterations", 100000);
+  double massSafetyFactor = adrParams->get("Mass Safety Factor", 5.0);
+  int printFrequency = adrParams->get("Iteration Print Frequency", 1000);
+  bool solverVerbose = solverParams->get("Verbose", false);
+
+  // Determine tolerance
+  double tolerance = adrParams->get("Relative Tolerance", 1.0e-6);
+  bool useAbsoluteTolerance = false;
+  if(adrParams->isParameter("Absolute Tolerance")){
+    useAbsoluteTolerance = true;
+    tolerance = adrParams->get<double>("Absolute Tolerance");
+  }
+
+  // The residual must live on an Epetra_Map with element size one, consistent with the
+  // map used by the tangent in the other quasi-static solvers (required by applyKinematicBC_InsertZeros())
+  int numMyElements = 3*oneDimensionalMap->NumMyElements();
+  vector<int> myGlobalElements(numMyElements);
+  int* oneDimensionalMapGlobalElements = oneDimensionalMap->MyGlobalElements();
+  for(int iElem=0 ; iElem<oneDimensionalMap->NumMyElements() ; ++iElem){
+    for(int dof=0 ; dof<3 ; ++dof)
+      myGlobalElements[3*iElem + dof] = 3*oneDimensionalMapGlobalElements[iElem] + dof;
+  }
+  Epetra_Map residualMap(3*oneDimensionalMap->NumGlobalElements(), numMyElements, &myGlobalElements[0], 0, *peridigmComm);
+  myGlobalElements.clear();
+
+  Teuchos::RCP<Epetra_Vector> residual = Teuchos::rcp(new Epetra_Vector(residualMap));
+  Teuchos::RCP<Epetra_Vector> reaction = Teuchos::rcp(new Epetra_Vector(force->Map()));
+
+  // Fictitious mass density, velocity, and force history for the relaxation iterations
+  Epetra_Vector massDensity(*oneDimensionalMap);
+  Epetra_Vector relaxationVelocity(residualMap);
+  Epetra_Vector relaxationForce(residualMap);
+  Epetra_Vector previousRelaxationForce(residualMap);
+
+  for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++)
+    ComputeDynamicRelaxationMassDensity(*blockIt, massSafetyFactor, massDensity);
+
+  double *xPtr, *uPtr, *yPtr, *vPtr, *deltaUPtr, *massDensityPtr, *residualPtr, *volumePtr;
+  double *relaxationVelocityPtr, *relaxationForcePtr, *previousRelaxationForcePtr;
+  x->ExtractView( &xPtr );
+  u->ExtractView( &uPtr );
+  deltaU->ExtractView( &deltaUPtr );
+  y->ExtractView( &yPtr );
+  v->ExtractView( &vPtr );
+  volume->ExtractView( &volumePtr );
+  massDensity.ExtractView( &massDensityPtr );
+  residual->ExtractView( &residualPtr );
+  relaxationVelocity.ExtractView( &relaxationVelocityPtr );
+  relaxationForce.ExtractView( &relaxationForcePtr );
+  previousRelaxationForce.ExtractView( &previousRelaxationForcePtr );
+  const int length = y->MyLength();
+
+  // Initialize velocity to zero
+  v->PutScalar(0.0);
+
+  // Create list of time steps
+
+  // Case 1:  User provided initial time, final time, and number of load steps
+  vector<double> timeSteps;
+  if( solverParams->isParameter("Final Time") && adrParams->isParameter("Number of Load Steps") ){
+    double timeInitial = solverParams->get("Initial Time", 0.0);
+    double timeFinal = solverParams->get<double>("Final Time");
+    int numLoadSteps = adrParams->get<int>("Number of Load Steps");
+    timeSteps.push_back(timeInitial);
+    for(int i=0 ; i<numLoadSteps ; ++i)
+      timeSteps.push_back(timeInitial + (i+1)*(timeFinal-timeInitial)/numLoadSteps);
+  }
+  // Case 2:  User provided a list of time steps
+  else if( adrParams->isParameter("Time Steps") ){
+    string timeStepString = adrParams->get<string>("Time Steps");
+    istringstream iss(timeStepString);
+    copy(istream_iterator<double>(iss),
+	 istream_iterator<double>(),
+	 back_inserter<vector<double> >(timeSteps));
+  }
+  else{
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(true, "\n****Error: No valid time step data provided.\n");
+  }
+
+  double timeCurrent = timeSteps[0];
+
+  // Write initial configuration to disk
+  PeridigmNS::Timer::self().startTimer("Output");
+  synchDataManagers();
+  outputManager->write(blocks, timeCurrent);
+  PeridigmNS::Timer::self().stopTimer("Output");
+  probeManager->record(timeCurrent);
+
+  Epetra_Time loadStepCPUTime(*peridigmComm);
+  double cumulativeLoadStepCPUTime = 0.0;
+
+  for(int step=1 ; step<(int)timeSteps.size() ; step++){
+
+    loadStepCPUTime.ResetStartTime();
+
+    double timePrevious = timeCurrent;
+    timeCurrent = timeSteps[step];
+    double timeIncrement = timeCurrent - timePrevious;
+    workset->timeStep = timeIncrement;
+
+    // Update nodal positions for nodes with kinematic B.C.
+    deltaU->PutScalar(0.0);
+
+    PeridigmNS::Timer::self().startTimer("Apply Kinematic B.C.");
+    boundaryAndInitialConditionManager->applyBoundaryConditions(timeCurrent,timePrevious);
+    PeridigmNS::Timer::self().stopTimer("Apply Kinematic B.C.");
+
+    // evaluate the external (body) forces:
+    PeridigmNS::Timer::self().startTimer("Apply Body Forces");
+    boundaryAndInitialConditionManager->applyForceContributions(timeCurrent,timePrevious);
+    PeridigmNS::Timer::self().stopTimer("Apply Body Forces");
+
+    // Set the current position and velocity
+    for(int i=0 ; i<length ; ++i){
+      yPtr[i] = xPtr[i] + uPtr[i] + deltaUPtr[i];
+      vPtr[i] = deltaUPtr[i]/timeIncrement;
+    }
+
+    // compute the residual
+    double residualNorm = computeQuasiStaticResidual(residual);
+
+    double toleranceMultiplier = 1.0;
+    if(!useAbsoluteTolerance){
+      // compute the vector of reactions, i.e., the forces corresponding to degrees of freedom for which kinematic B.C. are applied
+      boundaryAndInitialConditionManager->applyKinematicBC_ComputeReactions(force, reaction, numMultiphysDoFs);
+      // convert force density to force
+      for(int i=0 ; i<reaction->MyLength() ; ++i)
+        (*reaction)[i] *= volumePtr[i/3];
+      double reactionNorm2;
+      reaction->Norm2(&reactionNorm2);
+      toleranceMultiplier = reactionNorm2;
+    }
+
+    if(peridigmComm->MyPID() == 0)
+      cout << "Load step " << step << ", initial time = " << timePrevious << ", final time = " << timeCurrent <<
+        ", convergence criterion = " << tolerance*toleranceMultiplier << endl;
+
+    // The residual is the net force with the kinematic B.C. entries zeroed out;
+    // dividing by the volume recovers the force density acting on the free degrees of freedom
+    for(int i=0 ; i<length ; ++i)
+      relaxationForcePtr[i] = residualPtr[i]/volumePtr[i/3];
+    relaxationVelocity.PutScalar(0.0);
+
+    int solverIteration = 1;
+    double dampingCoefficient = 0.0;
+    while(residualNorm > tolerance*toleranceMultiplier && solverIteration <= maxSolverIterations){
+
+      // Track the total number of iterations taken over the simulation
+      *nonlinearSolverIterations += 1;
+
+      if(solverIteration == 1){
+        // Start-up step:  V^{1/2} = dt * F^0 / (2 lambda), with dt = 1
+        for(int i=0 ; i<length ; ++i){
+          double lambda = massDensityPtr[i/3];
+          relaxationVelocityPtr[i] = lambda > 0.0 ? 0.5*relaxationForcePtr[i]/lambda : 0.0;
+        }
+      }
+      else{
+        // Adaptive damping from the Rayleigh quotient of the local diagonal stiffness
+        //   c = 2 sqrt( (U^T K U) / (U^T U) ),  K_ii = -(F_i^n - F_i^{n-1}) / (lambda_ii dt V_i^{n-1/2})
+        double localSums[2] = {0.0, 0.0};
+        double globalSums[2] = {0.0, 0.0};
+        for(int i=0 ; i<length ; ++i){
+          double lambda = massDensityPtr[i/3];
+          double totalDisplacement = uPtr[i] + deltaUPtr[i];
+          if(relaxationVelocityPtr[i] != 0.0 && lambda > 0.0){
+            double localStiffness = -(relaxationForcePtr[i] - previousRelaxationForcePtr[i])/(lambda*relaxationVelocityPtr[i]);
+            localSums[0] += totalDisplacement*localStiffness*totalDisplacement;
+          }
+          localSums[1] += totalDisplacement*totalDisplacement;
+        }
+        peridigmComm->SumAll(localSums, globalSums, 2);
+        dampingCoefficient = 0.0;
+        if(globalSums[0] > 0.0 && globalSums[1] > 0.0)
+          dampingCoefficient = 2.0*sqrt(globalSums[0]/globalSums[1]);
+        // a unit time step with critical damping cannot exceed c = 2
+        if(dampingCoefficient > 2.0)
+          dampingCoefficient = 2.0;
+
+        // V^{n+1/2} = ((2 - c dt) V^{n-1/2} + 2 dt F^n / lambda) / (2 + c dt)
+        const double oldVelocityCoefficient = (2.0 - dampingCoefficient)/(2.0 + dampingCoefficient);
+        const double forceCoefficient = 2.0/(2.0 + dampingCoefficient);
+        for(int i=0 ; i<length ; ++i){
+          double lambda = massDensityPtr[i/3];
+          relaxationVelocityPtr[i] = oldVelocityCoefficient*relaxationVelocityPtr[i];
+          if(lambda > 0.0)
+            relaxationVelocityPtr[i] += forceCoefficient*relaxationForcePtr[i]/lambda;
+        }
+      }
+
+      // U^{n+1} = U^n + dt V^{n+1/2}
+      for(int i=0 ; i<length ; ++i){
+        deltaUPtr[i] += relaxationVelocityPtr[i];
+        yPtr[i] = xPtr[i] + uPtr[i] + deltaUPtr[i];
+        vPtr[i] = deltaUPtr[i]/timeIncrement;
+      }
+
+      previousRelaxationForce.Update(1.0, relaxationForce, 0.0);
+      residualNorm = computeQuasiStaticResidual(residual);
+      for(int i=0 ; i<length ; ++i)
+        relaxationForcePtr[i] = residualPtr[i]/volumePtr[i/3];
+
+      if(printFrequency > 0 && solverIteration%printFrequency == 0 && peridigmComm->MyPID() == 0){
+        if(!solverVerbose)
+          cout << "  iteration " << solverIteration << ": residual = " << residualNorm << endl;
+        else
+          cout << "  iteration " << solverIteration << ": residual = " << residualNorm << ", damping coefficient = " << dampingCoefficient << endl;
+      }
+
+      solverIteration++;
+    } // end loop of relaxation iterations
+
+    if(solverIteration > maxSolverIterations && peridigmComm->MyPID() == 0)
+      cout << "\nWarning:  Dynamic relaxation failed to converge in maximum allowable iterations." << endl;
+
+    // If the residual is within a reasonable tolerance, then just accept the solution and forge ahead.
+    // If not, abort the analysis.
+    if(residualNorm > tolerance*toleranceMultiplier){
+      if(residualNorm < 100.0*tolerance*toleranceMultiplier){
+	if(peridigmComm->MyPID() == 0)
+	  cout << "\nWarning:  Accepting current solution and progressing to next load step.\n" << endl;
+      }
+      else{
+	if(peridigmComm->MyPID() == 0)
+	  cout << "\nError:  Aborting analysis.\n" << endl;
+	break;
+      }
+    }
+
+    if(peridigmComm->MyPID() == 0)
+      cout << "  iteration " << solverIteration << ": residual = " << residualNorm << endl;
+
+    // Print load step timing information
+    double CPUTime = loadStepCPUTime.ElapsedTime();
+    cumulativeLoadStepCPUTime += CPUTime;
+    if(peridigmComm->MyPID() == 0)
+      cout << setprecision(2) << "  cpu time for load step = " << CPUTime << " sec., cumulative cpu time = " << cumulativeLoadStepCPUTime << " sec.\n" << endl;
+
+    // Add the converged displacement increment to the displacement
+    for(int i=0 ; i<u->MyLength() ; ++i)
+      uPtr[i] += deltaUPtr[i];
+
     // Write output for completed load step
     PeridigmNS::Timer::self().startTimer("Output");
     synchDataManagers();
     outputManager->write(blocks, timeCurrent);
     PeridigmNS::Timer::self().stopTimer("Output");
+    probeManager->record(timeCurrent);
+    PeridigmNS::Timer::self().markStep();
 
     // swap state N and state NP1
     for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++)
@@ -2787,47 +3197,132 @@ void PeridigmNS::Peridigm::executeQuasiStatic(Teuchos::RCP<Teuchos::ParameterLis
     cout << endl;
 }
 
+void PeridigmNS::Peridigm::setLinearSolverPreconditioner(Teuchos::RCP<Teuchos::ParameterList> params) {
+  linearSolverPreconditioner = params->get("Preconditioner", "None");
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(linearSolverPreconditioner != "None" && linearSolverPreconditioner != "Ifpack" &&
+                              linearSolverPreconditioner != "Multigrid" && linearSolverPreconditioner != "Block Jacobi",
+                              "**** Error:  Invalid Preconditioner \"" + linearSolverPreconditioner + "\", valid options are \"None\", \"Ifpack\", \"Multigrid\", and \"Block Jacobi\".\n");
+#ifndef PERIDIGM_ML
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(linearSolverPreconditioner == "Multigrid",
+                              "**** Error:  The Multigrid preconditioner requires Peridigm to be built against a Trilinos installation that includes ML.\n");
+#endif
+  // Parameters in the Multigrid sublist are passed directly to ML and override the defaults set in MultigridPreconditioner::compute()
+  multigridParameters = Teuchos::ParameterList();
+  if(params->isSublist("Multigrid"))
+    multigridParameters = params->sublist("Multigrid");
+  // If a positive lag ratio is given, the numeric refresh of the preconditioner is skipped until the number of
+  // Belos iterations grows beyond this multiple of the count measured right after the last refresh
+  preconditionerLagRatio = params->get("Preconditioner Lag Ratio", 0.0);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(preconditionerLagRatio != 0.0 && preconditionerLagRatio < 1.0,
+                              "**** Error:  Preconditioner Lag Ratio must be zero (no lagging) or greater than or equal to one.\n");
+  preconditioner = Teuchos::null;
+  belosPreconditioner = Teuchos::null;
+  preconditionerReferenceIterations = -1;
+  linearSolverIterations = 0;
+}
+
+void PeridigmNS::Peridigm::recordLinearSolverIterations(int numIterations) {
+  linearSolverIterations = numIterations;
+  if(!preconditioner.is_null() && preconditionerReferenceIterations < 0)
+    preconditionerReferenceIterations = numIterations;
+}
+
 void PeridigmNS::Peridigm::quasiStaticsSetPreconditioner(Belos::LinearProblem<double,Epetra_MultiVector,Epetra_Operator>& linearProblem) {
-  Ifpack IFPFactory;
-  Teuchos::ParameterList ifpackList;
 
-  if (linearProblem.isHermitian()) { // assume matrix Hermitian; construct IC preconditioner
-    Teuchos::RCP<Ifpack_Preconditioner> Prec = Teuchos::rcp( IFPFactory.Create("IC", &(*tangent), 0) );
-    Teuchos::ParameterList ifpackList;
-    TEUCHOS_TEST_FOR_EXCEPT_MSG(Prec->SetParameters(ifpackList), 
-  		      "**** PeridigmNS::Peridigm::executeQuasiStatic(), Prec->SetParameters() returned nonzero error code.\n");
-    TEUCHOS_TEST_FOR_EXCEPT_MSG(Prec->Initialize(), 
-		      "**** PeridigmNS::Peridigm::executeQuasiStatic(), Prec->Initialize() returned nonzero error code.\n");
-    TEUCHOS_TEST_FOR_EXCEPT_MSG(Prec->Compute(), 
-		      "**** PeridigmNS::Peridigm::executeQuasiStatic(), Prec->Compute() returned nonzero error code.\n");
-    // Create the Belos preconditioned operator from the Ifpack preconditioner.
-    // NOTE:  This is necessary because Belos expects an operator to apply the
-    //        preconditioner with Apply() NOT ApplyInverse().
-    Teuchos::RCP<Belos::EpetraPrecOp> belosPrec = Teuchos::rcp( new Belos::EpetraPrecOp( Prec ) );
-    linearProblem.setLeftPrec( belosPrec );
+  // The sparsity pattern of the tangent is fixed by allocateJacobian(), so a preconditioner built on a previous call
+  // is retained and only its numeric phase is refreshed.  If lagging is enabled, the refresh is skipped altogether
+  // while the preconditioner built from an earlier tangent remains effective.
+  if(!preconditioner.is_null()){
+    if(preconditionerLagRatio > 0.0 && preconditionerReferenceIterations >= 0 &&
+       linearSolverIterations <= preconditionerLagRatio*std::max(preconditionerReferenceIterations, 1)){
+      linearProblem.setLeftPrec( belosPreconditioner );
+      return;
+    }
+    PeridigmNS::Timer::self().startTimer("Refresh Preconditioner");
+    Teuchos::RCP<PeridigmNS::MultigridPreconditioner> multigridPrec = Teuchos::rcp_dynamic_cast<PeridigmNS::MultigridPreconditioner>(preconditioner);
+    if(!multigridPrec.is_null()){
+      // Recompute the multigrid hierarchy with the aggregates from the initial setup
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(multigridPrec->compute(),
+                                  "**** PeridigmNS::Peridigm::quasiStaticsSetPreconditioner(), multigrid preconditioner refresh returned nonzero error code.\n");
+    }
+    Teuchos::RCP<PeridigmNS::BlockJacobiPreconditioner> blockJacobiPrec = Teuchos::rcp_dynamic_cast<PeridigmNS::BlockJacobiPreconditioner>(preconditioner);
+    if(!blockJacobiPrec.is_null()){
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(blockJacobiPrec->compute(),
+                                  "**** PeridigmNS::Peridigm::quasiStaticsSetPreconditioner(), singular diagonal block in the block Jacobi preconditioner.\n");
+    }
+    Teuchos::RCP<Ifpack_Preconditioner> ifpackPrec = Teuchos::rcp_dynamic_cast<Ifpack_Preconditioner>(preconditioner);
+    if(!ifpackPrec.is_null()){
+      // An overlapping Schwarz preconditioner copies the off-processor rows of the tangent during Initialize(),
+      // so the symbolic phase must be repeated to pick up their new values
+      if(!linearProblem.isHermitian() && peridigmComm->NumProc() > 1)
+        TEUCHOS_TEST_FOR_EXCEPT_MSG(ifpackPrec->Initialize(),
+                                    "**** PeridigmNS::Peridigm::quasiStaticsSetPreconditioner(), Prec->Initialize() returned nonzero error code.\n");
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(ifpackPrec->Compute(),
+                                  "**** PeridigmNS::Peridigm::quasiStaticsSetPreconditioner(), Prec->Compute() returned nonzero error code.\n");
+    }
+    PeridigmNS::Timer::self().stopTimer("Refresh Preconditioner");
+    preconditionerReferenceIterations = -1;
+    linearProblem.setLeftPrec( belosPreconditioner );
+    return;
   }
-  else { // assume matrix non-Hermitian; construct ILU preconditioner
-    std::string PrecType = "ILU"; // incomplete LU
-    int OverlapLevel = 1; // must be >= 0. If Comm.NumProc() == 1, param is ignored.
-    Teuchos::RCP<Ifpack_Preconditioner> Prec = Teuchos::rcp( IFPFactory.Create(PrecType, &(*tangent), OverlapLevel) );
-    // specify parameters for ILU
-    ifpackList.set("fact: drop tolerance", 1e-9);
-    ifpackList.set("fact: ilut level-of-fill", 1);
-    // the combine mode is on the following: "Add", "Zero", "Insert", "InsertAdd", "Average", "AbsMax"
-    ifpackList.set("schwarz: combine mode", "Add");
+
+  PeridigmNS::Timer::self().startTimer("Create Preconditioner");
+
+  if (linearSolverPreconditioner == "Multigrid") {
+    // Smoothed-aggregation multigrid, with the degrees of freedom of each node treated as a block and
+    // the rigid-body modes of the model coordinates as the near-nullspace
+    Teuchos::RCP<PeridigmNS::MultigridPreconditioner> multigridPrec =
+      Teuchos::rcp( new PeridigmNS::MultigridPreconditioner(tangent, x, 3 + numMultiphysDoFs, multigridParameters) );
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(multigridPrec->compute(),
+                                "**** PeridigmNS::Peridigm::quasiStaticsSetPreconditioner(), multigrid preconditioner setup returned nonzero error code.\n");
+    preconditioner = multigridPrec;
+  }
+
+  if (linearSolverPreconditioner == "Block Jacobi") {
+    // Inverse of the (3+numMultiphysDoFs)x(3+numMultiphysDoFs) diagonal block of each point
+    Teuchos::RCP<PeridigmNS::BlockJacobiPreconditioner> blockJacobiPrec =
+      Teuchos::rcp( new PeridigmNS::BlockJacobiPreconditioner(tangent, 3 + numMultiphysDoFs) );
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(blockJacobiPrec->compute(),
+                                "**** PeridigmNS::Peridigm::quasiStaticsSetPreconditioner(), singular diagonal block in the block Jacobi preconditioner.\n");
+    preconditioner = blockJacobiPrec;
+  }
+
+  if (preconditioner.is_null()) {
+    Ifpack IFPFactory;
+    Teuchos::ParameterList ifpackList;
+    Teuchos::RCP<Ifpack_Preconditioner> Prec;
+
+    if (linearProblem.isHermitian()) { // assume matrix Hermitian; construct IC preconditioner
+      Prec = Teuchos::rcp( IFPFactory.Create("IC", &(*tangent), 0) );
+    }
+    else { // assume matrix non-Hermitian; construct ILU preconditioner
+      std::string PrecType = "ILU"; // incomplete LU
+      int OverlapLevel = 1; // must be >= 0. If Comm.NumProc() == 1, param is ignored.
+      Prec = Teuchos::rcp( IFPFactory.Create(PrecType, &(*tangent), OverlapLevel) );
+      // specify parameters for ILU
+      ifpackList.set("fact: drop tolerance", 1e-9);
+      ifpackList.set("fact: ilut level-of-fill", 1);
+      // the combine mode is on the following: "Add", "Zero", "Insert", "InsertAdd", "Average", "AbsMax"
+      ifpackList.set("schwarz: combine mode", "Add");
+    }
     // sets the parameters
     TEUCHOS_TEST_FOR_EXCEPT_MSG(Prec->SetParameters(ifpackList), 
-  		      "**** PeridigmNS::Peridigm::executeQuasiStatic(), Prec->SetParameters() returned nonzero error code.\n");
+                                "**** PeridigmNS::Peridigm::executeQuasiStatic(), Prec->SetParameters() returned nonzero error code.\n");
     TEUCHOS_TEST_FOR_EXCEPT_MSG(Prec->Initialize(), 
-		      "**** PeridigmNS::Peridigm::executeQuasiStatic(), Prec->Initialize() returned nonzero error code.\n");
+                                "**** PeridigmNS::Peridigm::executeQuasiStatic(), Prec->Initialize() returned nonzero error code.\n");
     TEUCHOS_TEST_FOR_EXCEPT_MSG(Prec->Compute(), 
-		      "**** PeridigmNS::Peridigm::executeQuasiStatic(), Prec->Compute() returned nonzero error code.\n");
-    // Create the Belos preconditioned operator from the Ifpack preconditioner.
-    // NOTE:  This is necessary because Belos expects an operator to apply the
-    //        preconditioner with Apply() NOT ApplyInverse().
-    Teuchos::RCP<Belos::EpetraPrecOp> belosPrec = Teuchos::rcp( new Belos::EpetraPrecOp( Prec ) );
-    linearProblem.setLeftPrec( belosPrec );
+                                "**** PeridigmNS::Peridigm::executeQuasiStatic(), Prec->Compute() returned nonzero error code.\n");
+    preconditioner = Prec;
   }
+
+  PeridigmNS::Timer::self().stopTimer("Create Preconditioner");
+
+  // Create the Belos preconditioned operator from the preconditioner.
+  // NOTE:  This is necessary because Belos expects an operator to apply the
+  //        preconditioner with Apply() NOT ApplyInverse().
+  belosPreconditioner = Teuchos::rcp( new Belos::EpetraPrecOp( preconditioner ) );
+  preconditionerReferenceIterations = -1;
+  linearProblem.setLeftPrec( belosPreconditioner );
 }
 
 void PeridigmNS::Peridigm::quasiStaticsDampTangent(double dampedNewtonDiagonalScaleFactor,
@@ -2864,6 +3359,7 @@ Belos::ReturnType PeridigmNS::Peridigm::quasiStaticsSolveSystem(Teuchos::RCP<Epe
   TEUCHOS_TEST_FOR_EXCEPT_MSG(!isSet, "**** Belos::LinearProblem::setProblem() returned nonzero error code.\n");
   try{
     isConverged = belosSolver->solve();
+    recordLinearSolverIterations(belosSolver->getNumIters());
   }
   catch(const std::exception &e){
     if(peridigmComm->MyPID() == 0)
@@ -3178,6 +3674,7 @@ void PeridigmNS::Peridigm::executeImplicit(Teuchos::RCP<Teuchos::ParameterList>
   double dt                      = implicitParams->get<double>("Fixed dt");
   double beta                    = implicitParams->get("Beta", 0.25);
   double gamma                   = implicitParams->get("Gamma", 0.50);
+  setLinearSolverPreconditioner(implicitParams);
   workset->timeStep = dt;
   double dt2 = dt*dt;
   int nsteps = (int)floor((timeFinal-timeInitial)/dt);
@@ -3232,6 +3729,7 @@ void PeridigmNS::Peridigm::executeImplicit(Teuchos::RCP<Teuchos::ParameterList>
   synchDataManagers();
   outputManager->write(blocks, timeCurrent);
   PeridigmNS::Timer::self().stopTimer("Output");
+  probeManager->record(timeCurrent);
 
   for(int step=0; step<nsteps ; step++){
 
@@ -3402,12 +3900,15 @@ void PeridigmNS::Peridigm::executeImplicit(Teuchos::RCP<Teuchos::ParameterList>
 	fluidPressureDeltaU->PutScalar(0.0);
       }
       linearProblem.setOperator(tangent);
+      if(linearSolverPreconditioner != "None")
+        quasiStaticsSetPreconditioner(linearProblem);
 
       bool isSet = linearProblem.setProblem(displacementIncrement, residual);
 
       TEUCHOS_TEST_FOR_EXCEPT_MSG(!isSet, "**** Peridigm::executeImplicit(), failed to set linear problem.\n");
       PeridigmNS::Timer::self().startTimer("Solve Linear System");
       Belos::ReturnType isConverged = belosSolver->solve();
+      recordLinearSolverIterations(belosSolver->getNumIters());
       if(isConverged != Belos::Converged && peridigmComm->MyPID() == 0)
         cout << "Warning:  Belos linear solver failed to converge!  Proceeding with nonconverged solution..." << endl;
       PeridigmNS::Timer::self().stopTimer("Solve Linear System");
@@ -3535,6 +4036,8 @@ void PeridigmNS::Peridigm::executeImplicit(Teuchos::RCP<Teuchos::ParameterList>
     synchDataManagers();
     outputManager->write(blocks, timeCurrent);
     PeridigmNS::Timer::self().stopTimer("Output");
+    probeManager->record(timeCurrent);
+    PeridigmNS::Timer::self().markStep();
 
     // swap state N and state NP1
     for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++)
@@ -3562,74 +4065,177 @@ void PeridigmNS::Peridigm::allocateJacobian(const int numDoFs) {
   tangentMap = Teuchos::rcp(new Epetra_Map(numGlobalElements, numMyElements, &myGlobalElements[0], indexBase, *peridigmComm));
   myGlobalElements.clear();
 
-  // Create the global tangent matrix
-  Epetra_DataAccess CV = Copy;
-  int numEntriesPerRow = 0;  // Indicates allocation will take place during the insertion phase
-  bool ignoreNonLocalEntries = false;
-  tangent = Teuchos::rcp(new Epetra_FECrsMatrix(CV, *tangentMap, numEntriesPerRow, ignoreNonLocalEntries));
+  // The graph of the tangent is constructed directly in compressed row form, first for the points (each point
+  // contributes a numDoFs by numDoFs block) and in local indices wherever possible.
+  // Entries exist for any two points that are bonded, and any two points that are bonded to a common third point.
+  // The row of a point therefore contains the neighborhood (including the point itself) of each locally-owned point
+  // whose neighborhood contains it.  For points whose material has a pairwise jacobian, the bonds of the point couple
+  // only their two endpoints, and the neighbors of the point are not coupled to each other.
+  int* neighborhoodList = globalNeighborhoodData->NeighborhoodList();
+  int numOwnedPoints = globalNeighborhoodData->NumOwnedPoints();
+  int numOverlapPoints = oneDimensionalOverlapMap->NumMyElements();
 
-  // Store nonzero columns for each row, with everything in global indices
-  map<int, boost::unordered_set<int> > rowEntries;
+  vector<char> pairwiseJacobian(numOwnedPoints, 0);
+  for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
+    if(blockIt->getMaterialModel().is_null() || !blockIt->getMaterialModel()->HasPairwiseJacobian())
+      continue;
+    const Epetra_BlockMap& blockOwnedMap = *blockIt->getOwnedScalarPointMap();
+    for(int i=0 ; i<blockOwnedMap.NumMyElements() ; ++i){
+      int LID = oneDimensionalOverlapMap->LID(blockOwnedMap.GID(i));
+      if(LID != -1 && LID < numOwnedPoints)
+        pairwiseJacobian[LID] = 1;
+    }
+  }
 
-  // Loop over the neighborhood for each locally-owned point and record non-zero entries in the matrix.
-  // Entries will exist for any two points that are bonded, and any two points that are bonded to a common third point.
-  int* neighborhoodList = globalNeighborhoodData->NeighborhoodList();
+  // Offset of each owned point's neighborhood in the neighborhood list, and the inverse of the neighborhoods, i.e.,
+  // for each point, the owned points whose neighborhood contains it
+  vector<int> neighborhoodOffsets(numOwnedPoints);
+  vector<int> inverseOffsets(numOverlapPoints + 1, 0);
   int neighborhoodListIndex = 0;
-  vector<int> globalIndices;
-  int numOwnedPoints = globalNeighborhoodData->NumOwnedPoints();
   for(int LID=0 ; LID<numOwnedPoints ; ++LID){
-    int GID = oneDimensionalOverlapMap->GID(LID);
+    neighborhoodOffsets[LID] = neighborhoodListIndex;
     int numNeighbors = neighborhoodList[neighborhoodListIndex++];
-
-    unsigned int numEntries = numDoFs*(numNeighbors+1);
-
-    if(globalIndices.size() < numEntries)
-      globalIndices.resize(numEntries);
-
-    for(int dof = 0; dof < numDoFs; dof++){
-        globalIndices[dof] = numDoFs * GID + dof;
+    inverseOffsets[LID + 1] += 1;
+    for(int j=0 ; j<numNeighbors ; ++j)
+      inverseOffsets[neighborhoodList[neighborhoodListIndex++] + 1] += 1;
+  }
+  for(int i=0 ; i<numOverlapPoints ; ++i)
+    inverseOffsets[i + 1] += inverseOffsets[i];
+  vector<int> inverseNeighborhoods(inverseOffsets[numOverlapPoints]);
+  {
+    vector<int> position(inverseOffsets.begin(), inverseOffsets.end() - 1);
+    for(int LID=0 ; LID<numOwnedPoints ; ++LID){
+      int index = neighborhoodOffsets[LID];
+      int numNeighbors = neighborhoodList[index++];
+      inverseNeighborhoods[position[LID]++] = LID;
+      for(int j=0 ; j<numNeighbors ; ++j)
+        inverseNeighborhoods[position[neighborhoodList[index++]]++] = LID;
     }
+  }
 
-    for(int j=0 ; j<numNeighbors ; ++j){
-      int neighborLocalID = neighborhoodList[neighborhoodListIndex++];
-      int neighborGlobalID = oneDimensionalOverlapMap->GID(neighborLocalID);
-
-      for(int dof = 0; dof < numDoFs; dof++){
-          globalIndices[numDoFs * j + numDoFs + dof] = numDoFs * neighborGlobalID + dof;
+  // Point graph for all overlap points, with each row sorted and free of duplicates
+  // The columns are sorted by global id so that the global indices of each row of the tangent are sorted as well
+  vector<int> pointGraphOffsets(numOverlapPoints + 1, 0);
+  vector<int> pointGraphColumns;
+  pointGraphColumns.reserve(inverseOffsets[numOverlapPoints]);
+  vector<int> rowColumns;
+  for(int i=0 ; i<numOverlapPoints ; ++i){
+    rowColumns.clear();
+    for(int k=inverseOffsets[i] ; k<inverseOffsets[i + 1] ; ++k){
+      int owner = inverseNeighborhoods[k];
+      rowColumns.push_back(oneDimensionalOverlapMap->GID(owner));
+      if(pairwiseJacobian[owner] && owner != i){
+        rowColumns.push_back(oneDimensionalOverlapMap->GID(i));
+        continue;
       }
+      int index = neighborhoodOffsets[owner];
+      int numNeighbors = neighborhoodList[index++];
+      for(int j=0 ; j<numNeighbors ; ++j)
+        rowColumns.push_back(oneDimensionalOverlapMap->GID(neighborhoodList[index++]));
     }
-
-    // The entries going into the tangent are a dense matrix of size numEntries by numEntries.
-    // Each global ID in the list interacts with all other global IDs in the list.
-    for(unsigned int i=0 ; i<numEntries ; ++i){
-      for(unsigned int j=0 ; j<numEntries ; ++j)
-	rowEntries[globalIndices[i]].insert(globalIndices[j]);
+    sort(rowColumns.begin(), rowColumns.end());
+    rowColumns.erase(unique(rowColumns.begin(), rowColumns.end()), rowColumns.end());
+    pointGraphColumns.insert(pointGraphColumns.end(), rowColumns.begin(), rowColumns.end());
+    pointGraphOffsets[i + 1] = static_cast<int>(pointGraphColumns.size());
+  }
+  neighborhoodOffsets.clear();
+  inverseOffsets.clear();
+  inverseNeighborhoods.clear();
+  pairwiseJacobian.clear();
+
+  // Rows of ghosted points are completed by the processors that own them
+  Teuchos::RCP<Epetra_CrsGraph> remotePointGraph;
+  if(peridigmComm->NumProc() > 1){
+    vector<int> ghostGlobalIds;
+    vector<int> ghostRowLengths;
+    for(int i=0 ; i<numOverlapPoints ; ++i){
+      int GID = oneDimensionalOverlapMap->GID(i);
+      if(!oneDimensionalMap->MyGID(GID)){
+        ghostGlobalIds.push_back(GID);
+        ghostRowLengths.push_back(pointGraphOffsets[i + 1] - pointGraphOffsets[i]);
+      }
+    }
+    int numGhostPoints = static_cast<int>(ghostGlobalIds.size());
+    Epetra_Map ghostMap(-1, numGhostPoints, numGhostPoints > 0 ? &ghostGlobalIds[0] : 0, 0, *peridigmComm);
+    Epetra_CrsGraph ghostPointGraph(Copy, ghostMap, numGhostPoints > 0 ? &ghostRowLengths[0] : 0, true);
+    for(int i=0 ; i<numOverlapPoints ; ++i){
+      int GID = oneDimensionalOverlapMap->GID(i);
+      if(!oneDimensionalMap->MyGID(GID)){
+        int err = ghostPointGraph.InsertGlobalIndices(GID, pointGraphOffsets[i + 1] - pointGraphOffsets[i], &pointGraphColumns[pointGraphOffsets[i]]);
+        TEUCHOS_TEST_FOR_EXCEPT_MSG(err < 0, "**** PeridigmNS::Peridigm::allocateJacobian(), InsertGlobalIndices() returned negative error code.\n");
+      }
     }
+    int err = ghostPointGraph.FillComplete(*oneDimensionalMap, *oneDimensionalMap);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(err != 0, "**** PeridigmNS::Peridigm::allocateJacobian(), FillComplete() returned nonzero error code.\n");
+    Epetra_Export ghostExporter(ghostMap, *oneDimensionalMap);
+    remotePointGraph = Teuchos::rcp(new Epetra_CrsGraph(Copy, *oneDimensionalMap, 0));
+    err = remotePointGraph->Export(ghostPointGraph, ghostExporter, Insert);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(err != 0, "**** PeridigmNS::Peridigm::allocateJacobian(), Export() returned nonzero error code.\n");
+    err = remotePointGraph->FillComplete(*oneDimensionalMap, *oneDimensionalMap);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(err != 0, "**** PeridigmNS::Peridigm::allocateJacobian(), FillComplete() returned nonzero error code.\n");
   }
 
-  // Allocate space in the global Epetra_FECrsMatrix
+  // Final point graph for the locally-owned points, in the order of oneDimensionalMap
+  int numMyPoints = oneDimensionalMap->NumMyElements();
+  vector<int> ownedGraphOffsets(numMyPoints + 1, 0);
+  vector<int> ownedGraphColumns;
+  ownedGraphColumns.reserve(pointGraphColumns.size());
+  vector<int> remoteColumns;
+  for(int iElem=0 ; iElem<numMyPoints ; ++iElem){
+    int GID = oneDimensionalMap->GID(iElem);
+    int overlapLID = oneDimensionalOverlapMap->LID(GID);
+    rowColumns.clear();
+    if(overlapLID != -1)
+      rowColumns.assign(pointGraphColumns.begin() + pointGraphOffsets[overlapLID], pointGraphColumns.begin() + pointGraphOffsets[overlapLID + 1]);
+    if(!remotePointGraph.is_null()){
+      int numRemoteColumns = remotePointGraph->NumGlobalIndices(GID);
+      if(numRemoteColumns > 0){
+        remoteColumns.resize(numRemoteColumns);
+        int err = remotePointGraph->ExtractGlobalRowCopy(GID, numRemoteColumns, numRemoteColumns, &remoteColumns[0]);
+        TEUCHOS_TEST_FOR_EXCEPT_MSG(err != 0, "**** PeridigmNS::Peridigm::allocateJacobian(), ExtractGlobalRowCopy() returned nonzero error code.\n");
+        rowColumns.insert(rowColumns.end(), remoteColumns.begin(), remoteColumns.end());
+        sort(rowColumns.begin(), rowColumns.end());
+        rowColumns.erase(unique(rowColumns.begin(), rowColumns.end()), rowColumns.end());
+      }
+    }
+    ownedGraphColumns.insert(ownedGraphColumns.end(), rowColumns.begin(), rowColumns.end());
+    ownedGraphOffsets[iElem + 1] = static_cast<int>(ownedGraphColumns.size());
+  }
+  pointGraphOffsets.clear();
+  pointGraphColumns.clear();
+  remotePointGraph = Teuchos::null;
+
+  // Expand the point graph into the graph of the tangent, with a static profile
+  vector<int> numIndicesPerRow(numMyElements);
+  for(int iElem=0 ; iElem<numMyPoints ; ++iElem)
+    for(int dof=0 ; dof<numDoFs ; ++dof)
+      numIndicesPerRow[numDoFs*iElem + dof] = numDoFs*(ownedGraphOffsets[iElem + 1] - ownedGraphOffsets[iElem]);
+  bool staticProfile = true;
+  Epetra_CrsGraph tangentGraph(Copy, *tangentMap, numMyElements > 0 ? &numIndicesPerRow[0] : 0, staticProfile);
+  numIndicesPerRow.clear();
   vector<int> indices;
-  vector<double> zeros;
-  for(map<int, boost::unordered_set<int> >::iterator rowEntry=rowEntries.begin(); rowEntry!=rowEntries.end() ; ++rowEntry){
-    unsigned int numRowNonzeros = rowEntry->second.size();
-    if(zeros.size() < numRowNonzeros)
-      zeros.resize(numRowNonzeros, 0.0);
-
-    // Load indices into a sorted vector
-    indices.resize(numRowNonzeros);
-    int i=0;
-    for(boost::unordered_set<int>::const_iterator globalIndex=rowEntry->second.begin() ; globalIndex!=rowEntry->second.end() ; ++globalIndex)
-      indices[i++] = *globalIndex;
-    sort(indices.begin(), indices.end());
-
-    // Allocate space in the global matrix
-    int err = tangent->InsertGlobalValues(rowEntry->first, numRowNonzeros, (const double*)&zeros[0], (const int*)&indices[0]);
-    TEUCHOS_TEST_FOR_EXCEPT_MSG(err < 0, "**** PeridigmNS::Peridigm::allocateJacobian(), InsertGlobalValues() returned negative error code.\n");
-
-    rowEntry->second.clear();
+  for(int iElem=0 ; iElem<numMyPoints ; ++iElem){
+    int numRowPoints = ownedGraphOffsets[iElem + 1] - ownedGraphOffsets[iElem];
+    indices.resize(numDoFs*numRowPoints);
+    for(int j=0 ; j<numRowPoints ; ++j)
+      for(int dof=0 ; dof<numDoFs ; ++dof)
+        indices[numDoFs*j + dof] = numDoFs*ownedGraphColumns[ownedGraphOffsets[iElem] + j] + dof;
+    for(int dof=0 ; dof<numDoFs ; ++dof){
+      int err = tangentGraph.InsertGlobalIndices(numDoFs*oneDimensionalMap->GID(iElem) + dof, static_cast<int>(indices.size()), indices.size() > 0 ? &indices[0] : 0);
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(err < 0, "**** PeridigmNS::Peridigm::allocateJacobian(), InsertGlobalIndices() returned negative error code.\n");
+    }
   }
-  int err = tangent->GlobalAssemble();
-  TEUCHOS_TEST_FOR_EXCEPT_MSG(err != 0, "**** PeridigmNS::Peridigm::allocateJacobian(), GlobalAssemble() returned nonzero error code.\n");
+  ownedGraphOffsets.clear();
+  ownedGraphColumns.clear();
+  int err = tangentGraph.FillComplete();
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(err != 0, "**** PeridigmNS::Peridigm::allocateJacobian(), FillComplete() returned nonzero error code.\n");
+  err = tangentGraph.OptimizeStorage();
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(err != 0, "**** PeridigmNS::Peridigm::allocateJacobian(), OptimizeStorage() returned nonzero error code.\n");
+
+  // Create the global tangent matrix from the graph; entries in rows owned by other processors are summed in GlobalAssemble()
+  Epetra_DataAccess CV = Copy;
+  bool ignoreNonLocalEntries = false;
+  tangent = Teuchos::rcp(new Epetra_FECrsMatrix(CV, tangentGraph, ignoreNonLocalEntries));
 
   // create the serial Jacobian
   overlapJacobian = Teuchos::rcp(new PeridigmNS::SerialMatrix(tangent));
@@ -3853,7 +4459,8 @@ void PeridigmNS::Peridigm::synchDataManagers() {
   // Copy data from mothership vectors to overlap vectors in blocks
   // Volume, Block_Id, and Model_Coordinates are synched at initialization and never change
 
-  PeridigmNS::Timer::self().startTimer("Gather/Scatter");
+  static const int gatherScatterTimerId = PeridigmNS::Timer::self().getTimerId("Gather/Scatter");
+  PeridigmNS::Timer::self().startTimer(gatherScatterTimerId);
 
 	if(analysisHasMultiphysics){
 		for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
@@ -3901,7 +4508,7 @@ void PeridigmNS::Peridigm::synchDataManagers() {
       blockIt->importData(*tempVector, hourglassForceDensityFieldId, PeridigmField::STEP_NP1, Insert);
   }
 
-  PeridigmNS::Timer::self().stopTimer("Gather/Scatter");
+  PeridigmNS::Timer::self().stopTimer(gatherScatterTimerId);
 }
 
 Teuchos::RCP< map< string, vector<int> > > PeridigmNS::Peridigm::getExodusNodeSets(){
@@ -74,6 +74,7 @@
 #include "Peridigm_DataManager.hpp"
 #include "Peridigm_SerialMatrix.hpp"
 #include "Peridigm_OutputManagerContainer.hpp"
+#include "Peridigm_ProbeManager.hpp"
 #include "Peridigm_ComputeManager.hpp"
 #include "Peridigm_BoundaryAndInitialConditionManager.hpp"
 #include "Peridigm_ContactManager.hpp"
@@ -124,6 +125,9 @@ namespace PeridigmNS {
     //! Initialize the output manager
     void initializeOutputManager();
 
+    //! Instantiate the time-history probe manager
+    void initializeProbeManager();
+
     //! Initialize blocks
     void initializeBlocks(Teuchos::RCP<Discretization> disc);
 
@@ -275,9 +279,18 @@ namespace PeridigmNS {
     //! Main routine to drive problem solution for quasistatics using NOX
     void executeNOXQuasiStatic(Teuchos::RCP<Teuchos::ParameterList> solverParams); 
 
-    //! Set the preconditioner for the global linear system
+    //! Main routine to drive problem solution for quasistatics using adaptive dynamic relaxation (no tangent matrix)
+    void executeAdaptiveDynamicRelaxation(Teuchos::RCP<Teuchos::ParameterList> solverParams);
+
+    //! Set the preconditioner for the global linear system, reusing the preconditioner from previous calls when possible
     void quasiStaticsSetPreconditioner(Belos::LinearProblem<double,Epetra_MultiVector,Epetra_Operator>& linearProblem);
 
+    //! Record the Belos iteration count of the most recent linear solve, used to decide when the preconditioner must be refreshed
+    void recordLinearSolverIterations(int numIterations);
+
+    //! Read the preconditioner type, multigrid parameters, and lag ratio for the quasi-static and implicit linear solvers
+    void setLinearSolverPreconditioner(Teuchos::RCP<Teuchos::ParameterList> params);
+
     //! Damp the tangent matrix by scaling the diagonal and adding a small value to each entry in the diagonal
     void quasiStaticsDampTangent(double dampedNewtonDiagonalScaleFactor,
                                  double dampedNewtonDiagonalShiftFactor);
@@ -380,6 +393,7 @@ namespace PeridigmNS {
     //! @name Friend classes
     //@{ 
     friend class OutputManager_ExodusII;
+    friend class ProbeManager;
     //@}
 
     //! Parameterlist of entire input deck
@@ -409,6 +423,9 @@ namespace PeridigmNS {
     //! Flag for computing element-sphere intersections
     bool computeIntersections;
 
+    //! Flag for computing analytic approximations of the partial volumes of bonded cells
+    bool computeAnalyticPartialVolumes;
+
     //! Flag for computing interface information
     bool constructInterfaces;
 
@@ -565,6 +582,27 @@ namespace PeridigmNS {
     //! Global tangent matrix
     Teuchos::RCP<Epetra_FECrsMatrix> tangent;
 
+    //! Preconditioner for the quasi-static and implicit linear solvers, either "None", "Ifpack", or "Multigrid"
+    std::string linearSolverPreconditioner;
+
+    //! User-specified ML parameters for the multigrid preconditioner
+    Teuchos::ParameterList multigridParameters;
+
+    //! Preconditioner retained across Newton iterations and load steps; the symbolic setup is performed once and only the numeric phase is refreshed
+    Teuchos::RCP<Epetra_Operator> preconditioner;
+
+    //! Belos wrapper for the retained preconditioner
+    Teuchos::RCP<Belos::EpetraPrecOp> belosPreconditioner;
+
+    //! If positive, the numeric refresh of the preconditioner is skipped while the Belos iteration count stays within this multiple of the count measured after the last refresh
+    double preconditionerLagRatio;
+
+    //! Number of Belos iterations for the first solve after the last numeric refresh of the preconditioner, or -1 if not yet measured
+    int preconditionerReferenceIterations;
+
+    //! Number of Belos iterations for the most recent linear solve
+    int linearSolverIterations;
+
     //! Block diagonal of global tangent matrix
     Teuchos::RCP<Epetra_FECrsMatrix> blockDiagonalTangent;
 
@@ -586,6 +624,9 @@ namespace PeridigmNS {
     //! The peridigm output manager
     Teuchos::RCP<PeridigmNS::OutputManagerContainer> outputManager;
 
+    //! The time-history probe manager
+    Teuchos::RCP<PeridigmNS::ProbeManager> probeManager;
+
     //! Vector of parameters for each solver (multiple solvers indicates, e.g., a simulation with both implicit and explicit time integration)
     std::vector< Teuchos::RCP<Teuchos::ParameterList> > solverParameters;
 
@@ -310,4 +310,7 @@ void PeridigmNS::BlockBase::initializeDataManager(vector<int> fieldIds)
 
   // Allocate data in the data manager
   dataManager->allocateData(fieldIds);
+
+  if(!neighborhoodData.is_null())
+    dataManager->setNeighborhoodVersion(neighborhoodData->Version());
 }
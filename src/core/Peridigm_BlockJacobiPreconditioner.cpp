@@ -0,0 +1,123 @@
+/*! \file Peridigm_BlockJacobiPreconditioner.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include "Peridigm_BlockJacobiPreconditioner.hpp"
+#include <Epetra_MultiVector.h>
+#include <Epetra_LAPACK.h>
+#include <Teuchos_Assert.hpp>
+
+using namespace std;
+
+PeridigmNS::BlockJacobiPreconditioner::BlockJacobiPreconditioner(Teuchos::RCP<const Epetra_CrsMatrix> tangent_, int blockSize_)
+  : tangent(tangent_), blockSize(blockSize_)
+{
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(!tangent->Filled(), "**** PeridigmNS::BlockJacobiPreconditioner::BlockJacobiPreconditioner(), tangent must be fill-complete.\n");
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(tangent->NumMyRows()%blockSize != 0,
+                              "**** PeridigmNS::BlockJacobiPreconditioner::BlockJacobiPreconditioner(), number of rows is not a multiple of the block size.\n");
+}
+
+int PeridigmNS::BlockJacobiPreconditioner::compute()
+{
+  const Epetra_Map& rowMap = tangent->RowMap();
+  const Epetra_Map& colMap = tangent->ColMap();
+  int numMyPoints = tangent->NumMyRows()/blockSize;
+  int blockEntrySize = blockSize*blockSize;
+  inverseBlocks.assign(numMyPoints*blockEntrySize, 0.0);
+
+  Epetra_LAPACK lapack;
+  vector<int> pivots(blockSize);
+  vector<double> work(blockSize);
+  int returnCode = 0;
+  for(int i=0 ; i<numMyPoints ; ++i){
+    double* block = &inverseBlocks[i*blockEntrySize];
+    int firstGlobalColumn = rowMap.GID(blockSize*i);
+    for(int row=0 ; row<blockSize ; ++row){
+      int numEntries;
+      double* values;
+      int* indices;
+      tangent->ExtractMyRowView(blockSize*i + row, numEntries, values, indices);
+      for(int k=0 ; k<numEntries ; ++k){
+        int col = colMap.GID(indices[k]) - firstGlobalColumn;
+        if(col >= 0 && col < blockSize)
+          block[col*blockSize + row] = values[k];
+      }
+    }
+    int info;
+    lapack.GETRF(blockSize, blockSize, block, blockSize, &pivots[0], &info);
+    if(info == 0)
+      lapack.GETRI(blockSize, block, blockSize, &pivots[0], &work[0], &blockSize, &info);
+    if(info != 0)
+      returnCode = 1;
+  }
+  return returnCode;
+}
+
+int PeridigmNS::BlockJacobiPreconditioner::ApplyInverse(const Epetra_MultiVector& X, Epetra_MultiVector& Y) const
+{
+  if(X.NumVectors() != Y.NumVectors())
+    return -1;
+
+  // X and Y may be the same vector, so each block of X is copied before it is overwritten
+  int numMyPoints = static_cast<int>(inverseBlocks.size())/(blockSize*blockSize);
+  vector<double> x(blockSize);
+  for(int v=0 ; v<X.NumVectors() ; ++v){
+    const double* xValues = X[v];
+    double* yValues = Y[v];
+    for(int i=0 ; i<numMyPoints ; ++i){
+      const double* block = &inverseBlocks[i*blockSize*blockSize];
+      for(int row=0 ; row<blockSize ; ++row)
+        x[row] = xValues[blockSize*i + row];
+      for(int row=0 ; row<blockSize ; ++row){
+        double sum = 0.0;
+        for(int col=0 ; col<blockSize ; ++col)
+          sum += block[col*blockSize + row]*x[col];
+        yValues[blockSize*i + row] = sum;
+      }
+    }
+  }
+  return 0;
+}
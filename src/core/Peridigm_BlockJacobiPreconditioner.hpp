@@ -0,0 +1,102 @@
+/*! \file Peridigm_BlockJacobiPreconditioner.hpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#ifndef PERIDIGM_BLOCKJACOBIPRECONDITIONER_HPP
+#define PERIDIGM_BLOCKJACOBIPRECONDITIONER_HPP
+
+#include <Teuchos_RCP.hpp>
+#include <Epetra_Operator.h>
+#include <Epetra_CrsMatrix.h>
+#include <vector>
+
+namespace PeridigmNS {
+
+/*! \brief Block Jacobi preconditioner for the global tangent, with one dense block for each point.
+ *
+ *  The diagonal block of each point (blockSize consecutive rows and columns of the scalar tangent) is inverted in
+ *  compute(), and ApplyInverse() applies the inverted blocks.  The preconditioner applies to vectors laid out as the
+ *  scalar tangent, whether the linear solver operates on the scalar tangent or on its block copy.
+ */
+class BlockJacobiPreconditioner : public Epetra_Operator {
+
+public:
+
+  //! Constructor; the scalar tangent must be fill-complete, with blockSize consecutive rows for each point.
+  BlockJacobiPreconditioner(Teuchos::RCP<const Epetra_CrsMatrix> tangent, int blockSize);
+
+  //! Destructor.
+  virtual ~BlockJacobiPreconditioner() {}
+
+  //! Extracts and inverts the diagonal blocks of the tangent; returns nonzero if a block is singular.
+  int compute();
+
+  //! @name Epetra_Operator interface
+  //@{
+  int SetUseTranspose(bool useTranspose) { return useTranspose ? -1 : 0; }
+  int Apply(const Epetra_MultiVector& X, Epetra_MultiVector& Y) const { return -1; }
+  int ApplyInverse(const Epetra_MultiVector& X, Epetra_MultiVector& Y) const;
+  double NormInf() const { return 0.0; }
+  const char* Label() const { return "PeridigmNS::BlockJacobiPreconditioner"; }
+  bool UseTranspose() const { return false; }
+  bool HasNormInf() const { return false; }
+  const Epetra_Comm& Comm() const { return tangent->Comm(); }
+  const Epetra_Map& OperatorDomainMap() const { return tangent->OperatorDomainMap(); }
+  const Epetra_Map& OperatorRangeMap() const { return tangent->OperatorRangeMap(); }
+  //@}
+
+protected:
+
+  Teuchos::RCP<const Epetra_CrsMatrix> tangent;
+  int blockSize;
+
+  //! Inverse of the diagonal block of each point, stored by column
+  std::vector<double> inverseBlocks;
+};
+
+}
+
+#endif // PERIDIGM_BLOCKJACOBIPRECONDITIONER_HPP
@@ -0,0 +1,110 @@
+/*! \file Peridigm_CompactBondVector.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include "Peridigm_CompactBondVector.hpp"
+#include <Teuchos_Assert.hpp>
+
+PeridigmNS::CompactBondVector::CompactBondVector(PeridigmField::Storage storage_, int length_)
+  : storage(storage_), length(length_)
+{
+  if(storage == PeridigmField::BIT_STORAGE)
+    bits.resize((length + bitsPerWord - 1)/bitsPerWord, 0u);
+  else if(storage == PeridigmField::FLOAT_STORAGE)
+    floatValues.resize(length, 0.0f);
+  else
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(true, "\n**** Error:  CompactBondVector, invalid storage type.\n");
+}
+
+void PeridigmNS::CompactBondVector::pack(const double* values)
+{
+  if(storage == PeridigmField::BIT_STORAGE){
+    int numWords = static_cast<int>(bits.size());
+    for(int iWord=0 ; iWord<numWords ; ++iWord){
+      unsigned int word = 0u;
+      int first = iWord*bitsPerWord;
+      int last = first + bitsPerWord < length ? first + bitsPerWord : length;
+      for(int i=first ; i<last ; ++i){
+        TEUCHOS_TEST_FOR_EXCEPT_MSG(values[i] != 0.0 && values[i] != 1.0,
+                                    "\n**** Error:  CompactBondVector::pack(), bit-packed storage requires bond values of zero or one.\n");
+        if(values[i] == 1.0)
+          word |= (1u << (i - first));
+      }
+      bits[iWord] = word;
+    }
+  }
+  else{
+    for(int i=0 ; i<length ; ++i)
+      floatValues[i] = static_cast<float>(values[i]);
+  }
+}
+
+void PeridigmNS::CompactBondVector::unpack(double* values) const
+{
+  if(storage == PeridigmField::BIT_STORAGE){
+    for(int i=0 ; i<length ; ++i)
+      values[i] = flag(i) ? 1.0 : 0.0;
+  }
+  else{
+    for(int i=0 ; i<length ; ++i)
+      values[i] = floatValues[i];
+  }
+}
+
+void PeridigmNS::CompactBondVector::setValue(int i, double value)
+{
+  if(storage == PeridigmField::BIT_STORAGE){
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(value != 0.0 && value != 1.0,
+                                "\n**** Error:  CompactBondVector::setValue(), bit-packed storage requires bond values of zero or one.\n");
+    if(value == 1.0)
+      bits[i/bitsPerWord] |= (1u << (i%bitsPerWord));
+    else
+      bits[i/bitsPerWord] &= ~(1u << (i%bitsPerWord));
+  }
+  else{
+    floatValues[i] = static_cast<float>(value);
+  }
+}
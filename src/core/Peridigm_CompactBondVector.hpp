@@ -0,0 +1,113 @@
+/*! \file Peridigm_CompactBondVector.hpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#ifndef PERIDIGM_COMPACTBONDVECTOR_HPP
+#define PERIDIGM_COMPACTBONDVECTOR_HPP
+
+#include "Peridigm_Field.hpp"
+#include <vector>
+#include <cstddef>
+
+namespace PeridigmNS {
+
+/*! \brief Compact storage for a scalar bond field.
+ *
+ *  Values are stored either as single-precision floats (FLOAT_STORAGE) or as bit-packed flags (BIT_STORAGE), in the
+ *  same layout as the bond data in a State.  Bit-packed storage is intended for binary data such as the bond damage
+ *  computed by the critical stretch damage model, and accepts only the values zero and one.
+ */
+class CompactBondVector {
+
+public:
+
+  //! Constructor; all values are initialized to zero.
+  CompactBondVector(PeridigmField::Storage storage, int length);
+
+  //! Stores the given values, which must be of the vector's length.
+  void pack(const double* values);
+
+  //! Copies the stored values into the given array, which must be of the vector's length.
+  void unpack(double* values) const;
+
+  //! Returns the value of the i-th bond.
+  double operator[](int i) const {
+    if(storage == PeridigmField::BIT_STORAGE)
+      return flag(i) ? 1.0 : 0.0;
+    return floatValues[i];
+  }
+
+  //! Sets the value of the i-th bond.
+  void setValue(int i, double value);
+
+  //! Typed accessor for bit-packed storage.
+  bool flag(int i) const { return (bits[i/bitsPerWord] >> (i%bitsPerWord)) & 1u; }
+
+  //! Typed accessor for single-precision storage.
+  const float* FloatValues() const { return floatValues.size() > 0 ? &floatValues[0] : 0; }
+
+  //! Storage type.
+  PeridigmField::Storage Storage() const { return storage; }
+
+  //! Number of bonds.
+  int Length() const { return length; }
+
+  //! Memory used for the stored values, in bytes.
+  std::size_t Bytes() const { return bits.size()*sizeof(unsigned int) + floatValues.size()*sizeof(float); }
+
+protected:
+
+  static const int bitsPerWord = 8*sizeof(unsigned int);
+
+  PeridigmField::Storage storage;
+  int length;
+  std::vector<unsigned int> bits;
+  std::vector<float> floatValues;
+};
+
+}
+
+#endif // PERIDIGM_COMPACTBONDVECTOR_HPP
@@ -55,7 +55,8 @@
 
 using namespace std;
 
-PeridigmNS::ComputeManager::ComputeManager( Teuchos::RCP<Teuchos::ParameterList> params, Teuchos::RCP<const Epetra_Comm> epetraComm, Teuchos::RCP<const Teuchos::ParameterList> computeClassGlobalParams ) {
+PeridigmNS::ComputeManager::ComputeManager( Teuchos::RCP<Teuchos::ParameterList> params, Teuchos::RCP<const Epetra_Comm> epetraComm, Teuchos::RCP<const Teuchos::ParameterList> computeClassGlobalParams )
+  : comm(epetraComm) {
 
   Teuchos::RCP<Compute> compute;
 
@@ -198,8 +199,63 @@ void PeridigmNS::ComputeManager::compute(Teuchos::RCP< vector<PeridigmNS::Block>
 
   // \todo Identify what the desired behavior is for compute classes and multiple blocks!
 
+  // The compute objects are evaluated in list order.  Consecutive compute objects that support batching append their
+  // processor-local contributions to a common buffer; the global reductions for the batch are then carried out with a
+  // single SumAll() and a single MaxAll(), and each compute object in the batch reads back its slice of the reduced values.
+  // Compute objects that perform no global communication are evaluated in place and do not complete the batch, so a
+  // typical output list is reduced with one SumAll() and one MaxAll() regardless of how its entries are interleaved.
+  // Such a compute object must therefore not read the global results of batched compute objects earlier in the list.
+  // A batch is completed before any other compute object that does not support batching is evaluated, so that compute
+  // object always sees the final results of the compute objects that precede it in the list.
+  // Within a batch, the processor-local phase of a compute object must not depend on the global results of another.
+
+  localSums.clear();
+  localMaxima.clear();
+  sumOffsets.resize(computeObjects.size());
+  maxOffsets.resize(computeObjects.size());
+
+  unsigned int batchBegin = 0;
   for(unsigned int i=0 ; i<computeObjects.size() ; ++i){
-     computeObjects[i]->compute(blocks);
+    if(computeObjects[i]->batchesGlobalReductions()){
+      sumOffsets[i] = localSums.size();
+      maxOffsets[i] = localMaxima.size();
+      computeObjects[i]->computeLocalContribution(blocks, localSums, localMaxima);
+    }
+    else if(!computeObjects[i]->performsGlobalCommunication()){
+      computeObjects[i]->compute(blocks);
+    }
+    else{
+      finalizeBatch(blocks, batchBegin, i);
+      computeObjects[i]->compute(blocks);
+      batchBegin = i+1;
+    }
+  }
+  finalizeBatch(blocks, batchBegin, computeObjects.size());
+}
+
+void PeridigmNS::ComputeManager::finalizeBatch(Teuchos::RCP< vector<PeridigmNS::Block> > blocks,
+                                               unsigned int batchBegin,
+                                               unsigned int batchEnd) {
+
+  if(batchBegin == batchEnd)
+    return;
+
+  // The size of the buffers is identical on all processors, so either every processor or no processor communicates
+  globalSums.resize(localSums.size());
+  globalMaxima.resize(localMaxima.size());
+  if(localSums.size() > 0)
+    comm->SumAll(&localSums[0], &globalSums[0], static_cast<int>(localSums.size()));
+  if(localMaxima.size() > 0)
+    comm->MaxAll(&localMaxima[0], &globalMaxima[0], static_cast<int>(localMaxima.size()));
+
+  for(unsigned int i=batchBegin ; i<batchEnd ; ++i){
+    if(!computeObjects[i]->batchesGlobalReductions())
+      continue;
+    const double* globalSumsPtr = sumOffsets[i] < globalSums.size() ? &globalSums[sumOffsets[i]] : NULL;
+    const double* globalMaximaPtr = maxOffsets[i] < globalMaxima.size() ? &globalMaxima[maxOffsets[i]] : NULL;
+    computeObjects[i]->finalizeGlobalContribution(blocks, globalSumsPtr, globalMaximaPtr);
   }
 
+  localSums.clear();
+  localMaxima.clear();
 }
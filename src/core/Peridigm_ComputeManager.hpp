@@ -93,9 +93,19 @@ namespace PeridigmNS {
 
     //! Return valid input parameterlist
     Teuchos::ParameterList getValidParameterList();
+
+    //! Carry out the global reductions for the batching compute objects in [batchBegin, batchEnd) and pass the results back to them
+    void finalizeBatch(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, unsigned int batchBegin, unsigned int batchEnd);
     
     //! Individual compute objects
     std::vector< Teuchos::RCP<PeridigmNS::Compute> > computeObjects;
+
+    //! Communicator used for the batched global reductions
+    Teuchos::RCP<const Epetra_Comm> comm;
+
+    //! Buffers for the batched global reductions, and the offset of each compute object into them
+    std::vector<double> localSums, localMaxima, globalSums, globalMaxima;
+    std::vector<size_t> sumOffsets, maxOffsets;
   };  
 }
  
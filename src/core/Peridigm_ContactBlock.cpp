@@ -109,4 +109,7 @@ void PeridigmNS::ContactBlock::rebalance(Teuchos::RCP<const Epetra_BlockMap> reb
                          ownedVectorPointMap,
                          overlapVectorPointMap,
                          ownedScalarBondMap);
+
+  // Invalidates neighborhood structures cached by the contact model
+  dataManager->setNeighborhoodVersion(neighborhoodData->Version());
 }
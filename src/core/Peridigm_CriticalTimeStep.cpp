@@ -126,3 +126,63 @@ double PeridigmNS::ComputeCriticalTimeStep(const Epetra_Comm& comm, PeridigmNS::
 
   return globalMinCriticalTimeStep;
 }
+
+void PeridigmNS::ComputeDynamicRelaxationMassDensity(PeridigmNS::Block& block, double safetyFactor, Epetra_Vector& massDensity){
+
+  // Diagonal fictitious mass for dynamic relaxation (Underwood, Kilic and Madenci):
+  //   lambda_ii >= 0.25 * dt^2 * sum_j |K_ij|,  with dt = 1
+  // The stiffness is estimated with the same bond-based spring constant used by ComputeCriticalTimeStep().
+
+  Teuchos::RCP<PeridigmNS::NeighborhoodData> neighborhoodData = block.getNeighborhoodData();
+  const int numOwnedPoints = neighborhoodData->NumOwnedPoints();
+  const int* ownedIDs = neighborhoodData->OwnedIDs();
+  const int* neighborhoodList = neighborhoodData->NeighborhoodList();
+  Teuchos::RCP<const PeridigmNS::Material> materialModel = block.getMaterialModel();
+  const Epetra_BlockMap& overlapMap = *block.getOverlapScalarPointMap();
+
+  double bulkModulus = materialModel()->BulkModulus();
+
+  double horizon(0.0);
+  string blockName = block.getName();
+  PeridigmNS::HorizonManager& horizonManager = PeridigmNS::HorizonManager::self();
+  bool blockHasConstantHorizon = horizonManager.blockHasConstantHorizon(blockName);
+  if(blockHasConstantHorizon)
+    horizon = horizonManager.getBlockConstantHorizonValue(blockName);
+
+  double *cellVolume, *x;
+  PeridigmNS::FieldManager& fieldManager = PeridigmNS::FieldManager::self();
+  block.getData(fieldManager.getFieldId("Volume"), PeridigmField::STEP_NONE)->ExtractView(&cellVolume);
+  block.getData(fieldManager.getFieldId("Model_Coordinates"), PeridigmField::STEP_NONE)->ExtractView(&x);
+
+  const double pi = boost::math::constants::pi<double>();
+  double springConstant(0.0);
+  if(blockHasConstantHorizon)
+    springConstant = 18.0*bulkModulus/(pi*horizon*horizon*horizon*horizon);
+
+  int neighborhoodListIndex = 0;
+  for(int iID=0 ; iID<numOwnedPoints ; ++iID){
+
+    double stiffness = 0.0;
+    int nodeID = ownedIDs[iID];
+    double X[3] = { x[nodeID*3], x[nodeID*3+1], x[nodeID*3+2] };
+    int numNeighbors = neighborhoodList[neighborhoodListIndex++];
+
+    if(!blockHasConstantHorizon){
+      double delta = horizonManager.evaluateHorizon(blockName, X[0], X[1], X[2]);
+      springConstant = 18.0*bulkModulus/(pi*delta*delta*delta*delta);
+    }
+
+    for(int iNID=0 ; iNID<numNeighbors ; ++iNID){
+      int neighborID = neighborhoodList[neighborhoodListIndex++];
+      double initialDistance = sqrt( (X[0] - x[neighborID*3  ])*(X[0] - x[neighborID*3  ]) +
+                                     (X[1] - x[neighborID*3+1])*(X[1] - x[neighborID*3+1]) +
+                                     (X[2] - x[neighborID*3+2])*(X[2] - x[neighborID*3+2]) );
+      if(initialDistance > 1.0e-50)
+        stiffness += cellVolume[neighborID]*springConstant/initialDistance;
+    }
+
+    int lid = massDensity.Map().LID(overlapMap.GID(nodeID));
+    if(lid != -1)
+      massDensity[lid] = safetyFactor*0.25*stiffness;
+  }
+}
@@ -50,11 +50,15 @@
 
 #include "Peridigm_Block.hpp"
 #include <Epetra_Comm.h>
+#include <Epetra_Vector.h>
 
 namespace PeridigmNS {
 
 double ComputeCriticalTimeStep(const Epetra_Comm& comm, PeridigmNS::Block& block);
 
+//! Compute the fictitious mass density used by dynamic relaxation, based on the stable time step estimate with unit time step.
+void ComputeDynamicRelaxationMassDensity(PeridigmNS::Block& block, double safetyFactor, Epetra_Vector& massDensity);
+
 }
 
 #endif // PERIDIGM_CRITICALTIMESTEP_HPP
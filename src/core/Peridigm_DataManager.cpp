@@ -64,6 +64,27 @@ std::vector< Teuchos::RCP<Epetra_Vector> > PeridigmNS::DataManager::vectorGlobal
 std::vector< Teuchos::RCP<Epetra_Vector> > PeridigmNS::DataManager::vectorGlobalDataStateNP1;
 std::vector< Teuchos::RCP<Epetra_Vector> > PeridigmNS::DataManager::vectorGlobalDataStateNONE;
 
+//! Copies locally-owned compact bond data based on global IDs, following State::copyLocallyOwnedMultiVectorData().
+static void copyLocallyOwnedCompactBondData(const PeridigmNS::CompactBondVector& source,
+                                            const Epetra_BlockMap& sourceMap,
+                                            PeridigmNS::CompactBondVector& target,
+                                            const Epetra_BlockMap& targetMap)
+{
+  for(int targetLID=0 ; targetLID<targetMap.NumMyElements() ; ++targetLID){
+    int GID = targetMap.GID(targetLID);
+    int sourceLID = sourceMap.LID(GID);
+    TEUCHOS_TEST_FOR_EXCEPTION(sourceLID == -1, std::range_error,
+                               "PeridigmNS::DataManager::copyLocallyOwnedDataFromDataManager() called with incompatible compact bond data.\n");
+    TEUCHOS_TEST_FOR_EXCEPTION(sourceMap.ElementSize(sourceLID) != targetMap.ElementSize(targetLID), std::range_error,
+                               "PeridigmNS::DataManager::copyLocallyOwnedDataFromDataManager() called with incompatible compact bond data.\n");
+    int elementSize = targetMap.ElementSize(targetLID);
+    int sourceFirstPointInElement = sourceMap.FirstPointInElement(sourceLID);
+    int targetFirstPointInElement = targetMap.FirstPointInElement(targetLID);
+    for(int i=0 ; i<elementSize ; ++i)
+      target.setValue(targetFirstPointInElement+i, source[sourceFirstPointInElement+i]);
+  }
+}
+
 void PeridigmNS::DataManager::allocateData(vector<int> fieldIds)
 {
   // remove duplicates
@@ -120,8 +141,12 @@ void PeridigmNS::DataManager::allocateData(vector<int> fieldIds)
       if(temporal == PeridigmField::CONSTANT)
         statelessBondFieldIds.push_back(fieldId);
 
-      else if(temporal == PeridigmField::TWO_STEP)
-        statefulBondFieldIds.push_back(fieldId);
+      else if(temporal == PeridigmField::TWO_STEP){
+        if(fieldManager.getBondStorage(fieldId) == PeridigmField::DOUBLE_STORAGE)
+          statefulBondFieldIds.push_back(fieldId);
+        else
+          compactBondFieldIds.push_back(fieldId);
+      }
 
       else
         TEUCHOS_TEST_FOR_EXCEPTION(true, Teuchos::RangeError, 
@@ -159,7 +184,7 @@ void PeridigmNS::DataManager::allocateData(vector<int> fieldIds)
     numMyElements = overlapScalarPointMap->NumMyElements();
     myGlobalElements = overlapScalarPointMap->MyGlobalElements();
   }
-  if(statelessBondFieldIds.size() + statefulBondFieldIds.size() > 0){
+  if(statelessBondFieldIds.size() + statefulBondFieldIds.size() + compactBondFieldIds.size() > 0){
     TEUCHOS_TEST_FOR_EXCEPTION(ownedBondMap.is_null(), Teuchos::NullReferenceError, 
                                "Error in PeridigmNS::DataManager::allocateData(), attempting to allocate bond data with no map (forget setMaps()?).");
   }
@@ -271,6 +296,16 @@ void PeridigmNS::DataManager::allocateData(vector<int> fieldIds)
       stateNP1->allocateBondData(statefulBondFieldIds, ownedBondMap);
     }
   }
+  if(compactBondFieldIds.size() > 0){
+    stateCompactNP1 = Teuchos::rcp(new State);
+    stateCompactNP1->allocateBondData(compactBondFieldIds, ownedBondMap);
+    fieldIdToCompactBondIndex.resize(compactBondFieldIds.back()+1, -1);
+    compactBondDataN.clear();
+    for(unsigned int i=0 ; i<compactBondFieldIds.size() ; ++i){
+      fieldIdToCompactBondIndex[compactBondFieldIds[i]] = i;
+      compactBondDataN.push_back( Teuchos::rcp(new CompactBondVector(fieldManager.getBondStorage(compactBondFieldIds[i]), ownedBondMap->NumMyPoints())) );
+    }
+  }
 }
 
 void PeridigmNS::DataManager::scatterToGhosts()
@@ -456,6 +491,20 @@ void PeridigmNS::DataManager::rebalance(Teuchos::RCP<const Epetra_BlockMap> reba
     }
   }
 
+  // Rebalance the bond data with compact storage, the state N values are imported in double precision
+  if(compactBondFieldIds.size() > 0){
+    Epetra_Import importer(*rebalancedOwnedBondMap, *ownedBondMap);
+    Teuchos::RCP<State> rebalancedStateCompactNP1 = Teuchos::rcp(new State);
+    rebalancedStateCompactNP1->allocateBondData(compactBondFieldIds, rebalancedOwnedBondMap);
+    rebalancedStateCompactNP1->getBondMultiVector()->Import(*stateCompactNP1->getBondMultiVector(), importer, Insert);
+    Teuchos::RCP<State> compactN = unpackCompactBondData();
+    Teuchos::RCP<State> rebalancedCompactN = Teuchos::rcp(new State);
+    rebalancedCompactN->allocateBondData(compactBondFieldIds, rebalancedOwnedBondMap);
+    rebalancedCompactN->getBondMultiVector()->Import(*compactN->getBondMultiVector(), importer, Insert);
+    stateCompactNP1 = rebalancedStateCompactNP1;
+    packCompactBondData(rebalancedCompactN);
+  }
+
   // Store the rebalanced maps
   ownedScalarPointMap = rebalancedOwnedScalarPointMap;
   overlapScalarPointMap = rebalancedOverlapScalarPointMap;
@@ -508,6 +557,14 @@ void PeridigmNS::DataManager::copyLocallyOwnedDataFromDataManager(PeridigmNS::Da
   else{
     TEUCHOS_TEST_FOR_EXCEPTION(!source.getStateNP1().is_null(), Teuchos::NullReferenceError, "PeridigmNS::State::copyLocallyOwnedDataFromDataManager() called with incompatible source and target.\n");
   }
+
+  // Bond data with compact storage is copied without conversion to double precision
+  TEUCHOS_TEST_FOR_EXCEPTION(source.compactBondFieldIds != compactBondFieldIds, Teuchos::RangeError, "PeridigmNS::DataManager::copyLocallyOwnedDataFromDataManager() called with incompatible source and target.\n");
+  if(!stateCompactNP1.is_null()){
+    stateCompactNP1->copyLocallyOwnedDataFromState(source.stateCompactNP1);
+    for(unsigned int i=0 ; i<compactBondDataN.size() ; ++i)
+      copyLocallyOwnedCompactBondData(*source.compactBondDataN[i], *source.ownedBondMap, *compactBondDataN[i], *ownedBondMap);
+  }
 }
 
 bool PeridigmNS::DataManager::hasData(int fieldId, PeridigmField::Step step)
@@ -519,10 +576,11 @@ bool PeridigmNS::DataManager::hasData(int fieldId, PeridigmField::Step step)
     hasData = stateNONE->hasData(fieldId);
   }
   else if(step == PeridigmField::STEP_N){
+    // Bond data with compact storage at step N is not available as an Epetra_Vector
     hasData = stateN->hasData(fieldId);
   }
   else if(step == PeridigmField::STEP_NP1){
-    hasData = stateNP1->hasData(fieldId);
+    hasData = isCompactBondField(fieldId) || stateNP1->hasData(fieldId);
   }
   else{
     TEUCHOS_TEST_FOR_EXCEPTION(false, Teuchos::RangeError, 
@@ -550,10 +608,16 @@ Teuchos::RCP<Epetra_Vector> PeridigmNS::DataManager::getData(int fieldId, Peridi
       data = stateNONE->getData(fieldId);
     }
     else if(step == PeridigmField::STEP_N){
+      TEUCHOS_TEST_FOR_EXCEPTION(isCompactBondField(fieldId), Teuchos::RangeError,
+                                 "**** Error, PeridigmNS::DataManager::getData(), the STEP_N values of " + fieldManager.getFieldSpec(fieldId).getLabel() +
+                                 " have compact storage, use getCompactData() or copyStepNToStepNP1().\n");
       data = stateN->getData(fieldId);
     }
     else if(step == PeridigmField::STEP_NP1){
-      data = stateNP1->getData(fieldId);
+      if(isCompactBondField(fieldId))
+        data = stateCompactNP1->getData(fieldId);
+      else
+        data = stateNP1->getData(fieldId);
     }
     else{
       TEUCHOS_TEST_FOR_EXCEPTION(false, Teuchos::RangeError, 
@@ -571,3 +635,76 @@ Teuchos::RCP<Epetra_Vector> PeridigmNS::DataManager::getData(int fieldId, Peridi
 
   return data;
 }
+
+Teuchos::RCP<const PeridigmNS::CompactBondVector> PeridigmNS::DataManager::getCompactData(int fieldId)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(!isCompactBondField(fieldId), Teuchos::RangeError,
+                             "**** Error, PeridigmNS::DataManager::getCompactData(), " + fieldManager.getFieldSpec(fieldId).getLabel() + " does not have compact storage.\n");
+  return compactBondDataN[fieldIdToCompactBondIndex[fieldId]];
+}
+
+void PeridigmNS::DataManager::copyStepNToStepNP1(int fieldId)
+{
+  if(isCompactBondField(fieldId))
+    compactBondDataN[fieldIdToCompactBondIndex[fieldId]]->unpack( stateCompactNP1->getData(fieldId)->Values() );
+  else
+    *(getData(fieldId, PeridigmField::STEP_NP1)) = *(getData(fieldId, PeridigmField::STEP_N));
+}
+
+Teuchos::RCP<PeridigmNS::State> PeridigmNS::DataManager::unpackCompactBondData() const
+{
+  Teuchos::RCP<State> state = Teuchos::rcp(new State);
+  state->allocateBondData(compactBondFieldIds, ownedBondMap);
+  for(unsigned int i=0 ; i<compactBondFieldIds.size() ; ++i)
+    compactBondDataN[i]->unpack( state->getData(compactBondFieldIds[i])->Values() );
+  return state;
+}
+
+void PeridigmNS::DataManager::packCompactBondData(Teuchos::RCP<State> state)
+{
+  for(unsigned int i=0 ; i<compactBondFieldIds.size() ; ++i){
+    Teuchos::RCP<Epetra_Vector> data = state->getData(compactBondFieldIds[i]);
+    if(compactBondDataN[i]->Length() != data->MyLength())
+      compactBondDataN[i] = Teuchos::rcp(new CompactBondVector(compactBondDataN[i]->Storage(), data->MyLength()));
+    compactBondDataN[i]->pack( data->Values() );
+  }
+}
+
+Teuchos::RCP<PeridigmNS::SoAVectorData> PeridigmNS::DataManager::getSoAData(int fieldId, PeridigmField::Step step, bool copyValues)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(fieldManager.getFieldSpec(fieldId).getLength() != PeridigmField::VECTOR, Teuchos::RangeError,
+                             "**** Error, PeridigmNS::DataManager::getSoAData(), structure-of-arrays data is supported only for VECTOR fields.\n");
+
+  Teuchos::RCP<SoAVectorData>& data = soaData[ pair<int, PeridigmField::Step>(fieldId, step) ];
+  if(data.is_null())
+    data = Teuchos::rcp(new SoAVectorData);
+
+  Teuchos::RCP<Epetra_Vector> vector = getData(fieldId, step);
+  if(!copyValues){
+    if(step == PeridigmField::STEP_NONE)
+      soaDataRebalanceCount.erase(fieldId);
+    data->resize(vector->MyLength()/3);
+    return data;
+  }
+
+  if(step == PeridigmField::STEP_NONE){
+    std::map<int, int>::iterator it = soaDataRebalanceCount.find(fieldId);
+    if(it != soaDataRebalanceCount.end() && it->second == rebalanceCount)
+      return data;
+    soaDataRebalanceCount[fieldId] = rebalanceCount;
+  }
+
+  data->gather(vector->Values(), vector->MyLength()/3);
+  return data;
+}
+
+void PeridigmNS::DataManager::scatterSoAData(int fieldId, PeridigmField::Step step)
+{
+  std::map< std::pair<int, PeridigmField::Step>, Teuchos::RCP<SoAVectorData> >::iterator it = soaData.find( pair<int, PeridigmField::Step>(fieldId, step) );
+  TEUCHOS_TEST_FOR_EXCEPTION(it == soaData.end(), Teuchos::RangeError,
+                             "**** Error, PeridigmNS::DataManager::scatterSoAData(), called without a prior call to getSoAData().\n");
+  Teuchos::RCP<Epetra_Vector> vector = getData(fieldId, step);
+  TEUCHOS_TEST_FOR_EXCEPTION(it->second->Length() != vector->MyLength()/3, Teuchos::RangeError,
+                             "**** Error, PeridigmNS::DataManager::scatterSoAData(), structure-of-arrays data is out of date (rebalance?).\n");
+  it->second->scatter(vector->Values());
+}
@@ -49,6 +49,8 @@
 #define PERIDIGM_DATAMANAGER_HPP
 
 #include "Peridigm_State.hpp"
+#include "Peridigm_CompactBondVector.hpp"
+#include "Peridigm_SoAVectorData.hpp"
 
 namespace PeridigmNS {
 
@@ -62,16 +64,21 @@ namespace PeridigmNS {
  * to off-processor points that are within the neighborhood of one or more owned points.
  * Data is accessed via the getData function, which provides access to the Epetra_Vector corresponding to
  * the given field id and step (STATE_NONE, STATE_N, or STATE_NP1).
+ *
+ * Two-step bond fields may be assigned a compact PeridigmField::Storage type through the FieldManager.  For these
+ * fields, the STATE_NP1 values are stored as an Epetra_Vector and the STATE_N values are stored in a CompactBondVector,
+ * which is accessed through getCompactData().  The STATE_N values are converted to and from double precision on the fly
+ * for rebalance, copy, and restart operations.
  */
 class DataManager {
 
 public:
   
   //! Constructor.
-  DataManager() : fieldManager(FieldManager::self()), rebalanceCount(0) {}
+  DataManager() : fieldManager(FieldManager::self()), rebalanceCount(0), neighborhoodVersion(0) {}
 
   //! Copy constructor.
-  DataManager(const DataManager& dataManager) : fieldManager(FieldManager::self()) {}
+  DataManager(const DataManager& dataManager) : fieldManager(FieldManager::self()), neighborhoodVersion(0) {}
 
   //! Destructor.
   ~DataManager(){}
@@ -115,6 +122,12 @@ public:
   //! Returns the number of times rebalance has been called.
   int getRebalanceCount(){ return rebalanceCount; }
 
+  //! Records the version of the neighborhood list the data is laid out for, see NeighborhoodData::Version().
+  void setNeighborhoodVersion(int version){ neighborhoodVersion = version; }
+
+  //! Returns the version of the neighborhood list, or zero if it is unknown.  Structures cached per neighborhood list must be rebuilt when it changes or is zero.
+  int getNeighborhoodVersion() const { return neighborhoodVersion; }
+
   //! Returns RCP to Epetra_Comm object
   Teuchos::RCP<const Epetra_Comm> getEpetraComm();
 
@@ -152,6 +165,30 @@ public:
   //! Provides access to the Epetra_Vector specified by the given field Id and step.
   Teuchos::RCP<Epetra_Vector> getData(int fieldId, PeridigmField::Step step);
 
+  //! Query whether the STEP_N values of a two-step bond field are stored in a CompactBondVector.
+  bool isCompactBondField(int fieldId) const {
+    return fieldId < static_cast<int>(fieldIdToCompactBondIndex.size()) && fieldIdToCompactBondIndex[fieldId] != -1;
+  }
+
+  //! Provides read access to the STEP_N values of a two-step bond field with compact storage.
+  Teuchos::RCP<const CompactBondVector> getCompactData(int fieldId);
+
+  //! Sets the STEP_NP1 values of a two-step field to the STEP_N values, for both compact and double storage.
+  void copyStepNToStepNP1(int fieldId);
+
+  /*! \brief Provides a structure-of-arrays copy of the VECTOR point data specified by the given field Id and step.
+   *
+   * The copy covers the owned and ghosted points and persists for the lifetime of the DataManager.  It is refreshed
+   * from the Epetra_Vector on each call, except for STEP_NONE data, which is copied on the first call and after each
+   * rebalance, and except when copyValues is false, in which case the copy is only resized and its values are
+   * unspecified (use this for output arrays that are zeroed and then written back in full).  Changes to the copy are
+   * written back to the Epetra_Vector by scatterSoAData().
+   */
+  Teuchos::RCP<SoAVectorData> getSoAData(int fieldId, PeridigmField::Step step, bool copyValues = true);
+
+  //! Copies the structure-of-arrays data obtained through getSoAData() back into the corresponding Epetra_Vector.
+  void scatterSoAData(int fieldId, PeridigmField::Step step);
+
   //! Returns the complete list of field ids.
   std::vector<int> getFieldIds() { return allFieldIds; }
 
@@ -172,16 +209,32 @@ public:
 
     // Swap pointers for all other state data
     stateN.swap(stateNP1);
+
+    // Bond data with compact storage is not swapped, the STEP_NP1 values are packed into the STEP_N storage
+    for(unsigned int i=0 ; i<compactBondFieldIds.size() ; ++i)
+      compactBondDataN[i]->pack( stateCompactNP1->getData(compactBondFieldIds[i])->Values() );
   }
   void writeBlocktoDisk(std::string blockName,char const * path){
       // StateNone is unaffected by restart so only StateN and StateNP1 are written
 	  getStateN()->writeStateData(getStateN(),"StateN",blockName,path);
 	  getStateNP1()->writeStateData(getStateNP1(),"StateNP1",blockName,path);
+      // Bond data with compact storage is written in double precision
+      if(!stateCompactNP1.is_null()){
+        stateCompactNP1->writeStateData(stateCompactNP1,"StateCompactNP1",blockName,path);
+        Teuchos::RCP<State> compactN = unpackCompactBondData();
+        compactN->writeStateData(compactN,"StateCompactN",blockName,path);
+      }
   }
   void readBlockfromDisk(std::string blockName,char const * path){
       // StateNone is unaffected by restart so only StateN and StateNP1 are red
 	  getStateN()->readStateData(getStateN(),"StateN",blockName,path);
 	  getStateNP1()->readStateData(getStateNP1(),"StateNP1",blockName,path);
+      if(!stateCompactNP1.is_null()){
+        stateCompactNP1->readStateData(stateCompactNP1,"StateCompactNP1",blockName,path);
+        Teuchos::RCP<State> compactN = unpackCompactBondData();
+        compactN->readStateData(compactN,"StateCompactN",blockName,path);
+        packCompactBondData(compactN);
+      }
   }
 
 protected:
@@ -192,6 +245,9 @@ protected:
   //! Number of times rebalance has been called.
   int rebalanceCount;
 
+  //! Version of the neighborhood list the data is laid out for, or zero if unknown.
+  int neighborhoodVersion;
+
   //! @name Field ids
   //@{
   //! Complete list of field ids.
@@ -206,6 +262,10 @@ protected:
   std::map< PeridigmField::Length, std::vector<int> > statefulPointFieldIds;
   //! Field specs for stateful bond data.
   std::vector<int> statefulBondFieldIds;
+  //! Field specs for stateful bond data with compact storage at step N.
+  std::vector<int> compactBondFieldIds;
+  //! Index into compactBondFieldIds for each field id, or -1 if the field does not have compact storage.
+  std::vector<int> fieldIdToCompactBondIndex;
   //@}
 
   //! @name Maps
@@ -252,7 +312,25 @@ protected:
   Teuchos::RCP<State> stateNP1;
   //! Data storage for state NONE (stateless data).
   Teuchos::RCP<State> stateNONE;
+  //! Data storage for state N plus 1 for bond data with compact storage.
+  Teuchos::RCP<State> stateCompactNP1;
+  //! Compact storage for state N for bond data with compact storage, one entry for each field in compactBondFieldIds.
+  std::vector< Teuchos::RCP<CompactBondVector> > compactBondDataN;
   //@}
+
+  //! @name Structure-of-arrays data
+  //@{
+  //! Structure-of-arrays copies of vector point data, keyed by field id and step.
+  std::map< std::pair<int, PeridigmField::Step>, Teuchos::RCP<SoAVectorData> > soaData;
+  //! Value of rebalanceCount when the STEP_NONE data in soaData was copied.
+  std::map< int, int > soaDataRebalanceCount;
+  //@}
+
+  //! Returns a temporary State containing the state N values of the bond data with compact storage in double precision.
+  Teuchos::RCP<State> unpackCompactBondData() const;
+
+  //! Sets the state N values of the bond data with compact storage from a State created by unpackCompactBondData().
+  void packCompactBondData(Teuchos::RCP<State> state);
 };
 
 }
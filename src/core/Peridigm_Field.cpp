@@ -137,6 +137,7 @@ int PeridigmNS::FieldManager::getFieldId(PeridigmField::Relation relation_,
     specIsGlobal.push_back(true);
   else
     specIsGlobal.push_back(false);
+  bondStorage.push_back(PeridigmField::DOUBLE_STORAGE);
 
   return id;
 }
@@ -170,6 +171,17 @@ PeridigmNS::FieldSpec PeridigmNS::FieldManager::getFieldSpec(string label)
   return getFieldSpec( getFieldId(label) );
 }
 
+void PeridigmNS::FieldManager::setBondStorage(int fieldId, PeridigmField::Storage storage)
+{
+  FieldSpec spec = getFieldSpec(fieldId);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(spec.getRelation() != PeridigmField::BOND || spec.getTemporal() != PeridigmField::TWO_STEP,
+                              "\n**** Error:  setBondStorage(), compact storage is supported only for two-step bond data.\n");
+
+  // If different storage types are requested for the same field (e.g., by different blocks), use the more precise one
+  if(bondStorage[fieldId] == PeridigmField::DOUBLE_STORAGE || storage < bondStorage[fieldId])
+    bondStorage[fieldId] = storage;
+}
+
 std::ostream& operator<<(std::ostream& os, const PeridigmNS::PeridigmField::Relation& relation){
   if(relation == PeridigmNS::PeridigmField::UNDEFINED_RELATION)
     os << "UNDEFINED_RELATION";
@@ -100,6 +100,15 @@ namespace PeridigmField {
     STEP_NP1
   };
 
+  // Storage type for the STEP_N values of two-step bond data.
+  // DOUBLE_STORAGE keeps the values in the State objects; the
+  // compact types are managed by the DataManager.
+  enum Storage {
+    DOUBLE_STORAGE=0,
+    FLOAT_STORAGE,
+    BIT_STORAGE
+  };
+
   //! Return the integer value of the field length for a given PeridigmField::Length.
   int variableDimension(Length length);
 
@@ -169,6 +178,12 @@ public:
 
   bool isGlobalSpec(int fieldId) { return specIsGlobal[fieldId]; }
 
+  //! Sets the storage type for the STEP_N values of a two-step bond field; must be called before data is allocated.
+  void setBondStorage(int fieldId, PeridigmField::Storage storage);
+
+  //! Returns the storage type for the STEP_N values of a two-step bond field.
+  PeridigmField::Storage getBondStorage(int fieldId) { return bondStorage[fieldId]; }
+
   std::vector<std::string> getFieldLabels() {
     std::vector<std::string> labels;
     for(std::vector<FieldSpec>::const_iterator it = fieldSpecs.begin() ; it != fieldSpecs.end() ; it++)
@@ -223,6 +238,8 @@ private:
   std::map<std::string, int> labelToIdMap;
 
   std::vector<bool> specIsGlobal;
+
+  std::vector<PeridigmField::Storage> bondStorage;
 };
 
 }
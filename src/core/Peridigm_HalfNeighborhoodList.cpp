@@ -0,0 +1,129 @@
+/*! \file Peridigm_HalfNeighborhoodList.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include "Peridigm_HalfNeighborhoodList.hpp"
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+void PeridigmNS::HalfNeighborhoodList::update(int numOwned,
+                                              const int* ownedIDs,
+                                              const int* fullNeighborhoodList,
+                                              int fullNeighborhoodVersion)
+{
+  if(fullNeighborhoodVersion != 0 && neighborhoodVersion == fullNeighborhoodVersion && numOwnedPoints == numOwned)
+    return;
+
+  // Offsets into the full list, and the local id of each owned point
+  vector<int> listOffsets(numOwned);
+  vector<int> bondOffsets(numOwned + 1);
+  vector<int> localIds(numOwned);
+  int listIndex(0), numBonds(0), maxLocalId(-1);
+  for(int i=0 ; i<numOwned ; ++i){
+    listOffsets[i] = listIndex;
+    bondOffsets[i] = numBonds;
+    localIds[i] = (ownedIDs != 0) ? ownedIDs[i] : i;
+    maxLocalId = max(maxLocalId, localIds[i]);
+    int numNeighbors = fullNeighborhoodList[listIndex];
+    for(int n=0 ; n<numNeighbors ; ++n)
+      maxLocalId = max(maxLocalId, fullNeighborhoodList[listIndex+1+n]);
+    listIndex += numNeighbors + 1;
+    numBonds += numNeighbors;
+  }
+  bondOffsets[numOwned] = numBonds;
+
+  // Map from local id to owned point, -1 for ghosted points
+  vector<int> ownedIndex(maxLocalId + 1, -1);
+  for(int i=0 ; i<numOwned ; ++i)
+    ownedIndex[localIds[i]] = i;
+
+  // Sorted copy of each neighborhood, used to locate reverse bonds
+  vector< pair<int,int> > sortedNeighbors(numBonds);
+  for(int i=0 ; i<numOwned ; ++i){
+    int numNeighbors = fullNeighborhoodList[listOffsets[i]];
+    for(int n=0 ; n<numNeighbors ; ++n)
+      sortedNeighbors[bondOffsets[i]+n] = make_pair(fullNeighborhoodList[listOffsets[i]+1+n], bondOffsets[i]+n);
+    sort(sortedNeighbors.begin() + bondOffsets[i], sortedNeighbors.begin() + bondOffsets[i+1]);
+  }
+
+  neighborhoodList.clear();
+  bondIndices.clear();
+  reverseBondIndices.clear();
+  neighborhoodList.reserve(numOwned + numBonds/2 + 1);
+  bondIndices.reserve(numBonds/2 + 1);
+  reverseBondIndices.reserve(numBonds/2 + 1);
+
+  for(int i=0 ; i<numOwned ; ++i){
+    int numNeighborsIndex = static_cast<int>(neighborhoodList.size());
+    neighborhoodList.push_back(0);
+    int numNeighbors = fullNeighborhoodList[listOffsets[i]];
+    for(int n=0 ; n<numNeighbors ; ++n){
+      int neighborId = fullNeighborhoodList[listOffsets[i]+1+n];
+      int bondIndex = bondOffsets[i] + n;
+      int reverseBondIndex = -1;
+      int j = ownedIndex[neighborId];
+      if(j != -1){
+        vector< pair<int,int> >::const_iterator begin = sortedNeighbors.begin() + bondOffsets[j];
+        vector< pair<int,int> >::const_iterator end = sortedNeighbors.begin() + bondOffsets[j+1];
+        vector< pair<int,int> >::const_iterator it = lower_bound(begin, end, make_pair(localIds[i], -1));
+        if(it != end && it->first == localIds[i])
+          reverseBondIndex = it->second;
+      }
+      // The pair is evaluated with the first of the two owned points
+      if(reverseBondIndex != -1 && j < i)
+        continue;
+      neighborhoodList.push_back(neighborId);
+      bondIndices.push_back(bondIndex);
+      reverseBondIndices.push_back(reverseBondIndex);
+      neighborhoodList[numNeighborsIndex] += 1;
+    }
+  }
+
+  numOwnedPoints = numOwned;
+  neighborhoodVersion = fullNeighborhoodVersion;
+}
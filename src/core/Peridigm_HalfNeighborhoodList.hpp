@@ -0,0 +1,109 @@
+/*! \file Peridigm_HalfNeighborhoodList.hpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#ifndef PERIDIGM_HALFNEIGHBORHOODLIST_HPP
+#define PERIDIGM_HALFNEIGHBORHOODLIST_HPP
+
+#include <vector>
+
+namespace PeridigmNS {
+
+/*! \brief Half neighbor list in which each pair of owned points that are neighbors of each other appears only once.
+ *
+ *  The half list is derived from a full neighborhood list (numNeighbors followed by the neighbor ids for each
+ *  owned point) and is intended for pairwise kernels that apply equal and opposite forces to both points of a pair.
+ *  A pair of owned points i and j that appear in each other's neighborhoods is stored only with the owned point that
+ *  comes first.  Bonds to ghosted points, for which the reverse bond is evaluated by another block or processor, and
+ *  bonds with no reverse bond in the full list are retained as-is.
+ *
+ *  For each retained bond, the half list records the index of the bond in the full list and, for pairs that are
+ *  stored only once, the index of the reverse bond in the full list.  Kernels may use these indices to access bond
+ *  data (e.g., bond damage) that is stored in the layout of the full list.
+ */
+class HalfNeighborhoodList {
+
+public:
+
+  HalfNeighborhoodList() : numOwnedPoints(-1), neighborhoodVersion(0) {}
+
+  /*! \brief Rebuilds the half list if the full neighborhood list has changed.
+   *
+   *  The full list is identified by its version, see NeighborhoodData::Version(); a version of zero is unknown and
+   *  always forces a rebuild.  If ownedIDs is null, the local id of the i-th owned point is i.
+   */
+  void update(int numOwnedPoints,
+              const int* ownedIDs,
+              const int* neighborhoodList,
+              int neighborhoodVersion);
+
+  //! Half neighborhood list, in the same format as the full neighborhood list.
+  const int* NeighborhoodList() const { return neighborhoodList.size() > 0 ? &neighborhoodList[0] : 0; }
+
+  //! Index of each bond of the half list in the full list, laid out as the half list less the number of neighbors for each point.
+  const int* BondIndices() const { return bondIndices.size() > 0 ? &bondIndices[0] : 0; }
+
+  //! Index of the reverse bond in the full list, or -1 if the reverse bond is evaluated separately; same layout as BondIndices().
+  const int* ReverseBondIndices() const { return reverseBondIndices.size() > 0 ? &reverseBondIndices[0] : 0; }
+
+  //! Number of bonds in the half list.
+  int NumBonds() const { return static_cast<int>(bondIndices.size()); }
+
+protected:
+
+  int numOwnedPoints;
+
+  //! Version of the full neighborhood list from which the half list was built.
+  int neighborhoodVersion;
+
+  std::vector<int> neighborhoodList;
+  std::vector<int> bondIndices;
+  std::vector<int> reverseBondIndices;
+};
+
+}
+
+#endif // PERIDIGM_HALFNEIGHBORHOODLIST_HPP
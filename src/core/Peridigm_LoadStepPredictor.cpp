@@ -0,0 +1,113 @@
+/*! \file Peridigm_LoadStepPredictor.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include "Peridigm_LoadStepPredictor.hpp"
+#include <Teuchos_Assert.hpp>
+
+PeridigmNS::LoadStepPredictor::LoadStepPredictor(Order order_)
+  : order(order_), numRecordedSteps(0), timeIncrement(0.0), previousTimeIncrement(0.0)
+{}
+
+PeridigmNS::LoadStepPredictor::Order PeridigmNS::LoadStepPredictor::orderFromString(const std::string& orderString)
+{
+  if(orderString == "None")
+    return NONE;
+  else if(orderString == "Linear")
+    return LINEAR;
+  else if(orderString == "Quadratic")
+    return QUADRATIC;
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(true, "**** Error:  Invalid Load Step Predictor \"" + orderString + "\", valid options are \"None\", \"Linear\", and \"Quadratic\".\n");
+  return NONE;
+}
+
+void PeridigmNS::LoadStepPredictor::recordConvergedStep(const Epetra_Vector& v, double dt)
+{
+  if(order == NONE)
+    return;
+
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(dt <= 0.0, "**** PeridigmNS::LoadStepPredictor::recordConvergedStep(), time increment must be positive.\n");
+
+  int length = v.MyLength();
+  if(numRecordedSteps > 0 && static_cast<int>(velocity.size()) != length)
+    numRecordedSteps = 0;
+
+  if(order == QUADRATIC && numRecordedSteps > 0){
+    velocity.swap(previousVelocity);
+    previousTimeIncrement = timeIncrement;
+  }
+  velocity.resize(length);
+  for(int i=0 ; i<length ; ++i)
+    velocity[i] = v[i];
+  timeIncrement = dt;
+
+  if(numRecordedSteps < static_cast<int>(order))
+    numRecordedSteps += 1;
+}
+
+bool PeridigmNS::LoadStepPredictor::predict(Epetra_Vector& increment, double dt) const
+{
+  if(numRecordedSteps == 0)
+    return false;
+
+  int length = increment.MyLength();
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(length != static_cast<int>(velocity.size()),
+                              "**** PeridigmNS::LoadStepPredictor::predict(), increment vector is incompatible with the recorded velocities.\n");
+
+  if(order == QUADRATIC && numRecordedSteps > 1){
+    // Newton form of the quadratic through the last three converged displacements, evaluated at the end of the load step:
+    //   increment = dt*v1 + dt*(dt + dt1)*(v1 - v2)/(dt1 + dt2)
+    double c = dt*(dt + timeIncrement)/(timeIncrement + previousTimeIncrement);
+    for(int i=0 ; i<length ; ++i)
+      increment[i] = dt*velocity[i] + c*(velocity[i] - previousVelocity[i]);
+  }
+  else{
+    for(int i=0 ; i<length ; ++i)
+      increment[i] = dt*velocity[i];
+  }
+
+  return true;
+}
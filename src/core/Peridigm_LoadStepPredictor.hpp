@@ -0,0 +1,112 @@
+/*! \file Peridigm_LoadStepPredictor.hpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#ifndef PERIDIGM_LOADSTEPPREDICTOR_HPP
+#define PERIDIGM_LOADSTEPPREDICTOR_HPP
+
+#include <Epetra_Vector.h>
+#include <vector>
+#include <string>
+
+namespace PeridigmNS {
+
+/*! \brief Predictor for the initial displacement increment of a quasi-static load step.
+ *
+ *  The increment is extrapolated in time from the velocities (converged displacement increments divided by the
+ *  corresponding time increments) of the last one or two load steps, which accounts for load steps of different sizes.
+ *  Linear extrapolation assumes a constant velocity; quadratic extrapolation fits the displacement at the last three
+ *  converged states.  Entries for degrees of freedom with kinematic boundary conditions are not treated specially;
+ *  callers are expected to re-impose the boundary values on the predicted increment.
+ */
+class LoadStepPredictor {
+
+public:
+
+  //! Order of the extrapolation.
+  enum Order {
+    NONE = 0,
+    LINEAR = 1,
+    QUADRATIC = 2
+  };
+
+  LoadStepPredictor(Order order = LINEAR);
+
+  //! Converts the input deck value "None", "Linear", or "Quadratic" to an order.
+  static Order orderFromString(const std::string& orderString);
+
+  //! Discards the recorded load steps.
+  void reset() { numRecordedSteps = 0; }
+
+  //! Records the velocity of a converged load step of the given size.
+  void recordConvergedStep(const Epetra_Vector& velocity, double timeIncrement);
+
+  //! Computes the predicted displacement increment for a load step of the given size; returns false, and leaves the increment untouched, if no prediction is available.
+  bool predict(Epetra_Vector& increment, double timeIncrement) const;
+
+  //! Order of the extrapolation.
+  Order getOrder() const { return order; }
+
+  //! Number of converged load steps available for extrapolation (at most two).
+  int NumRecordedSteps() const { return numRecordedSteps; }
+
+protected:
+
+  Order order;
+  int numRecordedSteps;
+
+  //! Velocity and time increment of the most recent converged load step.
+  std::vector<double> velocity;
+  double timeIncrement;
+
+  //! Velocity and time increment of the converged load step prior to the most recent one.
+  std::vector<double> previousVelocity;
+  double previousTimeIncrement;
+};
+
+}
+
+#endif // PERIDIGM_LOADSTEPPREDICTOR_HPP
@@ -62,6 +62,9 @@
 #include "Peridigm_Version.hpp"
 #include "Peridigm_Factory.hpp"
 #include "Peridigm_Timer.hpp"
+#ifdef PERIDIGM_KOKKOS
+  #include "elastic_kokkos.h"
+#endif
 
 using namespace std;
 
@@ -151,6 +154,10 @@ int main(int argc, char *argv[]) {
   PeridigmNS::Timer::self().stopTimer("Total");
   PeridigmNS::Timer::self().printTimingData(cout);
 
+#ifdef PERIDIGM_KOKKOS
+  MATERIAL_EVALUATION::finalizeKokkos();
+#endif
+
 #ifdef HAVE_MPI
   MPI_Finalize() ;
 #endif
@@ -46,15 +46,29 @@
 //@HEADER
 
 #include "Peridigm_ModelEvaluator.hpp"
+#include "Peridigm_Timer.hpp"
 
 using namespace std;
 
 PeridigmNS::ModelEvaluator::ModelEvaluator(){
+  damageTimerId = PeridigmNS::Timer::self().getTimerId("Damage");
+  materialTimerId = PeridigmNS::Timer::self().getTimerId("Material");
+  contactTimerId = PeridigmNS::Timer::self().getTimerId("Contact");
 }
 
 PeridigmNS::ModelEvaluator::~ModelEvaluator(){
 }
 
+int
+PeridigmNS::ModelEvaluator::getBlockTimerId(int blockIndex, const std::string& blockName) const
+{
+  if(blockIndex >= static_cast<int>(blockTimerIds.size()))
+    blockTimerIds.resize(blockIndex+1, -1);
+  if(blockTimerIds[blockIndex] == -1)
+    blockTimerIds[blockIndex] = PeridigmNS::Timer::self().getTimerId("Block " + blockName);
+  return blockTimerIds[blockIndex];
+}
+
 void 
 PeridigmNS::ModelEvaluator::evalModel(Teuchos::RCP<Workset> workset) const
 {
@@ -72,11 +86,16 @@ PeridigmNS::ModelEvaluator::evalModel(Teuchos::RCP<Workset> workset) const
       const int* ownedIDs = neighborhoodData->OwnedIDs();
       const int* neighborhoodList = neighborhoodData->NeighborhoodList();
       Teuchos::RCP<PeridigmNS::DataManager> dataManager = blockIt->getDataManager();
+      const int blockTimerId = getBlockTimerId(blockIt - workset->blocks->begin(), blockIt->getName());
+      PeridigmNS::Timer::self().startTimer(blockTimerId);
+      PeridigmNS::Timer::self().startTimer(damageTimerId);
       damageModel->computeDamage(dt, 
                                  numOwnedPoints,
                                  ownedIDs,
                                  neighborhoodList,
                                  *dataManager);
+      PeridigmNS::Timer::self().stopTimer(damageTimerId);
+      PeridigmNS::Timer::self().stopTimer(blockTimerId);
     }
   }
 
@@ -91,16 +110,24 @@ PeridigmNS::ModelEvaluator::evalModel(Teuchos::RCP<Workset> workset) const
     Teuchos::RCP<PeridigmNS::DataManager> dataManager = blockIt->getDataManager();
     Teuchos::RCP<const PeridigmNS::Material> materialModel = blockIt->getMaterialModel();
 
+    const int blockTimerId = getBlockTimerId(blockIt - workset->blocks->begin(), blockIt->getName());
+    PeridigmNS::Timer::self().startTimer(blockTimerId);
+    PeridigmNS::Timer::self().startTimer(materialTimerId);
     materialModel->computeForce(dt, 
                                 numOwnedPoints,
                                 ownedIDs,
                                 neighborhoodList,
                                 *dataManager);
+    PeridigmNS::Timer::self().stopTimer(materialTimerId);
+    PeridigmNS::Timer::self().stopTimer(blockTimerId);
   }
 
   // ---- Evaluate Contact ----
-  if(!workset->contactManager.is_null())
+  if(!workset->contactManager.is_null()){
+    PeridigmNS::Timer::self().startTimer(contactTimerId);
     workset->contactManager->evaluateContactForce(dt);
+    PeridigmNS::Timer::self().stopTimer(contactTimerId);
+  }
 }
 
 void 
@@ -130,4 +157,7 @@ PeridigmNS::ModelEvaluator::evalJacobian(Teuchos::RCP<Workset> workset) const
                                    jacobian,
                                    jacobianType);
   }
+
+  // Pass the contributions to rows owned by other processors to the global tangent
+  jacobian.sumIntoNonlocalRows();
 }
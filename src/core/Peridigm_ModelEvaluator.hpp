@@ -81,6 +81,17 @@ namespace PeridigmNS {
     void evalJacobian(Teuchos::RCP<Workset> workset) const;
 
   private:
+
+    //! Returns the timer handle for the given block, creating it on first use.
+    int getBlockTimerId(int blockIndex, const std::string& blockName) const;
+
+    //! Timer handles for the phases of the model evaluation
+    int damageTimerId;
+    int materialTimerId;
+    int contactTimerId;
+
+    //! Timer handles for each block, cached to avoid string lookups during the time loop
+    mutable std::vector<int> blockTimerIds;
     
     //! Private to prohibit copying
     ModelEvaluator(const ModelEvaluator&);
@@ -0,0 +1,171 @@
+/*! \file Peridigm_MultigridPreconditioner.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include "Peridigm_MultigridPreconditioner.hpp"
+#include <Epetra_MultiVector.h>
+#include <Teuchos_Assert.hpp>
+#ifdef PERIDIGM_ML
+  #include <ml_MultiLevelPreconditioner.h>
+#endif
+
+using namespace std;
+
+PeridigmNS::MultigridPreconditioner::MultigridPreconditioner(Teuchos::RCP<const Epetra_CrsMatrix> tangent_,
+                                                             Teuchos::RCP<const Epetra_Vector> modelCoordinates_,
+                                                             int blockSize_,
+                                                             const Teuchos::ParameterList& parameters_)
+  : tangent(tangent_), modelCoordinates(modelCoordinates_), blockSize(blockSize_), parameters(parameters_)
+{
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(!tangent->Filled(), "**** PeridigmNS::MultigridPreconditioner::MultigridPreconditioner(), tangent must be fill-complete.\n");
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(blockSize < 3, "**** PeridigmNS::MultigridPreconditioner::MultigridPreconditioner(), block size must be at least three.\n");
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(tangent->NumMyRows() != blockSize*(modelCoordinates->MyLength()/3),
+                              "**** PeridigmNS::MultigridPreconditioner::MultigridPreconditioner(), number of rows does not match the number of points.\n");
+}
+
+PeridigmNS::MultigridPreconditioner::~MultigridPreconditioner()
+{
+  // The ML preconditioner is released here, where its type is complete, and before the near-nullspace it references
+  preconditioner = Teuchos::null;
+}
+
+void PeridigmNS::MultigridPreconditioner::computeRigidBodyModes(const Epetra_Vector& modelCoordinates,
+                                                                int blockSize,
+                                                                std::vector<double>& modes,
+                                                                int& numModes)
+{
+  int numMyNodes = modelCoordinates.MyLength()/3;
+  int numMyRows = blockSize*numMyNodes;
+  numModes = 3 + blockSize;
+  modes.assign(numModes*numMyRows, 0.0);
+
+  // Rotations are taken about the centroid of the model to improve the conditioning of the modes
+  double* xPtr;
+  modelCoordinates.ExtractView(&xPtr);
+  double localSum[4] = {0.0, 0.0, 0.0, static_cast<double>(numMyNodes)};
+  double globalSum[4];
+  for(int i=0 ; i<numMyNodes ; ++i)
+    for(int dof=0 ; dof<3 ; ++dof)
+      localSum[dof] += xPtr[3*i+dof];
+  modelCoordinates.Comm().SumAll(localSum, globalSum, 4);
+  double centroid[3] = {0.0, 0.0, 0.0};
+  if(globalSum[3] > 0.0)
+    for(int dof=0 ; dof<3 ; ++dof)
+      centroid[dof] = globalSum[dof]/globalSum[3];
+
+  for(int i=0 ; i<numMyNodes ; ++i){
+    double dx = xPtr[3*i] - centroid[0];
+    double dy = xPtr[3*i+1] - centroid[1];
+    double dz = xPtr[3*i+2] - centroid[2];
+    int row = blockSize*i;
+    // Translations
+    for(int dof=0 ; dof<3 ; ++dof)
+      modes[dof*numMyRows + row + dof] = 1.0;
+    // Rotation about the x axis
+    modes[3*numMyRows + row + 1] = -dz;
+    modes[3*numMyRows + row + 2] = dy;
+    // Rotation about the y axis
+    modes[4*numMyRows + row + 0] = dz;
+    modes[4*numMyRows + row + 2] = -dx;
+    // Rotation about the z axis
+    modes[5*numMyRows + row + 0] = -dy;
+    modes[5*numMyRows + row + 1] = dx;
+    // Degrees of freedom beyond the displacements
+    for(int dof=3 ; dof<blockSize ; ++dof)
+      modes[(3+dof)*numMyRows + row + dof] = 1.0;
+  }
+}
+
+#ifdef PERIDIGM_ML
+
+int PeridigmNS::MultigridPreconditioner::compute()
+{
+  if(!preconditioner.is_null()){
+    // Recompute the multigrid hierarchy with the aggregates from the initial setup
+    return preconditioner->ReComputePreconditioner();
+  }
+
+  int numModes;
+  computeRigidBodyModes(*modelCoordinates, blockSize, nullSpace, numModes);
+  Teuchos::ParameterList mlList;
+  ML_Epetra::SetDefaults("SA", mlList);
+  mlList.set("PDE equations", blockSize);
+  mlList.set("null space: type", "pre-computed");
+  mlList.set("null space: dimension", numModes);
+  mlList.set("null space: vectors", nullSpace.size() > 0 ? &nullSpace[0] : static_cast<double*>(0));
+  mlList.set("aggregation: type", "Uncoupled");
+  mlList.set("smoother: type", "Chebyshev");
+  mlList.set("smoother: sweeps", 2);
+  mlList.set("coarse: max size", 512);
+  mlList.set("ML output", 0);
+  // Keep the aggregates so that later calls only recompute the numeric hierarchy
+  mlList.set("reuse: enable", true);
+  mlList.setParameters(parameters);
+  preconditioner = Teuchos::rcp( new ML_Epetra::MultiLevelPreconditioner(*tangent, mlList, true) );
+  return preconditioner->IsPreconditionerComputed() ? 0 : -1;
+}
+
+int PeridigmNS::MultigridPreconditioner::ApplyInverse(const Epetra_MultiVector& X, Epetra_MultiVector& Y) const
+{
+  if(preconditioner.is_null())
+    return -1;
+  return preconditioner->ApplyInverse(X, Y);
+}
+
+#else
+
+int PeridigmNS::MultigridPreconditioner::compute()
+{
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(true, "**** Error:  The Multigrid preconditioner requires Peridigm to be built against a Trilinos installation that includes ML.\n");
+  return -1;
+}
+
+int PeridigmNS::MultigridPreconditioner::ApplyInverse(const Epetra_MultiVector& X, Epetra_MultiVector& Y) const
+{
+  return -1;
+}
+
+#endif
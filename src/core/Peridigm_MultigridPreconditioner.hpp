@@ -0,0 +1,130 @@
+/*! \file Peridigm_MultigridPreconditioner.hpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#ifndef PERIDIGM_MULTIGRIDPRECONDITIONER_HPP
+#define PERIDIGM_MULTIGRIDPRECONDITIONER_HPP
+
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_ParameterList.hpp>
+#include <Epetra_Operator.h>
+#include <Epetra_CrsMatrix.h>
+#include <Epetra_Vector.h>
+#include <vector>
+
+namespace ML_Epetra {
+  class MultiLevelPreconditioner;
+}
+
+namespace PeridigmNS {
+
+/*! \brief Smoothed-aggregation multigrid preconditioner for the global tangent, provided by ML.
+ *
+ *  The degrees of freedom of each point are treated as a block, and the rigid-body modes of the model coordinates,
+ *  plus a constant mode for each degree of freedom beyond the three displacements, serve as the near-nullspace.  The
+ *  first call to compute() builds the multigrid hierarchy; later calls keep the aggregates and recompute only the
+ *  numeric hierarchy.  Building the hierarchy requires Peridigm to be built against a Trilinos installation that
+ *  includes ML (PERIDIGM_ML); computeRigidBodyModes() is always available.
+ */
+class MultigridPreconditioner : public Epetra_Operator {
+
+public:
+
+  /*! \brief Constructor; the scalar tangent must be fill-complete, with blockSize consecutive rows for each point.
+   *
+   *  The model coordinates hold the three coordinates of each locally-owned point.  Entries in the parameter list are
+   *  passed to ML and override the defaults.
+   */
+  MultigridPreconditioner(Teuchos::RCP<const Epetra_CrsMatrix> tangent,
+                          Teuchos::RCP<const Epetra_Vector> modelCoordinates,
+                          int blockSize,
+                          const Teuchos::ParameterList& parameters);
+
+  //! Destructor.
+  virtual ~MultigridPreconditioner();
+
+  //! Builds the multigrid hierarchy on the first call and recomputes it on later calls; returns nonzero on error.
+  int compute();
+
+  /*! \brief Computes the rigid-body modes of the given model coordinates in the layout of a tangent with blockSize
+   *  rows for each point, stored one mode after another.
+   *
+   *  The modes are the three translations and the three rotations about the centroid of the model, followed by a
+   *  constant mode for each degree of freedom beyond the first three.
+   */
+  static void computeRigidBodyModes(const Epetra_Vector& modelCoordinates, int blockSize, std::vector<double>& modes, int& numModes);
+
+  //! @name Epetra_Operator interface
+  //@{
+  int SetUseTranspose(bool useTranspose) { return useTranspose ? -1 : 0; }
+  int Apply(const Epetra_MultiVector& X, Epetra_MultiVector& Y) const { return -1; }
+  int ApplyInverse(const Epetra_MultiVector& X, Epetra_MultiVector& Y) const;
+  double NormInf() const { return 0.0; }
+  const char* Label() const { return "PeridigmNS::MultigridPreconditioner"; }
+  bool UseTranspose() const { return false; }
+  bool HasNormInf() const { return false; }
+  const Epetra_Comm& Comm() const { return tangent->Comm(); }
+  const Epetra_Map& OperatorDomainMap() const { return tangent->OperatorDomainMap(); }
+  const Epetra_Map& OperatorRangeMap() const { return tangent->OperatorRangeMap(); }
+  //@}
+
+protected:
+
+  Teuchos::RCP<const Epetra_CrsMatrix> tangent;
+  Teuchos::RCP<const Epetra_Vector> modelCoordinates;
+  int blockSize;
+  Teuchos::ParameterList parameters;
+
+  //! Near-nullspace, which ML references for as long as the hierarchy exists
+  std::vector<double> nullSpace;
+
+  //! The ML preconditioner, created by the first call to compute()
+  Teuchos::RCP<ML_Epetra::MultiLevelPreconditioner> preconditioner;
+};
+
+}
+
+#endif // PERIDIGM_MULTIGRIDPRECONDITIONER_HPP
@@ -55,10 +55,10 @@ class NeighborhoodData {
 public:
 
   NeighborhoodData() 
-    : numOwnedPoints(0), ownedIDs(0), neighborhoodListSize(0), neighborhoodList(0), neighborhoodPtr(0) {}
+    : numOwnedPoints(0), ownedIDs(0), neighborhoodListSize(0), neighborhoodList(0), neighborhoodPtr(0), version(NextVersion()) {}
 
   NeighborhoodData(const NeighborhoodData& other)
-    : numOwnedPoints(0), ownedIDs(0), neighborhoodListSize(0), neighborhoodList(0), neighborhoodPtr(0)
+    : numOwnedPoints(0), ownedIDs(0), neighborhoodListSize(0), neighborhoodList(0), neighborhoodPtr(0), version(NextVersion())
   {
     SetNumOwned(other.NumOwnedPoints());
     SetNeighborhoodListSize(other.NeighborhoodListSize());
@@ -91,6 +91,17 @@ public:
 	if(neighborhoodList != 0)
 	  delete[] neighborhoodList;
 	neighborhoodList = new int[neighborhoodListSize];
+    version = NextVersion();
+  }
+
+  //! Returns an identifier for the neighborhood list that is unique within the process; it changes whenever the list is reallocated.
+  int Version() const{
+    return version;
+  }
+
+  //! Assigns a new version, to be called after the neighborhood list has been modified in place.
+  void IncrementVersion(){
+    version = NextVersion();
   }
 
   int NumOwnedPoints() const{
@@ -126,6 +137,12 @@ protected:
   int neighborhoodListSize;
   int* neighborhoodList;
   int* neighborhoodPtr;
+  int version;
+
+  static int NextVersion(){
+    static int counter = 0;
+    return ++counter;
+  }
 };
 
 }
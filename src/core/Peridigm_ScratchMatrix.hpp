@@ -86,6 +86,9 @@ namespace PeridigmNS {
     //! Access to underlying data array.
     const double *const * Data(){ return data; }
 
+    //! Access to the rows of the underlying data array, for kernels that fill the matrix directly.
+    double *const * Rows(){ return data; }
+
     //! @name Accessor functions (warning: no bounds checking).
     //@{
 
@@ -46,6 +46,7 @@
 //@HEADER
 
 #include <vector>
+#include <algorithm>
 
 #include <Epetra_Import.h>
 #include <Epetra_SerialDenseMatrix.h>
@@ -56,6 +57,15 @@
 
 using namespace std;
 
+//! Returns the position of the given column in a row of column indices, or -1 if the row has no entry for the column
+static int findColumn(const int* rowIndices, int numEntries, bool sorted, int column)
+{
+  const int* position = sorted ? std::lower_bound(rowIndices, rowIndices + numEntries, column) : std::find(rowIndices, rowIndices + numEntries, column);
+  if(position == rowIndices + numEntries || *position != column)
+    return -1;
+  return static_cast<int>(position - rowIndices);
+}
+
 PeridigmNS::SerialMatrix::SerialMatrix(Teuchos::RCP<Epetra_FECrsMatrix> epetraFECrsMatrix)
   : FECrsMatrix(epetraFECrsMatrix)
 {
@@ -81,101 +91,217 @@ void PeridigmNS::SerialMatrix::addValue(int globalRow, int globalCol, double val
 
 void PeridigmNS::SerialMatrix::addValues(int numIndices, const int* globalIndices, const double *const * values)
 {
-  vector<int> localRowIndices(numIndices);
-  vector<int> localColIndices(numIndices);
-  for(int i=0 ; i<numIndices ; ++i){
-    localRowIndices[i] = FECrsMatrix->LRID(globalIndices[i]);
-    int localColIndex = FECrsMatrix->LCID(globalIndices[i]);
-    TEUCHOS_TEST_FOR_EXCEPT_MSG(localColIndex == -1, "Error in PeridigmNS::SerialMatrix::addValues(), bad column index.");
-    localColIndices[i] = localColIndex;
-  }
+  addValues(getAssemblyPlan(numIndices, globalIndices, FULL), values);
+}
+
+// This is like the SerialMatrix::addValues routine above, but inserts only the block diagonal values and filters out the rest
+void PeridigmNS::SerialMatrix::addBlockDiagonalValues(int numIndices, const int* globalIndices, const double *const * values)
+{
+  addValues(getAssemblyPlan(numIndices, globalIndices, BLOCK_DIAGONAL), values);
+}
+
+void PeridigmNS::SerialMatrix::addPairwiseValues(int numIndices, const int* globalIndices, const double *const * values)
+{
+  addValues(getAssemblyPlan(numIndices, globalIndices, PAIRWISE), values);
+}
 
+void PeridigmNS::SerialMatrix::addValues(const AssemblyPlan& plan, const double *const * values)
+{
+  int numIndices = static_cast<int>(plan.rows.size());
+  bool graphIsSorted = FECrsMatrix->Graph().Sorted();
   for(int iRow=0 ; iRow<numIndices ; ++iRow){
+    const double* rowValues = values[iRow];
+    int numEntries;
+    int* rowIndices;
+    double* target;
+    const int* columns;
+    const int* columnOrder;
+    bool sorted;
+    // Locally-owned rows are summed directly into the values of the matrix; the views are extracted
+    // for each call because the matrix storage may be reorganized by FillComplete()
+    if(plan.rows[iRow] >= 0){
+      int err = FECrsMatrix->ExtractMyRowView(plan.rows[iRow], numEntries, target);
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(err != 0, "**** PeridigmNS::SerialMatrix::addValues(), ExtractMyRowView() returned nonzero error code.\n");
+      err = FECrsMatrix->Graph().ExtractMyRowView(plan.rows[iRow], numEntries, rowIndices);
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(err != 0, "**** PeridigmNS::SerialMatrix::addValues(), ExtractMyRowView() returned nonzero error code.\n");
+      columns = &plan.localColumns[0];
+      columnOrder = plan.localColumnOrder.size() > 0 ? &plan.localColumnOrder[0] : 0;
+      sorted = graphIsSorted;
+    }
+    // Rows that are not locally owned are accumulated and passed to the FECrsMatrix in sumIntoNonlocalRows()
+    else{
+      NonlocalRow& nonlocalRow = nonlocalRows[-1 - plan.rows[iRow]];
+      numEntries = static_cast<int>(nonlocalRow.globalColumns.size());
+      rowIndices = &nonlocalRow.globalColumns[0];
+      target = &nonlocalRow.values[0];
+      columns = &plan.globalIndices[0];
+      columnOrder = plan.globalColumnOrder.size() > 0 ? &plan.globalColumnOrder[0] : 0;
+      sorted = true;
+    }
 
-    // If the row is locally owned, then sum into the global tangent with Epetra_CrsMatrix::SumIntoMyValues().
-    if(localRowIndices[iRow] != -1){
-      int err = FECrsMatrix->SumIntoMyValues(localRowIndices[iRow], numIndices, values[iRow], &localColIndices[0]);
-      TEUCHOS_TEST_FOR_EXCEPT_MSG(err != 0, "**** PeridigmNS::SerialMatrix::addValues(), SumIntoMyValues() returned nonzero error code.\n");
+    if(plan.pattern == BLOCK_DIAGONAL){
+      for(int j=0 ; j<3 ; ++j){
+        int sourceColumn = plan.blockColumns[3*iRow + j];
+        int position = findColumn(rowIndices, numEntries, sorted, columns[sourceColumn]);
+        TEUCHOS_TEST_FOR_EXCEPT_MSG(position == -1, "**** PeridigmNS::SerialMatrix::addValues(), entry is not in the graph of the matrix.\n");
+        target[position] += rowValues[sourceColumn];
+      }
+    }
+    else if(plan.pattern == PAIRWISE && iRow >= 3){
+      // The columns of the point, followed by the columns of the neighbor to which this row belongs
+      int neighborOffset = 3*(iRow/3);
+      for(int j=0 ; j<6 ; ++j){
+        int column = j < 3 ? columns[j] : columns[neighborOffset + j - 3];
+        int position = findColumn(rowIndices, numEntries, sorted, column);
+        TEUCHOS_TEST_FOR_EXCEPT_MSG(position == -1, "**** PeridigmNS::SerialMatrix::addValues(), entry is not in the graph of the matrix.\n");
+        target[position] += rowValues[j];
+      }
+    }
+    else if(sorted){
+      // Walk through the row, visiting the columns in increasing order
+      int position = 0;
+      for(int k=0 ; k<numIndices ; ++k){
+        int sourceColumn = columnOrder[k];
+        while(position < numEntries && rowIndices[position] < columns[sourceColumn])
+          ++position;
+        TEUCHOS_TEST_FOR_EXCEPT_MSG(position == numEntries || rowIndices[position] != columns[sourceColumn],
+                                    "**** PeridigmNS::SerialMatrix::addValues(), entry is not in the graph of the matrix.\n");
+        target[position] += rowValues[sourceColumn];
+      }
     }
-    // If the row is not locally owned, then sum into the global tangent with Epetra_FECrsMatrix::SumIntoGlobalValues().
-    // This is expensive.
     else{
-      int err = FECrsMatrix->SumIntoGlobalValues(globalIndices[iRow], numIndices, values[iRow], &globalIndices[0]);
-      TEUCHOS_TEST_FOR_EXCEPT_MSG(err != 0, "**** PeridigmNS::SerialMatrix::addValues(), SumIntoGlobalValues() returned nonzero error code.\n");
+      for(int sourceColumn=0 ; sourceColumn<numIndices ; ++sourceColumn){
+        int position = findColumn(rowIndices, numEntries, sorted, columns[sourceColumn]);
+        TEUCHOS_TEST_FOR_EXCEPT_MSG(position == -1, "**** PeridigmNS::SerialMatrix::addValues(), entry is not in the graph of the matrix.\n");
+        target[position] += rowValues[sourceColumn];
+      }
     }
   }
 }
 
-// This is like the SerialMatrix::addValues routine above, but inserts only the block diagonal values and filters out the rest
-void PeridigmNS::SerialMatrix::addBlockDiagonalValues(int numIndices, const int* globalIndices, const double *const * values)
+const PeridigmNS::SerialMatrix::AssemblyPlan& PeridigmNS::SerialMatrix::getAssemblyPlan(int numIndices, const int* globalIndices, AssemblyPattern pattern)
 {
+  // Look for an existing plan for this list of global indices
+  std::vector<int>& candidates = assemblyPlanLookup[numIndices > 0 ? globalIndices[0] : -1];
+  for(unsigned int i=0 ; i<candidates.size() ; ++i){
+    const AssemblyPlan& plan = assemblyPlans[candidates[i]];
+    if(plan.pattern == pattern &&
+       static_cast<int>(plan.globalIndices.size()) == numIndices &&
+       std::equal(globalIndices, globalIndices + numIndices, plan.globalIndices.begin()))
+      return plan;
+  }
 
-  // Local row and column indices for each global index
-  vector<int> localRowIndices(numIndices);
-  vector<int> localColIndices(numIndices);
-
-  // Inverse map that gives index value into globalIndices array for each global index value
-  std::map<int,int> inverseMap;
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(pattern == PAIRWISE && numIndices%3 != 0,
+                              "Error in PeridigmNS::SerialMatrix::addPairwiseValues(), number of indices is not a multiple of three.");
 
-  // Assign local indices and inverse map
+  AssemblyPlan plan;
+  plan.pattern = pattern;
+  plan.globalIndices.assign(globalIndices, globalIndices + numIndices);
+  plan.rows.resize(numIndices);
+  plan.localColumns.resize(numIndices);
   for(int i=0 ; i<numIndices ; ++i){
-    localRowIndices[i] = FECrsMatrix->LRID(globalIndices[i]);
-    int localColIndex = FECrsMatrix->LCID(globalIndices[i]);
-    // Will be receiving data for columns that we will not fill, so don't check that all column data is locally owned. 
-    localColIndices[i] = localColIndex;
-    inverseMap[globalIndices[i]] = i;
+    plan.localColumns[i] = FECrsMatrix->LCID(globalIndices[i]);
+    // For the block diagonal, data will be received for columns that are not filled, so not all columns are checked
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(pattern != BLOCK_DIAGONAL && plan.localColumns[i] == -1, "Error in PeridigmNS::SerialMatrix::addValues(), bad column index.");
   }
 
-  // Scratch space for extracting the three nonzeros per row to fill
-  int blockDiagonalNumIndices = 3;
-  Teuchos::SerialDenseVector<int,int> blockDiagonalLocalColIndices(blockDiagonalNumIndices);
-  Teuchos::SerialDenseVector<int,int> blockDiagonalGlobalIndices(blockDiagonalNumIndices);
-  Teuchos::SerialDenseVector<int,double> blockDiagonalValues(blockDiagonalNumIndices);
+  if(pattern == BLOCK_DIAGONAL){
+    // Determine which global element each row belongs to, and the positions of the global indices of DOFs for this element
+    std::map<int,int> inverseMap;
+    for(int i=0 ; i<numIndices ; ++i)
+      inverseMap[globalIndices[i]] = i;
+    plan.blockColumns.resize(3*numIndices);
+    for(int iRow=0 ; iRow<numIndices ; ++iRow){
+      int elem = globalIndices[iRow] / 3;
+      for(int e=3*elem ; e<3*elem+3 ; ++e){
+        TEUCHOS_TEST_FOR_EXCEPT_MSG(inverseMap.count(e)<=0, "Error in PeridigmNS::SerialMatrix::addBlockDiagonalValues(), bad index.");
+        plan.blockColumns[3*iRow + e - 3*elem] = inverseMap[e];
+      }
+    }
+  }
+  else{
+    // The order in which the columns are visited when walking through the rows of the matrix, which are sorted
+    // by local column, and through the nonlocal rows, which are sorted by global column
+    vector< pair<int,int> > sortedColumns(numIndices);
+    for(int i=0 ; i<numIndices ; ++i)
+      sortedColumns[i] = std::make_pair(plan.localColumns[i], i);
+    std::sort(sortedColumns.begin(), sortedColumns.end());
+    plan.localColumnOrder.resize(numIndices);
+    for(int i=0 ; i<numIndices ; ++i)
+      plan.localColumnOrder[i] = sortedColumns[i].second;
+    for(int i=0 ; i<numIndices ; ++i)
+      sortedColumns[i] = std::make_pair(globalIndices[i], i);
+    std::sort(sortedColumns.begin(), sortedColumns.end());
+    plan.globalColumnOrder.resize(numIndices);
+    for(int i=0 ; i<numIndices ; ++i)
+      plan.globalColumnOrder[i] = sortedColumns[i].second;
+  }
 
   for(int iRow=0 ; iRow<numIndices ; ++iRow){
- 
-    // Determine which global element iRow belongs to
-    int elem = globalIndices[iRow] / 3;
-    // Determine global indices of DOFs for this element
-    int e1 = 3*elem + 0;
-    int e2 = 3*elem + 1;
-    int e3 = 3*elem + 2;
-
-    // Be sure entries exist in inverseMap
-    TEUCHOS_TEST_FOR_EXCEPT_MSG(inverseMap.count(e1)<=0, "Error in PeridigmNS::SerialMatrix::addBlockDiagonalValues(), bad index.");
-    TEUCHOS_TEST_FOR_EXCEPT_MSG(inverseMap.count(e2)<=0, "Error in PeridigmNS::SerialMatrix::addBlockDiagonalValues(), bad index.");
-    TEUCHOS_TEST_FOR_EXCEPT_MSG(inverseMap.count(e3)<=0, "Error in PeridigmNS::SerialMatrix::addBlockDiagonalValues(), bad index.");
-
-    // Store only the three block diagonal nonzeros to fill
-    int idx1 = inverseMap[e1];
-    blockDiagonalLocalColIndices[0] = localColIndices[idx1];
-    blockDiagonalValues[0]          = values[iRow][idx1];
-    int idx2 = inverseMap[e2];
-    blockDiagonalLocalColIndices[1] = localColIndices[idx2];
-    blockDiagonalValues[1]          = values[iRow][idx2];
-    int idx3 = inverseMap[e3];
-    blockDiagonalLocalColIndices[2] = localColIndices[idx3];
-    blockDiagonalValues[2]          = values[iRow][idx3];
-    // Store global indices in case row not locally owned
-    blockDiagonalGlobalIndices[0] = e1;
-    blockDiagonalGlobalIndices[1] = e2;
-    blockDiagonalGlobalIndices[2] = e3;
-     
-    // If the row is locally owned, then sum into the global tangent with Epetra_CrsMatrix::SumIntoMyValues().
-    if(localRowIndices[iRow] != -1){
-      int err = FECrsMatrix->SumIntoMyValues(localRowIndices[iRow], blockDiagonalNumIndices, &blockDiagonalValues[0], &blockDiagonalLocalColIndices[0]);
-      TEUCHOS_TEST_FOR_EXCEPT_MSG(err != 0, "**** PeridigmNS::SerialMatrix::addBlockDiagonalValues(), SumIntoMyValues() returned nonzero error code.\n");
+    int localRow = FECrsMatrix->LRID(globalIndices[iRow]);
+    if(localRow != -1){
+      plan.rows[iRow] = localRow;
     }
-    // If the row is not locally owned, then sum into the global tangent with Epetra_FECrsMatrix::SumIntoGlobalValues().
-    // This is expensive.
     else{
-      int err = FECrsMatrix->SumIntoGlobalValues(globalIndices[iRow], blockDiagonalNumIndices, const_cast<double *>(&blockDiagonalValues[0]), const_cast<int *>(&blockDiagonalGlobalIndices[0]));
-      TEUCHOS_TEST_FOR_EXCEPT_MSG(err != 0, "**** PeridigmNS::SerialMatrix::addBlockDiagonalValues(), SumIntoGlobalValues() returned nonzero error code.\n");
+      // Add the columns that receive values in this row to the buffer for the nonlocal row
+      std::map<int,int>::iterator it = nonlocalRowLookup.find(globalIndices[iRow]);
+      if(it == nonlocalRowLookup.end()){
+        it = nonlocalRowLookup.insert(std::make_pair(globalIndices[iRow], static_cast<int>(nonlocalRows.size()))).first;
+        nonlocalRows.push_back(NonlocalRow());
+        nonlocalRows.back().globalRow = globalIndices[iRow];
+      }
+      NonlocalRow& nonlocalRow = nonlocalRows[it->second];
+      plan.rows[iRow] = -1 - it->second;
+      if(pattern == BLOCK_DIAGONAL){
+        for(int j=0 ; j<3 ; ++j)
+          addNonlocalColumn(nonlocalRow, globalIndices[plan.blockColumns[3*iRow + j]]);
+      }
+      else if(pattern == PAIRWISE && iRow >= 3){
+        int neighborOffset = 3*(iRow/3);
+        for(int j=0 ; j<3 ; ++j){
+          addNonlocalColumn(nonlocalRow, globalIndices[j]);
+          addNonlocalColumn(nonlocalRow, globalIndices[neighborOffset + j]);
+        }
+      }
+      else{
+        for(int j=0 ; j<numIndices ; ++j)
+          addNonlocalColumn(nonlocalRow, globalIndices[j]);
+      }
     }
   }
+
+  candidates.push_back(static_cast<int>(assemblyPlans.size()));
+  assemblyPlans.push_back(plan);
+  return assemblyPlans.back();
+}
+
+void PeridigmNS::SerialMatrix::addNonlocalColumn(NonlocalRow& nonlocalRow, int globalCol)
+{
+  std::vector<int>::iterator position = std::lower_bound(nonlocalRow.globalColumns.begin(), nonlocalRow.globalColumns.end(), globalCol);
+  if(position == nonlocalRow.globalColumns.end() || *position != globalCol){
+    // Values that have already been accumulated in the row are moved along with their columns
+    nonlocalRow.values.insert(nonlocalRow.values.begin() + (position - nonlocalRow.globalColumns.begin()), 0.0);
+    nonlocalRow.globalColumns.insert(position, globalCol);
+  }
+}
+
+void PeridigmNS::SerialMatrix::sumIntoNonlocalRows()
+{
+  // Sum into the global tangent with Epetra_FECrsMatrix::SumIntoGlobalValues(), once for each nonlocal row
+  for(unsigned int i=0 ; i<nonlocalRows.size() ; ++i){
+    NonlocalRow& nonlocalRow = nonlocalRows[i];
+    int numEntries = static_cast<int>(nonlocalRow.globalColumns.size());
+    if(numEntries == 0)
+      continue;
+    int err = FECrsMatrix->SumIntoGlobalValues(nonlocalRow.globalRow, numEntries, &nonlocalRow.values[0], &nonlocalRow.globalColumns[0]);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(err != 0, "**** PeridigmNS::SerialMatrix::sumIntoNonlocalRows(), SumIntoGlobalValues() returned nonzero error code.\n");
+    std::fill(nonlocalRow.values.begin(), nonlocalRow.values.end(), 0.0);
+  }
 }
 
 void PeridigmNS::SerialMatrix::putScalar(double value)
 {
   FECrsMatrix->PutScalar(value);
+  for(unsigned int i=0 ; i<nonlocalRows.size() ; ++i)
+    std::fill(nonlocalRows[i].values.begin(), nonlocalRows[i].values.end(), 0.0);
 }
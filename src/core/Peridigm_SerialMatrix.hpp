@@ -62,6 +62,14 @@ namespace PeridigmNS {
  *  block-specific data and were designed such that a single, consistent indexing scheme is used for all calculations.  This
  *  indexing scheme differs from the global indexing scheme, hence the index values must be transformed prior to inserting
  *  values into the global tangent matrix.  This translation is the main purpose of PeridigmNS::SerialMatrix.
+ *
+ *  Because the graph of the matrix does not change after it is allocated, the translation for each list of global indices
+ *  passed to addValues(), addBlockDiagonalValues(), or addPairwiseValues() is computed once and cached as an assembly plan.
+ *  A plan holds the local row and local column of each global index, along with the order in which the columns are visited,
+ *  so that the position of each entry is found by walking through the sorted row of the matrix.  The memory required by a
+ *  plan is proportional to the number of global indices, rather than to the number of entries.  Values in rows owned by
+ *  other processors are accumulated in a buffer that is laid out when the plans are created, and are passed to the
+ *  Epetra_FECrsMatrix by sumIntoNonlocalRows().
  */
 class SerialMatrix {
 
@@ -75,12 +83,24 @@ public:
   //! Add data at given location, indexed by global ID (the block version of this function, addValues(), is prefered for efficiency)
   void addValue(int globalRow, int globalCol, double value);
 
-  //! Add block of data at given locations, indexed by global ID
+  //! Add block of data at given locations, indexed by global ID; values in rows owned by other processors are held until sumIntoNonlocalRows()
   void addValues(int numIndicies, const int* globalIndices, const double *const * values);
 
-  //! Add only block diagonal values at given locations, indexed by global ID
+  //! Add only block diagonal values at given locations, indexed by global ID; values in rows owned by other processors are held until sumIntoNonlocalRows()
   void addBlockDiagonalValues(int numIndicies, const int* globalIndices, const double *const * values);
 
+  /*! \brief Add the values for the bonds of a single point, for tangents in which each bond couples only its two endpoints; indexed by global ID.
+   *
+   *  The first three global indices belong to the point and the remaining indices to its neighbors, three for each neighbor.
+   *  Each row of the point holds a value for every global index, whereas each row of a neighbor holds only six values, for
+   *  the three columns of the point followed by the three columns of the neighbor.  Values in rows owned by other processors
+   *  are held until sumIntoNonlocalRows().
+   */
+  void addPairwiseValues(int numIndicies, const int* globalIndices, const double *const * values);
+
+  //! Pass the accumulated values in rows owned by other processors to the FECrsMatrix, must be called prior to GlobalAssemble()
+  void sumIntoNonlocalRows();
+
   //! Set all entries to given scalar
   void putScalar(double value);
 
@@ -89,8 +109,51 @@ public:
 
 protected:
 
+  //! Layout of the values passed to addValues(), addBlockDiagonalValues(), and addPairwiseValues(), respectively
+  enum AssemblyPattern { FULL, BLOCK_DIAGONAL, PAIRWISE };
+
+  //! Rows and columns in the matrix of the entries added for a given list of global indices
+  struct AssemblyPlan {
+    AssemblyPattern pattern;
+    std::vector<int> globalIndices;
+    //! Local row in the matrix, or -1 minus the index of the nonlocal row, for each global index
+    std::vector<int> rows;
+    //! Local column in the matrix for each global index, or -1 if the column is not in the column map
+    std::vector<int> localColumns;
+    //! Positions in the list of global indices, in order of increasing local column
+    std::vector<int> localColumnOrder;
+    //! Positions in the list of global indices, in order of increasing global index
+    std::vector<int> globalColumnOrder;
+    //! For the block diagonal, the positions in the list of global indices of the three columns of each row
+    std::vector<int> blockColumns;
+  };
+
+  //! Accumulated values for a row owned by another processor, with the global columns in increasing order
+  struct NonlocalRow {
+    int globalRow;
+    std::vector<int> globalColumns;
+    std::vector<double> values;
+  };
+
+  //! Returns the assembly plan for the given global indices, creating it if necessary
+  const AssemblyPlan& getAssemblyPlan(int numIndices, const int* globalIndices, AssemblyPattern pattern);
+
+  //! Sums the dense block of values into the matrix according to the given assembly plan
+  void addValues(const AssemblyPlan& plan, const double *const * values);
+
+  //! Adds the given global column to a nonlocal row, if it is not already present
+  void addNonlocalColumn(NonlocalRow& nonlocalRow, int globalCol);
+
   Teuchos::RCP<Epetra_FECrsMatrix> FECrsMatrix;
 
+  std::vector<AssemblyPlan> assemblyPlans;
+
+  //! Assembly plans for each list of global indices, keyed by the first global index
+  std::map<int, std::vector<int> > assemblyPlanLookup;
+
+  std::vector<NonlocalRow> nonlocalRows;
+  std::map<int,int> nonlocalRowLookup;
+
 private:
 
   //! Private to prohibit use.
@@ -0,0 +1,104 @@
+/*! \file Peridigm_SoAVectorData.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include "Peridigm_SoAVectorData.hpp"
+#include <cstddef>
+
+void PeridigmNS::SoAVectorData::resize(int numPoints)
+{
+  const int entriesPerAlignment = alignment/sizeof(double);
+  int newPaddedLength = ((numPoints + entriesPerAlignment - 1)/entriesPerAlignment)*entriesPerAlignment;
+  int previousLength = length;
+  length = numPoints;
+  if(newPaddedLength == paddedLength && storage.size() > 0){
+    // Entries beyond the new length may hold values from a longer, earlier use; the padding must stay zero
+    for(int i=length ; i<previousLength ; ++i){
+      x[i] = 0.0;
+      y[i] = 0.0;
+      z[i] = 0.0;
+    }
+    return;
+  }
+  paddedLength = newPaddedLength;
+
+  // Over-allocate by one alignment unit and offset the first component array to an aligned address;
+  // the padded length is a multiple of the alignment, so the other component arrays are aligned as well
+  storage.assign(3*paddedLength + entriesPerAlignment, 0.0);
+  std::size_t address = reinterpret_cast<std::size_t>(&storage[0]);
+  std::size_t offset = (alignment - address%alignment)%alignment;
+  x = &storage[0] + offset/sizeof(double);
+  y = x + paddedLength;
+  z = y + paddedLength;
+}
+
+void PeridigmNS::SoAVectorData::gather(const double* interleavedData, int numPoints)
+{
+  resize(numPoints);
+  for(int i=0 ; i<length ; ++i){
+    x[i] = interleavedData[3*i];
+    y[i] = interleavedData[3*i+1];
+    z[i] = interleavedData[3*i+2];
+  }
+}
+
+void PeridigmNS::SoAVectorData::scatter(double* interleavedData) const
+{
+  for(int i=0 ; i<length ; ++i){
+    interleavedData[3*i] = x[i];
+    interleavedData[3*i+1] = y[i];
+    interleavedData[3*i+2] = z[i];
+  }
+}
+
+void PeridigmNS::SoAVectorData::PutScalar(double value)
+{
+  for(int i=0 ; i<length ; ++i){
+    x[i] = value;
+    y[i] = value;
+    z[i] = value;
+  }
+}
@@ -0,0 +1,111 @@
+/*! \file Peridigm_SoAVectorData.hpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#ifndef PERIDIGM_SOAVECTORDATA_HPP
+#define PERIDIGM_SOAVECTORDATA_HPP
+
+#include <vector>
+
+namespace PeridigmNS {
+
+/*! \brief Structure-of-arrays copy of three-dimensional point data.
+ *
+ *  Peridigm stores vector data with interleaved components (x0, y0, z0, x1, y1, z1, ...).  SoAVectorData holds the
+ *  same data as three separate arrays (x0, x1, ..., y0, y1, ..., z0, z1, ...), each of which starts on a 64-byte
+ *  boundary and is padded with zeros to a multiple of eight entries, so that kernels can process several neighbors
+ *  per instruction.  Data is transposed to and from the interleaved layout by gather() and scatter().
+ */
+class SoAVectorData {
+
+public:
+
+  //! Alignment of each component array, in bytes.
+  static const int alignment = 64;
+
+  SoAVectorData() : length(0), paddedLength(0), x(0), y(0), z(0) {}
+
+  //! Copies interleaved data for the given number of points into the component arrays, resizing them if needed.
+  void gather(const double* interleavedData, int numPoints);
+
+  //! Copies the component arrays into interleaved data.
+  void scatter(double* interleavedData) const;
+
+  //! Sets all entries to the given value; the padding remains zero.
+  void PutScalar(double value);
+
+  //! Sets the number of points, reallocating and zeroing the component arrays only if the padded length changes.
+  void resize(int numPoints);
+
+  //! Number of points.
+  int Length() const { return length; }
+
+  //! Length of each component array including padding.
+  int PaddedLength() const { return paddedLength; }
+
+  //! @name Component arrays
+  //@{
+  double* X() { return x; }
+  double* Y() { return y; }
+  double* Z() { return z; }
+  const double* X() const { return x; }
+  const double* Y() const { return y; }
+  const double* Z() const { return z; }
+  //@}
+
+protected:
+
+  int length;
+  int paddedLength;
+  std::vector<double> storage;
+  double* x;
+  double* y;
+  double* z;
+};
+
+}
+
+#endif // PERIDIGM_SOAVECTORDATA_HPP
@@ -2,7 +2,9 @@
 
 #include "Peridigm_Timer.hpp"
 #include <iostream>
+#include <fstream>
 #include <vector>
+#include <algorithm>
 
 #include <Teuchos_CommHelpers.hpp>
 #include <Teuchos_DefaultComm.hpp>
@@ -16,47 +18,235 @@ PeridigmNS::Timer& PeridigmNS::Timer::self() {
   return timer;
 }
 
-void PeridigmNS::Timer::printTimingData(ostream &out){
+double PeridigmNS::Timer::wallTime() {
+  if(clock.is_null()){
+#ifdef HAVE_MPI
+    clock = Teuchos::rcp(new Epetra_Time(Epetra_MpiComm(MPI_COMM_WORLD)));
+#else
+    clock = Teuchos::rcp(new Epetra_Time(Epetra_SerialComm()));
+#endif
+  }
+  return clock->WallTime();
+}
+
+int PeridigmNS::Timer::getTimerId(const string& name) {
+  map<string, int>::const_iterator it = timerIds.find(name);
+  if(it != timerIds.end())
+    return it->second;
+  int timerId = static_cast<int>(names.size());
+  names.push_back(name);
+  timerIds[name] = timerId;
+  return timerId;
+}
+
+void PeridigmNS::Timer::startTimer(int timerId) {
+
+  // Nest the timer under the most recently started timer that is still running
+  int parent = activeTimers.empty() ? 0 : activeTimers.back().node;
+  int node = -1;
+  const vector<int>& children = nodes[parent].children;
+  for(unsigned int i=0 ; i<children.size() ; ++i){
+    if(nodes[children[i]].timerId == timerId){
+      node = children[i];
+      break;
+    }
+  }
+  if(node == -1){
+    node = static_cast<int>(nodes.size());
+    nodes.push_back(Node(timerId, parent));
+    nodes[parent].children.push_back(node);
+  }
+
+  ActiveTimer activeTimer;
+  activeTimer.timerId = timerId;
+  activeTimer.node = node;
+  activeTimer.startTime = wallTime();
+  activeTimers.push_back(activeTimer);
+}
+
+void PeridigmNS::Timer::stopTimer(int timerId) {
+
+  // Timers are normally stopped in the reverse order in which they were started,
+  // but tolerate overlapping timers by searching down the stack
+  for(int i=static_cast<int>(activeTimers.size())-1 ; i>=0 ; --i){
+    if(activeTimers[i].timerId == timerId){
+      Node& node = nodes[activeTimers[i].node];
+      node.elapsedTime += wallTime() - activeTimers[i].startTime;
+      node.numCalls += 1;
+      activeTimers.erase(activeTimers.begin() + i);
+      return;
+    }
+  }
+}
+
+double PeridigmNS::Timer::elapsedTime(const string& name) {
+  map<string, int>::const_iterator it = timerIds.find(name);
+  if(it == timerIds.end())
+    return 0.0;
+  double time = 0.0;
+  for(unsigned int i=1 ; i<nodes.size() ; ++i)
+    if(nodes[i].timerId == it->second)
+      time += nodes[i].elapsedTime;
+  return time;
+}
+
+void PeridigmNS::Timer::markStep() {
+  if(timeSeriesFrequency <= 0)
+    return;
+  stepCount += 1;
+  if(stepCount%timeSeriesFrequency != 0)
+    return;
+  sampleSteps.push_back(stepCount);
+  vector<double> snapshot(nodes.size());
+  for(unsigned int i=0 ; i<nodes.size() ; ++i)
+    snapshot[i] = nodes[i].elapsedTime;
+  samples.push_back(snapshot);
+}
 
-  int count = (int)( timers.size() );
-  vector<string> names(count);
-  vector<double> times(count);
-  vector<double> minTimes(count);
-  vector<double> maxTimes(count);
-  vector<double> totalTimes(count);
-  int i = 0;
-  for(map<string, TimeKeeper>::reverse_iterator it=timers.rbegin() ; it!=timers.rend() ; it++){
-    names[i] = it->first;
-    times[i] = it->second.getElapsedTime();
-    i++;
+string PeridigmNS::Timer::nodePath(int node) const {
+  string path = names[nodes[node].timerId];
+  for(int parent = nodes[node].parent ; parent > 0 ; parent = nodes[parent].parent)
+    path = names[nodes[parent].timerId] + " > " + path;
+  return path;
+}
+
+int PeridigmNS::Timer::pathHash(const vector< pair<string, int> >& paths) const {
+  // FNV-1a, restricted to non-negative ints so that it can be reduced with the Teuchos int reductions
+  unsigned int hash = 2166136261u;
+  for(unsigned int i=0 ; i<paths.size() ; ++i){
+    const string& path = paths[i].first;
+    for(unsigned int j=0 ; j<=path.size() ; ++j){
+      hash ^= (j < path.size()) ? static_cast<unsigned char>(path[j]) : 0u;
+      hash *= 16777619u;
+    }
   }
+  return static_cast<int>(hash & 0x7fffffffu);
+}
+
+void PeridigmNS::Timer::printTimingData(ostream &out){
 
   Teuchos::RCP<const Teuchos::Comm<int> > teuchosComm = Teuchos::createMpiComm<int>(Teuchos::opaqueWrapper<MPI_Comm>(MPI_COMM_WORLD));
-  Teuchos::reduceAll<int, double>(*teuchosComm,Teuchos::REDUCE_MIN,count,&times[0], &minTimes[0]);
-  Teuchos::reduceAll<int, double>(*teuchosComm,Teuchos::REDUCE_MAX,count,&times[0], &maxTimes[0]);
-  Teuchos::reduceAll<int, double>(*teuchosComm,Teuchos::REDUCE_SUM,count,&times[0], &totalTimes[0]);
+  int nProc = teuchosComm->getSize();
+  int myPID = teuchosComm->getRank();
+
+  // Order the nodes by path so that the reductions line up across processors
+  int count = (int)( nodes.size() ) - 1;
+  vector< pair<string, int> > paths(count);
+  for(int i=0 ; i<count ; ++i)
+    paths[i] = make_pair(nodePath(i+1), i+1);
+  sort(paths.begin(), paths.end());
+  vector<int> order(count);
+  vector<int> sortedIndex(nodes.size(), -1);
+  for(int i=0 ; i<count ; ++i){
+    order[i] = paths[i].second;
+    sortedIndex[order[i]] = i;
+  }
+
+  vector<double> times(count), calls(count);
+  for(int i=0 ; i<count ; ++i){
+    times[i] = nodes[order[i]].elapsedTime;
+    calls[i] = nodes[order[i]].numCalls;
+  }
+
+  vector<double> minTimes(times), maxTimes(times), totalTimes(times), maxCalls(calls), maxRanks(count, 0.0);
+
+  // The call trees are consistent if every processor has the same set of paths; compare the number of paths
+  // and a hash of the sorted paths, along with the number of time series samples
+  int numSamples = (int)( samples.size() );
+  int signature[3] = {count, pathHash(paths), numSamples};
+  int minSignature[3], maxSignature[3];
+  Teuchos::reduceAll<int, int>(*teuchosComm, Teuchos::REDUCE_MIN, 3, signature, minSignature);
+  Teuchos::reduceAll<int, int>(*teuchosComm, Teuchos::REDUCE_MAX, 3, signature, maxSignature);
+  bool consistent = (minSignature[0] == maxSignature[0] && minSignature[1] == maxSignature[1]);
+  bool consistentSamples = (minSignature[2] == maxSignature[2]);
+  if(!consistent){
+    if(myPID == 0)
+      out << "Warning:  The timer call trees differ across processors, reporting timing data for processor 0 only.\n" << endl;
+    nProc = 1;
+  }
+  else if(count > 0){
+    Teuchos::reduceAll<int, double>(*teuchosComm,Teuchos::REDUCE_MIN,count,&times[0], &minTimes[0]);
+    Teuchos::reduceAll<int, double>(*teuchosComm,Teuchos::REDUCE_MAX,count,&times[0], &maxTimes[0]);
+    Teuchos::reduceAll<int, double>(*teuchosComm,Teuchos::REDUCE_SUM,count,&times[0], &totalTimes[0]);
+    Teuchos::reduceAll<int, double>(*teuchosComm,Teuchos::REDUCE_MAX,count,&calls[0], &maxCalls[0]);
+    // Identify the slowest processor for each timer
+    vector<double> candidateRanks(count);
+    for(int i=0 ; i<count ; ++i)
+      candidateRanks[i] = (times[i] == maxTimes[i]) ? myPID : nProc;
+    Teuchos::reduceAll<int, double>(*teuchosComm,Teuchos::REDUCE_MIN,count,&candidateRanks[0], &maxRanks[0]);
+  }
+
+  // Per-step time series, stored as the time spent in each node between consecutive samples
+  // The conditions below are identical on all processors, so either all or none of them take part in the reductions
+  vector<double> seriesMax, seriesTotal;
+  if(!jsonFilename.empty() && numSamples > 0){
+    vector<double> series(numSamples*count, 0.0);
+    for(int s=0 ; s<numSamples ; ++s){
+      for(int i=0 ; i<count ; ++i){
+        unsigned int node = order[i];
+        double current = node < samples[s].size() ? samples[s][node] : 0.0;
+        double previous = (s > 0 && node < samples[s-1].size()) ? samples[s-1][node] : 0.0;
+        series[s*count + i] = current - previous;
+      }
+    }
+    seriesMax = series;
+    seriesTotal = series;
+    if(consistent && consistentSamples && series.size() > 0){
+      Teuchos::reduceAll<int, double>(*teuchosComm,Teuchos::REDUCE_MAX,(int)series.size(),&series[0], &seriesMax[0]);
+      Teuchos::reduceAll<int, double>(*teuchosComm,Teuchos::REDUCE_SUM,(int)series.size(),&series[0], &seriesTotal[0]);
+    }
+  }
+
+  if(myPID != 0)
+    return;
+
+  if(!jsonFilename.empty())
+    writeJSON(order, minTimes, maxTimes, totalTimes, maxRanks, maxCalls, seriesMax, seriesTotal, nProc);
+
+  // Depth-first traversal of the call tree
+  vector<int> traversal, depth;
+  vector< pair<int, int> > stack;
+  for(int i=(int)(nodes[0].children.size())-1 ; i>=0 ; --i)
+    stack.push_back(make_pair(nodes[0].children[i], 0));
+  while(!stack.empty()){
+    pair<int, int> entry = stack.back();
+    stack.pop_back();
+    traversal.push_back(entry.first);
+    depth.push_back(entry.second);
+    const vector<int>& children = nodes[entry.first].children;
+    for(int i=(int)(children.size())-1 ; i>=0 ; --i)
+      stack.push_back(make_pair(children[i], entry.second + 1));
+  }
 
   unsigned int nameLength = 0;
-  for(unsigned int i=0 ; i<names.size() ; ++i)
-    if(names[i].size() > nameLength) nameLength = names[i].size();
+  for(unsigned int i=0 ; i<traversal.size() ; ++i){
+    unsigned int length = names[nodes[traversal[i]].timerId].size() + 2*depth[i];
+    if(length > nameLength) nameLength = length;
+  }
 
   int indent = 15;
-  int nProc = teuchosComm->getSize();
 
-  if(nProc > 1 && teuchosComm->getRank() == 0){
+  if(nProc > 1){
     out << "Wallclock Time (seconds):" << endl;
     out << "  ";
     out.width(nameLength + 17); out << "Min";
     out.width(indent); out << right << "Max";
     out.width(indent); out << right << "Ave";
+    out.width(indent); out << right << "Imbalance";
+    out.width(indent); out << right << "Max Rank";
     out << endl;
     out.precision(2);
-    for(unsigned int i=0 ; i<names.size() ; ++i){
+    for(unsigned int i=0 ; i<traversal.size() ; ++i){
+      int index = sortedIndex[traversal[i]];
+      double ave = totalTimes[index]/nProc;
+      double imbalance = ave > 0.0 ? maxTimes[index]/ave : 1.0;
       out << "  ";
-      out.width(nameLength + 2); out << left << names[i];
-      out.width(indent); out << right << minTimes[i];
-      out.width(indent); out << right << maxTimes[i];
-      out.width(indent); out << right << totalTimes[i]/nProc;
+      out.width(nameLength + 2); out << left << string(2*depth[i], ' ') + names[nodes[traversal[i]].timerId];
+      out.width(indent); out << right << minTimes[index];
+      out.width(indent); out << right << maxTimes[index];
+      out.width(indent); out << right << ave;
+      out.width(indent); out << right << imbalance;
+      out.width(indent); out << right << (int)(maxRanks[index]);
       out << endl;
     }
     out << endl;
@@ -64,12 +254,74 @@ void PeridigmNS::Timer::printTimingData(ostream &out){
   else if(nProc == 1){
     out << "Wallclock Time (seconds):" << endl;
     out.precision(2);
-    for(unsigned int i=0 ; i<names.size() ; ++i){
+    for(unsigned int i=0 ; i<traversal.size() ; ++i){
+      int index = sortedIndex[traversal[i]];
       out << "  ";
-      out.width(nameLength + 2); out << left << names[i];
-      out.width(indent); out << right << minTimes[i];
+      out.width(nameLength + 2); out << left << string(2*depth[i], ' ') + names[nodes[traversal[i]].timerId];
+      out.width(indent); out << right << minTimes[index];
       out << endl;
     }
     out << endl;
   }
 }
+
+void PeridigmNS::Timer::writeJSON(const vector<int>& order,
+                                  const vector<double>& minTimes,
+                                  const vector<double>& maxTimes,
+                                  const vector<double>& totalTimes,
+                                  const vector<double>& maxRanks,
+                                  const vector<double>& maxCalls,
+                                  const vector<double>& seriesMax,
+                                  const vector<double>& seriesTotal,
+                                  int nProc) {
+
+  ofstream json(jsonFilename.c_str());
+  if(!json.is_open()){
+    cout << "Warning:  Unable to open timing data file " << jsonFilename << endl;
+    return;
+  }
+  json.precision(9);
+
+  int count = (int)( order.size() );
+  json << "{\n";
+  json << "  \"num_processors\": " << nProc << ",\n";
+  json << "  \"timers\": [\n";
+  for(int i=0 ; i<count ; ++i){
+    const Node& node = nodes[order[i]];
+    double ave = totalTimes[i]/nProc;
+    json << "    {\"name\": \"" << names[node.timerId] << "\""
+         << ", \"path\": \"" << nodePath(order[i]) << "\""
+         << ", \"calls\": " << (int)(maxCalls[i])
+         << ", \"min\": " << minTimes[i]
+         << ", \"max\": " << maxTimes[i]
+         << ", \"mean\": " << ave
+         << ", \"imbalance\": " << (ave > 0.0 ? maxTimes[i]/ave : 1.0)
+         << ", \"max_rank\": " << (int)(maxRanks[i]) << "}";
+    json << (i < count-1 ? ",\n" : "\n");
+  }
+  json << "  ]";
+
+  int numSamples = (int)( sampleSteps.size() );
+  if(numSamples > 0 && (int)(seriesMax.size()) == numSamples*count){
+    json << ",\n  \"time_series\": {\n";
+    json << "    \"steps\": [";
+    for(int s=0 ; s<numSamples ; ++s)
+      json << (s > 0 ? ", " : "") << sampleSteps[s];
+    json << "],\n";
+    json << "    \"timers\": [\n";
+    for(int i=0 ; i<count ; ++i){
+      json << "      {\"path\": \"" << nodePath(order[i]) << "\", \"max\": [";
+      for(int s=0 ; s<numSamples ; ++s)
+        json << (s > 0 ? ", " : "") << seriesMax[s*count + i];
+      json << "], \"mean\": [";
+      for(int s=0 ; s<numSamples ; ++s)
+        json << (s > 0 ? ", " : "") << seriesTotal[s*count + i]/nProc;
+      json << "]}";
+      json << (i < count-1 ? ",\n" : "\n");
+    }
+    json << "    ]\n";
+    json << "  }";
+  }
+  json << "\n}\n";
+  json.close();
+}
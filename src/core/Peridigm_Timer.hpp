@@ -59,10 +59,22 @@ typedef int MPI_Comm;
 
 #include <Epetra_Time.h>
 #include <ostream>
+#include <string>
+#include <vector>
+#include <map>
 
 namespace PeridigmNS {
 
-//! Singleton class for performance monitoring; manages a set of TimeKeeper objects.
+//! Singleton class for performance monitoring; manages a tree of nested timers.
+/*!
+ *  Timers are identified either by name or by a handle obtained from getTimerId(); the
+ *  handle avoids a string lookup in performance-critical loops.  A timer that is started
+ *  while other timers are running is nested under the most recently started one, so the
+ *  same timer may appear in several places in the call tree.  The report gives the
+ *  min/max/mean over processors for each node of the tree along with the load imbalance
+ *  (max/mean) and the rank of the slowest processor.  All processors must start the same
+ *  set of timers in the same nesting for the report to be consistent.
+ */
 class Timer {
 
 public:
@@ -73,14 +85,32 @@ public:
   //! Singleton.
   static Timer& self();
 
+  //! Returns a handle for the specified timer, creates the timer if it does not exist.
+  int getTimerId(const std::string& name);
+
   //! Starts specified timer, creates the timer if it does not exist.
-  void startTimer(const std::string& name) { timers[name].start(); }
+  void startTimer(const std::string& name) { startTimer(getTimerId(name)); }
 
   //! Stops specified timer.
-  void stopTimer(const std::string& name) { timers[name].stop(); }
+  void stopTimer(const std::string& name) { stopTimer(getTimerId(name)); }
+
+  //! Starts the timer with the given handle.
+  void startTimer(int timerId);
+
+  //! Stops the timer with the given handle.
+  void stopTimer(int timerId);
+
+  //! Query specified timer for elasped time, summed over all of the places it appears in the call tree.
+  double elapsedTime(const std::string& name);
+
+  //! Write the timing data in JSON format to the given file when printTimingData() is called.
+  void setJSONFilename(const std::string& filename) { jsonFilename = filename; }
+
+  //! Record a time series of the per-step timings every frequency calls to markStep(); zero disables the time series.
+  void setTimeSeriesFrequency(int frequency) { timeSeriesFrequency = frequency; }
 
-  //! Query specified timer for elasped time.
-  double elapsedTime(const std::string& name) { return timers[name].getElapsedTime(); }
+  //! Marks the end of a step for the time series.
+  void markStep();
 
   //! Prints out a table of timing data.
   void printTimingData(std::ostream &out);
@@ -88,7 +118,9 @@ public:
 private:
 
   //! Private constructor
-  Timer(){}
+  Timer() : timeSeriesFrequency(0), stepCount(0) {
+    nodes.push_back(Node(-1, -1));
+  }
 
   //! @name Private and unimplemented to prevent use
   //@{
@@ -96,39 +128,72 @@ private:
   Timer& operator=(const Timer&);
   //@}  
 
-  //! Time keeper class, operates like a stopwatch.
-  class TimeKeeper {
+  //! Node in the call tree.
+  struct Node {
+    Node(int timerId_, int parent_) : timerId(timerId_), parent(parent_), elapsedTime(0.0), numCalls(0) {}
+    int timerId;
+    int parent;
+    std::vector<int> children;
+    double elapsedTime;
+    int numCalls;
+  };
 
-  public:
+  //! Timer that is currently running.
+  struct ActiveTimer {
+    int timerId;
+    int node;
+    double startTime;
+  };
 
-    TimeKeeper() : elapsedTime(0.0) {
-#ifdef HAVE_MPI
-      epetraTime = Teuchos::rcp(new Epetra_Time(Epetra_MpiComm(MPI_COMM_WORLD)));
-#else
-      epetraTime = Teuchos::rcp(new Epetra_Time(Epetra_SerialComm()));
-#endif
-    }
+  //! Returns the wall clock time.
+  double wallTime();
 
-    void start() {
-      epetraTime->ResetStartTime();
-    }
+  //! Returns the full path of a node in the call tree, e.g., "Total > Internal Force".
+  std::string nodePath(int node) const;
 
-    void stop() {
-      elapsedTime += epetraTime->ElapsedTime();
-    }
+  //! Returns a hash of the sorted paths of the call tree, used to check that the call trees match across processors.
+  int pathHash(const std::vector< std::pair<std::string, int> >& paths) const;
 
-    //! Returns the cummulative elapsed time.
-    double getElapsedTime() const { return elapsedTime; }
+  //! Writes the timing data in JSON format.
+  void writeJSON(const std::vector<int>& order,
+                 const std::vector<double>& minTimes,
+                 const std::vector<double>& maxTimes,
+                 const std::vector<double>& totalTimes,
+                 const std::vector<double>& maxRanks,
+                 const std::vector<double>& maxCalls,
+                 const std::vector<double>& seriesMax,
+                 const std::vector<double>& seriesTotal,
+                 int nProc);
 
-  private:
-    Teuchos::RCP<Epetra_Time> epetraTime;
-    double elapsedTime;
-  };
+  //! Clock shared by all timers.
+  Teuchos::RCP<Epetra_Time> clock;
+
+  //! Timer names, indexed by handle.
+  std::vector<std::string> names;
+
+  //! Map that associates a name with a handle.
+  std::map<std::string, int> timerIds;
+
+  //! Call tree; node zero is the root.
+  std::vector<Node> nodes;
+
+  //! Stack of running timers.
+  std::vector<ActiveTimer> activeTimers;
+
+  //! JSON output file, if any.
+  std::string jsonFilename;
+
+  //! Time series sampling frequency.
+  int timeSeriesFrequency;
+
+  //! Number of calls to markStep().
+  int stepCount;
 
-protected:
+  //! Steps at which the time series was sampled.
+  std::vector<int> sampleSteps;
 
-  //! Map that associates a name with a TimeKeeper.
-  std::map<std::string, TimeKeeper> timers;
+  //! Cumulative elapsed time of each node at each sample.
+  std::vector< std::vector<double> > samples;
 };
 
 }
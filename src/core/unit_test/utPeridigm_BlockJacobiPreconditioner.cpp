@@ -0,0 +1,148 @@
+/*! \file utPeridigm_BlockJacobiPreconditioner.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include "Peridigm_BlockJacobiPreconditioner.hpp"
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_UnitTestRepository.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include <Epetra_SerialComm.h>
+#include <Epetra_Map.h>
+#include <Epetra_CrsMatrix.h>
+#include <Epetra_MultiVector.h>
+#include <vector>
+#include <cmath>
+
+using namespace std;
+using namespace PeridigmNS;
+using namespace Teuchos;
+
+const int numPoints = 6;
+
+//! Entry of the tangent; the blocks are nonsymmetric, and the diagonal blocks are diagonally dominant.
+double tangentValue(int globalRow, int globalCol, int blockSize)
+{
+  if(globalRow == globalCol)
+    return 10.0 + globalRow;
+  double value = 0.1*(globalRow%blockSize) - 0.05*(globalCol%blockSize) + 0.01*(globalRow/blockSize) + 0.02*(globalCol/blockSize);
+  return globalRow/blockSize == globalCol/blockSize ? 1.0 + value : value;
+}
+
+//! Tangent with blockSize consecutive rows for each point, which is coupled to the points within the given bandwidth on a line.
+RCP<Epetra_CrsMatrix> createTangent(const Epetra_Comm& comm, int blockSize, int bandwidth)
+{
+  Epetra_Map rowMap(blockSize*numPoints, 0, comm);
+  RCP<Epetra_CrsMatrix> tangent = rcp(new Epetra_CrsMatrix(Copy, rowMap, 0));
+  for(int localRow=0 ; localRow<rowMap.NumMyElements() ; ++localRow){
+    int globalRow = rowMap.GID(localRow);
+    int point = globalRow/blockSize;
+    vector<int> columns;
+    vector<double> values;
+    for(int neighbor=point-bandwidth ; neighbor<=point+bandwidth ; ++neighbor){
+      if(neighbor >= 0 && neighbor < numPoints){
+        for(int dof=0 ; dof<blockSize ; ++dof){
+          columns.push_back(blockSize*neighbor + dof);
+          values.push_back(tangentValue(globalRow, columns.back(), blockSize));
+        }
+      }
+    }
+    tangent->InsertGlobalValues(globalRow, static_cast<int>(columns.size()), &values[0], &columns[0]);
+  }
+  tangent->FillComplete();
+  return tangent;
+}
+
+//! Sets the entries of a multivector laid out as the tangent.
+void setValues(Epetra_MultiVector& x)
+{
+  for(int v=0 ; v<x.NumVectors() ; ++v){
+    for(int i=0 ; i<x.MyLength() ; ++i)
+      x[v][i] = 1.0 + 0.3*i - 0.7*v + 0.01*i*i;
+  }
+}
+
+//! Returns the largest difference between the entries of two multivectors with the same layout.
+double maxDifference(const Epetra_MultiVector& a, const Epetra_MultiVector& b)
+{
+  double maxDiff(0.0);
+  for(int v=0 ; v<a.NumVectors() ; ++v){
+    for(int i=0 ; i<a.MyLength() ; ++i)
+      maxDiff = max(maxDiff, fabs(a[v][i] - b[v][i]));
+  }
+  return maxDiff;
+}
+
+TEUCHOS_UNIT_TEST(BlockJacobiPreconditioner, ApplyInverse) {
+
+  Epetra_SerialComm comm;
+
+  for(int blockSize=3 ; blockSize<=4 ; ++blockSize){
+
+    // for a block-diagonal tangent, the preconditioner is the exact inverse
+    RCP<Epetra_CrsMatrix> tangent = createTangent(comm, blockSize, 0);
+    BlockJacobiPreconditioner preconditioner(tangent, blockSize);
+    TEST_EQUALITY(preconditioner.compute(), 0);
+
+    Epetra_MultiVector x(tangent->OperatorDomainMap(), 2);
+    Epetra_MultiVector y(tangent->OperatorRangeMap(), 2);
+    Epetra_MultiVector tangentTimesY(tangent->OperatorRangeMap(), 2);
+    setValues(x);
+
+    TEST_EQUALITY(preconditioner.ApplyInverse(x, y), 0);
+    TEST_EQUALITY(tangent->Multiply(false, y, tangentTimesY), 0);
+    TEST_ASSERT(maxDifference(tangentTimesY, x) < 1.0e-10);
+
+    // the input and output may be the same vector
+    TEST_EQUALITY(preconditioner.ApplyInverse(x, x), 0);
+    TEST_ASSERT(maxDifference(x, y) < 1.0e-10);
+  }
+}
+
+int main( int argc, char* argv[] ) {
+
+    Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+    return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
@@ -0,0 +1,355 @@
+/*! \file utPeridigm_DataManager.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <Epetra_ConfigDefs.h> // used to define HAVE_MPI
+#include "Peridigm_DataManager.hpp"
+#include "Peridigm_Field.hpp"
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_UnitTestRepository.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#include <Epetra_SerialComm.h>
+#ifdef HAVE_MPI
+  #include <Epetra_MpiComm.h>
+#endif
+
+using namespace std;
+using namespace PeridigmNS;
+using namespace Teuchos;
+
+const int numGlobalPoints = 6;
+
+//! Number of bonds of each point.
+int numBonds(int globalId) { return globalId%3 + 1; }
+
+//! Values stored for bond j of each point in the bit-packed, single precision, and double precision fields.
+double flagValue(int globalId, int j) { return (globalId + j)%2 == 0 ? 1.0 : 0.0; }
+double floatValue(int globalId, int j) { return 0.1*globalId + 0.01*j; }
+double doubleValue(int globalId, int j) { return 0.3*globalId + j; }
+
+RCP<Epetra_Comm> getComm() {
+#ifdef HAVE_MPI
+  return rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+#else
+  return rcp(new Epetra_SerialComm);
+#endif
+}
+
+//! Field ids of the test fields; Bond_Flag and Bond_Float have compact storage.
+struct FieldIds {
+  FieldIds() {
+    FieldManager& fm = FieldManager::self();
+    volume = fm.getFieldId(PeridigmField::ELEMENT, PeridigmField::SCALAR, PeridigmField::CONSTANT, "Volume");
+    modelCoordinates = fm.getFieldId(PeridigmField::NODE, PeridigmField::VECTOR, PeridigmField::CONSTANT, "Model_Coordinates");
+    coordinates = fm.getFieldId(PeridigmField::NODE, PeridigmField::VECTOR, PeridigmField::TWO_STEP, "Coordinates");
+    flag = fm.getFieldId(PeridigmField::BOND, PeridigmField::SCALAR, PeridigmField::TWO_STEP, "Bond_Flag");
+    single = fm.getFieldId(PeridigmField::BOND, PeridigmField::SCALAR, PeridigmField::TWO_STEP, "Bond_Float");
+    full = fm.getFieldId(PeridigmField::BOND, PeridigmField::SCALAR, PeridigmField::TWO_STEP, "Bond_Double");
+    fm.setBondStorage(flag, PeridigmField::BIT_STORAGE);
+    fm.setBondStorage(single, PeridigmField::FLOAT_STORAGE);
+  }
+  vector<int> all() const {
+    vector<int> ids;
+    ids.push_back(volume);
+    ids.push_back(modelCoordinates);
+    ids.push_back(coordinates);
+    ids.push_back(flag);
+    ids.push_back(single);
+    ids.push_back(full);
+    return ids;
+  }
+  int volume, modelCoordinates, coordinates, flag, single, full;
+};
+
+//! Scalar, vector, and bond maps for the given points, without ghosts.
+struct Maps {
+  Maps(const Epetra_Comm& comm, const vector<int>& globalIds) {
+    int numMyPoints = static_cast<int>(globalIds.size());
+    vector<int> bondElementSizes(numMyPoints);
+    for(int i=0 ; i<numMyPoints ; ++i)
+      bondElementSizes[i] = numBonds(globalIds[i]);
+    const int* ids = numMyPoints > 0 ? &globalIds[0] : 0;
+    const int* sizes = numMyPoints > 0 ? &bondElementSizes[0] : 0;
+    scalarMap = rcp(new Epetra_BlockMap(-1, numMyPoints, ids, 1, 0, comm));
+    vectorMap = rcp(new Epetra_BlockMap(-1, numMyPoints, ids, 3, 0, comm));
+    bondMap = rcp(new Epetra_BlockMap(-1, numMyPoints, ids, sizes, 0, comm));
+  }
+  RCP<const Epetra_BlockMap> scalarMap, vectorMap, bondMap;
+};
+
+//! Creates a data manager that owns the given points, without ghosts.
+RCP<DataManager> createDataManager(const Epetra_Comm& comm, const vector<int>& globalIds, const FieldIds& fieldIds)
+{
+  Maps maps(comm, globalIds);
+  RCP<DataManager> dataManager = rcp(new DataManager);
+  dataManager->setMaps(maps.scalarMap, maps.scalarMap, maps.vectorMap, maps.vectorMap, maps.bondMap);
+  dataManager->allocateData(fieldIds.all());
+  return dataManager;
+}
+
+//! Sets the STEP_NP1 values of the bond fields.
+void setBondData(DataManager& dataManager, const FieldIds& fieldIds)
+{
+  const Epetra_BlockMap& bondMap = dataManager.getData(fieldIds.flag, PeridigmField::STEP_NP1)->Map();
+  Epetra_Vector& flag = *dataManager.getData(fieldIds.flag, PeridigmField::STEP_NP1);
+  Epetra_Vector& single = *dataManager.getData(fieldIds.single, PeridigmField::STEP_NP1);
+  Epetra_Vector& full = *dataManager.getData(fieldIds.full, PeridigmField::STEP_NP1);
+  for(int i=0 ; i<bondMap.NumMyElements() ; ++i){
+    int globalId = bondMap.GID(i);
+    for(int j=0 ; j<bondMap.ElementSize(i) ; ++j){
+      flag[bondMap.FirstPointInElement(i) + j] = flagValue(globalId, j);
+      single[bondMap.FirstPointInElement(i) + j] = floatValue(globalId, j);
+      full[bondMap.FirstPointInElement(i) + j] = doubleValue(globalId, j);
+    }
+  }
+}
+
+//! Checks the STEP_N values of the bond fields against the values set by setBondData().
+void checkStepN(DataManager& dataManager, const FieldIds& fieldIds, FancyOStream& out, bool& success)
+{
+  RCP<const CompactBondVector> flag = dataManager.getCompactData(fieldIds.flag);
+  RCP<const CompactBondVector> single = dataManager.getCompactData(fieldIds.single);
+  const Epetra_Vector& full = *dataManager.getData(fieldIds.full, PeridigmField::STEP_N);
+  const Epetra_BlockMap& bondMap = full.Map();
+  TEST_EQUALITY(flag->Length(), bondMap.NumMyPoints());
+  TEST_EQUALITY(single->Length(), bondMap.NumMyPoints());
+  for(int i=0 ; i<bondMap.NumMyElements() ; ++i){
+    int globalId = bondMap.GID(i);
+    TEST_EQUALITY(bondMap.ElementSize(i), numBonds(globalId));
+    for(int j=0 ; j<bondMap.ElementSize(i) ; ++j){
+      int bondIndex = bondMap.FirstPointInElement(i) + j;
+      TEST_EQUALITY((*flag)[bondIndex], flagValue(globalId, j));
+      TEST_FLOATING_EQUALITY((*single)[bondIndex], floatValue(globalId, j), 1.0e-7);
+      TEST_EQUALITY(full[bondIndex], doubleValue(globalId, j));
+    }
+  }
+}
+
+//! Points are initially owned round-robin; after the rebalance each point moves to the next processor, in reverse order.
+vector<int> initialGlobalIds(const Epetra_Comm& comm)
+{
+  vector<int> globalIds;
+  for(int g=0 ; g<numGlobalPoints ; ++g)
+    if(g%comm.NumProc() == comm.MyPID())
+      globalIds.push_back(g);
+  return globalIds;
+}
+
+vector<int> rebalancedGlobalIds(const Epetra_Comm& comm)
+{
+  vector<int> globalIds;
+  for(int g=numGlobalPoints-1 ; g>=0 ; --g)
+    if((g+1)%comm.NumProc() == comm.MyPID())
+      globalIds.push_back(g);
+  return globalIds;
+}
+
+TEUCHOS_UNIT_TEST(DataManager, CompactBondDataUpdateState) {
+
+  RCP<Epetra_Comm> comm = getComm();
+  FieldIds fieldIds;
+  RCP<DataManager> dataManager = createDataManager(*comm, initialGlobalIds(*comm), fieldIds);
+
+  TEST_ASSERT(dataManager->isCompactBondField(fieldIds.flag));
+  TEST_ASSERT(dataManager->isCompactBondField(fieldIds.single));
+  TEST_ASSERT(!dataManager->isCompactBondField(fieldIds.full));
+  TEST_ASSERT(!dataManager->isCompactBondField(fieldIds.coordinates));
+
+  // updateState() packs the STEP_NP1 values into the compact STEP_N storage
+  setBondData(*dataManager, fieldIds);
+  dataManager->updateState();
+  checkStepN(*dataManager, fieldIds, out, success);
+  TEST_ASSERT(!dataManager->hasData(fieldIds.flag, PeridigmField::STEP_N));
+  TEST_ASSERT(dataManager->hasData(fieldIds.flag, PeridigmField::STEP_NP1));
+  TEST_THROW(dataManager->getData(fieldIds.flag, PeridigmField::STEP_N), std::exception);
+
+  // copyStepNToStepNP1() restores the STEP_NP1 values for both compact and double storage
+  dataManager->getData(fieldIds.flag, PeridigmField::STEP_NP1)->PutScalar(0.0);
+  dataManager->getData(fieldIds.single, PeridigmField::STEP_NP1)->PutScalar(-1.0);
+  dataManager->getData(fieldIds.full, PeridigmField::STEP_NP1)->PutScalar(-1.0);
+  dataManager->copyStepNToStepNP1(fieldIds.flag);
+  dataManager->copyStepNToStepNP1(fieldIds.single);
+  dataManager->copyStepNToStepNP1(fieldIds.full);
+  dataManager->updateState();
+  checkStepN(*dataManager, fieldIds, out, success);
+
+  // the bit-packed storage accepts only zero and one
+  Epetra_Vector& flag = *dataManager->getData(fieldIds.flag, PeridigmField::STEP_NP1);
+  flag[0] = 0.5;
+  TEST_THROW(dataManager->updateState(), std::exception);
+}
+
+TEUCHOS_UNIT_TEST(DataManager, CompactBondDataRebalance) {
+
+  RCP<Epetra_Comm> comm = getComm();
+  FieldIds fieldIds;
+  RCP<DataManager> dataManager = createDataManager(*comm, initialGlobalIds(*comm), fieldIds);
+  setBondData(*dataManager, fieldIds);
+  dataManager->updateState();
+
+  // the compact STEP_N data follows the points to their new owners
+  Maps maps(*comm, rebalancedGlobalIds(*comm));
+  RCP<const Epetra_BlockMap> bondMap = maps.bondMap;
+  dataManager->rebalance(maps.scalarMap, maps.scalarMap, maps.vectorMap, maps.vectorMap, maps.bondMap);
+
+  TEST_ASSERT(dataManager->getData(fieldIds.full, PeridigmField::STEP_N)->Map().SameAs(*bondMap));
+  checkStepN(*dataManager, fieldIds, out, success);
+
+  // the STEP_NP1 values of the fields with compact storage are not swapped by updateState(), and are also redistributed
+  const Epetra_Vector& flag = *dataManager->getData(fieldIds.flag, PeridigmField::STEP_NP1);
+  const Epetra_Vector& single = *dataManager->getData(fieldIds.single, PeridigmField::STEP_NP1);
+  TEST_ASSERT(flag.Map().SameAs(*bondMap));
+  for(int i=0 ; i<bondMap->NumMyElements() ; ++i){
+    for(int j=0 ; j<bondMap->ElementSize(i) ; ++j){
+      TEST_EQUALITY(flag[bondMap->FirstPointInElement(i) + j], flagValue(bondMap->GID(i), j));
+      TEST_EQUALITY(single[bondMap->FirstPointInElement(i) + j], floatValue(bondMap->GID(i), j));
+    }
+  }
+}
+
+TEUCHOS_UNIT_TEST(DataManager, CompactBondDataCopyLocallyOwnedData) {
+
+  RCP<Epetra_Comm> comm = getComm();
+  FieldIds fieldIds;
+  vector<int> globalIds = initialGlobalIds(*comm);
+  RCP<DataManager> dataManager = createDataManager(*comm, globalIds, fieldIds);
+  setBondData(*dataManager, fieldIds);
+  dataManager->updateState();
+
+  // copy the last locally-owned point into a data manager with a single point, as for the finite-difference Jacobian
+  Epetra_SerialComm serialComm;
+  vector<int> singlePoint(1, globalIds.back());
+  RCP<DataManager> target = createDataManager(serialComm, singlePoint, fieldIds);
+  target->copyLocallyOwnedDataFromDataManager(*dataManager);
+  checkStepN(*target, fieldIds, out, success);
+}
+
+//! Value of component k of point globalId in the vector fields.
+double vectorValue(int globalId, int k) { return 10.0*globalId + k; }
+
+//! Sets the values of a vector field from vectorValue() plus the given offset.
+void setVectorData(Epetra_Vector& data, double offset)
+{
+  const Epetra_BlockMap& map = data.Map();
+  for(int i=0 ; i<map.NumMyElements() ; ++i)
+    for(int k=0 ; k<3 ; ++k)
+      data[3*i+k] = vectorValue(map.GID(i), k) + offset;
+}
+
+//! Checks structure-of-arrays data against the given vector map and the values set by setVectorData().
+void checkSoAData(const SoAVectorData& data, const Epetra_BlockMap& map, double offset, FancyOStream& out, bool& success)
+{
+  TEST_EQUALITY(data.Length(), map.NumMyElements());
+  for(int i=0 ; i<map.NumMyElements() ; ++i){
+    TEST_EQUALITY(data.X()[i], vectorValue(map.GID(i), 0) + offset);
+    TEST_EQUALITY(data.Y()[i], vectorValue(map.GID(i), 1) + offset);
+    TEST_EQUALITY(data.Z()[i], vectorValue(map.GID(i), 2) + offset);
+  }
+}
+
+TEUCHOS_UNIT_TEST(DataManager, SoAData) {
+
+  RCP<Epetra_Comm> comm = getComm();
+  FieldIds fieldIds;
+  RCP<DataManager> dataManager = createDataManager(*comm, initialGlobalIds(*comm), fieldIds);
+  Epetra_Vector& modelCoordinates = *dataManager->getData(fieldIds.modelCoordinates, PeridigmField::STEP_NONE);
+  Epetra_Vector& coordinates = *dataManager->getData(fieldIds.coordinates, PeridigmField::STEP_NP1);
+  setVectorData(modelCoordinates, 0.0);
+  setVectorData(coordinates, 0.5);
+
+  TEST_THROW(dataManager->getSoAData(fieldIds.volume, PeridigmField::STEP_NONE), std::exception);
+  TEST_THROW(dataManager->scatterSoAData(fieldIds.coordinates, PeridigmField::STEP_N), std::exception);
+
+  // STEP_NONE data is copied once and then reused, other steps are copied on each call
+  RCP<SoAVectorData> x = dataManager->getSoAData(fieldIds.modelCoordinates, PeridigmField::STEP_NONE);
+  RCP<SoAVectorData> y = dataManager->getSoAData(fieldIds.coordinates, PeridigmField::STEP_NP1);
+  checkSoAData(*x, modelCoordinates.Map(), 0.0, out, success);
+  checkSoAData(*y, coordinates.Map(), 0.5, out, success);
+  setVectorData(modelCoordinates, 1.0);
+  setVectorData(coordinates, 1.5);
+  TEST_EQUALITY(dataManager->getSoAData(fieldIds.modelCoordinates, PeridigmField::STEP_NONE).get(), x.get());
+  TEST_EQUALITY(dataManager->getSoAData(fieldIds.coordinates, PeridigmField::STEP_NP1).get(), y.get());
+  checkSoAData(*x, modelCoordinates.Map(), 0.0, out, success);
+  checkSoAData(*y, coordinates.Map(), 1.5, out, success);
+
+  // without copyValues the data is only sized, and scatterSoAData() writes it back in full
+  RCP<SoAVectorData> force = dataManager->getSoAData(fieldIds.coordinates, PeridigmField::STEP_N, false);
+  TEST_EQUALITY(force->Length(), coordinates.Map().NumMyElements());
+  force->PutScalar(0.0);
+  for(int i=0 ; i<force->Length() ; ++i){
+    force->X()[i] = vectorValue(coordinates.Map().GID(i), 0) + 2.0;
+    force->Y()[i] = vectorValue(coordinates.Map().GID(i), 1) + 2.0;
+    force->Z()[i] = vectorValue(coordinates.Map().GID(i), 2) + 2.0;
+  }
+  dataManager->scatterSoAData(fieldIds.coordinates, PeridigmField::STEP_N);
+  checkSoAData(*dataManager->getSoAData(fieldIds.coordinates, PeridigmField::STEP_N), coordinates.Map(), 2.0, out, success);
+
+  // a rebalance that changes the number of points on each processor, here by dropping the last point of each processor,
+  // invalidates the structure-of-arrays data until it is requested again
+  vector<int> globalIds;
+  vector<int> rebalancedIds = rebalancedGlobalIds(*comm);
+  for(unsigned int i=0 ; i<rebalancedIds.size() ; ++i)
+    if(rebalancedIds[i] < numGlobalPoints - comm->NumProc())
+      globalIds.push_back(rebalancedIds[i]);
+  Maps maps(*comm, globalIds);
+  dataManager->rebalance(maps.scalarMap, maps.scalarMap, maps.vectorMap, maps.vectorMap, maps.bondMap);
+  TEST_EQUALITY(dataManager->getRebalanceCount(), 1);
+  TEST_THROW(dataManager->scatterSoAData(fieldIds.coordinates, PeridigmField::STEP_NP1), std::exception);
+
+  const Epetra_BlockMap& rebalancedMap = *dataManager->getOwnedVectorPointMap();
+  checkSoAData(*dataManager->getSoAData(fieldIds.modelCoordinates, PeridigmField::STEP_NONE), rebalancedMap, 1.0, out, success);
+  checkSoAData(*dataManager->getSoAData(fieldIds.coordinates, PeridigmField::STEP_NP1), rebalancedMap, 1.5, out, success);
+  dataManager->scatterSoAData(fieldIds.coordinates, PeridigmField::STEP_NP1);
+}
+
+int main( int argc, char* argv[] ) {
+
+    Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+    return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
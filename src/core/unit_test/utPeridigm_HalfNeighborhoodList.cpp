@@ -0,0 +1,177 @@
+/*! \file utPeridigm_HalfNeighborhoodList.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include "Peridigm_HalfNeighborhoodList.hpp"
+#include "elastic_bond_based.h"
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_UnitTestRepository.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include <vector>
+#include <set>
+#include <cmath>
+
+using namespace std;
+using namespace PeridigmNS;
+using namespace Teuchos;
+
+//! Three owned points (local ids 0, 1, 2) and two ghosted points (local ids 3, 4).
+//! Point 0 lists point 2 as a neighbor, but point 2 does not list point 0, so that pair is not symmetric.
+void setUpNeighborhood(vector<int>& neighborhoodList,
+                       vector<double>& x,
+                       vector<double>& y,
+                       vector<double>& volume,
+                       vector<double>& bondDamage)
+{
+  int list[] = {4, 1, 2, 3, 4,
+                3, 0, 2, 3,
+                3, 1, 4, 3};
+  neighborhoodList.assign(list, list + 13);
+
+  double coordinates[] = {0.0, 0.0, 0.0,
+                          1.0, 0.1, 0.0,
+                          0.2, 1.1, 0.1,
+                          1.2, 1.0, 0.3,
+                          -0.1, 0.4, 1.0};
+  x.assign(coordinates, coordinates + 15);
+  y.resize(15);
+  for(int i=0 ; i<15 ; ++i)
+    y[i] = x[i]*(1.0 + 0.01*(i%4)) + 0.002*i;
+
+  double volumes[] = {1.0, 1.1, 0.9, 1.2, 0.8};
+  volume.assign(volumes, volumes + 5);
+
+  // the damage on a bond and on its reverse bond differ
+  double damage[] = {0.1, 0.0, 0.3, 0.5,
+                     0.2, 0.0, 0.6,
+                     0.4, 0.0, 0.7};
+  bondDamage.assign(damage, damage + 10);
+}
+
+TEUCHOS_UNIT_TEST(HalfNeighborhoodList, Construction) {
+
+  vector<int> neighborhoodList;
+  vector<double> x, y, volume, bondDamage;
+  setUpNeighborhood(neighborhoodList, x, y, volume, bondDamage);
+
+  HalfNeighborhoodList halfList;
+  halfList.update(3, 0, &neighborhoodList[0], 1);
+
+  // bonds in the full list:  0-1, 0-2, 0-3, 0-4, 1-0, 1-2, 1-3, 2-1, 2-4, 2-3
+  // the symmetric pairs 0-1 and 1-2 are stored once, by the point with the lower index
+  // the bond 0-2 has no reverse bond, and the bonds to ghosted points are always kept
+  TEST_EQUALITY(halfList.NumBonds(), 8);
+  const int* half = halfList.NeighborhoodList();
+  const int* bondIndices = halfList.BondIndices();
+  const int* reverseBondIndices = halfList.ReverseBondIndices();
+
+  int expectedList[] = {4, 1, 2, 3, 4,
+                        2, 2, 3,
+                        2, 4, 3};
+  for(int i=0 ; i<11 ; ++i)
+    TEST_EQUALITY(half[i], expectedList[i]);
+  int expectedBondIndices[] = {0, 1, 2, 3, 5, 6, 8, 9};
+  int expectedReverseBondIndices[] = {4, -1, -1, -1, 7, -1, -1, -1};
+  for(int i=0 ; i<8 ; ++i){
+    TEST_EQUALITY(bondIndices[i], expectedBondIndices[i]);
+    TEST_EQUALITY(reverseBondIndices[i], expectedReverseBondIndices[i]);
+  }
+
+  // the half list is reused while the version of the full list is unchanged
+  neighborhoodList[1] = 3;
+  neighborhoodList[2] = 4;
+  neighborhoodList[3] = 1;
+  neighborhoodList[4] = 2;
+  halfList.update(3, 0, &neighborhoodList[0], 1);
+  TEST_EQUALITY(halfList.NeighborhoodList()[1], 1);
+
+  // the half list is rebuilt when the version changes, even if the new list is at the address of the old one
+  halfList.update(3, 0, &neighborhoodList[0], 2);
+  TEST_EQUALITY(halfList.NumBonds(), 8);
+  TEST_EQUALITY(halfList.NeighborhoodList()[1], 3);
+  TEST_EQUALITY(halfList.BondIndices()[2], 2);
+  TEST_EQUALITY(halfList.ReverseBondIndices()[2], 4);
+}
+
+TEUCHOS_UNIT_TEST(HalfNeighborhoodList, InternalForce) {
+
+  vector<int> neighborhoodList;
+  vector<double> x, y, volume, bondDamage;
+  setUpNeighborhood(neighborhoodList, x, y, volume, bondDamage);
+
+  double bulkModulus = 130.0e9;
+  double horizon = 1.75;
+
+  // forces on both the owned and the ghosted points are compared
+  vector<double> fullForce(15, 0.0), halfForce(15, 0.0);
+  MATERIAL_EVALUATION::computeInternalForceElasticBondBased(&x[0], &y[0], &volume[0], &bondDamage[0], &fullForce[0],
+                                                            &neighborhoodList[0], 3, bulkModulus, horizon);
+
+  HalfNeighborhoodList halfList;
+  halfList.update(3, 0, &neighborhoodList[0], 0);
+  MATERIAL_EVALUATION::computeInternalForceElasticBondBasedHalfList(&x[0], &y[0], &volume[0], &bondDamage[0], &halfForce[0],
+                                                                    halfList.NeighborhoodList(),
+                                                                    halfList.BondIndices(),
+                                                                    halfList.ReverseBondIndices(),
+                                                                    3, bulkModulus, horizon);
+
+  double maxForce(0.0);
+  for(int i=0 ; i<15 ; ++i)
+    maxForce = max(maxForce, fabs(fullForce[i]));
+  TEST_ASSERT(maxForce > 0.0);
+  for(int i=0 ; i<15 ; ++i)
+    TEST_ASSERT(fabs(halfForce[i] - fullForce[i]) <= 1.0e-12*maxForce);
+
+  // the forces on the ghosted points are nonzero, so the ghosted contributions are checked
+  TEST_ASSERT(fabs(fullForce[9]) + fabs(fullForce[10]) + fabs(fullForce[11]) > 0.0);
+  TEST_ASSERT(fabs(fullForce[12]) + fabs(fullForce[13]) + fabs(fullForce[14]) > 0.0);
+}
+
+int main( int argc, char* argv[] ) {
+
+    Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+    return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
@@ -0,0 +1,203 @@
+/*! \file utPeridigm_LoadStepPredictor.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <Epetra_ConfigDefs.h> // used to define HAVE_MPI
+#include "Peridigm_LoadStepPredictor.hpp"
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_UnitTestRepository.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include <Epetra_Map.h>
+#include <vector>
+#include <stdexcept>
+#ifdef HAVE_MPI
+  #include <Epetra_MpiComm.h>
+#else
+  #include <Epetra_SerialComm.h>
+#endif
+
+using namespace std;
+using namespace PeridigmNS;
+using namespace Teuchos;
+
+const int numGlobalEntries = 10;
+
+RCP<Epetra_Comm> getComm() {
+#ifdef HAVE_MPI
+  return rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+#else
+  return rcp(new Epetra_SerialComm);
+#endif
+}
+
+//! Displacement history u(t) = a + b*t + c*t^2, with coefficients that differ for each entry.
+double displacement(int globalId, double t, bool quadratic)
+{
+  double a = 0.5*globalId, b = 1.0 - 0.3*globalId, c = quadratic ? 2.0 + 0.7*globalId : 0.0;
+  return a + b*t + c*t*t;
+}
+
+//! Records the converged load steps ending at the given times, with velocity (u(t_i) - u(t_{i-1}))/(t_i - t_{i-1}).
+void recordSteps(LoadStepPredictor& predictor, Epetra_Vector& velocity, const vector<double>& times, bool quadratic)
+{
+  for(unsigned int step=1 ; step<times.size() ; ++step){
+    double dt = times[step] - times[step-1];
+    for(int i=0 ; i<velocity.MyLength() ; ++i){
+      int globalId = velocity.Map().GID(i);
+      velocity[i] = (displacement(globalId, times[step], quadratic) - displacement(globalId, times[step-1], quadratic))/dt;
+    }
+    predictor.recordConvergedStep(velocity, dt);
+  }
+}
+
+//! Checks the predicted increment against the exact displacement increment from time t to t + dt.
+void checkPrediction(const LoadStepPredictor& predictor, Epetra_Vector& increment, double t, double dt, bool quadratic,
+                     FancyOStream& out, bool& success)
+{
+  increment.PutScalar(0.0);
+  TEST_ASSERT(predictor.predict(increment, dt));
+  for(int i=0 ; i<increment.MyLength() ; ++i){
+    int globalId = increment.Map().GID(i);
+    double expected = displacement(globalId, t + dt, quadratic) - displacement(globalId, t, quadratic);
+    TEST_FLOATING_EQUALITY(increment[i], expected, 1.0e-12);
+  }
+}
+
+TEUCHOS_UNIT_TEST(LoadStepPredictor, OrderFromString) {
+  TEST_EQUALITY(LoadStepPredictor::orderFromString("None"), LoadStepPredictor::NONE);
+  TEST_EQUALITY(LoadStepPredictor::orderFromString("Linear"), LoadStepPredictor::LINEAR);
+  TEST_EQUALITY(LoadStepPredictor::orderFromString("Quadratic"), LoadStepPredictor::QUADRATIC);
+  TEST_THROW(LoadStepPredictor::orderFromString("Cubic"), std::exception);
+}
+
+TEUCHOS_UNIT_TEST(LoadStepPredictor, None) {
+  RCP<Epetra_Comm> comm = getComm();
+  Epetra_Map map(numGlobalEntries, 0, *comm);
+  Epetra_Vector velocity(map), increment(map);
+  LoadStepPredictor predictor(LoadStepPredictor::NONE);
+  vector<double> times;
+  times.push_back(0.0);
+  times.push_back(0.1);
+  times.push_back(0.3);
+  recordSteps(predictor, velocity, times, false);
+  TEST_EQUALITY(predictor.NumRecordedSteps(), 0);
+  increment.PutScalar(7.0);
+  TEST_ASSERT(!predictor.predict(increment, 0.2));
+  for(int i=0 ; i<increment.MyLength() ; ++i)
+    TEST_EQUALITY(increment[i], 7.0);
+}
+
+TEUCHOS_UNIT_TEST(LoadStepPredictor, Linear) {
+  RCP<Epetra_Comm> comm = getComm();
+  Epetra_Map map(numGlobalEntries, 0, *comm);
+  Epetra_Vector velocity(map), increment(map);
+  LoadStepPredictor predictor(LoadStepPredictor::LINEAR);
+
+  // no prediction before the first converged load step
+  TEST_ASSERT(!predictor.predict(increment, 0.1));
+
+  // a linear displacement history is predicted exactly from a single load step, for a load step of a different size
+  vector<double> times;
+  times.push_back(0.0);
+  times.push_back(0.1);
+  recordSteps(predictor, velocity, times, false);
+  TEST_EQUALITY(predictor.NumRecordedSteps(), 1);
+  checkPrediction(predictor, increment, 0.1, 0.25, false, out, success);
+
+  // only the most recent load step is retained
+  times.push_back(0.4);
+  recordSteps(predictor, velocity, vector<double>(times.begin()+1, times.end()), false);
+  TEST_EQUALITY(predictor.NumRecordedSteps(), 1);
+  checkPrediction(predictor, increment, 0.4, 0.05, false, out, success);
+
+  predictor.reset();
+  TEST_EQUALITY(predictor.NumRecordedSteps(), 0);
+  TEST_ASSERT(!predictor.predict(increment, 0.1));
+  TEST_THROW(predictor.recordConvergedStep(velocity, 0.0), std::exception);
+}
+
+TEUCHOS_UNIT_TEST(LoadStepPredictor, Quadratic) {
+  RCP<Epetra_Comm> comm = getComm();
+  Epetra_Map map(numGlobalEntries, 0, *comm);
+  Epetra_Vector velocity(map), increment(map);
+  LoadStepPredictor predictor(LoadStepPredictor::QUADRATIC);
+
+  // with a single load step the prediction is linear
+  vector<double> times;
+  times.push_back(0.0);
+  times.push_back(0.1);
+  recordSteps(predictor, velocity, times, false);
+  TEST_EQUALITY(predictor.NumRecordedSteps(), 1);
+  checkPrediction(predictor, increment, 0.1, 0.3, false, out, success);
+
+  // a quadratic displacement history is predicted exactly from two load steps of unequal size, for a third size
+  predictor.reset();
+  times.push_back(0.35);
+  recordSteps(predictor, velocity, times, true);
+  TEST_EQUALITY(predictor.NumRecordedSteps(), 2);
+  checkPrediction(predictor, increment, 0.35, 0.2, true, out, success);
+
+  // after a further load step the oldest one is discarded
+  times.push_back(0.4);
+  vector<double> lastStep(times.end()-2, times.end());
+  recordSteps(predictor, velocity, lastStep, true);
+  TEST_EQUALITY(predictor.NumRecordedSteps(), 2);
+  checkPrediction(predictor, increment, 0.4, 0.6, true, out, success);
+
+  // a vector with a different layout discards the recorded load steps
+  Epetra_Map otherMap(2*numGlobalEntries, 0, *comm);
+  Epetra_Vector otherVelocity(otherMap), otherIncrement(otherMap);
+  recordSteps(predictor, otherVelocity, lastStep, false);
+  TEST_EQUALITY(predictor.NumRecordedSteps(), 1);
+  checkPrediction(predictor, otherIncrement, 0.4, 0.1, false, out, success);
+  TEST_THROW(predictor.predict(increment, 0.1), std::exception);
+}
+
+int main( int argc, char* argv[] ) {
+
+    Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+    return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
@@ -0,0 +1,285 @@
+/*! \file utPeridigm_MultigridPreconditioner.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <Epetra_ConfigDefs.h> // used to define HAVE_MPI
+#include "Peridigm_MultigridPreconditioner.hpp"
+#include "elastic_bond_based.h"
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_UnitTestRepository.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include <Teuchos_Assert.hpp>
+#include <Epetra_Map.h>
+#include <Epetra_BlockMap.h>
+#include <Epetra_MultiVector.h>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#ifdef HAVE_MPI
+  #include <Epetra_MpiComm.h>
+#else
+  #include <Epetra_SerialComm.h>
+#endif
+
+using namespace std;
+using namespace PeridigmNS;
+using namespace Teuchos;
+
+const int nx = 4, ny = 3, nz = 3;
+const int numGlobalPoints = nx*ny*nz;
+const double horizon = 1.6;
+const double bulkModulus = 1.0;
+
+RCP<Epetra_Comm> getComm() {
+#ifdef HAVE_MPI
+  return rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+#else
+  return rcp(new Epetra_SerialComm);
+#endif
+}
+
+//! Coordinates of a regular lattice of points with unit spacing, offset from the origin.
+vector<double> latticeCoordinates()
+{
+  vector<double> x(3*numGlobalPoints);
+  for(int i=0 ; i<nx ; ++i){
+    for(int j=0 ; j<ny ; ++j){
+      for(int k=0 ; k<nz ; ++k){
+        int id = (i*ny + j)*nz + k;
+        x[3*id] = 10.0 + i;
+        x[3*id+1] = -5.0 + j;
+        x[3*id+2] = 2.0 + k;
+      }
+    }
+  }
+  return x;
+}
+
+//! Neighborhood of a point: the number of neighbors followed by their ids.
+vector<int> neighborhood(const vector<double>& x, int id)
+{
+  vector<int> list(1, 0);
+  for(int n=0 ; n<numGlobalPoints ; ++n){
+    double d0 = x[3*n] - x[3*id], d1 = x[3*n+1] - x[3*id+1], d2 = x[3*n+2] - x[3*id+2];
+    if(n != id && std::sqrt(d0*d0 + d1*d1 + d2*d2) < horizon)
+      list.push_back(n);
+  }
+  list[0] = static_cast<int>(list.size()) - 1;
+  return list;
+}
+
+//! Points are owned round-robin.
+vector<int> myPoints(const Epetra_Comm& comm)
+{
+  vector<int> points;
+  for(int id=0 ; id<numGlobalPoints ; ++id)
+    if(id%comm.NumProc() == comm.MyPID())
+      points.push_back(id);
+  return points;
+}
+
+//! Model coordinates of the locally-owned points.
+RCP<Epetra_Vector> modelCoordinates(const Epetra_Comm& comm)
+{
+  vector<int> points = myPoints(comm);
+  vector<double> x = latticeCoordinates();
+  Epetra_BlockMap map(numGlobalPoints, static_cast<int>(points.size()), &points[0], 3, 0, comm);
+  RCP<Epetra_Vector> modelCoordinates = rcp(new Epetra_Vector(map));
+  for(unsigned int i=0 ; i<points.size() ; ++i)
+    for(int dof=0 ; dof<3 ; ++dof)
+      (*modelCoordinates)[3*i+dof] = x[3*points[i]+dof];
+  return modelCoordinates;
+}
+
+/*! \brief Assembles the tangent of the elastic bond-based material in the undeformed configuration, plus the given
+ *  multiple of the identity, with blockSize rows for each point.
+ *
+ *  Each degree of freedom beyond the displacements is coupled to the same degree of freedom of the neighbors as a
+ *  graph Laplacian, the simplest operator whose null space is the constant mode.
+ */
+RCP<Epetra_CrsMatrix> assembleTangent(const Epetra_Comm& comm, int blockSize, double shift)
+{
+  vector<int> points = myPoints(comm);
+  vector<int> myRows;
+  for(unsigned int i=0 ; i<points.size() ; ++i)
+    for(int dof=0 ; dof<blockSize ; ++dof)
+      myRows.push_back(blockSize*points[i] + dof);
+  Epetra_Map rowMap(blockSize*numGlobalPoints, static_cast<int>(myRows.size()), &myRows[0], 0, comm);
+  RCP<Epetra_CrsMatrix> tangent = rcp(new Epetra_CrsMatrix(Copy, rowMap, 0));
+
+  vector<double> x = latticeCoordinates();
+  vector<double> volume(numGlobalPoints, 1.0);
+  for(unsigned int i=0 ; i<points.size() ; ++i){
+    int id = points[i];
+    vector<int> list = neighborhood(x, id);
+    int numNeighbors = list[0];
+    vector<double> bondDamage(numNeighbors, 0.0);
+    vector<double> bondStiffness(9*numNeighbors);
+    MATERIAL_EVALUATION::computeBondStiffnessElasticBondBased(&x[0], &x[0], &volume[0], &bondDamage[0], &bondStiffness[0],
+                                                              id, &list[0], bulkModulus, horizon);
+    for(int dof=0 ; dof<blockSize ; ++dof){
+      int row = blockSize*id + dof;
+      vector<int> columns;
+      vector<double> values;
+      double diagonal = shift;
+      for(int n=0 ; n<numNeighbors ; ++n){
+        int neighbor = list[n+1];
+        if(dof < 3){
+          for(int j=0 ; j<3 ; ++j){
+            double k = bondStiffness[9*n + 3*dof + j];
+            columns.push_back(blockSize*neighbor + j);
+            values.push_back(k);
+            columns.push_back(blockSize*id + j);
+            values.push_back(-k);
+          }
+        }
+        else{
+          columns.push_back(blockSize*neighbor + dof);
+          values.push_back(1.0);
+          diagonal -= 1.0;
+        }
+      }
+      columns.push_back(row);
+      values.push_back(diagonal);
+      TEUCHOS_TEST_FOR_EXCEPT(tangent->InsertGlobalValues(row, static_cast<int>(values.size()), &values[0], &columns[0]) < 0);
+    }
+  }
+  tangent->FillComplete();
+  return tangent;
+}
+
+//! Checks that the tangent maps each rigid-body mode to zero, relative to the magnitude of the tangent and the mode.
+void checkRigidBodyModes(const Epetra_Comm& comm, int blockSize, FancyOStream& out, bool& success)
+{
+  RCP<Epetra_CrsMatrix> tangent = assembleTangent(comm, blockSize, 0.0);
+  RCP<Epetra_Vector> x = modelCoordinates(comm);
+
+  vector<double> modes;
+  int numModes;
+  MultigridPreconditioner::computeRigidBodyModes(*x, blockSize, modes, numModes);
+  TEST_EQUALITY(numModes, 3 + blockSize);
+  int numMyRows = tangent->NumMyRows();
+  TEST_EQUALITY(static_cast<int>(modes.size()), numModes*numMyRows);
+
+  Epetra_MultiVector modeVectors(View, tangent->RowMap(), &modes[0], numMyRows, numModes);
+  Epetra_MultiVector result(tangent->RowMap(), numModes);
+  tangent->Multiply(false, modeVectors, result);
+  vector<double> modeNorms(numModes), resultNorms(numModes);
+  modeVectors.NormInf(&modeNorms[0]);
+  result.NormInf(&resultNorms[0]);
+  double tangentNorm = tangent->NormInf();
+  TEST_ASSERT(tangentNorm > 0.0);
+  for(int m=0 ; m<numModes ; ++m){
+    TEST_ASSERT(modeNorms[m] > 0.0);
+    TEST_ASSERT(resultNorms[m] <= 1.0e-12*tangentNorm*modeNorms[m]);
+  }
+
+  // The rotations are taken about the centroid, so they are orthogonal to the translations
+  for(int m=3 ; m<6 ; ++m){
+    Epetra_MultiVector rotation(View, modeVectors, m, 1);
+    for(int t=0 ; t<3 ; ++t){
+      Epetra_MultiVector translation(View, modeVectors, t, 1);
+      double dot;
+      rotation.Dot(translation, &dot);
+      TEST_ASSERT(std::abs(dot) <= 1.0e-12*modeNorms[m]*numGlobalPoints);
+    }
+  }
+}
+
+TEUCHOS_UNIT_TEST(MultigridPreconditioner, RigidBodyModes) {
+  RCP<Epetra_Comm> comm = getComm();
+  checkRigidBodyModes(*comm, 3, out, success);
+}
+
+TEUCHOS_UNIT_TEST(MultigridPreconditioner, RigidBodyModesMultiphysics) {
+  RCP<Epetra_Comm> comm = getComm();
+  checkRigidBodyModes(*comm, 4, out, success);
+}
+
+#ifdef PERIDIGM_ML
+
+//! Applies the preconditioner to A*v and returns the infinity norm of the error relative to that of v.
+double relativeError(const Epetra_CrsMatrix& A, const MultigridPreconditioner& preconditioner)
+{
+  Epetra_Vector v(A.RowMap()), b(A.RowMap()), w(A.RowMap());
+  for(int i=0 ; i<v.MyLength() ; ++i)
+    v[i] = std::sin(1.0 + A.RowMap().GID(i));
+  A.Multiply(false, v, b);
+  preconditioner.ApplyInverse(b, w);
+  double vNorm, errorNorm;
+  v.NormInf(&vNorm);
+  w.Update(-1.0, v, 1.0);
+  w.NormInf(&errorNorm);
+  return errorNorm/vNorm;
+}
+
+TEUCHOS_UNIT_TEST(MultigridPreconditioner, ApplyInverse) {
+
+  RCP<Epetra_Comm> comm = getComm();
+  RCP<Epetra_Vector> x = modelCoordinates(*comm);
+  for(int blockSize=3 ; blockSize<=4 ; ++blockSize){
+    // The shift makes the tangent nonsingular, as the boundary conditions would
+    RCP<Epetra_CrsMatrix> tangent = assembleTangent(*comm, blockSize, 0.1);
+    Teuchos::ParameterList parameters;
+    parameters.set("coarse: max size", 16);
+    MultigridPreconditioner preconditioner(tangent, x, blockSize, parameters);
+    TEST_EQUALITY(preconditioner.compute(), 0);
+    TEST_ASSERT(relativeError(*tangent, preconditioner) < 1.0);
+
+    // A refresh after a change in the values of the tangent reuses the aggregates
+    tangent->Scale(2.0);
+    TEST_EQUALITY(preconditioner.compute(), 0);
+    TEST_ASSERT(relativeError(*tangent, preconditioner) < 1.0);
+  }
+}
+
+#endif
+
+int main( int argc, char* argv[] ) {
+
+    Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+    return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
@@ -0,0 +1,217 @@
+/*! \file utPeridigm_PairwiseJacobian.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <Epetra_ConfigDefs.h> // used to define HAVE_MPI
+#include "Peridigm.hpp"
+#include "Peridigm_Discretization.hpp"
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_UnitTestRepository.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include <Teuchos_ParameterList.hpp>
+#include <Epetra_FECrsMatrix.h>
+#ifdef HAVE_MPI
+  #include <Epetra_MpiComm.h>
+#else
+  #include <Epetra_SerialComm.h>
+#endif
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+using namespace PeridigmNS;
+using namespace Teuchos;
+
+const int nx = 6, ny = 2, nz = 2;
+const char meshFileName[] = "utPeridigm_PairwiseJacobian.txt";
+
+//! Global id of the point at the given grid position, in the order in which the points are written to the mesh file.
+int pointId(int i, int j, int k)
+{
+  return (i*ny + j)*nz + k;
+}
+
+//! Writes a grid with unit spacing, in which the points with x < 3 are in block 1 and the others in block 2.
+void writeMeshFile(const Epetra_Comm& comm)
+{
+  if(comm.MyPID() == 0){
+    ofstream textFile(meshFileName);
+    textFile << "# x y z block_id volume" << endl;
+    for(int i=0 ; i<nx ; ++i)
+      for(int j=0 ; j<ny ; ++j)
+        for(int k=0 ; k<nz ; ++k)
+          textFile << i << " " << j << " " << k << " " << (i < 3 ? 1 : 2) << " " << 1.0 << endl;
+    textFile.close();
+  }
+  comm.Barrier();
+}
+
+//! Quasi-static model with an elastic bond-based block next to an elastic (state-based) block.
+RCP<Peridigm> createTwoBlockModel(bool applyAnalyticJacobian)
+{
+  RCP<ParameterList> peridigmParams = rcp(new ParameterList());
+
+  ParameterList& materialParams = peridigmParams->sublist("Materials");
+  ParameterList& bondBasedMaterialParams = materialParams.sublist("My Bond Based Material");
+  bondBasedMaterialParams.set("Material Model", "Elastic Bond Based");
+  bondBasedMaterialParams.set("Density", 7800.0);
+  bondBasedMaterialParams.set("Bulk Modulus", 130.0e9);
+  bondBasedMaterialParams.set("Finite Difference Probe Length", 1.0e-7);
+  bondBasedMaterialParams.set("Apply Analytic Jacobian", applyAnalyticJacobian);
+  ParameterList& elasticMaterialParams = materialParams.sublist("My Elastic Material");
+  elasticMaterialParams.set("Material Model", "Elastic");
+  elasticMaterialParams.set("Density", 7800.0);
+  elasticMaterialParams.set("Bulk Modulus", 130.0e9);
+  elasticMaterialParams.set("Shear Modulus", 50.0e9);
+  elasticMaterialParams.set("Apply Automatic Differentiation Jacobian", false);
+  elasticMaterialParams.set("Finite Difference Probe Length", 1.0e-7);
+
+  // the horizon includes the six nearest neighbors and the twelve face diagonals, but not the body diagonals
+  ParameterList& blockParams = peridigmParams->sublist("Blocks");
+  ParameterList& blockOneParams = blockParams.sublist("My Bond Based Block");
+  blockOneParams.set("Block Names", "block_1");
+  blockOneParams.set("Material", "My Bond Based Material");
+  blockOneParams.set("Horizon", 1.5);
+  ParameterList& blockTwoParams = blockParams.sublist("My Elastic Block");
+  blockTwoParams.set("Block Names", "block_2");
+  blockTwoParams.set("Material", "My Elastic Material");
+  blockTwoParams.set("Horizon", 1.5);
+
+  ParameterList& discretizationParams = peridigmParams->sublist("Discretization");
+  discretizationParams.set("Type", "Text File");
+  discretizationParams.set("Input Mesh File", meshFileName);
+
+  // a quasi-static solver causes the tangent to be allocated
+  ParameterList& solverParams = peridigmParams->sublist("Solver");
+  solverParams.set("Initial Time", 0.0);
+  solverParams.set("Final Time", 1.0);
+  solverParams.sublist("QuasiStatic");
+
+  RCP<Discretization> nullDiscretization;
+  return rcp(new Peridigm(MPI_COMM_WORLD, peridigmParams, nullDiscretization));
+}
+
+//! Returns true if the locally-owned row of the matrix has an entry in the given column, and its value.
+bool getEntry(const Epetra_CrsMatrix& matrix, int globalRow, int globalCol, double& value)
+{
+  value = 0.0;
+  int numEntries = matrix.NumGlobalEntries(globalRow);
+  vector<double> values(numEntries);
+  vector<int> indices(numEntries);
+  matrix.ExtractGlobalRowCopy(globalRow, numEntries, numEntries, numEntries > 0 ? &values[0] : 0, numEntries > 0 ? &indices[0] : 0);
+  for(int i=0 ; i<numEntries ; ++i){
+    if(indices[i] == globalCol){
+      value = values[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+TEUCHOS_UNIT_TEST(PairwiseJacobian, BlockBoundary)
+{
+#ifdef HAVE_MPI
+  Epetra_MpiComm comm(MPI_COMM_WORLD);
+#else
+  Epetra_SerialComm comm;
+#endif
+  writeMeshFile(comm);
+
+  // the analytic bond-based Jacobian is assembled into the graph built by allocateJacobian(), in which the bonds of
+  // block 1 couple only their endpoints, and compared to the finite-difference Jacobian assembled into the full graph
+  RCP<Peridigm> analyticModel = createTwoBlockModel(true);
+  RCP<Peridigm> finiteDifferenceModel = createTwoBlockModel(false);
+  TEST_NOTHROW(analyticModel->evaluateTangentStiffnessMatrix());
+  TEST_NOTHROW(finiteDifferenceModel->evaluateTangentStiffnessMatrix());
+  RCP<const Epetra_FECrsMatrix> analyticTangent = analyticModel->getTangentStiffnessMatrix();
+  RCP<const Epetra_FECrsMatrix> finiteDifferenceTangent = finiteDifferenceModel->getTangentStiffnessMatrix();
+  TEST_ASSERT(analyticTangent->NumGlobalNonzeros() < finiteDifferenceTangent->NumGlobalNonzeros());
+
+  double maxAbs = finiteDifferenceTangent->NormInf();
+  double value;
+  for(int dof=0 ; dof<3 ; ++dof){
+
+    // two neighbors of a point in block 1 are not coupled to each other
+    int row = 3*pointId(0, 0, 0) + dof;
+    if(analyticTangent->MyGRID(row)){
+      TEST_ASSERT(!getEntry(*analyticTangent, row, 3*pointId(2, 0, 0) + dof, value));
+      TEST_ASSERT(getEntry(*finiteDifferenceTangent, row, 3*pointId(2, 0, 0) + dof, value));
+      TEST_ASSERT(fabs(value) < 1.0e-6*maxAbs);
+    }
+
+    // a point in block 1 is coupled to the neighbors of its neighbor in block 2, through the dilatation of the neighbor
+    row = 3*pointId(2, 0, 0) + dof;
+    if(analyticTangent->MyGRID(row)){
+      TEST_ASSERT(getEntry(*analyticTangent, row, 3*pointId(4, 0, 0) + dof, value));
+      if(dof == 0)
+        TEST_ASSERT(fabs(value) > 1.0e-6*maxAbs);
+    }
+  }
+
+  // every nonzero of the finite-difference Jacobian is in the graph of the analytic Jacobian, with the same value
+  const Epetra_Map& rowMap = finiteDifferenceTangent->RowMap();
+  for(int localRow=0 ; localRow<rowMap.NumMyElements() ; ++localRow){
+    int row = rowMap.GID(localRow);
+    TEST_ASSERT(analyticTangent->MyGRID(row));
+    int numEntries = finiteDifferenceTangent->NumGlobalEntries(row);
+    vector<double> values(numEntries);
+    vector<int> indices(numEntries);
+    finiteDifferenceTangent->ExtractGlobalRowCopy(row, numEntries, numEntries, &values[0], &indices[0]);
+    for(int i=0 ; i<numEntries ; ++i){
+      bool inGraph = getEntry(*analyticTangent, row, indices[i], value);
+      TEST_ASSERT(inGraph || fabs(values[i]) < 1.0e-6*maxAbs);
+      TEST_ASSERT(fabs(value - values[i]) < 1.0e-4*maxAbs);
+    }
+  }
+}
+
+int main( int argc, char* argv[] ) {
+
+    Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+    return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
@@ -0,0 +1,248 @@
+/*! \file utPeridigm_QuasiStaticPreconditioner.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <Epetra_ConfigDefs.h> // used to define HAVE_MPI
+#include "Peridigm.hpp"
+#include "Peridigm_Discretization.hpp"
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_UnitTestRepository.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include <Teuchos_ParameterList.hpp>
+#include <Epetra_FECrsMatrix.h>
+#include <Epetra_Vector.h>
+#include <BelosLinearProblem.hpp>
+
+using namespace std;
+using namespace PeridigmNS;
+using namespace Teuchos;
+
+typedef Belos::LinearProblem<double,Epetra_MultiVector,Epetra_Operator> LinearProblem;
+
+//! Quasi-static model on a 2x2x2 grid in which every point is bonded to all others, so that each diagonal block of the tangent is nonsingular.
+RCP<Peridigm> createQuasiStaticModel()
+{
+  RCP<ParameterList> peridigmParams = rcp(new ParameterList());
+
+  ParameterList& materialParams = peridigmParams->sublist("Materials");
+  ParameterList& linearElasticMaterialParams = materialParams.sublist("My Elastic Material");
+  linearElasticMaterialParams.set("Material Model", "Elastic");
+  linearElasticMaterialParams.set("Density", 7800.0);
+  linearElasticMaterialParams.set("Bulk Modulus", 130.0e9);
+  linearElasticMaterialParams.set("Shear Modulus", 78.0e9);
+
+  ParameterList& blockParams = peridigmParams->sublist("Blocks");
+  ParameterList& blockOneParams = blockParams.sublist("My Group of Blocks");
+  blockOneParams.set("Block Names", "block_1");
+  blockOneParams.set("Material", "My Elastic Material");
+  blockOneParams.set("Horizon", 1.8);
+
+  ParameterList& discretizationParams = peridigmParams->sublist("Discretization");
+  discretizationParams.set("Type", "PdQuickGrid");
+  ParameterList& pdQuickGridParams = discretizationParams.sublist("TensorProduct3DMeshGenerator");
+  pdQuickGridParams.set("Type", "PdQuickGrid");
+  pdQuickGridParams.set("X Origin",  0.0);
+  pdQuickGridParams.set("Y Origin",  0.0);
+  pdQuickGridParams.set("Z Origin",  0.0);
+  pdQuickGridParams.set("X Length",  2.0);
+  pdQuickGridParams.set("Y Length",  2.0);
+  pdQuickGridParams.set("Z Length",  2.0);
+  pdQuickGridParams.set("Number Points X", 2);
+  pdQuickGridParams.set("Number Points Y", 2);
+  pdQuickGridParams.set("Number Points Z", 2);
+
+  // a quasi-static solver causes the tangent to be allocated
+  ParameterList& solverParams = peridigmParams->sublist("Solver");
+  solverParams.set("Initial Time", 0.0);
+  solverParams.set("Final Time", 1.0);
+  solverParams.sublist("QuasiStatic");
+
+  RCP<Discretization> nullDiscretization;
+  return rcp(new Peridigm(MPI_COMM_WORLD, peridigmParams, nullDiscretization));
+}
+
+//! Apply the preconditioner currently set on the linear problem to a vector of ones.
+RCP<Epetra_Vector> applyPreconditioner(const LinearProblem& linearProblem, const Epetra_Map& map)
+{
+  Epetra_Vector ones(map);
+  ones.PutScalar(1.0);
+  RCP<Epetra_Vector> result = rcp(new Epetra_Vector(map));
+  linearProblem.getLeftPrec()->Apply(ones, *result);
+  return result;
+}
+
+TEUCHOS_UNIT_TEST(QuasiStaticPreconditioner, LagRatio)
+{
+  RCP<Peridigm> peridigm = createQuasiStaticModel();
+  TEST_ASSERT(peridigm->hasTangentStiffnessMatrix());
+
+  RCP<ParameterList> quasiStaticParams = rcp(new ParameterList());
+  quasiStaticParams->set("Preconditioner", "Block Jacobi");
+  quasiStaticParams->set("Preconditioner Lag Ratio", 2.0);
+  peridigm->setLinearSolverPreconditioner(quasiStaticParams);
+
+  peridigm->evaluateTangentStiffnessMatrix();
+  RCP<Epetra_FECrsMatrix> tangent = rcp_const_cast<Epetra_FECrsMatrix>(peridigm->getTangentStiffnessMatrix());
+  const Epetra_Map& map = tangent->RangeMap();
+  LinearProblem linearProblem;
+  linearProblem.setOperator(tangent);
+
+  // the first call creates the preconditioner from the current tangent
+  peridigm->quasiStaticsSetPreconditioner(linearProblem);
+  RCP<const Epetra_Operator> belosPreconditioner = linearProblem.getLeftPrec();
+  TEST_ASSERT(!belosPreconditioner.is_null());
+  RCP<Epetra_Vector> original = applyPreconditioner(linearProblem, map);
+
+  // the first solve after the preconditioner was built sets the reference iteration count
+  peridigm->recordLinearSolverIterations(10);
+
+  // change the tangent values without changing its structure
+  TEST_EQUALITY(tangent->Scale(2.0), 0);
+
+  // at twice the reference count the preconditioner is still lagged, and applies the inverse of the original tangent
+  peridigm->recordLinearSolverIterations(20);
+  peridigm->quasiStaticsSetPreconditioner(linearProblem);
+  TEST_ASSERT(linearProblem.getLeftPrec().get() == belosPreconditioner.get());
+  RCP<Epetra_Vector> lagged = applyPreconditioner(linearProblem, map);
+  for(int i=0 ; i<map.NumMyElements() ; ++i)
+    TEST_FLOATING_EQUALITY((*lagged)[i], (*original)[i], 1.0e-12);
+
+  // beyond twice the reference count the retained preconditioner is refreshed with the scaled tangent
+  peridigm->recordLinearSolverIterations(21);
+  peridigm->quasiStaticsSetPreconditioner(linearProblem);
+  TEST_ASSERT(linearProblem.getLeftPrec().get() == belosPreconditioner.get());
+  RCP<Epetra_Vector> refreshed = applyPreconditioner(linearProblem, map);
+  for(int i=0 ; i<map.NumMyElements() ; ++i)
+    TEST_FLOATING_EQUALITY((*refreshed)[i], 0.5*(*original)[i], 1.0e-12);
+
+  // the count of the first solve after the refresh becomes the new reference, so 21 iterations are lagged but 43 are not
+  peridigm->recordLinearSolverIterations(21);
+  TEST_EQUALITY(tangent->Scale(2.0), 0);
+  peridigm->quasiStaticsSetPreconditioner(linearProblem);
+  lagged = applyPreconditioner(linearProblem, map);
+  for(int i=0 ; i<map.NumMyElements() ; ++i)
+    TEST_FLOATING_EQUALITY((*lagged)[i], 0.5*(*original)[i], 1.0e-12);
+  peridigm->recordLinearSolverIterations(43);
+  peridigm->quasiStaticsSetPreconditioner(linearProblem);
+  refreshed = applyPreconditioner(linearProblem, map);
+  for(int i=0 ; i<map.NumMyElements() ; ++i)
+    TEST_FLOATING_EQUALITY((*refreshed)[i], 0.25*(*original)[i], 1.0e-12);
+}
+
+TEUCHOS_UNIT_TEST(QuasiStaticPreconditioner, NoLag)
+{
+  RCP<Peridigm> peridigm = createQuasiStaticModel();
+
+  RCP<ParameterList> quasiStaticParams = rcp(new ParameterList());
+  quasiStaticParams->set("Preconditioner", "Block Jacobi");
+  peridigm->setLinearSolverPreconditioner(quasiStaticParams);
+
+  peridigm->evaluateTangentStiffnessMatrix();
+  RCP<Epetra_FECrsMatrix> tangent = rcp_const_cast<Epetra_FECrsMatrix>(peridigm->getTangentStiffnessMatrix());
+  const Epetra_Map& map = tangent->RangeMap();
+  LinearProblem linearProblem;
+  linearProblem.setOperator(tangent);
+
+  peridigm->quasiStaticsSetPreconditioner(linearProblem);
+  RCP<const Epetra_Operator> belosPreconditioner = linearProblem.getLeftPrec();
+  RCP<Epetra_Vector> original = applyPreconditioner(linearProblem, map);
+  peridigm->recordLinearSolverIterations(10);
+
+  // without lagging, the retained preconditioner is refreshed on every call, even if the iteration count drops
+  TEST_EQUALITY(tangent->Scale(2.0), 0);
+  peridigm->recordLinearSolverIterations(1);
+  peridigm->quasiStaticsSetPreconditioner(linearProblem);
+  TEST_ASSERT(linearProblem.getLeftPrec().get() == belosPreconditioner.get());
+  RCP<Epetra_Vector> refreshed = applyPreconditioner(linearProblem, map);
+  for(int i=0 ; i<map.NumMyElements() ; ++i)
+    TEST_FLOATING_EQUALITY((*refreshed)[i], 0.5*(*original)[i], 1.0e-12);
+}
+
+TEUCHOS_UNIT_TEST(QuasiStaticPreconditioner, DropOnNewSolver)
+{
+  RCP<Peridigm> peridigm = createQuasiStaticModel();
+
+  RCP<ParameterList> quasiStaticParams = rcp(new ParameterList());
+  quasiStaticParams->set("Preconditioner", "Block Jacobi");
+  quasiStaticParams->set("Preconditioner Lag Ratio", 2.0);
+  peridigm->setLinearSolverPreconditioner(quasiStaticParams);
+
+  peridigm->evaluateTangentStiffnessMatrix();
+  RCP<Epetra_FECrsMatrix> tangent = rcp_const_cast<Epetra_FECrsMatrix>(peridigm->getTangentStiffnessMatrix());
+  const Epetra_Map& map = tangent->RangeMap();
+  LinearProblem linearProblem;
+  linearProblem.setOperator(tangent);
+
+  peridigm->quasiStaticsSetPreconditioner(linearProblem);
+  RCP<const Epetra_Operator> belosPreconditioner = linearProblem.getLeftPrec();
+  RCP<Epetra_Vector> original = applyPreconditioner(linearProblem, map);
+  peridigm->recordLinearSolverIterations(10);
+
+  // the tangent is allocated once in the constructor, so a later call to allocateJacobian() keeps both the tangent
+  // and the preconditioner built from it
+  peridigm->allocateJacobian(3);
+  TEST_ASSERT(peridigm->getTangentStiffnessMatrix().get() == tangent.get());
+  peridigm->recordLinearSolverIterations(10);
+  peridigm->quasiStaticsSetPreconditioner(linearProblem);
+  TEST_ASSERT(linearProblem.getLeftPrec().get() == belosPreconditioner.get());
+
+  // the parameters of the next solver discard the retained preconditioner, and its replacement is built from the
+  // current tangent even though the iteration count of the last solve is within the lag ratio
+  TEST_EQUALITY(tangent->Scale(2.0), 0);
+  peridigm->setLinearSolverPreconditioner(quasiStaticParams);
+  peridigm->recordLinearSolverIterations(10);
+  peridigm->quasiStaticsSetPreconditioner(linearProblem);
+  TEST_ASSERT(linearProblem.getLeftPrec().get() != belosPreconditioner.get());
+  RCP<Epetra_Vector> rebuilt = applyPreconditioner(linearProblem, map);
+  for(int i=0 ; i<map.NumMyElements() ; ++i)
+    TEST_FLOATING_EQUALITY((*rebuilt)[i], 0.5*(*original)[i], 1.0e-12);
+}
+
+int main( int argc, char* argv[] ) {
+
+    Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+    return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
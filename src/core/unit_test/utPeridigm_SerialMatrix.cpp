@@ -0,0 +1,258 @@
+/*! \file utPeridigm_SerialMatrix.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <Epetra_ConfigDefs.h> // used to define HAVE_MPI
+#include "Peridigm_SerialMatrix.hpp"
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_UnitTestRepository.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include <Epetra_Map.h>
+#include <Epetra_CrsGraph.h>
+#include <Epetra_FECrsMatrix.h>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <Epetra_SerialComm.h>
+#ifdef HAVE_MPI
+  #include <Epetra_MpiComm.h>
+#endif
+
+using namespace std;
+using namespace PeridigmNS;
+using namespace Teuchos;
+
+const int numPointsPerProc = 4;
+
+//! Layout of the values passed to SerialMatrix::addValues(), addBlockDiagonalValues(), and addPairwiseValues(), respectively.
+enum Layout { FULL, BLOCK_DIAGONAL, PAIRWISE };
+
+RCP<Epetra_Comm> getComm() {
+#ifdef HAVE_MPI
+  return rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+#else
+  return rcp(new Epetra_SerialComm);
+#endif
+}
+
+//! Global indices of the degrees of freedom of a point and of its neighbors, which are the points within two positions of it on a line.
+vector<int> neighborhoodIndices(int globalId, int numGlobalPoints)
+{
+  vector<int> indices;
+  for(int dof=0 ; dof<3 ; ++dof)
+    indices.push_back(3*globalId + dof);
+  for(int neighbor=globalId-2 ; neighbor<=globalId+2 ; ++neighbor){
+    if(neighbor != globalId && neighbor >= 0 && neighbor < numGlobalPoints){
+      for(int dof=0 ; dof<3 ; ++dof)
+        indices.push_back(3*neighbor + dof);
+    }
+  }
+  return indices;
+}
+
+//! Positions in the list of global indices of the columns that receive values in the given row.
+vector<int> rowColumns(Layout layout, int numIndices, int iRow)
+{
+  vector<int> columns;
+  if(layout == BLOCK_DIAGONAL){
+    for(int j=0 ; j<3 ; ++j)
+      columns.push_back(3*(iRow/3) + j);
+  }
+  else if(layout == PAIRWISE && iRow >= 3){
+    for(int j=0 ; j<3 ; ++j)
+      columns.push_back(j);
+    for(int j=0 ; j<3 ; ++j)
+      columns.push_back(3*(iRow/3) + j);
+  }
+  else{
+    for(int j=0 ; j<numIndices ; ++j)
+      columns.push_back(j);
+  }
+  return columns;
+}
+
+//! Value added by the given point to an entry of the matrix, indexed by global ID.
+double value(int globalId, int globalRow, int globalCol, double scale)
+{
+  return scale*(1.0 + 0.1*globalRow + 0.01*globalCol + 0.001*globalId);
+}
+
+//! Creates a matrix for the degrees of freedom of the given points; each row has entries for the points within four
+//! positions of its own point, which covers the blocks of all the neighborhoods, or only for its own point for the block diagonal.
+RCP<Epetra_FECrsMatrix> createMatrix(const Epetra_Map& pointMap, Layout layout)
+{
+  vector<int> myGlobalIndices;
+  for(int i=0 ; i<pointMap.NumMyElements() ; ++i){
+    for(int dof=0 ; dof<3 ; ++dof)
+      myGlobalIndices.push_back(3*pointMap.GID(i) + dof);
+  }
+  Epetra_Map tangentMap(-1, static_cast<int>(myGlobalIndices.size()), myGlobalIndices.size() > 0 ? &myGlobalIndices[0] : 0, 0, pointMap.Comm());
+
+  int bandwidth = layout == BLOCK_DIAGONAL ? 0 : 4;
+  Epetra_CrsGraph graph(Copy, tangentMap, 0);
+  for(int i=0 ; i<pointMap.NumMyElements() ; ++i){
+    int globalId = pointMap.GID(i);
+    vector<int> columns;
+    for(int point=globalId-bandwidth ; point<=globalId+bandwidth ; ++point){
+      if(point >= 0 && point < pointMap.NumGlobalElements()){
+        for(int dof=0 ; dof<3 ; ++dof)
+          columns.push_back(3*point + dof);
+      }
+    }
+    for(int dof=0 ; dof<3 ; ++dof)
+      graph.InsertGlobalIndices(3*globalId + dof, static_cast<int>(columns.size()), &columns[0]);
+  }
+  graph.FillComplete();
+
+  bool ignoreNonLocalEntries = false;
+  return rcp(new Epetra_FECrsMatrix(Copy, graph, ignoreNonLocalEntries));
+}
+
+//! Adds the values of the locally-owned points to the matrix, and returns the number of rows owned by other processors that received values.
+int assemble(SerialMatrix& serialMatrix, Layout layout, const Epetra_Map& pointMap, const Epetra_BlockMap& rowMap, double scale)
+{
+  int numNonlocalRows(0);
+  for(int i=0 ; i<pointMap.NumMyElements() ; ++i){
+    int globalId = pointMap.GID(i);
+    vector<int> indices = neighborhoodIndices(globalId, pointMap.NumGlobalElements());
+    int numIndices = static_cast<int>(indices.size());
+    vector< vector<double> > values(numIndices);
+    vector<double*> rowPointers(numIndices);
+    for(int iRow=0 ; iRow<numIndices ; ++iRow){
+      // The rows of the neighbors hold only six values for the pairwise layout; the other layouts have a full block of values
+      if(layout == PAIRWISE && iRow >= 3){
+        vector<int> columns = rowColumns(layout, numIndices, iRow);
+        for(unsigned int j=0 ; j<columns.size() ; ++j)
+          values[iRow].push_back(value(globalId, indices[iRow], indices[columns[j]], scale));
+      }
+      else{
+        for(int j=0 ; j<numIndices ; ++j)
+          values[iRow].push_back(value(globalId, indices[iRow], indices[j], scale));
+      }
+      rowPointers[iRow] = &values[iRow][0];
+      if(!rowMap.MyGID(indices[iRow]))
+        numNonlocalRows += 1;
+    }
+    if(layout == FULL)
+      serialMatrix.addValues(numIndices, &indices[0], &rowPointers[0]);
+    else if(layout == BLOCK_DIAGONAL)
+      serialMatrix.addBlockDiagonalValues(numIndices, &indices[0], &rowPointers[0]);
+    else
+      serialMatrix.addPairwiseValues(numIndices, &indices[0], &rowPointers[0]);
+  }
+  return numNonlocalRows;
+}
+
+//! Returns the largest difference between the entries of the locally-owned rows of the matrix and the values added by all points.
+double maxDifference(const Epetra_FECrsMatrix& matrix, Layout layout, double scale)
+{
+  map< pair<int,int>, double > difference;
+  int numGlobalPoints = matrix.RowMap().NumGlobalElements()/3;
+  for(int globalId=0 ; globalId<numGlobalPoints ; ++globalId){
+    vector<int> indices = neighborhoodIndices(globalId, numGlobalPoints);
+    int numIndices = static_cast<int>(indices.size());
+    for(int iRow=0 ; iRow<numIndices ; ++iRow){
+      if(!matrix.RowMap().MyGID(indices[iRow]))
+        continue;
+      vector<int> columns = rowColumns(layout, numIndices, iRow);
+      for(unsigned int j=0 ; j<columns.size() ; ++j)
+        difference[make_pair(indices[iRow], indices[columns[j]])] += value(globalId, indices[iRow], indices[columns[j]], scale);
+    }
+  }
+  for(int localRow=0 ; localRow<matrix.NumMyRows() ; ++localRow){
+    int numEntries;
+    double* rowValues;
+    int* rowIndices;
+    matrix.ExtractMyRowView(localRow, numEntries, rowValues, rowIndices);
+    for(int j=0 ; j<numEntries ; ++j)
+      difference[make_pair(matrix.GRID(localRow), matrix.GCID(rowIndices[j]))] -= rowValues[j];
+  }
+  double maxDiff(0.0);
+  for(map< pair<int,int>, double >::const_iterator it=difference.begin() ; it!=difference.end() ; ++it)
+    maxDiff = max(maxDiff, fabs(it->second));
+  return maxDiff;
+}
+
+//! Assembles the matrix twice with different values, so that the second evaluation reuses the assembly plans
+//! and the buffers for the nonlocal rows created by the first one.
+void testAssembly(Layout layout, Teuchos::FancyOStream& out, bool& success)
+{
+  RCP<Epetra_Comm> comm = getComm();
+  Epetra_Map pointMap(numPointsPerProc*comm->NumProc(), 0, *comm);
+  RCP<Epetra_FECrsMatrix> matrix = createMatrix(pointMap, layout);
+  SerialMatrix serialMatrix(matrix);
+
+  for(int evaluation=1 ; evaluation<=2 ; ++evaluation){
+    double scale = static_cast<double>(evaluation);
+    serialMatrix.putScalar(0.0);
+    int numNonlocalRows = assemble(serialMatrix, layout, pointMap, matrix->RowMap(), scale);
+    serialMatrix.sumIntoNonlocalRows();
+    TEST_EQUALITY_CONST(matrix->GlobalAssemble(), 0);
+
+    // with more than one processor, the neighborhoods at the processor boundaries include points owned by other processors
+    if(comm->NumProc() > 1)
+      TEST_ASSERT(numNonlocalRows > 0);
+    TEST_ASSERT(maxDifference(*matrix, layout, scale) < 1.0e-12);
+  }
+}
+
+TEUCHOS_UNIT_TEST(SerialMatrix, AddValues) {
+  testAssembly(FULL, out, success);
+}
+
+TEUCHOS_UNIT_TEST(SerialMatrix, AddBlockDiagonalValues) {
+  testAssembly(BLOCK_DIAGONAL, out, success);
+}
+
+TEUCHOS_UNIT_TEST(SerialMatrix, AddPairwiseValues) {
+  testAssembly(PAIRWISE, out, success);
+}
+
+int main( int argc, char* argv[] ) {
+
+    Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+    return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
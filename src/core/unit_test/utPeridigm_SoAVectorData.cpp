@@ -0,0 +1,156 @@
+/*! \file utPeridigm_SoAVectorData.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include "Peridigm_SoAVectorData.hpp"
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_UnitTestRepository.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+using namespace PeridigmNS;
+
+//! Interleaved data for the given number of points, with a distinct value for each component of each point.
+vector<double> interleavedData(int numPoints)
+{
+  vector<double> data(3*numPoints);
+  for(int i=0 ; i<numPoints ; ++i)
+    for(int k=0 ; k<3 ; ++k)
+      data[3*i+k] = 10.0*i + k + 1.0;
+  return data;
+}
+
+//! Checks that entries between the length and the padded length of each component array are zero.
+void checkPadding(const SoAVectorData& data, Teuchos::FancyOStream& out, bool& success)
+{
+  for(int i=data.Length() ; i<data.PaddedLength() ; ++i){
+    TEST_EQUALITY(data.X()[i], 0.0);
+    TEST_EQUALITY(data.Y()[i], 0.0);
+    TEST_EQUALITY(data.Z()[i], 0.0);
+  }
+}
+
+TEUCHOS_UNIT_TEST(SoAVectorData, GatherScatter) {
+
+  const int numPoints = 13;
+  vector<double> data = interleavedData(numPoints);
+  SoAVectorData soa;
+  soa.gather(&data[0], numPoints);
+
+  TEST_EQUALITY(soa.Length(), numPoints);
+  for(int i=0 ; i<numPoints ; ++i){
+    TEST_EQUALITY(soa.X()[i], data[3*i]);
+    TEST_EQUALITY(soa.Y()[i], data[3*i+1]);
+    TEST_EQUALITY(soa.Z()[i], data[3*i+2]);
+  }
+
+  // scatter() writes the component arrays back in interleaved order
+  for(int i=0 ; i<numPoints ; ++i){
+    soa.X()[i] *= -1.0;
+    soa.Y()[i] *= -2.0;
+    soa.Z()[i] *= -3.0;
+  }
+  vector<double> result(3*numPoints, 0.0);
+  soa.scatter(&result[0]);
+  for(int i=0 ; i<numPoints ; ++i){
+    TEST_EQUALITY(result[3*i], -1.0*data[3*i]);
+    TEST_EQUALITY(result[3*i+1], -2.0*data[3*i+1]);
+    TEST_EQUALITY(result[3*i+2], -3.0*data[3*i+2]);
+  }
+}
+
+TEUCHOS_UNIT_TEST(SoAVectorData, AlignmentAndPadding) {
+
+  const int entriesPerAlignment = SoAVectorData::alignment/sizeof(double);
+  SoAVectorData soa;
+  for(int numPoints=0 ; numPoints<=3*entriesPerAlignment ; ++numPoints){
+    vector<double> data = interleavedData(numPoints);
+    soa.gather(numPoints > 0 ? &data[0] : 0, numPoints);
+    TEST_EQUALITY(soa.Length(), numPoints);
+    TEST_EQUALITY(soa.PaddedLength()%entriesPerAlignment, 0);
+    TEST_ASSERT(soa.PaddedLength() >= numPoints);
+    TEST_ASSERT(soa.PaddedLength() < numPoints + entriesPerAlignment);
+    TEST_EQUALITY(reinterpret_cast<std::size_t>(soa.X())%SoAVectorData::alignment, 0);
+    TEST_EQUALITY(reinterpret_cast<std::size_t>(soa.Y())%SoAVectorData::alignment, 0);
+    TEST_EQUALITY(reinterpret_cast<std::size_t>(soa.Z())%SoAVectorData::alignment, 0);
+    checkPadding(soa, out, success);
+  }
+}
+
+TEUCHOS_UNIT_TEST(SoAVectorData, PaddingStaysZero) {
+
+  // a shorter gather into the same allocation must not leave earlier values in the padding
+  const int numPoints = 15;
+  vector<double> data = interleavedData(numPoints);
+  SoAVectorData soa;
+  soa.gather(&data[0], numPoints);
+  const double* x = soa.X();
+  soa.gather(&data[0], 9);
+  TEST_EQUALITY(soa.X(), x);
+  TEST_EQUALITY(soa.Length(), 9);
+  checkPadding(soa, out, success);
+
+  // the same holds for resize(), and PutScalar() sets only the entries for the points
+  soa.gather(&data[0], numPoints);
+  soa.resize(10);
+  TEST_EQUALITY(soa.X(), x);
+  checkPadding(soa, out, success);
+  soa.PutScalar(2.0);
+  for(int i=0 ; i<soa.Length() ; ++i){
+    TEST_EQUALITY(soa.X()[i], 2.0);
+    TEST_EQUALITY(soa.Y()[i], 2.0);
+    TEST_EQUALITY(soa.Z()[i], 2.0);
+  }
+  checkPadding(soa, out, success);
+}
+
+int main( int argc, char* argv[] ) {
+
+    Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+    return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
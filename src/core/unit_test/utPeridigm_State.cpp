@@ -9,6 +9,7 @@
 #include <Epetra_ConfigDefs.h> // used to define HAVE_MPI
 #include <Epetra_SerialComm.h>
 #include "Peridigm_State.hpp"
+#include "Peridigm_CompactBondVector.hpp"
 #include <vector>
 #include <Teuchos_ParameterList.hpp>
 #include <Teuchos_UnitTestHarness.hpp>
@@ -545,6 +546,46 @@ TEUCHOS_UNIT_TEST(State, CopyFrom) {
 
 
 
+//! Test compact storage of bond data.
+
+TEUCHOS_UNIT_TEST(State, CompactBondVector) {
+
+  // use a length that is not a multiple of the word size to exercise the last partial word
+  int length = 75;
+  vector<double> values(length), unpackedValues(length);
+  for(int i=0 ; i<length ; ++i)
+    values[i] = (i%3 == 0) ? 1.0 : 0.0;
+
+  PeridigmNS::CompactBondVector bits(PeridigmField::BIT_STORAGE, length);
+  TEST_EQUALITY( bits[length-1], 0.0 );
+  bits.pack(&values[0]);
+  bits.unpack(&unpackedValues[0]);
+  for(int i=0 ; i<length ; ++i){
+    TEST_EQUALITY( unpackedValues[i], values[i] );
+    TEST_EQUALITY( bits.flag(i), values[i] == 1.0 );
+  }
+  TEST_ASSERT( bits.Bytes() <= length/8 + sizeof(unsigned int) );
+  bits.setValue(1, 1.0);
+  bits.setValue(3, 0.0);
+  TEST_EQUALITY( bits[1], 1.0 );
+  TEST_EQUALITY( bits[3], 0.0 );
+  TEST_EQUALITY( bits[6], 1.0 );
+
+  // bit-packed storage accepts only zero and one
+  values[10] = 0.5;
+  TEST_THROW( bits.pack(&values[0]), std::logic_error );
+
+  PeridigmNS::CompactBondVector floats(PeridigmField::FLOAT_STORAGE, length);
+  for(int i=0 ; i<length ; ++i)
+    values[i] = 1.0/(i+1.0);
+  floats.pack(&values[0]);
+  floats.unpack(&unpackedValues[0]);
+  for(int i=0 ; i<length ; ++i){
+    TEST_FLOATING_EQUALITY( unpackedValues[i], values[i], 1.0e-7 );
+    TEST_EQUALITY( floats.FloatValues()[i], static_cast<float>(values[i]) );
+  }
+}
+
 int main( int argc, char* argv[] ) {
 
     int numProcs = 1;
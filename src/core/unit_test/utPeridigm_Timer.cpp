@@ -0,0 +1,164 @@
+/*! \file utPeridigm_Timer.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <Epetra_ConfigDefs.h> // used to define HAVE_MPI
+#include "Peridigm_Timer.hpp"
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_UnitTestRepository.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#ifdef HAVE_MPI
+  #include <Epetra_MpiComm.h>
+#else
+  #include <Epetra_SerialComm.h>
+#endif
+
+using namespace std;
+using namespace PeridigmNS;
+using namespace Teuchos;
+
+#ifdef HAVE_MPI
+Epetra_MpiComm& getComm() { static Epetra_MpiComm comm(MPI_COMM_WORLD); return comm; }
+#else
+Epetra_SerialComm& getComm() { static Epetra_SerialComm comm; return comm; }
+#endif
+
+int getRank() { return getComm().MyPID(); }
+
+void busyWait(Timer& timer, const string& name) {
+  // Spin until the named timer has accumulated a measurable amount of time
+  double start = timer.elapsedTime(name);
+  timer.startTimer(name);
+  volatile double x = 0.0;
+  for(int i=0 ; i<1000000 ; ++i)
+    x += 1.0e-6*i;
+  timer.stopTimer(name);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(timer.elapsedTime(name) < start, "**** busyWait():  elapsed time decreased.\n");
+}
+
+TEUCHOS_UNIT_TEST(Timer, NestedTimers) {
+
+  Timer& timer = Timer::self();
+
+  timer.startTimer("Nested Outer");
+  busyWait(timer, "Nested Inner");
+  busyWait(timer, "Nested Inner");
+  timer.stopTimer("Nested Outer");
+
+  double outer = timer.elapsedTime("Nested Outer");
+  double inner = timer.elapsedTime("Nested Inner");
+  TEST_ASSERT(inner > 0.0);
+  TEST_ASSERT(outer >= inner);
+
+  ostringstream report;
+  timer.printTimingData(report);
+  if(getRank() == 0){
+    TEST_ASSERT(report.str().find("Nested Outer") != string::npos);
+    TEST_ASSERT(report.str().find("Nested Inner") != string::npos);
+  }
+}
+
+TEUCHOS_UNIT_TEST(Timer, UnevenTimeSeries) {
+
+  // Only processor 0 records time series samples; every processor must still
+  // take part in the same collectives, otherwise printTimingData() hangs
+  Timer& timer = Timer::self();
+  string filename = "utPeridigm_Timer.json";
+  timer.setJSONFilename(filename);
+  timer.setTimeSeriesFrequency(1);
+
+  busyWait(timer, "Series");
+  if(getRank() == 0){
+    timer.markStep();
+    timer.markStep();
+  }
+
+  ostringstream report;
+  timer.printTimingData(report);
+  timer.setJSONFilename("");
+  timer.setTimeSeriesFrequency(0);
+
+  if(getRank() == 0){
+    ifstream json(filename.c_str());
+    TEST_ASSERT(json.good());
+    stringstream contents;
+    contents << json.rdbuf();
+    TEST_ASSERT(contents.str().find("Series") != string::npos);
+    json.close();
+    remove(filename.c_str());
+  }
+}
+
+TEUCHOS_UNIT_TEST(Timer, DifferingCallTrees) {
+
+  // Each processor creates a different timer, so the number of paths matches
+  // but the paths themselves do not
+  Timer& timer = Timer::self();
+  int rank = getRank();
+  ostringstream name;
+  name << "Processor " << rank << " Only";
+  busyWait(timer, name.str());
+
+  ostringstream report;
+  timer.printTimingData(report);
+
+  if(rank == 0){
+    bool warned = report.str().find("differ") != string::npos;
+    if(getComm().NumProc() > 1)
+      TEST_ASSERT(warned);
+    else
+      TEST_ASSERT(!warned);
+  }
+}
+
+int main( int argc, char* argv[] ) {
+
+    Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+    return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
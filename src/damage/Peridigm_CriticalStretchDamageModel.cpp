@@ -68,6 +68,17 @@ PeridigmNS::CriticalStretchDamageModel::CriticalStretchDamageModel(const Teuchos
   if(m_applyThermalStrains)
     m_deltaTemperatureFieldId = fieldManager.getFieldId(PeridigmField::NODE, PeridigmField::SCALAR, PeridigmField::TWO_STEP, "Temperature_Change");
 
+  // Bond damage is either zero or one, so the previous step's values may be stored as bit-packed flags
+  if(params.isParameter("Bond Damage Storage")){
+    string storage = params.get<string>("Bond Damage Storage");
+    if(storage == "Bit")
+      fieldManager.setBondStorage(m_bondDamageFieldId, PeridigmField::BIT_STORAGE);
+    else if(storage == "Float")
+      fieldManager.setBondStorage(m_bondDamageFieldId, PeridigmField::FLOAT_STORAGE);
+    else
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(storage != "Double", "**** Error:  CriticalStretchDamageModel, invalid Bond Damage Storage, valid options are \"Double\", \"Float\", and \"Bit\".\n");
+  }
+
   m_fieldIds.push_back(m_modelCoordinatesFieldId);
   m_fieldIds.push_back(m_coordinatesFieldId);
   m_fieldIds.push_back(m_damageFieldId);
@@ -112,11 +123,10 @@ PeridigmNS::CriticalStretchDamageModel::computeDamage(const double dt,
                                                       const int* neighborhoodList,
                                                       PeridigmNS::DataManager& dataManager) const
 {
-  double *x, *y, *damage, *bondDamageN, *bondDamageNP1, *deltaTemperature;
+  double *x, *y, *damage, *bondDamageNP1, *deltaTemperature;
   dataManager.getData(m_modelCoordinatesFieldId, PeridigmField::STEP_NONE)->ExtractView(&x);
   dataManager.getData(m_coordinatesFieldId, PeridigmField::STEP_NP1)->ExtractView(&y);
   dataManager.getData(m_damageFieldId, PeridigmField::STEP_NP1)->ExtractView(&damage);
-  dataManager.getData(m_bondDamageFieldId, PeridigmField::STEP_N)->ExtractView(&bondDamageN);
   dataManager.getData(m_bondDamageFieldId, PeridigmField::STEP_NP1)->ExtractView(&bondDamageNP1);
   deltaTemperature = NULL;
   if(m_applyThermalStrains)
@@ -128,7 +138,7 @@ PeridigmNS::CriticalStretchDamageModel::computeDamage(const double dt,
   double nodeInitialX[3], nodeCurrentX[3], initialDistance, currentDistance, relativeExtension, totalDamage;
 
   // Set the bond damage to the previous value
-  *(dataManager.getData(m_bondDamageFieldId, PeridigmField::STEP_NP1)) = *(dataManager.getData(m_bondDamageFieldId, PeridigmField::STEP_N));
+  dataManager.copyStepNToStepNP1(m_bondDamageFieldId);
 
   // Update the bond damage
   // Break bonds if the extension is greater than the critical extension
@@ -166,11 +166,10 @@ PeridigmNS::UserDefinedTimeDependentCriticalStretchDamageModel::computeDamage(co
                                                       const int* neighborhoodList,
                                                       PeridigmNS::DataManager& dataManager) const 
 {
-  double *x, *y, *damage, *bondDamageN, *bondDamageNP1, *deltaTemperature, *step;
+  double *x, *y, *damage, *bondDamageNP1, *deltaTemperature, *step;
   dataManager.getData(m_modelCoordinatesFieldId, PeridigmField::STEP_NONE)->ExtractView(&x);
   dataManager.getData(m_coordinatesFieldId, PeridigmField::STEP_NP1)->ExtractView(&y);
   dataManager.getData(m_damageFieldId, PeridigmField::STEP_NP1)->ExtractView(&damage);
-  dataManager.getData(m_bondDamageFieldId, PeridigmField::STEP_N)->ExtractView(&bondDamageN);
   dataManager.getData(m_bondDamageFieldId, PeridigmField::STEP_NP1)->ExtractView(&bondDamageNP1);
   //dataManager.getData(m_stepFieldId, PeridigmField::STEP_NP1)->ExtractView(&step);
   deltaTemperature = NULL;
@@ -184,8 +183,8 @@ PeridigmNS::UserDefinedTimeDependentCriticalStretchDamageModel::computeDamage(co
   double nodeInitialX[3], nodeCurrentX[3], initialDistance, currentDistance, relativeExtension, totalDamage;
 
   // Set the bond damage to the previous value
-  dataManager.getData(m_bondDamageFieldId, PeridigmField::STEP_NP1) =
-    dataManager.getData(m_bondDamageFieldId, PeridigmField::STEP_N);
+  // The step N bond damage may be stored in compact form (see the "Bond Damage Storage" option of the critical stretch damage model)
+  dataManager.copyStepNToStepNP1(m_bondDamageFieldId);
 
   // Update the bond damage
   // Break bonds if the extension is greater than the critical extension
@@ -0,0 +1,371 @@
+/*! \file Peridigm_ProbeManager.cpp */
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+
+#include "Peridigm.hpp"
+#include "Peridigm_ProbeManager.hpp"
+#include "Peridigm_Timer.hpp"
+#include "Peridigm_Enums.hpp"
+#include "Peridigm_Field.hpp"
+
+#include <float.h>
+
+using namespace std;
+
+PeridigmNS::ProbeManager::ProbeManager(const Teuchos::RCP<Teuchos::ParameterList>& params,
+                                       PeridigmNS::Peridigm *peridigm_)
+  : peridigm(peridigm_), active(false), iWrite(false), frequency(1), count(0), bufferSize(1), numBufferedRows(0), timerId(-1)
+{
+  if(params.is_null() || !params->isSublist("Probes"))
+    return;
+
+  Teuchos::RCP<const Epetra_Comm> comm = peridigm->getEpetraComm();
+  iWrite = (comm->MyPID() == 0);
+
+  frequency = params->get<int>("Output Frequency", 1);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(frequency < 1, "**** Error:  Time History \"Output Frequency\" must be greater than zero.\n");
+  bufferSize = params->get<int>("Buffer Size", 1000);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(bufferSize < 1, "**** Error:  Time History \"Buffer Size\" must be greater than zero.\n");
+  outputFormat = params->get<string>("Output Format", "CSV");
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(outputFormat != "CSV" && outputFormat != "BINARY",
+                              "**** Error:  Time History \"Output Format\" must be \"CSV\" or \"BINARY\".\n");
+  string filenameBase = params->get<string>("Output Filename", "time_history");
+
+  Teuchos::RCP< map< string, vector<int> > > exodusNodeSets = peridigm->getExodusNodeSets();
+
+  columnNames.push_back("Time");
+  Teuchos::ParameterList& probeParams = params->sublist("Probes");
+  for(Teuchos::ParameterList::ConstIterator it = probeParams.begin() ; it != probeParams.end() ; ++it){
+    const string& name = it->first;
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(!probeParams.isSublist(name), "**** Error:  Time History probe " + name + " is not a parameter list.\n");
+    Teuchos::ParameterList& probeParamList = probeParams.sublist(name);
+
+    Probe probe;
+    probe.name = name;
+    probe.globalNumNodes = 0;
+    string type = probeParamList.get<string>("Type");
+    if(type == "Node Set Resultant" || type == "Node Set Average"){
+      probe.type = (type == "Node Set Resultant") ? NODE_SET_RESULTANT : NODE_SET_AVERAGE;
+      probe.variable = probeParamList.get<string>("Variable", probe.type == NODE_SET_RESULTANT ? "Force_Density" : "Displacement");
+      string nodeSetName = probeParamList.get<string>("Node Set");
+      // Node set names are stored in the same form as in the boundary condition manager
+      tidy_string(nodeSetName);
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(exodusNodeSets->find(nodeSetName) == exodusNodeSets->end(),
+                                  "**** Error:  Time History probe " + name + ", node set not found: " + nodeSetName + "\n");
+      // Exodus node sets are one-based local ids into the mothership maps
+      const vector<int>& nodeSet = (*exodusNodeSets)[nodeSetName];
+      for(unsigned int i=0 ; i<nodeSet.size() ; ++i)
+        probe.localIds.push_back(nodeSet[i] - 1);
+      int localNumNodes = static_cast<int>(probe.localIds.size());
+      comm->SumAll(&localNumNodes, &probe.globalNumNodes, 1);
+    }
+    else if(type == "Kinetic Energy"){
+      probe.type = KINETIC_ENERGY;
+    }
+    else if(type == "Stored Elastic Energy"){
+      probe.type = STORED_ELASTIC_ENERGY;
+      // The energy density field is allocated in the blocks by Peridigm, see FieldIds()
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(!FieldManager::self().hasField("Stored_Elastic_Energy_Density"),
+                                  "**** Error:  Time History probe " + name + " requires the Stored_Elastic_Energy_Density field.\n");
+    }
+    else if(type == "Nearest Point"){
+      probe.type = NEAREST_POINT;
+      probe.variable = probeParamList.get<string>("Variable", "Displacement");
+      double point[3];
+      point[0] = probeParamList.get<double>("X");
+      point[1] = probeParamList.get<double>("Y");
+      point[2] = probeParamList.get<double>("Z");
+      findNearestPoint(point, probe.localIds);
+      probe.globalNumNodes = 1;
+    }
+    else{
+      string msg = "**** Error:  Unknown Time History probe type for probe " + name + ": " + type + "\n";
+      msg += "**** Valid types are \"Node Set Resultant\", \"Node Set Average\", \"Kinetic Energy\", \"Stored Elastic Energy\", and \"Nearest Point\".\n";
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(true, msg);
+    }
+
+    // Check that the variable is valid
+    if(probe.type != KINETIC_ENERGY && probe.type != STORED_ELASTIC_ENERGY)
+      getVariable(probe.variable);
+
+    if(numValues(probe) == 1){
+      columnNames.push_back(name);
+    }
+    else{
+      columnNames.push_back(name + "_X");
+      columnNames.push_back(name + "_Y");
+      columnNames.push_back(name + "_Z");
+    }
+
+    probes.push_back(probe);
+  }
+
+  active = (probes.size() > 0);
+  if(!active)
+    return;
+
+  timerId = PeridigmNS::Timer::self().getTimerId("Time History");
+
+  localValues.resize(columnNames.size() - 1);
+  globalValues.resize(columnNames.size() - 1);
+
+  if(iWrite){
+    buffer.resize(bufferSize*columnNames.size());
+    string filename = filenameBase + (outputFormat == "CSV" ? ".csv" : ".bin");
+    if(outputFormat == "CSV")
+      file.open(filename.c_str(), ios::out | ios::trunc);
+    else
+      file.open(filename.c_str(), ios::out | ios::trunc | ios::binary);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(!file.is_open(), "**** Error:  Unable to open Time History file " + filename + "\n");
+    file.precision(14);
+    writeHeader();
+  }
+}
+
+PeridigmNS::ProbeManager::~ProbeManager()
+{
+  if(iWrite && file.is_open()){
+    flush();
+    file.close();
+  }
+}
+
+void PeridigmNS::ProbeManager::record(double currentTime)
+{
+  if(!active)
+    return;
+
+  count++;
+  if((count-1)%frequency != 0)
+    return;
+
+  PeridigmNS::Timer::self().startTimer(timerId);
+
+  double* volume;
+  peridigm->volume->ExtractView(&volume);
+
+  for(unsigned int i=0 ; i<localValues.size() ; ++i)
+    localValues[i] = 0.0;
+
+  int offset = 0;
+  for(unsigned int iProbe=0 ; iProbe<probes.size() ; ++iProbe){
+    const Probe& probe = probes[iProbe];
+    if(probe.type == KINETIC_ENERGY){
+      double *velocity, *density;
+      peridigm->v->ExtractView(&velocity);
+      peridigm->density->ExtractView(&density);
+      int numOwnedPoints = peridigm->v->Map().NumMyElements();
+      double kineticEnergy = 0.0;
+      for(int i=0 ; i<numOwnedPoints ; ++i)
+        kineticEnergy += 0.5*density[i]*volume[i]*(velocity[3*i]*velocity[3*i] + velocity[3*i+1]*velocity[3*i+1] + velocity[3*i+2]*velocity[3*i+2]);
+      localValues[offset++] = kineticEnergy;
+    }
+    else if(probe.type == STORED_ELASTIC_ENERGY){
+      int energyDensityFieldId = FieldManager::self().getFieldId("Stored_Elastic_Energy_Density");
+      int volumeFieldId = FieldManager::self().getFieldId("Volume");
+      double storedElasticEnergy = 0.0;
+      for(vector<PeridigmNS::Block>::iterator blockIt = peridigm->getBlocks()->begin() ; blockIt != peridigm->getBlocks()->end() ; blockIt++){
+        Teuchos::RCP<PeridigmNS::NeighborhoodData> neighborhoodData = blockIt->getNeighborhoodData();
+        Teuchos::RCP<PeridigmNS::DataManager> dataManager = blockIt->getDataManager();
+        int numOwnedPoints = neighborhoodData->NumOwnedPoints();
+        int* ownedIDs = neighborhoodData->OwnedIDs();
+        blockIt->getMaterialModel()->computeStoredElasticEnergyDensity(0.0, numOwnedPoints, ownedIDs, neighborhoodData->NeighborhoodList(), *dataManager);
+        double *energyDensity, *blockVolume;
+        dataManager->getData(energyDensityFieldId, PeridigmField::STEP_NONE)->ExtractView(&energyDensity);
+        dataManager->getData(volumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&blockVolume);
+        for(int i=0 ; i<numOwnedPoints ; ++i)
+          storedElasticEnergy += energyDensity[ownedIDs[i]]*blockVolume[ownedIDs[i]];
+      }
+      localValues[offset++] = storedElasticEnergy;
+    }
+    else{
+      double* data;
+      getVariable(probe.variable)->ExtractView(&data);
+      for(unsigned int i=0 ; i<probe.localIds.size() ; ++i){
+        int localId = probe.localIds[i];
+        // Force densities are converted to forces
+        double scale = (probe.type == NODE_SET_RESULTANT) ? volume[localId] : 1.0;
+        for(int dof=0 ; dof<3 ; ++dof)
+          localValues[offset+dof] += scale*data[3*localId+dof];
+      }
+      offset += 3;
+    }
+  }
+
+  // A single reduction for all probes
+  peridigm->getEpetraComm()->SumAll(&localValues[0], &globalValues[0], static_cast<int>(localValues.size()));
+
+  if(iWrite){
+    double* row = &buffer[numBufferedRows*columnNames.size()];
+    row[0] = currentTime;
+    offset = 0;
+    for(unsigned int iProbe=0 ; iProbe<probes.size() ; ++iProbe){
+      const Probe& probe = probes[iProbe];
+      double scale = 1.0;
+      if(probe.type == NODE_SET_AVERAGE && probe.globalNumNodes > 0)
+        scale = 1.0/probe.globalNumNodes;
+      for(int i=0 ; i<numValues(probe) ; ++i)
+        row[1+offset+i] = scale*globalValues[offset+i];
+      offset += numValues(probe);
+    }
+    numBufferedRows++;
+    if(numBufferedRows == bufferSize)
+      flush();
+  }
+
+  PeridigmNS::Timer::self().stopTimer(timerId);
+}
+
+void PeridigmNS::ProbeManager::flush()
+{
+  if(!iWrite || numBufferedRows == 0)
+    return;
+
+  const int numColumns = static_cast<int>(columnNames.size());
+  if(outputFormat == "CSV"){
+    for(int iRow=0 ; iRow<numBufferedRows ; ++iRow){
+      const double* row = &buffer[iRow*numColumns];
+      file << row[0];
+      for(int i=1 ; i<numColumns ; ++i)
+        file << "," << row[i];
+      file << "\n";
+    }
+  }
+  else{
+    file.write(reinterpret_cast<const char*>(&buffer[0]), numBufferedRows*numColumns*sizeof(double));
+  }
+  file.flush();
+  numBufferedRows = 0;
+}
+
+vector<int> PeridigmNS::ProbeManager::FieldIds(const Teuchos::ParameterList& params)
+{
+  vector<int> fieldIds;
+  if(!params.isSublist("Probes"))
+    return fieldIds;
+  const Teuchos::ParameterList& probeParams = params.sublist("Probes");
+  for(Teuchos::ParameterList::ConstIterator it = probeParams.begin() ; it != probeParams.end() ; ++it){
+    if(!probeParams.isSublist(it->first) || !probeParams.sublist(it->first).isParameter("Type"))
+      continue;
+    if(probeParams.sublist(it->first).get<string>("Type") == "Stored Elastic Energy"){
+      fieldIds.push_back(FieldManager::self().getFieldId(PeridigmField::ELEMENT, PeridigmField::SCALAR, PeridigmField::CONSTANT, "Stored_Elastic_Energy_Density"));
+      break;
+    }
+  }
+  return fieldIds;
+}
+
+void PeridigmNS::ProbeManager::writeHeader()
+{
+  if(outputFormat == "CSV"){
+    file << columnNames[0];
+    for(unsigned int i=1 ; i<columnNames.size() ; ++i)
+      file << "," << columnNames[i];
+    file << "\n";
+  }
+  else{
+    int numColumns = static_cast<int>(columnNames.size());
+    file.write(reinterpret_cast<const char*>(&numColumns), sizeof(int));
+    for(unsigned int i=0 ; i<columnNames.size() ; ++i)
+      file.write(columnNames[i].c_str(), columnNames[i].size() + 1);
+  }
+  file.flush();
+}
+
+Teuchos::RCP<Epetra_Vector> PeridigmNS::ProbeManager::getVariable(const string& variable) const
+{
+  Teuchos::RCP<Epetra_Vector> vec;
+  if(variable == "Displacement")
+    vec = peridigm->getU();
+  else if(variable == "Coordinates")
+    vec = peridigm->getY();
+  else if(variable == "Velocity")
+    vec = peridigm->getV();
+  else if(variable == "Force_Density")
+    vec = peridigm->getForce();
+  else if(variable == "External_Force_Density")
+    vec = peridigm->getExternalForce();
+  else if(variable == "Contact_Force_Density")
+    vec = peridigm->getContactForce();
+  else{
+    string msg = "**** Error:  Unknown Time History variable: " + variable + "\n";
+    msg += "**** Valid variables are Displacement, Coordinates, Velocity, Force_Density, External_Force_Density, and Contact_Force_Density.\n";
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(true, msg);
+  }
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(vec.is_null(), "**** Error:  Time History variable " + variable + " is not available.\n");
+  return vec;
+}
+
+void PeridigmNS::ProbeManager::findNearestPoint(const double* point, vector<int>& localIds) const
+{
+  Teuchos::RCP<const Epetra_Comm> comm = peridigm->getEpetraComm();
+
+  double* x;
+  peridigm->getX()->ExtractView(&x);
+  int numOwnedPoints = peridigm->getX()->Map().NumMyElements();
+
+  int nearestLocalId = -1;
+  double localMinDistanceSquared = DBL_MAX;
+  for(int i=0 ; i<numOwnedPoints ; ++i){
+    double dx = x[3*i] - point[0];
+    double dy = x[3*i+1] - point[1];
+    double dz = x[3*i+2] - point[2];
+    double distanceSquared = dx*dx + dy*dy + dz*dz;
+    if(distanceSquared < localMinDistanceSquared){
+      localMinDistanceSquared = distanceSquared;
+      nearestLocalId = i;
+    }
+  }
+
+  double globalMinDistanceSquared;
+  comm->MinAll(&localMinDistanceSquared, &globalMinDistanceSquared, 1);
+
+  // In the case of a tie, the lowest-ranked processor owns the probe
+  int candidatePID = (nearestLocalId != -1 && localMinDistanceSquared == globalMinDistanceSquared) ? comm->MyPID() : comm->NumProc();
+  int ownerPID;
+  comm->MinAll(&candidatePID, &ownerPID, 1);
+
+  if(ownerPID == comm->MyPID())
+    localIds.push_back(nearestLocalId);
+}
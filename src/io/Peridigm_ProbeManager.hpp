@@ -0,0 +1,176 @@
+/*! \file Peridigm_ProbeManager.hpp */
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+#ifndef PERIDIGM_PROBEMANAGER_HPP
+#define PERIDIGM_PROBEMANAGER_HPP
+
+#include <vector>
+#include <string>
+#include <fstream>
+
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_ParameterList.hpp>
+#include <Epetra_Vector.h>
+
+// Forward declaration
+namespace PeridigmNS {
+  class Peridigm;
+}
+
+namespace PeridigmNS {
+
+  /*!
+   * \brief Lightweight per-step time-history output.
+   *
+   * Probes read the solver-level (mothership) vectors directly, so recording does not require
+   * synchDataManagers(), the compute classes, or an Exodus write.  The processor-local contributions
+   * of all probes are combined with a single SumAll() per sample, and processor 0 appends the result
+   * to an in-memory buffer that is flushed to disk whenever it fills and when the manager is destroyed.
+   *
+   * The Stored Elastic Energy probe is the exception:  it evaluates computeStoredElasticEnergyDensity()
+   * of each block's material model on the block data, and so relies on record() being called after
+   * synchDataManagers().  Its contribution is reduced in the same SumAll() as the other probes.
+   *
+   * The CSV format has a header line with the column names followed by one line per sample.  The
+   * BINARY format begins with the number of columns (int), followed by each column name as a
+   * null-terminated string, followed by one row of doubles per sample.
+   */
+  class ProbeManager {
+
+  public:
+
+    //! Constructor; a null parameter list results in an inactive manager.
+    ProbeManager(const Teuchos::RCP<Teuchos::ParameterList>& params,
+                 PeridigmNS::Peridigm *peridigm_);
+
+    //! Destructor; flushes any buffered samples.
+    ~ProbeManager();
+
+    //! Evaluate all probes and record a sample, subject to the sampling frequency.
+    void record(double currentTime);
+
+    //! Write buffered samples to disk.
+    void flush();
+
+    //! Return the ids of the block fields required by the probes in the given Time History parameter list.
+    static std::vector<int> FieldIds(const Teuchos::ParameterList& params);
+
+  private:
+
+    enum ProbeType { NODE_SET_RESULTANT, NODE_SET_AVERAGE, KINETIC_ENERGY, STORED_ELASTIC_ENERGY, NEAREST_POINT };
+
+    struct Probe {
+      std::string name;
+      ProbeType type;
+      std::string variable;
+      //! Mothership local ids of the nodes sampled by this probe on this processor
+      std::vector<int> localIds;
+      //! Number of nodes sampled by this probe across all processors
+      int globalNumNodes;
+    };
+
+    //! Return the number of columns written by a probe.
+    static int numValues(const Probe& probe) { return (probe.type == KINETIC_ENERGY || probe.type == STORED_ELASTIC_ENERGY) ? 1 : 3; }
+
+    //! Return the mothership vector corresponding to a variable name.
+    Teuchos::RCP<Epetra_Vector> getVariable(const std::string& variable) const;
+
+    //! Set the local ids of the owned node nearest to the given point, if this processor owns it.
+    void findNearestPoint(const double* point, std::vector<int>& localIds) const;
+
+    //! Write the column names to the output file.
+    void writeHeader();
+
+    //! Copy constructor.
+    ProbeManager( const ProbeManager& PM );
+
+    //! Assignment operator.
+    ProbeManager& operator=( const ProbeManager& PM );
+
+    //! Owning Peridigm object
+    PeridigmNS::Peridigm* peridigm;
+
+    //! True if any probes are defined
+    bool active;
+
+    //! True if this processor writes to disk
+    bool iWrite;
+
+    //! Record every frequency-th call to record()
+    int frequency;
+
+    //! Number of times record() has been called
+    int count;
+
+    //! CSV or BINARY
+    std::string outputFormat;
+
+    //! Probe definitions
+    std::vector<Probe> probes;
+
+    //! Column names, starting with Time
+    std::vector<std::string> columnNames;
+
+    //! Buffers for the batched reduction
+    std::vector<double> localValues;
+    std::vector<double> globalValues;
+
+    //! Buffered samples, stored row by row
+    std::vector<double> buffer;
+
+    //! Number of rows the buffer can hold before it is flushed
+    int bufferSize;
+
+    //! Number of rows currently in the buffer
+    int numBufferedRows;
+
+    //! Output file
+    std::ofstream file;
+
+    //! Timer handle
+    int timerId;
+  };
+}
+
+#endif //PERIDIGM_PROBEMANAGER_HPP
@@ -209,10 +209,42 @@ void PeridigmNS::ProximitySearch::GlobalProximitySearch(Teuchos::RCP<Epetra_Vect
                                                         std::vector< std::tr1::shared_ptr<PdBondFilter::BondFilter> > bondFilters,  /* optional input */
                                                         double radiusAddition)                                                      /* optional input */
 
+{
+  // Execute the search in its own load-balanced decomposition
+  Teuchos::RCP<Epetra_BlockMap> searchOwnedMap;
+  Teuchos::RCP<Epetra_BlockMap> searchOverlapMap;
+  int searchNeighborListSize;
+  int* searchNeighborList;
+  LoadBalancedGlobalProximitySearch(x, searchRadii, searchOwnedMap, searchOverlapMap, searchNeighborListSize, searchNeighborList, bondFilters, radiusAddition);
+
+  // The neighbor search is complete, but needs to be brought back into the initial decomposition
+  const Epetra_BlockMap& originalMap = x->Map();
+  Teuchos::RCP<const Epetra_BlockMap> targetOwnedMap = Teuchos::rcp(new Epetra_BlockMap(-1, originalMap.NumMyElements(), originalMap.MyGlobalElements(), 1, 0, originalMap.Comm()));
+
+  RebalanceNeighborhoodList(searchOwnedMap,                      /* input  */
+                            searchOverlapMap,                    /* input  */
+                            searchNeighborListSize,              /* input  */
+                            searchNeighborList,                  /* input  */
+                            targetOwnedMap,                      /* input  */
+                            overlapMap,                          /* output */
+                            neighborListSize,                    /* output */
+                            neighborList);                       /* output (allocated within function) */
+
+  delete[] searchNeighborList;
+}
+
+void PeridigmNS::ProximitySearch::LoadBalancedGlobalProximitySearch(Teuchos::RCP<Epetra_Vector> x,                                              /* input  */
+                                                                    Teuchos::RCP<Epetra_Vector> searchRadii,                                    /* input  */
+                                                                    Teuchos::RCP<Epetra_BlockMap>& ownedMap,                                    /* output */
+                                                                    Teuchos::RCP<Epetra_BlockMap>& overlapMap,                                  /* output */
+                                                                    int& neighborListSize,                                                      /* output */
+                                                                    int*& neighborList,                                                         /* output (allocated within function) */
+                                                                    std::vector< std::tr1::shared_ptr<PdBondFilter::BondFilter> > bondFilters,  /* optional input */
+                                                                    double radiusAddition)                                                      /* optional input */
 {
   // The proximity search does not appear to function properly if any of the search radii are set to zero
   for(int i=0 ; i<searchRadii->MyLength() ; ++i){
-    TEUCHOS_TEST_FOR_EXCEPT_MSG((*searchRadii)[i] <= 0.0, "\n****Error:  PeridigmNS::ProximitySearch::GlobalProximitySearch(), search radii must be greater than or equal to zero.\n");
+    TEUCHOS_TEST_FOR_EXCEPT_MSG((*searchRadii)[i] <= 0.0, "\n****Error:  PeridigmNS::ProximitySearch::LoadBalancedGlobalProximitySearch(), search radii must be greater than or equal to zero.\n");
   }
 
   // Copy information from the Epetra_Vector into a QUICKGRID::Data object
@@ -270,7 +302,7 @@ void PeridigmNS::ProximitySearch::GlobalProximitySearch(Teuchos::RCP<Epetra_Vect
                                  rebalancedSearchRadii,
                                  bondFilters);
 
-  // The neighbor search is complete, but needs to be brought back into the initial decomposition
+  // Copy the neighbor list and the maps out of the NeighborhoodList, which indexes into a list of owned ids followed by shared ids
 
   int listNumOwned = list.get_num_owned_points();
   int listNumShared = list.get_num_shared_points();
@@ -283,17 +315,12 @@ void PeridigmNS::ProximitySearch::GlobalProximitySearch(Teuchos::RCP<Epetra_Vect
   for(int i=0 ; i<listNumShared ; ++i)
     overlapIds[i+listNumOwned] = listSharedIds[i];
 
-  Teuchos::RCP<Epetra_BlockMap> currentOwnedMap = Teuchos::rcp(new Epetra_BlockMap(-1, listNumOwned, &overlapIds[0], 1, 0, originalMap.Comm()));
-  Teuchos::RCP<Epetra_BlockMap> currentOverlapMap = Teuchos::rcp(new Epetra_BlockMap(-1, listNumTotal, &overlapIds[0], 1, 0, originalMap.Comm()));
-  Teuchos::RCP<const Epetra_BlockMap> targetOwnedMap = Teuchos::rcp(new Epetra_BlockMap(-1, originalMap.NumMyElements(), originalMap.MyGlobalElements(), 1, 0, originalMap.Comm()));
+  ownedMap = Teuchos::rcp(new Epetra_BlockMap(-1, listNumOwned, &overlapIds[0], 1, 0, originalMap.Comm()));
+  overlapMap = Teuchos::rcp(new Epetra_BlockMap(-1, listNumTotal, &overlapIds[0], 1, 0, originalMap.Comm()));
 
-  RebalanceNeighborhoodList(currentOwnedMap,                     /* input  */
-                            currentOverlapMap,                   /* input  */
-                            list.get_size_neighborhood_list(),   /* input  */
-                            list.get_local_neighborhood().get(), /* input  */
-                            targetOwnedMap,                      /* input  */
-                            overlapMap,                          /* output */
-                            neighborListSize,                    /* output */
-                            neighborList);                       /* output (allocated within function) */
+  neighborListSize = list.get_size_neighborhood_list();
+  neighborList = new int[neighborListSize];
+  const int* listNeighborhood = list.get_local_neighborhood().get();
+  for(int i=0 ; i<neighborListSize ; ++i)
+    neighborList[i] = listNeighborhood[i];
 }
-
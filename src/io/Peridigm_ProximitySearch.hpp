@@ -104,6 +104,30 @@ namespace ProximitySearch {
                              std::vector< std::tr1::shared_ptr<PdBondFilter::BondFilter> > bondFilters = std::vector< std::tr1::shared_ptr<PdBondFilter::BondFilter> >(),
                              double radiusAddition = 0.0);
 
+    /** \brief Global proximity search that returns the neighbor list in the load-balanced decomposition used by the search.
+     *
+     *  \param x                 [input]           Set of points; the neighbors of each point will be found from among the other points in the vector.
+     *  \param searchRadii       [input]           The radii list defining the search sphere for each point.
+     *  \param ownedMap          [output]          Epetra_BlockMap containing the points owned by this processor in the search decomposition.
+     *  \param overlapMap        [output]          Epetra_BlockMap containing the owned points, in the same order as ownedMap, followed by the off-processor neighbors.
+     *  \param neighborListSize  [output]          The length of the neighbor list vector.
+     *  \param neighborList      [output]          Pointer to the neighbor list (indexes into overlapMap), stored as in GlobalProximitySearch().
+     *  \param bondFilters       [optional input]  Set of bond filters to employ during the proximity search.
+     *  \param radiusAddition    [optional input]  An additional length added to each radius defining the search sphere for each point.
+     *
+     *  The points are repartitioned by recursive coordinate bisection prior to the search.  Unlike GlobalProximitySearch(), the neighbor list is not
+     *  migrated back to the decomposition of x; a discretization may instead adopt ownedMap and migrate its per-point data once.
+     *  The neighborList is allocated within this function and becomes the responsibility of the calling routine.
+     **/
+  void LoadBalancedGlobalProximitySearch(Teuchos::RCP<Epetra_Vector> x,
+                                         Teuchos::RCP<Epetra_Vector> searchRadii,
+                                         Teuchos::RCP<Epetra_BlockMap>& ownedMap,
+                                         Teuchos::RCP<Epetra_BlockMap>& overlapMap,
+                                         int& neighborListSize,
+                                         int*& neighborList,
+                                         std::vector< std::tr1::shared_ptr<PdBondFilter::BondFilter> > bondFilters = std::vector< std::tr1::shared_ptr<PdBondFilter::BondFilter> >(),
+                                         double radiusAddition = 0.0);
+
 }
 }
 
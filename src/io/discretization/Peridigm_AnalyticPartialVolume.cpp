@@ -0,0 +1,99 @@
+/*! \file Peridigm_AnalyticPartialVolume.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include "Peridigm_AnalyticPartialVolume.hpp"
+#include "Peridigm_GeometryUtils.hpp"
+#include "Peridigm_Field.hpp"
+#include <cmath>
+
+using namespace std;
+
+void PeridigmNS::computeAnalyticPartialVolume(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks)
+{
+  PeridigmNS::FieldManager& fieldManager = PeridigmNS::FieldManager::self();
+  int horizonFieldId = fieldManager.getFieldId(PeridigmField::ELEMENT, PeridigmField::SCALAR, PeridigmField::CONSTANT, "Horizon");
+  int volumeFieldId = fieldManager.getFieldId(PeridigmField::ELEMENT, PeridigmField::SCALAR, PeridigmField::CONSTANT, "Volume");
+  int modelCoordinatesFieldId = fieldManager.getFieldId(PeridigmField::NODE, PeridigmField::VECTOR, PeridigmField::CONSTANT, "Model_Coordinates");
+  int neighborVolumeFieldId = fieldManager.getFieldId(PeridigmField::BOND, PeridigmField::SCALAR, PeridigmField::CONSTANT, "Neighbor_Volume");
+  int selfVolumeFieldId = fieldManager.getFieldId(PeridigmField::BOND, PeridigmField::SCALAR, PeridigmField::CONSTANT, "Self_Volume");
+
+  double *horizon, *volume, *modelCoordinates, *neighborVolume, *selfVolume;
+  double x, y, z, distance;
+  int numOwnedPoints, numNeighbors, neighborIndex, bondIndex;
+
+  for(std::vector<PeridigmNS::Block>::iterator blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
+
+    Teuchos::RCP<PeridigmNS::NeighborhoodData> neighborhoodData = blockIt->getNeighborhoodData();
+    numOwnedPoints = neighborhoodData->NumOwnedPoints();
+    const int* neighborhoodList = neighborhoodData->NeighborhoodList();
+
+    blockIt->getData(horizonFieldId, PeridigmField::STEP_NONE)->ExtractView(&horizon);
+    blockIt->getData(volumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&volume);
+    blockIt->getData(modelCoordinatesFieldId, PeridigmField::STEP_NONE)->ExtractView(&modelCoordinates);
+    blockIt->getData(neighborVolumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&neighborVolume);
+    blockIt->getData(selfVolumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&selfVolume);
+
+    const int* neighborListPtr = neighborhoodList;
+    bondIndex = 0;
+    for(int iID=0 ; iID<numOwnedPoints ; ++iID){
+      numNeighbors = *neighborListPtr; neighborListPtr++;
+      for(int n=0 ; n<numNeighbors ; ++n, ++neighborListPtr, ++bondIndex){
+        neighborIndex = *neighborListPtr;
+        x = modelCoordinates[3*neighborIndex]   - modelCoordinates[3*iID];
+        y = modelCoordinates[3*neighborIndex+1] - modelCoordinates[3*iID+1];
+        z = modelCoordinates[3*neighborIndex+2] - modelCoordinates[3*iID+2];
+        distance = std::sqrt(x*x + y*y + z*z);
+
+        // Portion of the neighbor's cell within the horizon of the point
+        neighborVolume[bondIndex] = volume[neighborIndex] * cellSphereVolumeFraction(volume[neighborIndex], distance, horizon[iID]);
+
+        // Portion of the point's cell within the horizon of the neighbor
+        selfVolume[bondIndex] = volume[iID] * cellSphereVolumeFraction(volume[iID], distance, horizon[neighborIndex]);
+      }
+    }
+  }
+}
@@ -0,0 +1,777 @@
+/*! \file Peridigm_BinaryDiscretization.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+
+#include "Peridigm_BinaryDiscretization.hpp"
+#include "Peridigm_ProximitySearch.hpp"
+#include "Peridigm_HorizonManager.hpp"
+#include <Epetra_Import.h>
+#include <Teuchos_Assert.hpp>
+
+#include <set>
+#include <sstream>
+#include <cstring>
+#include <climits>
+#include <cmath>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+
+  // File layout:
+  //   char[8]   "PDBINDSC"
+  //   int32     format version
+  //   int32     number of sections
+  //   int64     number of points
+  //   int64     number of neighbor list entries (zero if the file does not contain a neighbor list)
+  //   section table, one entry per section:  int32 id, int32 element size in bytes, int64 offset, int64 length in bytes
+  //   section data, each section starting on a 64-byte boundary
+  // The GLOBAL_IDS, COORDINATES, VOLUMES, BLOCK_IDS, and BLOCK_NAMES sections are required.  A text file discretization
+  // with Input Mesh Format "Binary" reads only the COORDINATES, VOLUMES, and BLOCK_IDS sections.
+  const char binaryDiscretizationMagic[8] = {'P', 'D', 'B', 'I', 'N', 'D', 'S', 'C'};
+  const int binaryDiscretizationVersion = 1;
+  const long long headerSize = 32;
+  const long long sectionEntrySize = 24;
+  const long long sectionAlignment = 64;
+
+  long long alignOffset(long long offset)
+  {
+    return ((offset + sectionAlignment - 1)/sectionAlignment)*sectionAlignment;
+  }
+
+  bool hostIsLittleEndian()
+  {
+    int one = 1;
+    return *reinterpret_cast<char*>(&one) == 1;
+  }
+
+  //! Read numBytes at the given offset, retrying until the read is complete.
+  void preadAll(int fileDescriptor, void* buffer, long long numBytes, long long offset)
+  {
+    char* ptr = static_cast<char*>(buffer);
+    while(numBytes > 0){
+      ssize_t numRead = pread(fileDescriptor, ptr, static_cast<size_t>(numBytes), static_cast<off_t>(offset));
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(numRead <= 0, "**** Error reading binary discretization file.\n");
+      ptr += numRead;
+      numBytes -= numRead;
+      offset += numRead;
+    }
+  }
+
+  //! Write numBytes at the given offset, retrying until the write is complete.
+  void pwriteAll(int fileDescriptor, const void* buffer, long long numBytes, long long offset)
+  {
+    const char* ptr = static_cast<const char*>(buffer);
+    while(numBytes > 0){
+      ssize_t numWritten = pwrite(fileDescriptor, ptr, static_cast<size_t>(numBytes), static_cast<off_t>(offset));
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(numWritten <= 0, "**** Error writing binary discretization file.\n");
+      ptr += numWritten;
+      numBytes -= numWritten;
+      offset += numWritten;
+    }
+  }
+
+  //! FNV-1a hash of a byte buffer.
+  unsigned int hashBytes(const vector<char>& buffer, unsigned int hash)
+  {
+    for(unsigned int i=0 ; i<buffer.size() ; ++i){
+      hash ^= static_cast<unsigned char>(buffer[i]);
+      hash *= 16777619u;
+    }
+    return hash;
+  }
+
+  template<class T>
+  void appendBytes(vector<char>& buffer, const T& value)
+  {
+    const char* ptr = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), ptr, ptr + sizeof(T));
+  }
+
+  template<class T>
+  T extractBytes(const vector<char>& buffer, size_t& position)
+  {
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(position + sizeof(T) > buffer.size(), "**** Error reading binary discretization file, corrupt section.\n");
+    T value;
+    memcpy(&value, &buffer[position], sizeof(T));
+    position += sizeof(T);
+    return value;
+  }
+}
+
+PeridigmNS::BinaryDiscretization::BinaryDiscretization(const Teuchos::RCP<const Epetra_Comm>& epetra_comm,
+                                                       const Teuchos::RCP<Teuchos::ParameterList>& params) :
+  minElementRadius(1.0e50),
+  maxElementRadius(0.0),
+  numBonds(0),
+  maxNumBondsPerElem(0),
+  myPID(epetra_comm->MyPID()),
+  numPID(epetra_comm->NumProc()),
+  comm(epetra_comm)
+{
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(params->get<string>("Type") != "Binary", "Invalid Type in BinaryDiscretization");
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(!hostIsLittleEndian(), "**** Error, binary discretization files are supported only on little-endian platforms.\n");
+
+  string meshFileName = params->get<string>("Input Mesh File");
+
+  // Set up bond filters, these are used only if the file does not contain a neighbor list
+  createBondFilters(params);
+
+  loadData(meshFileName);
+
+  // Create the three-dimensional overlap map based on the one-dimensional overlap map
+  threeDimensionalOverlapMap = Teuchos::rcp(new Epetra_BlockMap(-1,
+                                                                oneDimensionalOverlapMap->NumMyElements(),
+                                                                oneDimensionalOverlapMap->MyGlobalElements(),
+                                                                3,
+                                                                0,
+                                                                oneDimensionalOverlapMap->Comm()));
+
+  // \todo Move this functionality to base class, it's currently duplicated in PdQuickGridDiscretization.
+  // Create the bondMap, a local map used for constitutive data stored on bonds.
+  // Due to Epetra_BlockMap restrictions, there can not be any entries with length zero.
+  // This means that points with no neighbors can not appear in the bondMap.
+  int numMyElementsUpperBound = oneDimensionalMap->NumMyElements();
+  int numGlobalElements = -1;
+  int numMyElements = 0;
+  int maxNumBonds = 0;
+  int* oneDimensionalMapGlobalElements = oneDimensionalMap->MyGlobalElements();
+  int* myGlobalElements = new int[numMyElementsUpperBound];
+  int* elementSizeList = new int[numMyElementsUpperBound];
+  int* const neighborhood = neighborhoodData->NeighborhoodList();
+  int neighborhoodIndex = 0;
+  int numPointsWithZeroNeighbors = 0;
+  for(int i=0 ; i<neighborhoodData->NumOwnedPoints() ; ++i){
+    int numNeighbors = neighborhood[neighborhoodIndex];
+    if(numNeighbors > 0){
+      numMyElements++;
+      myGlobalElements[i-numPointsWithZeroNeighbors] = oneDimensionalMapGlobalElements[i];
+      elementSizeList[i-numPointsWithZeroNeighbors] = numNeighbors;
+    }
+    else{
+      numPointsWithZeroNeighbors++;
+    }
+    numBonds += numNeighbors;
+    if(numNeighbors>maxNumBonds) maxNumBonds = numNeighbors;
+    neighborhoodIndex += 1 + numNeighbors;
+  }
+  maxNumBondsPerElem = maxNumBonds;
+  int indexBase = 0;
+  bondMap = Teuchos::rcp(new Epetra_BlockMap(numGlobalElements, numMyElements, myGlobalElements, elementSizeList, indexBase, *comm));
+  delete[] myGlobalElements;
+  delete[] elementSizeList;
+
+  // find the minimum element radius
+  for(int i=0 ; i<cellVolume->MyLength() ; ++i){
+    double radius = pow(0.238732414637843*(*cellVolume)[i], 0.33333333333333333);
+    if(radius < minElementRadius)
+      minElementRadius = radius;
+    if(radius > maxElementRadius)
+      maxElementRadius = radius;
+  }
+  vector<double> localMin(1);
+  vector<double> globalMin(1);
+  localMin[0] = minElementRadius;
+  epetra_comm->MinAll(&localMin[0], &globalMin[0], 1);
+  minElementRadius = globalMin[0];
+  localMin[0] = maxElementRadius;
+  epetra_comm->MaxAll(&localMin[0], &globalMin[0], 1);
+  maxElementRadius = globalMin[0];
+}
+
+PeridigmNS::BinaryDiscretization::~BinaryDiscretization() {}
+
+map<int, PeridigmNS::BinaryDiscretization::Section>
+PeridigmNS::BinaryDiscretization::readSectionTable(int fileDescriptor,
+                                                   const string& fileName,
+                                                   long long& numPoints,
+                                                   long long& numNeighborEntries)
+{
+  // Header
+  char magic[8];
+  int version, numSections;
+  vector<char> header(headerSize);
+  preadAll(fileDescriptor, &header[0], headerSize, 0);
+  size_t position(0);
+  memcpy(magic, &header[0], 8);
+  position += 8;
+  version = extractBytes<int>(header, position);
+  numSections = extractBytes<int>(header, position);
+  numPoints = extractBytes<long long>(header, position);
+  numNeighborEntries = extractBytes<long long>(header, position);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(memcmp(magic, binaryDiscretizationMagic, 8) != 0,
+                              "**** Error, " + fileName + " is not a binary discretization file.\n");
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(version != binaryDiscretizationVersion,
+                              "**** Error, unsupported binary discretization file version.\n");
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(numPoints < 1 || numPoints > INT_MAX,
+                              "**** Error reading binary discretization file, invalid number of points.\n");
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(numSections < 0 || numSections > 64,
+                              "**** Error reading binary discretization file, invalid number of sections.\n");
+
+  // Offset table
+  map<int, Section> sections;
+  vector<char> table(numSections*sectionEntrySize);
+  if(numSections > 0)
+    preadAll(fileDescriptor, &table[0], numSections*sectionEntrySize, headerSize);
+  position = 0;
+  for(int i=0 ; i<numSections ; ++i){
+    Section section;
+    section.id = extractBytes<int>(table, position);
+    section.elementSize = extractBytes<int>(table, position);
+    section.offset = extractBytes<long long>(table, position);
+    section.length = extractBytes<long long>(table, position);
+    sections[section.id] = section;
+  }
+  return sections;
+}
+
+void PeridigmNS::BinaryDiscretization::readPointData(const string& fileName,
+                                                     int myPID,
+                                                     int numPID,
+                                                     vector<double>& coordinates,
+                                                     vector<int>& blockIds,
+                                                     vector<double>& volumes)
+{
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(!hostIsLittleEndian(), "**** Error, binary discretization files are supported only on little-endian platforms.\n");
+
+  int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(fileDescriptor < 0, "**** Error opening binary discretization file " + fileName + ".\n");
+
+  long long numPoints, numNeighborEntries;
+  map<int, Section> sections = readSectionTable(fileDescriptor, fileName, numPoints, numNeighborEntries);
+  int requiredSections[] = {COORDINATES, VOLUMES, BLOCK_IDS};
+  for(int i=0 ; i<3 ; ++i){
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(sections.find(requiredSections[i]) == sections.end(),
+                                "**** Error reading binary discretization file, missing required section.\n");
+  }
+
+  // Each processor reads a contiguous slab of points
+  int firstPoint = static_cast<int>( (numPoints*myPID)/numPID );
+  int numMyPoints = static_cast<int>( (numPoints*(myPID+1))/numPID ) - firstPoint;
+  coordinates.resize(3*numMyPoints);
+  blockIds.resize(numMyPoints);
+  volumes.resize(numMyPoints);
+  if(numMyPoints > 0){
+    preadAll(fileDescriptor, &coordinates[0], 3*numMyPoints*sizeof(double), sections[COORDINATES].offset + 3*firstPoint*sizeof(double));
+    preadAll(fileDescriptor, &blockIds[0], numMyPoints*sizeof(int), sections[BLOCK_IDS].offset + firstPoint*sizeof(int));
+    preadAll(fileDescriptor, &volumes[0], numMyPoints*sizeof(double), sections[VOLUMES].offset + firstPoint*sizeof(double));
+  }
+  close(fileDescriptor);
+}
+
+void PeridigmNS::BinaryDiscretization::loadData(const string& fileName)
+{
+  int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(fileDescriptor < 0, "**** Error opening binary discretization file " + fileName + ".\n");
+
+  long long numPoints, numNeighborEntries;
+  map<int, Section> sections = readSectionTable(fileDescriptor, fileName, numPoints, numNeighborEntries);
+  int requiredSections[] = {GLOBAL_IDS, COORDINATES, VOLUMES, BLOCK_IDS, BLOCK_NAMES};
+  for(int i=0 ; i<5 ; ++i){
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(sections.find(requiredSections[i]) == sections.end(),
+                                "**** Error reading binary discretization file, missing required section.\n");
+  }
+  bool hasNeighborList = sections.find(NEIGHBOR_OFFSETS) != sections.end() && sections.find(NEIGHBORS) != sections.end();
+
+  // Each processor reads a contiguous slab of points
+  // Points are stored in the order of the decomposition that wrote the file, so the slabs are spatially compact
+  int firstPoint = static_cast<int>( (numPoints*myPID)/numPID );
+  int numMyPoints = static_cast<int>( (numPoints*(myPID+1))/numPID ) - firstPoint;
+
+  vector<int> globalIds(numMyPoints);
+  vector<int> blockIds(numMyPoints);
+  if(numMyPoints > 0){
+    preadAll(fileDescriptor, &globalIds[0], numMyPoints*sizeof(int), sections[GLOBAL_IDS].offset + firstPoint*sizeof(int));
+    preadAll(fileDescriptor, &blockIds[0], numMyPoints*sizeof(int), sections[BLOCK_IDS].offset + firstPoint*sizeof(int));
+  }
+
+  int* myGlobalIds = numMyPoints > 0 ? &globalIds[0] : 0;
+  oneDimensionalMap = Teuchos::rcp(new Epetra_BlockMap(static_cast<int>(numPoints), numMyPoints, myGlobalIds, 1, 0, *comm));
+  threeDimensionalMap = Teuchos::rcp(new Epetra_BlockMap(static_cast<int>(numPoints), numMyPoints, myGlobalIds, 3, 0, *comm));
+  initialX = Teuchos::rcp(new Epetra_Vector(*threeDimensionalMap));
+  cellVolume = Teuchos::rcp(new Epetra_Vector(*oneDimensionalMap));
+  blockID = Teuchos::rcp(new Epetra_Vector(*oneDimensionalMap));
+  horizonForEachPoint = Teuchos::rcp(new Epetra_Vector(*oneDimensionalMap));
+
+  // The Epetra_Vectors are read directly from the file
+  double* ptr;
+  if(numMyPoints > 0){
+    initialX->ExtractView(&ptr);
+    preadAll(fileDescriptor, ptr, 3*numMyPoints*sizeof(double), sections[COORDINATES].offset + 3*firstPoint*sizeof(double));
+    cellVolume->ExtractView(&ptr);
+    preadAll(fileDescriptor, ptr, numMyPoints*sizeof(double), sections[VOLUMES].offset + firstPoint*sizeof(double));
+  }
+  for(int i=0 ; i<numMyPoints ; ++i)
+    (*blockID)[i] = blockIds[i];
+
+  // Block names, every processor records every block
+  vector<char> blockNameData(sections[BLOCK_NAMES].length);
+  if(blockNameData.size() > 0)
+    preadAll(fileDescriptor, &blockNameData[0], blockNameData.size(), sections[BLOCK_NAMES].offset);
+  map<int, string> blockNames;
+  size_t position(0);
+  while(position < blockNameData.size()){
+    int blockId = extractBytes<int>(blockNameData, position);
+    int nameLength = extractBytes<int>(blockNameData, position);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(nameLength < 0 || position + nameLength > blockNameData.size(),
+                                "**** Error reading binary discretization file, corrupt block name section.\n");
+    string blockName(&blockNameData[position], nameLength);
+    position += nameLength;
+    blockNames[blockId] = blockName;
+    (*elementBlocks)[blockName] = vector<int>();
+  }
+  for(int i=0 ; i<numMyPoints ; ++i){
+    map<int, string>::const_iterator it = blockNames.find(blockIds[i]);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(it == blockNames.end(), "**** Error reading binary discretization file, invalid block id.\n");
+    (*elementBlocks)[it->second].push_back(globalIds[i]);
+  }
+
+  // Horizons are taken from the file if present, otherwise they are evaluated as for the other discretization types
+  if(sections.find(HORIZONS) != sections.end()){
+    if(numMyPoints > 0){
+      horizonForEachPoint->ExtractView(&ptr);
+      preadAll(fileDescriptor, ptr, numMyPoints*sizeof(double), sections[HORIZONS].offset + firstPoint*sizeof(double));
+    }
+  }
+  else{
+    PeridigmNS::HorizonManager& horizonManager = PeridigmNS::HorizonManager::self();
+    for(map<string, vector<int> >::const_iterator it = elementBlocks->begin() ; it != elementBlocks->end() ; it++){
+      const string& blockName = it->first;
+      const vector<int>& blockGlobalIds = it->second;
+      bool hasConstantHorizon = horizonManager.blockHasConstantHorizon(blockName);
+      double constantHorizonValue(0.0);
+      if(hasConstantHorizon)
+        constantHorizonValue = horizonManager.getBlockConstantHorizonValue(blockName);
+      for(unsigned int i=0 ; i<blockGlobalIds.size() ; ++i){
+        int localId = oneDimensionalMap->LID(blockGlobalIds[i]);
+        if(hasConstantHorizon){
+          (*horizonForEachPoint)[localId] = constantHorizonValue;
+        }
+        else{
+          double x = (*initialX)[localId*3];
+          double y = (*initialX)[localId*3 + 1];
+          double z = (*initialX)[localId*3 + 2];
+          (*horizonForEachPoint)[localId] = horizonManager.evaluateHorizon(blockName, x, y, z);
+        }
+      }
+    }
+  }
+
+  // Node sets, each processor retains the locally-owned points in each set
+  nodeSets = Teuchos::rcp< map<string, vector<int> > >(new map<string, vector<int> >() );
+  nodeSetIds = Teuchos::rcp< map<string, int> >(new map<string, int>() );
+  if(sections.find(NODE_SETS) != sections.end() && sections.find(NODE_SET_IDS) != sections.end()){
+    vector<char> nodeSetData(sections[NODE_SETS].length);
+    if(nodeSetData.size() > 0)
+      preadAll(fileDescriptor, &nodeSetData[0], nodeSetData.size(), sections[NODE_SETS].offset);
+    const int chunkSize = 65536;
+    vector<int> chunk(chunkSize);
+    position = 0;
+    while(position < nodeSetData.size()){
+      int nodeSetId = extractBytes<int>(nodeSetData, position);
+      int nameLength = extractBytes<int>(nodeSetData, position);
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(nameLength < 0 || position + nameLength > nodeSetData.size(),
+                                  "**** Error reading binary discretization file, corrupt node set section.\n");
+      string nodeSetName(&nodeSetData[position], nameLength);
+      position += nameLength;
+      long long nodeSetOffset = extractBytes<long long>(nodeSetData, position);
+      long long nodeSetSize = extractBytes<long long>(nodeSetData, position);
+      (*nodeSetIds)[nodeSetName] = nodeSetId;
+      vector<int>& nodeSet = (*nodeSets)[nodeSetName];
+      for(long long chunkStart=0 ; chunkStart<nodeSetSize ; chunkStart+=chunkSize){
+        long long numThisChunk = min(static_cast<long long>(chunkSize), nodeSetSize - chunkStart);
+        preadAll(fileDescriptor, &chunk[0], numThisChunk*sizeof(int), sections[NODE_SET_IDS].offset + (nodeSetOffset + chunkStart)*sizeof(int));
+        for(long long i=0 ; i<numThisChunk ; ++i){
+          if(oneDimensionalMap->MyGID(chunk[i]))
+            nodeSet.push_back(chunk[i]);
+        }
+      }
+    }
+  }
+
+  int neighborListSize(0);
+  int* neighborList(0);
+  if(hasNeighborList){
+    // Read the neighbor list for the slab, and create the overlap map from the owned points followed by the ghosted neighbors
+    vector<long long> neighborOffsets(numMyPoints + 1);
+    preadAll(fileDescriptor, &neighborOffsets[0], (numMyPoints + 1)*sizeof(long long), sections[NEIGHBOR_OFFSETS].offset + firstPoint*sizeof(long long));
+    long long numMyNeighborEntries = neighborOffsets[numMyPoints] - neighborOffsets[0];
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(numMyNeighborEntries < 0 || neighborOffsets[numMyPoints] > numNeighborEntries,
+                                "**** Error reading binary discretization file, corrupt neighbor list.\n");
+    vector<int> neighborGlobalIds(numMyNeighborEntries);
+    if(numMyNeighborEntries > 0)
+      preadAll(fileDescriptor, &neighborGlobalIds[0], numMyNeighborEntries*sizeof(int), sections[NEIGHBORS].offset + neighborOffsets[0]*sizeof(int));
+
+    set<int> ghostGlobalIds;
+    for(long long i=0 ; i<numMyNeighborEntries ; ++i){
+      if(!oneDimensionalMap->MyGID(neighborGlobalIds[i]))
+        ghostGlobalIds.insert(neighborGlobalIds[i]);
+    }
+    vector<int> overlapGlobalIds(globalIds);
+    overlapGlobalIds.insert(overlapGlobalIds.end(), ghostGlobalIds.begin(), ghostGlobalIds.end());
+    int* myOverlapGlobalIds = overlapGlobalIds.size() > 0 ? &overlapGlobalIds[0] : 0;
+    oneDimensionalOverlapMap = Teuchos::rcp(new Epetra_BlockMap(-1, static_cast<int>(overlapGlobalIds.size()), myOverlapGlobalIds, 1, 0, *comm));
+
+    neighborListSize = static_cast<int>(numMyPoints + numMyNeighborEntries);
+    neighborList = new int[neighborListSize];
+    int neighborListIndex(0);
+    for(int i=0 ; i<numMyPoints ; ++i){
+      neighborList[neighborListIndex++] = static_cast<int>(neighborOffsets[i+1] - neighborOffsets[i]);
+      for(long long j=neighborOffsets[i] ; j<neighborOffsets[i+1] ; ++j)
+        neighborList[neighborListIndex++] = oneDimensionalOverlapMap->LID(neighborGlobalIds[j - neighborOffsets[0]]);
+    }
+  }
+  close(fileDescriptor);
+
+  if(!hasNeighborList)
+    ProximitySearch::GlobalProximitySearch(initialX, horizonForEachPoint, oneDimensionalOverlapMap, neighborListSize, neighborList, bondFilters);
+
+  createNeighborhoodData(neighborListSize, neighborList);
+  delete[] neighborList;
+}
+
+void
+PeridigmNS::BinaryDiscretization::createNeighborhoodData(int neighborListSize, int* neighborList)
+{
+   int numOwnedIds = oneDimensionalMap->NumMyElements();
+   vector<int> ownedLocalIds(numOwnedIds);
+   vector<int> neighborhoodPtr(numOwnedIds);
+
+   int numNeighbors(0), neighborListIndex(0);
+   for(int i=0 ; i<numOwnedIds ; ++i){
+     ownedLocalIds[i] = i;
+     neighborhoodPtr[i] = neighborListIndex;
+     numNeighbors = neighborList[neighborListIndex++];
+     neighborListIndex += numNeighbors;
+   }
+
+   neighborhoodData = Teuchos::rcp(new PeridigmNS::NeighborhoodData);
+   neighborhoodData->SetNumOwned(numOwnedIds);
+   if(numOwnedIds > 0){
+     memcpy(neighborhoodData->OwnedIDs(), &ownedLocalIds[0], numOwnedIds*sizeof(int));
+     memcpy(neighborhoodData->NeighborhoodPtr(), &neighborhoodPtr[0], numOwnedIds*sizeof(int));
+   }
+   neighborhoodData->SetNeighborhoodListSize(neighborListSize);
+   memcpy(neighborhoodData->NeighborhoodList(), neighborList, neighborListSize*sizeof(int));
+}
+
+void
+PeridigmNS::BinaryDiscretization::write(const Teuchos::RCP<PeridigmNS::Discretization>& discretization,
+                                        const Teuchos::RCP<const Epetra_Comm>& epetraComm,
+                                        const string& fileName,
+                                        bool writeNeighborList)
+{
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(!hostIsLittleEndian(), "**** Error, binary discretization files are supported only on little-endian platforms.\n");
+
+  int myPID = epetraComm->MyPID();
+  Teuchos::RCP<const Epetra_BlockMap> ownedMap = discretization->getGlobalOwnedMap(1);
+  Teuchos::RCP<const Epetra_BlockMap> overlapMap = discretization->getGlobalOverlapMap(1);
+  int numMyPoints = ownedMap->NumMyElements();
+
+  // Per-point data for the locally-owned points
+  vector<int> blockIds(numMyPoints);
+  Teuchos::RCP<Epetra_Vector> blockIdVector = discretization->getBlockID();
+  for(int i=0 ; i<numMyPoints ; ++i)
+    blockIds[i] = static_cast<int>((*blockIdVector)[i]);
+
+  // Neighbor list, stored with global ids
+  vector<long long> neighborOffsets(numMyPoints + 1, 0);
+  vector<int> neighborGlobalIds;
+  if(writeNeighborList){
+    Teuchos::RCP<PeridigmNS::NeighborhoodData> neighborhoodData = discretization->getNeighborhoodData();
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(neighborhoodData->NumOwnedPoints() != numMyPoints,
+                                "**** Error in BinaryDiscretization::write(), neighborhood data does not match the owned map.\n");
+    const int* const ownedIds = neighborhoodData->OwnedIDs();
+    const int* const neighborhoodPtr = neighborhoodData->NeighborhoodPtr();
+    const int* const neighborhoodList = neighborhoodData->NeighborhoodList();
+    neighborGlobalIds.reserve(neighborhoodData->NeighborhoodListSize());
+    for(int i=0 ; i<numMyPoints ; ++i){
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(ownedIds[i] != i, "**** Error in BinaryDiscretization::write(), unexpected ordering of neighborhood data.\n");
+      int index = neighborhoodPtr[i];
+      int numNeighbors = neighborhoodList[index++];
+      for(int j=0 ; j<numNeighbors ; ++j)
+        neighborGlobalIds.push_back(overlapMap->GID(neighborhoodList[index++]));
+      neighborOffsets[i+1] = static_cast<long long>(neighborGlobalIds.size());
+    }
+  }
+
+  // Node sets are written in name order, all processors must have the same set of names (checked below)
+  Teuchos::RCP< map<string, vector<int> > > nodeSets = discretization->getNodeSets();
+  Teuchos::RCP< map<string, int> > nodeSetIds = discretization->getNodeSetIds();
+  int numNodeSets = static_cast<int>(nodeSets->size());
+  int minNumNodeSets, maxNumNodeSets;
+  epetraComm->MinAll(&numNodeSets, &minNumNodeSets, 1);
+  epetraComm->MaxAll(&numNodeSets, &maxNumNodeSets, 1);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(minNumNodeSets != maxNumNodeSets,
+                              "**** Error in BinaryDiscretization::write(), node sets are not defined consistently across processors.\n");
+
+  // Offsets of this processor's data within each global array
+  // localCounts:  number of points, number of neighbor entries, number of entries in each node set
+  vector<long> localCounts(2 + numNodeSets), scanCounts(2 + numNodeSets), globalCounts(2 + numNodeSets);
+  localCounts[0] = numMyPoints;
+  localCounts[1] = static_cast<long>(neighborGlobalIds.size());
+  int index = 2;
+  for(map<string, vector<int> >::const_iterator it = nodeSets->begin() ; it != nodeSets->end() ; it++)
+    localCounts[index++] = static_cast<long>(it->second.size());
+  epetraComm->ScanSum(&localCounts[0], &scanCounts[0], 2 + numNodeSets);
+  epetraComm->SumAll(&localCounts[0], &globalCounts[0], 2 + numNodeSets);
+  long long numPoints = globalCounts[0];
+  long long numNeighborEntries = writeNeighborList ? globalCounts[1] : 0;
+  long long myFirstPoint = scanCounts[0] - localCounts[0];
+  long long myFirstNeighborEntry = scanCounts[1] - localCounts[1];
+
+  // Variable-length sections, identical on all processors
+  vector<char> blockNameData;
+  Teuchos::RCP< map<string, vector<int> > > elementBlocks = discretization->getElementBlocks();
+  for(map<string, vector<int> >::const_iterator it = elementBlocks->begin() ; it != elementBlocks->end() ; it++){
+    appendBytes(blockNameData, discretization->blockNameToBlockId(it->first));
+    appendBytes(blockNameData, static_cast<int>(it->first.size()));
+    blockNameData.insert(blockNameData.end(), it->first.begin(), it->first.end());
+  }
+  vector<char> nodeSetData;
+  long long nodeSetOffset(0);
+  index = 0;
+  for(map<string, vector<int> >::const_iterator it = nodeSets->begin() ; it != nodeSets->end() ; it++, index++){
+    int nodeSetId = index + 1;
+    if(!nodeSetIds.is_null() && nodeSetIds->find(it->first) != nodeSetIds->end())
+      nodeSetId = (*nodeSetIds)[it->first];
+    appendBytes(nodeSetData, nodeSetId);
+    appendBytes(nodeSetData, static_cast<int>(it->first.size()));
+    nodeSetData.insert(nodeSetData.end(), it->first.begin(), it->first.end());
+    appendBytes(nodeSetData, nodeSetOffset);
+    appendBytes(nodeSetData, static_cast<long long>(globalCounts[2 + index]));
+    nodeSetOffset += globalCounts[2 + index];
+  }
+
+  // The variable-length sections are written by the root processor only, so check that every processor
+  // has the same block and node set names by comparing the size and a hash of the section data
+  int signature[3] = {static_cast<int>(blockNameData.size()), static_cast<int>(nodeSetData.size()), 0};
+  signature[2] = static_cast<int>(hashBytes(nodeSetData, hashBytes(blockNameData, 2166136261u)) & 0x7fffffffu);
+  int minSignature[3], maxSignature[3];
+  epetraComm->MinAll(signature, minSignature, 3);
+  epetraComm->MaxAll(signature, maxSignature, 3);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(minSignature[0] != maxSignature[0] || minSignature[1] != maxSignature[1] || minSignature[2] != maxSignature[2],
+                              "**** Error in BinaryDiscretization::write(), block or node set names are not defined consistently across processors.\n");
+
+  // Section layout
+  vector<Section> sections;
+  Section section;
+  int sectionIds[] = {GLOBAL_IDS, COORDINATES, VOLUMES, BLOCK_IDS, HORIZONS, NEIGHBOR_OFFSETS, NEIGHBORS, BLOCK_NAMES, NODE_SETS, NODE_SET_IDS};
+  int elementSizes[] = {sizeof(int), sizeof(double), sizeof(double), sizeof(int), sizeof(double), sizeof(long long), sizeof(int), 1, 1, sizeof(int)};
+  long long lengths[] = {static_cast<long long>(numPoints*sizeof(int)),
+                         static_cast<long long>(3*numPoints*sizeof(double)),
+                         static_cast<long long>(numPoints*sizeof(double)),
+                         static_cast<long long>(numPoints*sizeof(int)),
+                         static_cast<long long>(numPoints*sizeof(double)),
+                         static_cast<long long>((numPoints + 1)*sizeof(long long)),
+                         static_cast<long long>(numNeighborEntries*sizeof(int)),
+                         static_cast<long long>(blockNameData.size()),
+                         static_cast<long long>(nodeSetData.size()),
+                         static_cast<long long>(nodeSetOffset*sizeof(int))};
+  int numSections = writeNeighborList ? 10 : 8;
+  long long offset = alignOffset(headerSize + numSections*sectionEntrySize);
+  map<int, long long> sectionOffsets;
+  for(int i=0 ; i<10 ; ++i){
+    if(!writeNeighborList && (sectionIds[i] == NEIGHBOR_OFFSETS || sectionIds[i] == NEIGHBORS))
+      continue;
+    section.id = sectionIds[i];
+    section.elementSize = elementSizes[i];
+    section.offset = offset;
+    section.length = lengths[i];
+    sections.push_back(section);
+    sectionOffsets[section.id] = offset;
+    offset = alignOffset(offset + section.length);
+  }
+  long long fileSize = offset;
+
+  // The root processor creates the file and writes the header and the variable-length sections
+  int fileDescriptor(-1);
+  if(myPID == 0){
+    fileDescriptor = open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(fileDescriptor < 0, "**** Error creating binary discretization file " + fileName + ".\n");
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(ftruncate(fileDescriptor, static_cast<off_t>(fileSize)) != 0,
+                                "**** Error creating binary discretization file " + fileName + ".\n");
+    vector<char> header(binaryDiscretizationMagic, binaryDiscretizationMagic + 8);
+    appendBytes(header, binaryDiscretizationVersion);
+    appendBytes(header, numSections);
+    appendBytes(header, numPoints);
+    appendBytes(header, numNeighborEntries);
+    for(unsigned int i=0 ; i<sections.size() ; ++i){
+      appendBytes(header, sections[i].id);
+      appendBytes(header, sections[i].elementSize);
+      appendBytes(header, sections[i].offset);
+      appendBytes(header, sections[i].length);
+    }
+    pwriteAll(fileDescriptor, &header[0], header.size(), 0);
+    if(blockNameData.size() > 0)
+      pwriteAll(fileDescriptor, &blockNameData[0], blockNameData.size(), sectionOffsets[BLOCK_NAMES]);
+    if(nodeSetData.size() > 0)
+      pwriteAll(fileDescriptor, &nodeSetData[0], nodeSetData.size(), sectionOffsets[NODE_SETS]);
+  }
+  epetraComm->Barrier();
+  if(myPID != 0){
+    fileDescriptor = open(fileName.c_str(), O_WRONLY);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(fileDescriptor < 0, "**** Error opening binary discretization file " + fileName + ".\n");
+  }
+
+  // Each processor writes its slab of each per-point array
+  if(numMyPoints > 0){
+    double* ptr;
+    pwriteAll(fileDescriptor, ownedMap->MyGlobalElements(), numMyPoints*sizeof(int), sectionOffsets[GLOBAL_IDS] + myFirstPoint*sizeof(int));
+    discretization->getInitialX()->ExtractView(&ptr);
+    pwriteAll(fileDescriptor, ptr, 3*numMyPoints*sizeof(double), sectionOffsets[COORDINATES] + 3*myFirstPoint*sizeof(double));
+    discretization->getCellVolume()->ExtractView(&ptr);
+    pwriteAll(fileDescriptor, ptr, numMyPoints*sizeof(double), sectionOffsets[VOLUMES] + myFirstPoint*sizeof(double));
+    pwriteAll(fileDescriptor, &blockIds[0], numMyPoints*sizeof(int), sectionOffsets[BLOCK_IDS] + myFirstPoint*sizeof(int));
+    discretization->getHorizon()->ExtractView(&ptr);
+    pwriteAll(fileDescriptor, ptr, numMyPoints*sizeof(double), sectionOffsets[HORIZONS] + myFirstPoint*sizeof(double));
+  }
+  if(writeNeighborList){
+    // Offsets are written for points [first, first + numMyPoints), the final offset is written by every processor (they agree)
+    for(int i=0 ; i<=numMyPoints ; ++i)
+      neighborOffsets[i] += myFirstNeighborEntry;
+    pwriteAll(fileDescriptor, &neighborOffsets[0], (numMyPoints + 1)*sizeof(long long), sectionOffsets[NEIGHBOR_OFFSETS] + myFirstPoint*sizeof(long long));
+    if(neighborGlobalIds.size() > 0)
+      pwriteAll(fileDescriptor, &neighborGlobalIds[0], neighborGlobalIds.size()*sizeof(int), sectionOffsets[NEIGHBORS] + myFirstNeighborEntry*sizeof(int));
+  }
+  index = 0;
+  for(map<string, vector<int> >::const_iterator it = nodeSets->begin() ; it != nodeSets->end() ; it++, index++){
+    long long setOffset(0);
+    for(int i=0 ; i<index ; ++i)
+      setOffset += globalCounts[2 + i];
+    long long myFirstEntry = setOffset + scanCounts[2 + index] - localCounts[2 + index];
+    if(it->second.size() > 0)
+      pwriteAll(fileDescriptor, &(it->second[0]), it->second.size()*sizeof(int), sectionOffsets[NODE_SET_IDS] + myFirstEntry*sizeof(int));
+  }
+
+  close(fileDescriptor);
+  epetraComm->Barrier();
+}
+
+Teuchos::RCP<const Epetra_BlockMap>
+PeridigmNS::BinaryDiscretization::getGlobalOwnedMap(int d) const
+{
+  switch (d) {
+    case 1:
+      return oneDimensionalMap;
+      break;
+    case 3:
+      return threeDimensionalMap;
+      break;
+    default:
+      TEUCHOS_TEST_FOR_EXCEPTION(true, Teuchos::Exceptions::InvalidParameter,
+                         endl << "BinaryDiscretization::getGlobalOwnedMap(int d) only supports dimensions d=1 or d=3. Supplied dimension d=" << d << endl);
+    }
+}
+
+Teuchos::RCP<const Epetra_BlockMap>
+PeridigmNS::BinaryDiscretization::getGlobalOverlapMap(int d) const
+{
+  switch (d) {
+    case 1:
+      return oneDimensionalOverlapMap;
+      break;
+    case 3:
+      return threeDimensionalOverlapMap;
+      break;
+    default:
+      TEUCHOS_TEST_FOR_EXCEPTION(true, Teuchos::Exceptions::InvalidParameter,
+                         endl << "BinaryDiscretization::getOverlapMap(int d) only supports dimensions d=1 or d=3. Supplied dimension d=" << d << endl);
+    }
+}
+
+Teuchos::RCP<const Epetra_BlockMap>
+PeridigmNS::BinaryDiscretization::getGlobalBondMap() const
+{
+  return bondMap;
+}
+
+Teuchos::RCP<Epetra_Vector>
+PeridigmNS::BinaryDiscretization::getInitialX() const
+{
+  return initialX;
+}
+
+Teuchos::RCP<Epetra_Vector>
+PeridigmNS::BinaryDiscretization::getHorizon() const
+{
+  return horizonForEachPoint;
+}
+
+Teuchos::RCP<Epetra_Vector>
+PeridigmNS::BinaryDiscretization::getCellVolume() const
+{
+  return cellVolume;
+}
+
+Teuchos::RCP<Epetra_Vector>
+PeridigmNS::BinaryDiscretization::getBlockID() const
+{
+  return blockID;
+}
+
+Teuchos::RCP<PeridigmNS::NeighborhoodData>
+PeridigmNS::BinaryDiscretization::getNeighborhoodData() const
+{
+  return neighborhoodData;
+}
+
+unsigned int
+PeridigmNS::BinaryDiscretization::getNumBonds() const
+{
+  return numBonds;
+}
+
+unsigned int
+PeridigmNS::BinaryDiscretization::getMaxNumBondsPerElem() const
+{
+  return maxNumBondsPerElem;
+}
@@ -0,0 +1,218 @@
+/*! \file Peridigm_BinaryDiscretization.hpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#ifndef PERIDIGM_BINARYDISCRETIZATION_HPP
+#define PERIDIGM_BINARYDISCRETIZATION_HPP
+
+#include "Peridigm_Discretization.hpp"
+#include <Teuchos_ParameterList.hpp>
+#include <Epetra_Comm.h>
+#include <vector>
+#include <map>
+
+namespace PeridigmNS {
+
+  /*! \brief Discretization class that reads a Peridigm-native binary discretization file.
+   *
+   *  The file stores little-endian arrays, each aligned on a 64-byte boundary, and located through an offset table
+   *  at the start of the file.  Each processor reads a contiguous slab of points with pread(); if the file contains a
+   *  neighbor list, no proximity search is performed.  Files are created with BinaryDiscretization::write() from any
+   *  existing discretization, for example through the "Write Discretization File" discretization parameter, or from a
+   *  text file with scripts/text_to_binary_discretization.py.  The same files can be read by a text file discretization
+   *  with "Input Mesh Format" set to "Binary", in which case only the coordinates, block ids, and volumes are used.
+   */
+  class BinaryDiscretization : public PeridigmNS::Discretization {
+
+  public:
+
+    //! Section identifiers in the offset table.
+    enum SectionId { GLOBAL_IDS = 1, COORDINATES = 2, VOLUMES = 3, BLOCK_IDS = 4, HORIZONS = 5,
+                     NEIGHBOR_OFFSETS = 6, NEIGHBORS = 7, BLOCK_NAMES = 8, NODE_SETS = 9, NODE_SET_IDS = 10 };
+
+    //! Constructor
+    BinaryDiscretization(const Teuchos::RCP<const Epetra_Comm>& epetraComm,
+                         const Teuchos::RCP<Teuchos::ParameterList>& params);
+
+    //! Destructor
+    virtual ~BinaryDiscretization();
+
+    //! Write a discretization to a binary file; each processor writes its owned points in parallel.
+    static void write(const Teuchos::RCP<PeridigmNS::Discretization>& discretization,
+                      const Teuchos::RCP<const Epetra_Comm>& epetraComm,
+                      const std::string& fileName,
+                      bool writeNeighborList = true);
+
+    //! Read the coordinates, block ids, and volumes of this processor's contiguous slab of points, in file order.
+    static void readPointData(const std::string& fileName,
+                              int myPID,
+                              int numPID,
+                              std::vector<double>& coordinates,
+                              std::vector<int>& blockIds,
+                              std::vector<double>& volumes);
+
+    //! Return d-dimensional map
+    virtual Teuchos::RCP<const Epetra_BlockMap> getGlobalOwnedMap(int d) const;
+
+    //! Return d-dimensional overlap map (includes ghosts)
+    virtual Teuchos::RCP<const Epetra_BlockMap> getGlobalOverlapMap(int d) const;
+
+    //! Bond map, used for constitutive data stored on each bond. This is a non-overlapping map.
+    virtual Teuchos::RCP<const Epetra_BlockMap> getGlobalBondMap() const;
+
+    //! Get initial positions
+    virtual Teuchos::RCP<Epetra_Vector> getInitialX() const;
+
+    //! Get the horizon value for each point.
+    virtual Teuchos::RCP<Epetra_Vector> getHorizon() const;
+
+    //! Get cell volumes
+    virtual Teuchos::RCP<Epetra_Vector> getCellVolume() const;
+
+    //! Get a vector containing the block ID of each element
+    virtual Teuchos::RCP<Epetra_Vector> getBlockID() const;
+
+    //! Get the neighbor list for all locally-owned nodes
+    virtual Teuchos::RCP<PeridigmNS::NeighborhoodData> getNeighborhoodData() const;
+
+    //! Get interface data for all locally-owned nodes
+    virtual Teuchos::RCP<PeridigmNS::InterfaceData> getInterfaceData() const{return Teuchos::null;}
+
+    //! determine if interface data was constructed
+    virtual bool InterfacesAreConstructed() const{return false;}
+
+    //! Get the number of bonds on this processor
+    virtual unsigned int getNumBonds() const;
+
+    //! Get the number of elems on this processor
+    virtual unsigned int getNumElem() const {return oneDimensionalMap->NumMyElements();}
+
+    //! Get the maximum number of bonds per element on this processor
+    virtual unsigned int getMaxNumBondsPerElem() const;
+
+    //! Get the minimum element radius in the model (used for example for determining magnitude of finite-difference probe).
+    virtual double getMinElementRadius() const { return minElementRadius; }
+
+    //! Get the maximum element radius in the model (used for example for determining magnitude of finite-difference probe).
+    virtual double getMaxElementRadius() const { return maxElementRadius; }
+
+    //! Get the maximum element dimension (for example the diagonal of a hex element, used for partial volume neighbor search).
+    virtual double getMaxElementDimension() const { return 0.0; }
+
+  private:
+
+    //! Private to prohibit copying
+    BinaryDiscretization(const BinaryDiscretization&);
+
+    //! Private to prohibit copying
+    BinaryDiscretization& operator=(const BinaryDiscretization&);
+
+    //! Entry in the offset table.
+    struct Section {
+      int id;
+      int elementSize;
+      long long offset;
+      long long length;
+    };
+
+    //! Reads and checks the file header, and returns the offset table.
+    static std::map<int, Section> readSectionTable(int fileDescriptor,
+                                                   const std::string& fileName,
+                                                   long long& numPoints,
+                                                   long long& numNeighborEntries);
+
+    //! Reads this processor's slab of points from the file.
+    void loadData(const std::string& fileName);
+
+    //! Create NeighborhoodData from a neighbor list of the form (numNeighbors, neighbor local ids, ...)
+    void createNeighborhoodData(int neighborListSize, int* neighborList);
+
+    //! Maps
+    Teuchos::RCP<Epetra_BlockMap> oneDimensionalMap;
+    Teuchos::RCP<Epetra_BlockMap> oneDimensionalOverlapMap;
+    Teuchos::RCP<Epetra_BlockMap> threeDimensionalMap;
+    Teuchos::RCP<Epetra_BlockMap> threeDimensionalOverlapMap;
+    Teuchos::RCP<Epetra_BlockMap> bondMap;
+
+    //! Minimum element radius
+    double minElementRadius;
+
+    //! Maximum element radius
+    double maxElementRadius;
+
+    //! Vector containing initial positions
+    Teuchos::RCP<Epetra_Vector> initialX;
+
+    //! Vector containing horizons
+    Teuchos::RCP<Epetra_Vector> horizonForEachPoint;
+
+    //! Vector containing cell volumes
+    Teuchos::RCP<Epetra_Vector> cellVolume;
+
+    //! Vector containing the block ID of each element
+    Teuchos::RCP<Epetra_Vector> blockID;
+
+    //! Struct containing neighborhoods for owned nodes.
+    Teuchos::RCP<PeridigmNS::NeighborhoodData> neighborhoodData;
+
+    //! Returns number of bonds on this processor
+    unsigned int numBonds;
+
+    //! Returns the max number of bonds per element on this processor
+    unsigned int maxNumBondsPerElem;
+
+    //! Processor ID
+    int myPID;
+
+    //! Number of Processors
+    int numPID;
+
+    //! Epetra communicator
+    Teuchos::RCP<const Epetra_Comm> comm;
+  };
+}
+
+#endif // PERIDIGM_BINARYDISCRETIZATION_HPP
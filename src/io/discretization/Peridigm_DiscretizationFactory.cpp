@@ -50,6 +50,7 @@
 #include "Peridigm_ExodusDiscretization.hpp"
 #include "Peridigm_TextFileDiscretization.hpp"
 #include "Peridigm_PdQuickGridDiscretization.hpp"
+#include "Peridigm_BinaryDiscretization.hpp"
 
 using namespace std;
 
@@ -81,9 +82,20 @@ PeridigmNS::DiscretizationFactory::create(const Teuchos::RCP<const Epetra_Comm>&
   else if(type == "PdQuickGrid"){
 	discretization = Teuchos::rcp(new PeridigmNS::PdQuickGridDiscretization(epetra_comm, discParams));
   }
+  else if(type == "Binary"){
+	discretization = Teuchos::rcp(new PeridigmNS::BinaryDiscretization(epetra_comm, discParams));
+  }
   else{
     TEUCHOS_TEST_FOR_EXCEPTION(true, Teuchos::Exceptions::InvalidParameter, 
-		       "**** Invalid discretization type.  Valid types are \"Exodus\", \"Text File\", and \"PdQuickGrid\".\n");
+		       "**** Invalid discretization type.  Valid types are \"Exodus\", \"Text File\", \"PdQuickGrid\", and \"Binary\".\n");
+  }
+
+  // Optionally save the discretization, including its neighbor list, in the native binary format
+  if(discParams->isParameter("Write Discretization File")){
+    bool writeNeighborList = true;
+    if(discParams->isParameter("Write Discretization Neighbor List"))
+      writeNeighborList = discParams->get<bool>("Write Discretization Neighbor List");
+    PeridigmNS::BinaryDiscretization::write(discretization, epetra_comm, discParams->get<string>("Write Discretization File"), writeNeighborList);
   }
  
   return discretization;
@@ -49,6 +49,8 @@
 #include "Peridigm_ProximitySearch.hpp"
 #include "Peridigm_HorizonManager.hpp"
 #include "Peridigm_GeometryUtils.hpp"
+#include "NeighborhoodList.h"
+#include "PdZoltan.h"
 #include <Epetra_Map.h>
 #include <Epetra_Vector.h>
 #include <Epetra_Import.h>
@@ -73,6 +75,8 @@ PeridigmNS::ExodusDiscretization::ExodusDiscretization(const Teuchos::RCP<const
   minElementRadius(1.0e50),
   maxElementRadius(0.0),
   storeExodusMesh(false),
+  singleInputMeshFile(false),
+  useProximitySearchDecomposition(false),
   constructInterfaces(false),
   computeIntersections(false),
   maxElementDimension(0.0),
@@ -107,11 +111,24 @@ PeridigmNS::ExodusDiscretization::ExodusDiscretization(const Teuchos::RCP<const
     storeExodusMesh = constructInterfaces;
   }
 
+  // Read a single genesis file on all processors rather than a set of pre-decomposed files
+  if(params->isParameter("Single Input Mesh File")){
+    singleInputMeshFile = params->get<bool>("Single Input Mesh File");
+  }
+
+  // Adopt the load-balanced decomposition computed for the neighbor search rather than the decomposition of the mesh file
+  if(params->isParameter("Use Proximity Search Decomposition")){
+    useProximitySearchDecomposition = params->get<bool>("Use Proximity Search Decomposition");
+  }
+
   // Set up bond filters
   createBondFilters(params);
 
   // Load data from mesh file
-  loadData(meshFileName);
+  if(singleInputMeshFile)
+    loadDataSingleFile(meshFileName);
+  else
+    loadData(meshFileName);
   
   if(computeIntersections)
     maxElementDimension = computeMaxElementDimension();
@@ -148,10 +165,16 @@ PeridigmNS::ExodusDiscretization::ExodusDiscretization(const Teuchos::RCP<const
 
   // Execute the neighbor search
   // When computing element-horizon intersections, the search is expanded by the maximum element dimension
-  if(computeIntersections)
-    ProximitySearch::GlobalProximitySearch(initialX, horizonForEachPoint, oneDimensionalOverlapMap, neighborListSize, neighborList, bondFilters, maxElementDimension);
-  else
-    ProximitySearch::GlobalProximitySearch(initialX, horizonForEachPoint, oneDimensionalOverlapMap, neighborListSize, neighborList, bondFilters);
+  double radiusAddition = computeIntersections ? maxElementDimension : 0.0;
+  if(useProximitySearchDecomposition){
+    // The neighbor list is left in the search decomposition, and the per-element data is migrated to it instead
+    Teuchos::RCP<Epetra_BlockMap> searchOwnedMap;
+    ProximitySearch::LoadBalancedGlobalProximitySearch(initialX, horizonForEachPoint, searchOwnedMap, oneDimensionalOverlapMap, neighborListSize, neighborList, bondFilters, radiusAddition);
+    migrateLoadedData(*searchOwnedMap);
+  }
+  else{
+    ProximitySearch::GlobalProximitySearch(initialX, horizonForEachPoint, oneDimensionalOverlapMap, neighborListSize, neighborList, bondFilters, radiusAddition);
+  }
 
   // Ghost exodus data so that element-horizon intersections can be calculated for ghosted neighbors
   if(storeExodusMesh)
@@ -385,6 +408,7 @@ void PeridigmNS::ExodusDiscretization::loadData(const string& meshFileName)
     TEUCHOS_TEST_FOR_EXCEPT_MSG(elementBlocks->find(elemBlockName) != elementBlocks->end(), "**** Duplicate block found: " + elemBlockName + "\n");
     // Create a list for storing the element ids in this block
     (*elementBlocks)[elemBlockName] = vector<int>();
+    blockNames[elemBlockId] = elemBlockName;
     vector<int>& elementBlock = (*elementBlocks)[elemBlockName];
 
     // Get the block parameters and the element connectivity
@@ -614,6 +638,426 @@ void PeridigmNS::ExodusDiscretization::loadData(const string& meshFileName)
   if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadData()", "ex_close");
 }
 
+void PeridigmNS::ExodusDiscretization::loadDataSingleFile(const string& meshFileName)
+{
+  // All processors open the same, undecomposed genesis file
+  int compWordSize = sizeof(double);
+  int ioWordSize = 0;
+  float exodusVersion;
+  int exodusFileId = ex_open(meshFileName.c_str(), EX_READ, &compWordSize, &ioWordSize, &exodusVersion);
+  if(exodusFileId < 0){
+    cout << "\n****Error on processor " << myPID << ": unable to open file " << meshFileName.c_str() << "\n" << endl;
+    reportExodusError(exodusFileId, "ExodusDiscretization::loadDataSingleFile()", "ex_open");
+  }
+
+  // Read the initialization parameters
+  int numDim, numNodes, numElem, numElemBlocks, numNodeSets, numSideSets;
+  char title[MAX_LINE_LENGTH];
+  int retval = ex_get_init(exodusFileId, title, &numDim, &numNodes, &numElem, &numElemBlocks, &numNodeSets, &numSideSets);
+  if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataSingleFile()", "ex_get_init");
+
+  // Auxiliary maps are written by external decomposition tools and indicate a pre-decomposed file
+  int numNodeMaps, numElemMaps;
+  retval = ex_get_map_param(exodusFileId, &numNodeMaps, &numElemMaps);
+  if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataSingleFile()", "ex_get_map_param");
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(numNodeMaps > 0 || numElemMaps > 0,
+                              "**** Error in ExodusDiscretization::loadDataSingleFile(), genesis file contains auxiliary maps, \"Single Input Mesh File\" requires an undecomposed mesh.\n");
+
+  // Each processor reads a contiguous slice of the elements, in file order
+  int firstElem = static_cast<int>( (static_cast<long long>(numElem)*myPID)/numPID );
+  int numMyElem = static_cast<int>( (static_cast<long long>(numElem)*(myPID+1))/numPID ) - firstElem;
+
+  // Global element numbering for the slice
+  vector<int> elemIdMap(numMyElem);
+  if(numMyElem > 0){
+    retval = ex_get_partial_id_map(exodusFileId, EX_ELEM_MAP, firstElem + 1, numMyElem, &elemIdMap[0]);
+    if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataSingleFile()", "ex_get_partial_id_map");
+  }
+  for(int i=0 ; i<numMyElem ; ++i)
+    elemIdMap[i] -= 1; // Note the switch from 1-based indexing to 0-based indexing
+  int* myElemIds = numMyElem > 0 ? &elemIdMap[0] : 0;
+
+  // Create the owned maps for the slice
+  oneDimensionalMap = Teuchos::rcp(new Epetra_BlockMap(numElem, numMyElem, myElemIds, 1, 0, *comm));
+  threeDimensionalMap = Teuchos::rcp(new Epetra_BlockMap(numElem, numMyElem, myElemIds, 3, 0, *comm));
+  initialX = Teuchos::rcp(new Epetra_Vector(*threeDimensionalMap));
+  cellVolume = Teuchos::rcp(new Epetra_Vector(*oneDimensionalMap));
+  blockID = Teuchos::rcp(new Epetra_Vector(*oneDimensionalMap));
+
+  // Read the block parameters for every block, and the connectivity for the portion of each block that lies within the slice
+  vector<int> elemBlockIds(numElemBlocks);
+  retval = ex_get_elem_blk_ids(exodusFileId, &elemBlockIds[0]);
+  if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataSingleFile()", "ex_get_elem_blk_ids");
+
+  vector<ExodusElementType> blockElementTypes(numElemBlocks, UNKNOWN_ELEMENT);
+  vector<int> blockNumNodesPerElem(numElemBlocks, 0);
+  vector<int> blockNumAttributes(numElemBlocks, 0);
+  vector<int> blockNumMyElem(numElemBlocks, 0);
+  vector< vector<int> > blockConn(numElemBlocks);
+  vector< vector<double> > blockAttributes(numElemBlocks);
+  set<int> myExodusNodes;
+  int blockFirstElem(0);
+  for(int iElemBlock=0 ; iElemBlock<numElemBlocks ; iElemBlock++){
+
+    int elemBlockId = elemBlockIds[iElemBlock];
+
+    // Get the block name, if there is one
+    char exodusElemBlockName[MAX_STR_LENGTH];
+    retval = ex_get_name(exodusFileId, EX_ELEM_BLOCK, elemBlockId, exodusElemBlockName);
+    if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataSingleFile()", "ex_get_name");
+    string elemBlockName(exodusElemBlockName);
+    if(elemBlockName.size() == 0){
+      stringstream ss;
+      ss << "block_" << elemBlockId;
+      elemBlockName = ss.str();
+    }
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(elementBlocks->find(elemBlockName) != elementBlocks->end(), "**** Duplicate block found: " + elemBlockName + "\n");
+    (*elementBlocks)[elemBlockName] = vector<int>();
+    blockNames[elemBlockId] = elemBlockName;
+
+    char elemType[MAX_STR_LENGTH];
+    int numElemThisBlock, numNodesPerElem, numAttributes;
+    retval = ex_get_elem_block(exodusFileId, elemBlockId, elemType, &numElemThisBlock, &numNodesPerElem, &numAttributes);
+    if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataSingleFile()", "ex_get_elem_block");
+
+    // Intersection of this block with the slice owned by this processor
+    int start = max(firstElem, blockFirstElem);
+    int end = min(firstElem + numMyElem, blockFirstElem + numElemThisBlock);
+    blockFirstElem += numElemThisBlock;
+    if(end <= start)
+      continue;
+    int numMyElemThisBlock = end - start;
+    int offset = start - (blockFirstElem - numElemThisBlock);
+
+    string elemTypeString(elemType);
+    boost::to_upper(elemTypeString);
+    ExodusElementType exodusElementType(UNKNOWN_ELEMENT);
+    if(elemTypeString == string("SPHERE"))
+      exodusElementType = SPHERE_ELEMENT;
+    else if(elemTypeString == string("TET") || elemTypeString == string("TETRA") || elemTypeString == string("TET4") || elemTypeString == string("TET10"))
+      exodusElementType = TET_ELEMENT;
+    else if(elemTypeString == string("HEX") || elemTypeString == string("HEX8") || elemTypeString == string("HEX20"))
+      exodusElementType = HEX_ELEMENT;
+    else{
+      string msg = "\n**** Error in loadDataSingleFile(), unknown element type " + elemTypeString + ".\n";
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(true, msg);
+    }
+
+    blockElementTypes[iElemBlock] = exodusElementType;
+    blockNumNodesPerElem[iElemBlock] = numNodesPerElem;
+    blockNumAttributes[iElemBlock] = numAttributes;
+    blockNumMyElem[iElemBlock] = numMyElemThisBlock;
+
+    vector<int>& conn = blockConn[iElemBlock];
+    conn.resize(numMyElemThisBlock*numNodesPerElem);
+    retval = ex_get_partial_conn(exodusFileId, EX_ELEM_BLOCK, elemBlockId, offset + 1, numMyElemThisBlock, &conn[0], NULL, NULL);
+    if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataSingleFile()", "ex_get_partial_conn");
+    for(unsigned int i=0 ; i<conn.size() ; ++i){
+      conn[i] -= 1; // Note the switch from 1-based indexing to 0-based indexing
+      myExodusNodes.insert(conn[i]);
+    }
+    if(exodusElementType == SPHERE_ELEMENT){
+      vector<double>& attributes = blockAttributes[iElemBlock];
+      attributes.resize(numMyElemThisBlock*numAttributes);
+      retval = ex_get_partial_attr(exodusFileId, EX_ELEM_BLOCK, elemBlockId, offset + 1, numMyElemThisBlock, &attributes[0]);
+      if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataSingleFile()", "ex_get_partial_attr");
+    }
+  }
+
+  // Read the coordinates and global ids of the nodes referenced by the slice
+  // The reads are done in fixed-size chunks spanning the referenced node range, so that the full node list is never held in memory
+  const int chunkSize = 65536;
+  int numMyNodes = static_cast<int>(myExodusNodes.size());
+  map<int, int> exodusNodeToLocalNode;
+  vector<double> nodeCoordX(numMyNodes), nodeCoordY(numMyNodes), nodeCoordZ(numMyNodes);
+  vector<int> nodeIdMap(numMyNodes);
+  if(numMyNodes > 0){
+    vector<double> chunkX(chunkSize), chunkY(chunkSize), chunkZ(chunkSize);
+    vector<int> chunkIds(chunkSize);
+    int firstNode = *myExodusNodes.begin();
+    int lastNode = *myExodusNodes.rbegin();
+    set<int>::const_iterator nodeIt = myExodusNodes.begin();
+    int localNodeId(0);
+    for(int chunkStart=firstNode ; chunkStart<=lastNode ; chunkStart+=chunkSize){
+      // Skip chunks that contain none of the referenced nodes
+      if(*nodeIt >= chunkStart + chunkSize)
+        continue;
+      int numNodesThisChunk = min(chunkSize, lastNode + 1 - chunkStart);
+      retval = ex_get_partial_coord(exodusFileId, chunkStart + 1, numNodesThisChunk, &chunkX[0], &chunkY[0], &chunkZ[0]);
+      if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataSingleFile()", "ex_get_partial_coord");
+      retval = ex_get_partial_id_map(exodusFileId, EX_NODE_MAP, chunkStart + 1, numNodesThisChunk, &chunkIds[0]);
+      if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataSingleFile()", "ex_get_partial_id_map");
+      for( ; nodeIt != myExodusNodes.end() && *nodeIt < chunkStart + numNodesThisChunk ; nodeIt++, localNodeId++){
+        int i = *nodeIt - chunkStart;
+        exodusNodeToLocalNode[*nodeIt] = localNodeId;
+        nodeCoordX[localNodeId] = chunkX[i];
+        nodeCoordY[localNodeId] = chunkY[i];
+        nodeCoordZ[localNodeId] = chunkZ[i];
+        nodeIdMap[localNodeId] = chunkIds[i] - 1; // Note the switch from 1-based indexing to 0-based indexing
+      }
+    }
+  }
+
+  // Store original exodus-mesh node positions
+  // Nodes on slice boundaries appear on more than one processor, as is the case for pre-decomposed files
+  if(storeExodusMesh){
+    Epetra_BlockMap exodusMeshNodePositionsMap(-1, numMyNodes, numMyNodes > 0 ? &nodeIdMap[0] : 0, 3, 0, *comm);
+    exodusMeshNodePositions = Teuchos::RCP<Epetra_Vector>(new Epetra_Vector(exodusMeshNodePositionsMap));
+    for(int iNode=0 ; iNode<numMyNodes ; ++iNode){
+      (*exodusMeshNodePositions)[3*iNode]   = nodeCoordX[iNode];
+      (*exodusMeshNodePositions)[3*iNode+1] = nodeCoordY[iNode];
+      (*exodusMeshNodePositions)[3*iNode+2] = nodeCoordZ[iNode];
+    }
+  }
+
+  // Convert the elements in the slice to spheres
+  vector<int> elementSizeList(numMyElem);
+  vector< vector<int> > elementsThatNodeBelongsTo(numMyNodes);
+  int localElemId(0);
+  for(int iElemBlock=0 ; iElemBlock<numElemBlocks ; iElemBlock++){
+    int numNodesPerElem = blockNumNodesPerElem[iElemBlock];
+    int numAttributes = blockNumAttributes[iElemBlock];
+    ExodusElementType exodusElementType = blockElementTypes[iElemBlock];
+    const vector<int>& conn = blockConn[iElemBlock];
+    const vector<double>& attributes = blockAttributes[iElemBlock];
+
+    if(blockNumMyElem[iElemBlock] > 0){
+      if(exodusElementType == TET_ELEMENT && numNodesPerElem == 10)
+        cout << "**** Warning on processor " << myPID
+             << ", side nodes being discarded for 10-node tetrahedron element, will be treated as 4-node tetrahedron element." << endl;
+      if(exodusElementType == HEX_ELEMENT && numNodesPerElem == 20)
+        cout << "**** Warning on processor " << myPID
+             << ", side nodes being discarded for 20-node hexahedron element, will be treated as 8-node hexahedron element." << endl;
+    }
+
+    vector<double> nodeCoordinates(3*numNodesPerElem);
+    for(int iElem=0 ; iElem<blockNumMyElem[iElemBlock] ; iElem++, localElemId++){
+
+      for(int i=0 ; i<numNodesPerElem ; ++i){
+        int localNodeId = exodusNodeToLocalNode[conn[iElem*numNodesPerElem + i]];
+        nodeCoordinates[3*i] = nodeCoordX[localNodeId];
+        nodeCoordinates[3*i+1] = nodeCoordY[localNodeId];
+        nodeCoordinates[3*i+2] = nodeCoordZ[localNodeId];
+        elementsThatNodeBelongsTo[localNodeId].push_back(localElemId);
+      }
+
+      int globalElemId = elemIdMap[localElemId];
+      (*elementBlocks)[blockNames[elemBlockIds[iElemBlock]]].push_back(globalElemId);
+      elementSizeList[localElemId] = numNodesPerElem;
+
+      double volume(0.0);
+      vector<double> coord(3);
+      if(exodusElementType == SPHERE_ELEMENT){
+        // The second attribute is the sphere volume
+        coord[0] = nodeCoordinates[0];
+        coord[1] = nodeCoordinates[1];
+        coord[2] = nodeCoordinates[2];
+        volume = attributes[iElem*numAttributes + 1];
+      }
+      else if(exodusElementType == TET_ELEMENT){
+        tetCentroidAndVolume(&nodeCoordinates[0], &coord[0], &volume);
+      }
+      else if(exodusElementType == HEX_ELEMENT){
+        hexCentroidAndVolume(&nodeCoordinates[0], &coord[0], &volume);
+      }
+
+      (*blockID)[localElemId] = elemBlockIds[iElemBlock];
+      (*cellVolume)[localElemId] = volume;
+      (*initialX)[3*localElemId] = coord[0];
+      (*initialX)[3*localElemId+1] = coord[1];
+      (*initialX)[3*localElemId+2] = coord[2];
+    }
+  }
+
+  // Store element connectivity for original exodus mesh, if needed
+  if(storeExodusMesh){
+    Epetra_BlockMap exodusMeshElementConnectivityMap(-1, numMyElem, myElemIds, numMyElem > 0 ? &elementSizeList[0] : 0, 0, *comm);
+    exodusMeshElementConnectivity = Teuchos::rcp(new Epetra_Vector(exodusMeshElementConnectivityMap));
+    exodusMeshElementConnectivity->PutScalar(-1.0);
+    int index(0);
+    for(int iElemBlock=0 ; iElemBlock<numElemBlocks ; ++iElemBlock){
+      const vector<int>& conn = blockConn[iElemBlock];
+      for(unsigned int i=0 ; i<conn.size() ; ++i, ++index)
+        (*exodusMeshElementConnectivity)[index] = nodeIdMap[exodusNodeToLocalNode[conn[i]]];
+    }
+  }
+
+  // Node sets must be converted to new sphere mesh and stored
+  // Each node set is read in chunks, and each processor retains the elements in its slice that contain a node in the set
+  nodeSets = Teuchos::rcp< map<string, vector<int> > >(new map<string, vector<int> >() );
+  nodeSetIds = Teuchos::rcp< map<string, int> >(new map<string, int>() );
+  if(numNodeSets > 0){
+    vector<int> exodusNodeSetIds(numNodeSets);
+    retval = ex_get_node_set_ids(exodusFileId, &exodusNodeSetIds[0]);
+    if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataSingleFile()", "ex_get_node_set_ids");
+    vector<int> nodeSetNodeList(chunkSize);
+    for(int i=0 ; i<numNodeSets ; ++i){
+      int nodeSetId = exodusNodeSetIds[i];
+      char exodusNodeSetName[MAX_STR_LENGTH];
+      retval = ex_get_name(exodusFileId, EX_NODE_SET, nodeSetId, exodusNodeSetName);
+      if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataSingleFile()", "ex_get_name");
+      string nodeSetName(exodusNodeSetName);
+      if(nodeSetName.size() == 0){
+        stringstream ss;
+        ss << "nodelist_" << nodeSetId;
+        nodeSetName = ss.str();
+      }
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(nodeSets->find(nodeSetName) != nodeSets->end(), "**** Duplicate node set found: " + nodeSetName + "\n");
+      (*nodeSetIds)[nodeSetName] = nodeSetId;
+      vector<int>& nodeSet = (*nodeSets)[nodeSetName];
+
+      int numNodesInSet, numDistributionFactorsInSet;
+      retval = ex_get_node_set_param(exodusFileId, nodeSetId, &numNodesInSet, &numDistributionFactorsInSet);
+      if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataSingleFile()", "ex_get_node_set_param");
+      set<int> nodeSetElements;
+      for(int chunkStart=0 ; chunkStart<numNodesInSet ; chunkStart+=chunkSize){
+        int numNodesThisChunk = min(chunkSize, numNodesInSet - chunkStart);
+        retval = ex_get_partial_set(exodusFileId, EX_NODE_SET, nodeSetId, chunkStart + 1, numNodesThisChunk, &nodeSetNodeList[0], NULL);
+        if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataSingleFile()", "ex_get_partial_set");
+        for(int j=0 ; j<numNodesThisChunk ; ++j){
+          map<int, int>::const_iterator it = exodusNodeToLocalNode.find(nodeSetNodeList[j] - 1);
+          if(it == exodusNodeToLocalNode.end())
+            continue;
+          const vector<int>& elements = elementsThatNodeBelongsTo[it->second];
+          for(unsigned int k=0 ; k<elements.size() ; ++k)
+            nodeSetElements.insert(elemIdMap[elements[k]]);
+        }
+      }
+      nodeSet.assign(nodeSetElements.begin(), nodeSetElements.end());
+    }
+  }
+
+  if(verbose && myPID == 0){
+    stringstream ss;
+    ss << "\nGenesis file " << meshFileName << " (read in parallel by " << numPID << " processors)" << endl;
+    ss << "  title " << title << endl;
+    ss << "  number of dimensions " << numDim << endl;
+    ss << "  number of nodes " << numNodes << endl;
+    ss << "  number of elements " << numElem << endl;
+    ss << "  number of blocks " << numElemBlocks << endl;
+    ss << "  number of node sets " << numNodeSets << endl;
+    ss << "  number of side sets (ignored) " << numSideSets << endl;
+    cout << ss.str() << endl;
+  }
+
+  // Close the genesis file
+  retval = ex_close(exodusFileId);
+  if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataSingleFile()", "ex_close");
+
+  // The file-order slices are generally not spatially compact, repartition prior to the neighbor search
+  if(numPID > 1)
+    rebalanceLoadedData();
+}
+
+void PeridigmNS::ExodusDiscretization::rebalanceLoadedData()
+{
+  // Compute an RCB partition of the element centroids
+  int numMyElements = oneDimensionalMap->NumMyElements();
+  int* myGlobalElements = oneDimensionalMap->MyGlobalElements();
+  QUICKGRID::Data decomp = QUICKGRID::allocatePdGridData(numMyElements, 3);
+  decomp.globalNumPoints = oneDimensionalMap->NumGlobalElements();
+  int* decompGlobalIds = decomp.myGlobalIDs.get();
+  double* decompVolumes = decomp.cellVolume.get();
+  double* decompCoordinates = decomp.myX.get();
+  for(int i=0 ; i<numMyElements ; ++i){
+    decompGlobalIds[i] = myGlobalElements[i];
+    decompVolumes[i] = (*cellVolume)[i];
+    decompCoordinates[i*3]   = (*initialX)[i*3];
+    decompCoordinates[i*3+1] = (*initialX)[i*3+1];
+    decompCoordinates[i*3+2] = (*initialX)[i*3+2];
+  }
+  decomp = PDNEIGH::getLoadBalancedDiscretization(decomp);
+
+  Epetra_BlockMap rebalancedMap(decomp.globalNumPoints, decomp.numPoints, decomp.myGlobalIDs.get(), 1, 0, *comm);
+  migrateLoadedData(rebalancedMap);
+}
+
+void PeridigmNS::ExodusDiscretization::migrateLoadedData(const Epetra_BlockMap& targetMap)
+{
+  Teuchos::RCP<Epetra_BlockMap> rebalancedOneDimensionalMap =
+    Teuchos::rcp(new Epetra_BlockMap(-1, targetMap.NumMyElements(), targetMap.MyGlobalElements(), 1, 0, *comm));
+  Teuchos::RCP<Epetra_BlockMap> rebalancedThreeDimensionalMap =
+    Teuchos::rcp(new Epetra_BlockMap(-1, targetMap.NumMyElements(), targetMap.MyGlobalElements(), 3, 0, *comm));
+  Epetra_Import oneDimensionalImporter(*rebalancedOneDimensionalMap, *oneDimensionalMap);
+  Epetra_Import threeDimensionalImporter(*rebalancedThreeDimensionalMap, *threeDimensionalMap);
+
+  // Migrate the initial positions, volumes, and block ids
+  Teuchos::RCP<Epetra_Vector> rebalancedInitialX = Teuchos::rcp(new Epetra_Vector(*rebalancedThreeDimensionalMap));
+  rebalancedInitialX->Import(*initialX, threeDimensionalImporter, Insert);
+  Teuchos::RCP<Epetra_Vector> rebalancedCellVolume = Teuchos::rcp(new Epetra_Vector(*rebalancedOneDimensionalMap));
+  rebalancedCellVolume->Import(*cellVolume, oneDimensionalImporter, Insert);
+  Teuchos::RCP<Epetra_Vector> rebalancedBlockID = Teuchos::rcp(new Epetra_Vector(*rebalancedOneDimensionalMap));
+  rebalancedBlockID->Import(*blockID, oneDimensionalImporter, Insert);
+  Teuchos::RCP<Epetra_Vector> rebalancedHorizonForEachPoint;
+  if(!horizonForEachPoint.is_null()){
+    rebalancedHorizonForEachPoint = Teuchos::rcp(new Epetra_Vector(*rebalancedOneDimensionalMap));
+    rebalancedHorizonForEachPoint->Import(*horizonForEachPoint, oneDimensionalImporter, Insert);
+  }
+
+  // Rebuild the element list for each block
+  for(map<string, vector<int> >::iterator it = elementBlocks->begin() ; it != elementBlocks->end() ; it++)
+    it->second.clear();
+  for(int i=0 ; i<rebalancedBlockID->MyLength() ; ++i){
+    map<int, string>::const_iterator it = blockNames.find(static_cast<int>((*rebalancedBlockID)[i]));
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(it == blockNames.end(), "\n**** Error in ExodusDiscretization::migrateLoadedData(), invalid block id.\n");
+    (*elementBlocks)[it->second].push_back(rebalancedOneDimensionalMap->GID(i));
+  }
+
+  // Migrate node set membership along with the elements
+  Epetra_Vector nodeSetFlag(*oneDimensionalMap);
+  Epetra_Vector rebalancedNodeSetFlag(*rebalancedOneDimensionalMap);
+  for(map<string, vector<int> >::iterator it = nodeSets->begin() ; it != nodeSets->end() ; it++){
+    vector<int>& nodeSet = it->second;
+    nodeSetFlag.PutScalar(0.0);
+    for(unsigned int i=0 ; i<nodeSet.size() ; ++i)
+      nodeSetFlag[oneDimensionalMap->LID(nodeSet[i])] = 1.0;
+    rebalancedNodeSetFlag.Import(nodeSetFlag, oneDimensionalImporter, Insert);
+    nodeSet.clear();
+    for(int i=0 ; i<rebalancedNodeSetFlag.MyLength() ; ++i){
+      if(rebalancedNodeSetFlag[i] != 0.0)
+        nodeSet.push_back(rebalancedOneDimensionalMap->GID(i));
+    }
+  }
+
+  // Migrate the original exodus mesh, if needed
+  if(storeExodusMesh){
+    Epetra_Vector elementSize(*oneDimensionalMap);
+    for(int i=0 ; i<elementSize.MyLength() ; ++i)
+      elementSize[i] = exodusMeshElementConnectivity->Map().ElementSize(i);
+    Epetra_Vector rebalancedElementSize(*rebalancedOneDimensionalMap);
+    rebalancedElementSize.Import(elementSize, oneDimensionalImporter, Insert);
+    vector<int> elementSizeList(rebalancedElementSize.MyLength());
+    for(int i=0 ; i<rebalancedElementSize.MyLength() ; ++i)
+      elementSizeList[i] = static_cast<int>(rebalancedElementSize[i]);
+
+    Epetra_BlockMap rebalancedConnectivityMap(-1, rebalancedOneDimensionalMap->NumMyElements(), rebalancedOneDimensionalMap->MyGlobalElements(), elementSizeList.size() > 0 ? &elementSizeList[0] : 0, 0, *comm);
+    Teuchos::RCP<Epetra_Vector> rebalancedConnectivity = Teuchos::rcp(new Epetra_Vector(rebalancedConnectivityMap));
+    rebalancedConnectivity->PutScalar(-1.0);
+    Epetra_Import connectivityImporter(rebalancedConnectivityMap, exodusMeshElementConnectivity->Map());
+    rebalancedConnectivity->Import(*exodusMeshElementConnectivity, connectivityImporter, Insert);
+
+    set<int> globalNodeIdsSet;
+    for(int i=0 ; i<rebalancedConnectivity->MyLength() ; ++i)
+      globalNodeIdsSet.insert( static_cast<int>( (*rebalancedConnectivity)[i] ) );
+    vector<int> globalNodeIds(globalNodeIdsSet.begin(), globalNodeIdsSet.end());
+
+    Epetra_BlockMap rebalancedNodePositionsMap(-1, globalNodeIds.size(), globalNodeIds.size() > 0 ? &globalNodeIds[0] : 0, 3, 0, *comm);
+    Teuchos::RCP<Epetra_Vector> rebalancedNodePositions = Teuchos::rcp(new Epetra_Vector(rebalancedNodePositionsMap));
+    Epetra_Import nodePositionsImporter(rebalancedNodePositionsMap, exodusMeshNodePositions->Map());
+    rebalancedNodePositions->Import(*exodusMeshNodePositions, nodePositionsImporter, Insert);
+
+    exodusMeshElementConnectivity = rebalancedConnectivity;
+    exodusMeshNodePositions = rebalancedNodePositions;
+  }
+
+  oneDimensionalMap = rebalancedOneDimensionalMap;
+  threeDimensionalMap = rebalancedThreeDimensionalMap;
+  initialX = rebalancedInitialX;
+  cellVolume = rebalancedCellVolume;
+  blockID = rebalancedBlockID;
+  horizonForEachPoint = rebalancedHorizonForEachPoint;
+}
+
 void
 PeridigmNS::ExodusDiscretization::constructInterfaceData()
 {
@@ -974,16 +1418,57 @@ void PeridigmNS::ExodusDiscretization::removeNonintersectingNeighborsFromNeighbo
                                                                                       int& neighborListSize,
                                                                                       int*& neighborList)
 {
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(!storeExodusMesh, "**** Error:  removeNonintersectingNeighborsFromNeighborList() called, but exodus information not stored.\n");
+
   int refinedNumNeighbors, numNeighbors, neighborLocalId, neighborGlobalId;
   unsigned int refinedNumNeighborsIndex;
   double horizon;
   SphereIntersection sphereIntersection;
-  vector<double> exodusNodePositions;
   vector<double> sphereCenter(3);
   vector<int> refinedNeighborGlobalIdList;
-  set<int> refinedGlobalIds;
+  vector<int> refinedGhostGlobalIds;
   refinedNeighborGlobalIdList.reserve(neighborListSize);
 
+  // Cache the corner node coordinates of each overlap element in a contiguous array, along with
+  // the element's axis-aligned bounding box and node-averaged center
+  // 10-noded tets and 20-noded hexes are treated as 4-noded tets and 8-noded hexes, respectively
+  const int maxNodesPerElement = 8;
+  int numOverlapElements = overlapMap->NumMyElements();
+  vector<int> elementNumNodes(numOverlapElements);
+  vector<double> elementNodePositions(3*maxNodesPerElement*numOverlapElements);
+  vector<double> elementBoundingBox(6*numOverlapElements);
+  vector<double> elementCenter(3*numOverlapElements);
+  const Epetra_BlockMap& connectivityMap = exodusMeshElementConnectivity->Map();
+  const Epetra_BlockMap& nodePositionsMap = exodusMeshNodePositions->Map();
+  for(int iElem=0 ; iElem<numOverlapElements ; ++iElem){
+    int connectivityLocalId = connectivityMap.LID(overlapMap->GID(iElem));
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(connectivityLocalId == -1, "**** Invalid local Exodus element Id in removeNonintersectingNeighborsFromNeighborList().\n");
+    int numNodes = connectivityMap.ElementSize(connectivityLocalId);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(numNodes != 8 && numNodes != 20 && numNodes != 4 && numNodes != 10,
+                                "\n**** Error:  Element-horizon intersection calculations currently enabled only for hexahedron and tetrahedron elements.\n");
+    numNodes = (numNodes == 8 || numNodes == 20) ? 8 : 4;
+    elementNumNodes[iElem] = numNodes;
+    int connectivityIndex = connectivityMap.FirstPointInElement(connectivityLocalId);
+    double* nodePositions = &elementNodePositions[3*maxNodesPerElement*iElem];
+    double* box = &elementBoundingBox[6*iElem];
+    double* center = &elementCenter[3*iElem];
+    for(int dof=0 ; dof<3 ; ++dof){
+      box[dof] = 1.0e100;
+      box[dof+3] = -1.0e100;
+      center[dof] = 0.0;
+    }
+    for(int i=0 ; i<numNodes ; ++i){
+      int nodeLocalId = nodePositionsMap.LID( static_cast<int>( (*exodusMeshElementConnectivity)[connectivityIndex+i] ) );
+      for(int dof=0 ; dof<3 ; ++dof){
+        double value = (*exodusMeshNodePositions)[3*nodeLocalId+dof];
+        nodePositions[3*i+dof] = value;
+        if(value < box[dof]) box[dof] = value;
+        if(value > box[dof+3]) box[dof+3] = value;
+        center[dof] += value/numNodes;
+      }
+    }
+  }
+
   int index = 0;
   int elemLocalId = 0;
   while(index < neighborListSize){
@@ -991,67 +1476,71 @@ void PeridigmNS::ExodusDiscretization::removeNonintersectingNeighborsFromNeighbo
     refinedNumNeighborsIndex = refinedNeighborGlobalIdList.size();
     refinedNumNeighbors = 0;
     refinedNeighborGlobalIdList.push_back(refinedNumNeighbors);
+    sphereCenter[0] = (*x)[3*elemLocalId];
+    sphereCenter[1] = (*x)[3*elemLocalId+1];
+    sphereCenter[2] = (*x)[3*elemLocalId+2];
+    horizon = (*searchRadii)[elemLocalId];
+    double horizonSquared = horizon*horizon;
     for(int iNeighbor=0 ; iNeighbor<numNeighbors ; ++iNeighbor){
       neighborLocalId = neighborList[index++];
       neighborGlobalId = overlapMap->GID(neighborLocalId);
 
-      // Determine if the element intersects the sphere
-      sphereCenter[0] = (*x)[3*elemLocalId];
-      sphereCenter[1] = (*x)[3*elemLocalId+1];
-      sphereCenter[2] = (*x)[3*elemLocalId+2];
-      getExodusMeshNodePositions(neighborGlobalId, exodusNodePositions);
-      horizon = (*searchRadii)[elemLocalId];
-   
-      TEUCHOS_TEST_FOR_EXCEPT_MSG(exodusNodePositions.size()/3 != 8,
-                                  "\n**** Error:  Element-horizon intersection calculations currently enabled only for hexahedron elements.\n");
-
-#ifdef DEBUGGING_BACKWARDS_COMPATIBILITY_NEIGHBORHOOD_LIST
-      double centroid[3];
-      centroid[0] = 0.0;
-      centroid[1] = 0.0;
-      centroid[2] = 0.0;
-      for(int i=0 ; i<8 ; ++i){
-        centroid[0] += exodusNodePositions[3*i];
-        centroid[1] += exodusNodePositions[3*i+1];
-        centroid[2] += exodusNodePositions[3*i+2];
+      // Reject elements whose bounding box lies entirely outside the sphere
+      const double* box = &elementBoundingBox[6*neighborLocalId];
+      double distanceSquared(0.0);
+      for(int dof=0 ; dof<3 ; ++dof){
+        double d = 0.0;
+        if(sphereCenter[dof] < box[dof])
+          d = box[dof] - sphereCenter[dof];
+        else if(sphereCenter[dof] > box[dof+3])
+          d = sphereCenter[dof] - box[dof+3];
+        distanceSquared += d*d;
       }
-      centroid[0] /= 8.0;
-      centroid[1] /= 8.0;
-      centroid[2] /= 8.0;
 
-      double distanceSquared = (sphereCenter[0] - centroid[0])*(sphereCenter[0] - centroid[0])
-        + (sphereCenter[1] - centroid[1])*(sphereCenter[1] - centroid[1])
-        + (sphereCenter[2] - centroid[2])*(sphereCenter[2] - centroid[2]);
+      // Accept elements whose center lies within the sphere
+      const double* center = &elementCenter[3*neighborLocalId];
+      double centerDistanceSquared =
+        (center[0] - sphereCenter[0])*(center[0] - sphereCenter[0]) +
+        (center[1] - sphereCenter[1])*(center[1] - sphereCenter[1]) +
+        (center[2] - sphereCenter[2])*(center[2] - sphereCenter[2]);
 
-      if(distanceSquared > horizon*horizon)
+#ifdef DEBUGGING_BACKWARDS_COMPATIBILITY_NEIGHBORHOOD_LIST
+      if(centerDistanceSquared > horizonSquared)
         sphereIntersection = OUTSIDE_SPHERE;
       else
         sphereIntersection = INSIDE_SPHERE;
 #else
-      sphereIntersection = hexahedronSphereIntersection(&exodusNodePositions[0], sphereCenter, horizon);
+      if(distanceSquared > horizonSquared)
+        sphereIntersection = OUTSIDE_SPHERE;
+      else if(centerDistanceSquared < horizonSquared)
+        sphereIntersection = INTERSECTS_SPHERE;
+      else if(elementNumNodes[neighborLocalId] == 8)
+        sphereIntersection = hexahedronSphereIntersection(&elementNodePositions[3*maxNodesPerElement*neighborLocalId], sphereCenter, horizon);
+      else
+        sphereIntersection = tetrahedronSphereIntersection(&elementNodePositions[3*maxNodesPerElement*neighborLocalId], sphereCenter, horizon);
 #endif
 
       if(sphereIntersection != OUTSIDE_SPHERE){
         refinedNeighborGlobalIdList.push_back(neighborGlobalId);
-        refinedGlobalIds.insert(neighborGlobalId);
+        if(!ownedMap->MyGID(neighborGlobalId))
+          refinedGhostGlobalIds.push_back(neighborGlobalId);
         refinedNumNeighbors += 1;
       }
     }
     refinedNeighborGlobalIdList[refinedNumNeighborsIndex] = refinedNumNeighbors;
     elemLocalId += 1;
   }
+  sort(refinedGhostGlobalIds.begin(), refinedGhostGlobalIds.end());
+  refinedGhostGlobalIds.erase(unique(refinedGhostGlobalIds.begin(), refinedGhostGlobalIds.end()), refinedGhostGlobalIds.end());
 
   // Create new overlap map and neighborlist based on refinedNeighborGlobalIdList
   vector<int> refinedGlobalIdVector;
-  refinedGlobalIdVector.reserve(refinedGlobalIds.size());
+  refinedGlobalIdVector.reserve(ownedMap->NumMyElements() + refinedGhostGlobalIds.size());
   // The non-ghost portion of the overlapMap must match the ownedMap
   for(int i=0 ; i<ownedMap->NumMyElements() ; ++i)
     refinedGlobalIdVector.push_back(ownedMap->GID(i));
   // Add the ghosts to the overlapMap
-  for(set<int>::const_iterator it=refinedGlobalIds.begin() ; it!=refinedGlobalIds.end() ; it++){
-    if(!ownedMap->MyGID(*it))
-      refinedGlobalIdVector.push_back(*it);
-  }
+  refinedGlobalIdVector.insert(refinedGlobalIdVector.end(), refinedGhostGlobalIds.begin(), refinedGhostGlobalIds.end());
   overlapMap = Teuchos::rcp(new Epetra_BlockMap(-1,
                                                 static_cast<int>( refinedGlobalIdVector.size() ),
                                                 &refinedGlobalIdVector[0],
@@ -136,6 +136,15 @@ namespace PeridigmNS {
     //! Loads mesh data into Epetra_Vectors (initial positions, volumes, block ids) and stores original Exodus node locations and connectivity.
     void loadData(const std::string& meshFileName);
 
+    //! Loads a contiguous slice of the elements in a single, undecomposed genesis file using partial reads, then rebalances.
+    void loadDataSingleFile(const std::string& meshFileName);
+
+    //! Migrates the loaded mesh data to a recursive coordinate bisection (RCB) partition computed by Zoltan.
+    void rebalanceLoadedData();
+
+    //! Migrates the loaded mesh data (and the horizons, if assigned) so that this processor owns the elements in targetMap.
+    void migrateLoadedData(const Epetra_BlockMap& targetMap);
+
   protected:
 
     template<class T>
@@ -200,6 +209,15 @@ namespace PeridigmNS {
     //! Boolean flag for storing exodus mesh
     bool storeExodusMesh;
 
+    //! Boolean flag indicating that all processors read a single, undecomposed genesis file
+    bool singleInputMeshFile;
+
+    //! Boolean flag indicating that the decomposition computed for the neighbor search is adopted as the owned decomposition
+    bool useProximitySearchDecomposition;
+
+    //! Names of the element blocks, keyed by exodus block id
+    std::map<int, std::string> blockNames;
+
     //! Boolean flag for constructing interfaces
     bool constructInterfaces;
 
@@ -47,6 +47,7 @@
 
 #include "Peridigm_GeometryUtils.hpp"
 #include <Teuchos_Assert.hpp>
+#include <cmath>
 using namespace std;
 
 void PeridigmNS::tetCentroidAndVolume(double* const nodeCoordinates,
@@ -934,3 +935,24 @@ double PeridigmNS::maxDistanceToNode(int numNodes,
   maxDistance = std::sqrt(maxDistance);
   return maxDistance;
 }
+
+double PeridigmNS::cellSphereVolumeFraction(double cellVolume,
+                                            double sphereCenterDistance,
+                                            double sphereRadius)
+{
+  // Radius of the ball having the same volume as the cell
+  double a = std::cbrt(0.75*cellVolume/3.14159265358979323846);
+  double d = sphereCenterDistance;
+  double R = sphereRadius;
+
+  if(d + a <= R)
+    return 1.0;
+  if(d >= R + a)
+    return 0.0;
+  if(d + R <= a)
+    return (R*R*R)/(a*a*a);
+
+  // Volume of the lens formed by two intersecting spheres, normalized by the volume of the ball
+  double temp = R + a - d;
+  return temp*temp*(d*d + 2.0*d*a - 3.0*a*a + 2.0*d*R + 6.0*a*R - 3.0*R*R)/(16.0*d*a*a*a);
+}
@@ -115,6 +115,9 @@ namespace PeridigmNS {
 
   //! Compute the maxmimum distance from a given point to a node in an element.
   double maxDistanceToNode(int numNodes, const double* const nodeCoordinates, const double* point);
+
+  //! Approximate the fraction of a cell that lies within a sphere; the cell is treated as a ball of equal volume centered a distance sphereCenterDistance from the center of the sphere.
+  double cellSphereVolumeFraction(double cellVolume, double sphereCenterDistance, double sphereRadius);
 }
 
 #endif // PERIDIGM_GEOMETRYUTILS_HPP
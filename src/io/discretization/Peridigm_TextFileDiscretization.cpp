@@ -46,6 +46,7 @@
 //@HEADER
 
 #include "Peridigm_TextFileDiscretization.hpp"
+#include "Peridigm_BinaryDiscretization.hpp"
 #include "Peridigm_HorizonManager.hpp"
 #include "NeighborhoodList.h"
 #include "PdZoltan.h"
@@ -61,11 +62,103 @@
 
 #include <sstream>
 #include <fstream>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <boost/algorithm/string/trim.hpp>
 
 using namespace std;
 
+namespace {
+
+  //! Powers of ten that are exactly representable as doubles.
+  const double exactPowersOfTen[] = { 1.0e0,  1.0e1,  1.0e2,  1.0e3,  1.0e4,  1.0e5,  1.0e6,  1.0e7,
+                                      1.0e8,  1.0e9,  1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15,
+                                      1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22 };
+
+  inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r' || c == ','; }
+
+  //! Locale-independent parse of a floating-point value starting at ptr; advances ptr past the value.
+  //! Values with at most 15 significant digits and a decimal exponent of at most 22 in magnitude are converted
+  //! exactly with a single multiplication or division, all others are handed to strtod().
+  bool parseDouble(const char*& ptr, const char* end, double& value)
+  {
+    const char* start = ptr;
+    const char* p = ptr;
+    bool negative(false);
+    if(p < end && (*p == '-' || *p == '+')){
+      negative = (*p == '-');
+      ++p;
+    }
+    unsigned long long mantissa(0);
+    int numSignificantDigits(0), numDigits(0), exponent(0);
+    for( ; p < end && *p >= '0' && *p <= '9' ; ++p, ++numDigits){
+      if(mantissa != 0 || *p != '0'){
+        if(numSignificantDigits < 19)
+          mantissa = 10*mantissa + (*p - '0');
+        else
+          exponent += 1;
+        numSignificantDigits += 1;
+      }
+    }
+    if(p < end && *p == '.'){
+      for(++p ; p < end && *p >= '0' && *p <= '9' ; ++p, ++numDigits){
+        if(mantissa != 0 || *p != '0'){
+          if(numSignificantDigits < 19){
+            mantissa = 10*mantissa + (*p - '0');
+            exponent -= 1;
+          }
+          numSignificantDigits += 1;
+        }
+        else{
+          exponent -= 1;
+        }
+      }
+    }
+    if(numDigits == 0)
+      return false;
+    if(p < end && (*p == 'e' || *p == 'E')){
+      ++p;
+      bool negativeExponent(false);
+      if(p < end && (*p == '-' || *p == '+')){
+        negativeExponent = (*p == '-');
+        ++p;
+      }
+      if(p == end || *p < '0' || *p > '9')
+        return false;
+      int explicitExponent(0);
+      for( ; p < end && *p >= '0' && *p <= '9' ; ++p){
+        if(explicitExponent < 100000)
+          explicitExponent = 10*explicitExponent + (*p - '0');
+      }
+      exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+    if(p < end && !isBlank(*p) && *p != '\n')
+      return false;
+
+    if(numSignificantDigits <= 15 && exponent >= -22 && exponent <= 22){
+      value = static_cast<double>(mantissa);
+      if(exponent < 0)
+        value /= exactPowersOfTen[-exponent];
+      else
+        value *= exactPowersOfTen[exponent];
+      if(negative)
+        value = -value;
+    }
+    else{
+      string token(start, p);
+      value = strtod(token.c_str(), NULL);
+    }
+    ptr = p;
+    return true;
+  }
+}
+
 PeridigmNS::TextFileDiscretization::TextFileDiscretization(const Teuchos::RCP<const Epetra_Comm>& epetra_comm,
                                                            const Teuchos::RCP<Teuchos::ParameterList>& params) :
   minElementRadius(1.0e50),
@@ -165,8 +258,24 @@ QUICKGRID::Data PeridigmNS::TextFileDiscretization::getDecomp(const string& text
   vector<double> volumes;
   vector<int> blockIds;
 
+  string inputFormat("Text");
+  if(params->isParameter("Input Mesh Format"))
+    inputFormat = params->get<string>("Input Mesh Format");
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(inputFormat != "Text" && inputFormat != "Binary",
+                              "**** Error, invalid Input Mesh Format for text file discretization, valid options are \"Text\" and \"Binary\".\n");
+  bool parallelRead(false);
+  if(params->isParameter("Parallel Read"))
+    parallelRead = params->get<bool>("Parallel Read");
+
+  if(inputFormat == "Binary"){
+    // Each processor reads a contiguous portion of a binary discretization file, points are numbered in file order
+    BinaryDiscretization::readPointData(textFileName, myPID, numPID, coordinates, blockIds, volumes);
+  }
+  else if(parallelRead){
+    readTextFileParallel(textFileName, coordinates, blockIds, volumes);
+  }
   // Read the text file on the root processor
-  if(myPID == 0){
+  else if(myPID == 0){
     ifstream inFile(textFileName.c_str());
     TEUCHOS_TEST_FOR_EXCEPT_MSG(!inFile.is_open(), "**** Error opening discretization text file.\n");
     while(inFile.good()){
@@ -197,37 +306,46 @@ QUICKGRID::Data PeridigmNS::TextFileDiscretization::getDecomp(const string& text
   }
 
   int numElements = static_cast<int>(blockIds.size());
-  TEUCHOS_TEST_FOR_EXCEPT_MSG(myPID == 0 && numElements < 1, "**** Error reading discretization text file, no data found.\n");
 
-  // Record the block ids on the root processor
+  // Record the block ids found on this processor
+  // When the file is read on the root processor only, the lists on the other processors are empty
   set<int> uniqueBlockIds;
-  if(myPID == 0){
-    for(unsigned int i=0 ; i<blockIds.size() ; ++i)
-      uniqueBlockIds.insert(blockIds[i]);
-  }
+  for(unsigned int i=0 ; i<blockIds.size() ; ++i)
+    uniqueBlockIds.insert(blockIds[i]);
 
-  // Broadcast necessary data from root processor
+  // Broadcast necessary data
   Teuchos::RCP<const Teuchos::Comm<int> > teuchosComm = Teuchos::createMpiComm<int>(Teuchos::opaqueWrapper<MPI_Comm>(MPI_COMM_WORLD));
   int numGlobalElements;
   reduceAll(*teuchosComm, Teuchos::REDUCE_SUM, 1, &numElements, &numGlobalElements);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(numGlobalElements < 1, "**** Error reading discretization text file, no data found.\n");
 
   // Broadcast the unique block ids so that all processors are aware of the full block list
   // This is necessary because if a processor does not have any elements for a given block, it will be unaware the
   // given block exists, which causes problems downstream
+  // Each processor writes its block ids into its own segment of the global list, duplicates are removed below
   int numLocalUniqueBlockIds = static_cast<int>( uniqueBlockIds.size() );
   int numGlobalUniqueBlockIds;
   reduceAll(*teuchosComm, Teuchos::REDUCE_SUM, 1, &numLocalUniqueBlockIds, &numGlobalUniqueBlockIds);
+  int uniqueBlockIdsOffset;
+  Teuchos::scan(*teuchosComm, Teuchos::REDUCE_SUM, 1, &numLocalUniqueBlockIds, &uniqueBlockIdsOffset);
+  uniqueBlockIdsOffset -= numLocalUniqueBlockIds;
   vector<int> uniqueLocalBlockIds(numGlobalUniqueBlockIds, 0);
-  int index = 0;
+  int index = uniqueBlockIdsOffset;
   for(set<int>::const_iterator it = uniqueBlockIds.begin() ; it != uniqueBlockIds.end() ; it++)
     uniqueLocalBlockIds[index++] = *it;
   vector<int> uniqueGlobalBlockIds(numGlobalUniqueBlockIds);  
   reduceAll(*teuchosComm, Teuchos::REDUCE_SUM, numGlobalUniqueBlockIds, &uniqueLocalBlockIds[0], &uniqueGlobalBlockIds[0]);
+  set<int> uniqueGlobalBlockIdsSet(uniqueGlobalBlockIds.begin(), uniqueGlobalBlockIds.end());
+  uniqueGlobalBlockIds.assign(uniqueGlobalBlockIdsSet.begin(), uniqueGlobalBlockIdsSet.end());
 
   // Create list of global ids
+  // Points are numbered in file order, processors that read a portion of the file number their points starting from the global offset of that portion
+  int globalIdOffset;
+  Teuchos::scan(*teuchosComm, Teuchos::REDUCE_SUM, 1, &numElements, &globalIdOffset);
+  globalIdOffset -= numElements;
   vector<int> globalIds(numElements);
   for(unsigned int i=0 ; i<globalIds.size() ; ++i)
-    globalIds[i] = i;
+    globalIds[i] = globalIdOffset + i;
 
   // Copy data into a decomp object
   int dimension = 3;
@@ -337,6 +455,87 @@ QUICKGRID::Data PeridigmNS::TextFileDiscretization::getDecomp(const string& text
   return decomp;
 }
 
+void
+PeridigmNS::TextFileDiscretization::readTextFileParallel(const string& textFileName,
+                                                         vector<double>& coordinates,
+                                                         vector<int>& blockIds,
+                                                         vector<double>& volumes)
+{
+  int fileDescriptor = open(textFileName.c_str(), O_RDONLY);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(fileDescriptor < 0, "**** Error opening discretization text file.\n");
+  struct stat fileStatus;
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(fstat(fileDescriptor, &fileStatus) != 0, "**** Error determining the size of the discretization text file.\n");
+  size_t fileSize = static_cast<size_t>(fileStatus.st_size);
+  if(fileSize == 0){
+    close(fileDescriptor);
+    return;
+  }
+  void* mappedFile = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(mappedFile == MAP_FAILED, "**** Error memory-mapping the discretization text file.\n");
+  close(fileDescriptor);
+  madvise(mappedFile, fileSize, MADV_SEQUENTIAL);
+
+  // Each processor parses the lines that begin within its byte range
+  // A line that straddles the start of the range belongs to the previous processor
+  const char* const fileBegin = static_cast<const char*>(mappedFile);
+  const char* const fileEnd = fileBegin + fileSize;
+  const char* ptr = fileBegin + (fileSize/numPID)*myPID + min(fileSize%numPID, static_cast<size_t>(myPID));
+  const char* rangeEnd = fileBegin + (fileSize/numPID)*(myPID+1) + min(fileSize%numPID, static_cast<size_t>(myPID+1));
+  if(ptr != fileBegin && *(ptr-1) != '\n'){
+    const char* newline = static_cast<const char*>(memchr(ptr, '\n', fileEnd - ptr));
+    ptr = (newline == NULL) ? fileEnd : newline + 1;
+  }
+
+  // Reserve storage based on the length of the first line in the range
+  const char* firstNewline = static_cast<const char*>(memchr(ptr, '\n', fileEnd - ptr));
+  if(ptr < rangeEnd && firstNewline != NULL && firstNewline > ptr){
+    size_t estimatedNumLines = (rangeEnd - ptr)/(firstNewline - ptr + 1) + 1;
+    coordinates.reserve(3*estimatedNumLines);
+    blockIds.reserve(estimatedNumLines);
+    volumes.reserve(estimatedNumLines);
+  }
+
+  double data[5];
+  while(ptr < rangeEnd){
+    const char* lineBegin = ptr;
+    const char* lineEnd = static_cast<const char*>(memchr(ptr, '\n', fileEnd - ptr));
+    if(lineEnd == NULL)
+      lineEnd = fileEnd;
+
+    while(ptr < lineEnd && isBlank(*ptr))
+      ++ptr;
+    // Ignore comment lines and blank lines, otherwise parse
+    if( !(ptr == lineEnd || *ptr == '#' || *ptr == '/' || *ptr == '*') ){
+      int numValues(0);
+      bool valid(true);
+      while(ptr < lineEnd && valid){
+        double value;
+        valid = parseDouble(ptr, lineEnd, value);
+        if(valid && numValues < 5)
+          data[numValues] = value;
+        numValues += 1;
+        while(ptr < lineEnd && isBlank(*ptr))
+          ++ptr;
+      }
+      // Check for obvious problems with the data
+      if(!valid || numValues != 5){
+        string msg = "\n**** Error parsing text file, invalid line: " + string(lineBegin, lineEnd) + "\n";
+        munmap(mappedFile, fileSize);
+        TEUCHOS_TEST_FOR_EXCEPT_MSG(true, msg);
+      }
+      // Store the coordinates, block id, and volumes
+      coordinates.push_back(data[0]);
+      coordinates.push_back(data[1]);
+      coordinates.push_back(data[2]);
+      blockIds.push_back(static_cast<int>(data[3]));
+      volumes.push_back(data[4]);
+    }
+    ptr = (lineEnd == fileEnd) ? fileEnd : lineEnd + 1;
+  }
+
+  munmap(mappedFile, fileSize);
+}
+
 void
 PeridigmNS::TextFileDiscretization::createMaps(const QUICKGRID::Data& decomp)
 {
@@ -52,6 +52,7 @@
 #include <Teuchos_ParameterList.hpp>
 #include <Epetra_Comm.h>
 #include "QuickGridData.h"
+#include <vector>
 
 namespace PeridigmNS {
 
@@ -127,6 +128,12 @@ namespace PeridigmNS {
     QUICKGRID::Data getDecomp(const std::string& textFileName,
                               const Teuchos::RCP<Teuchos::ParameterList>& params);
 
+    //! Reads the portion of the text file assigned to this processor; each processor memory-maps the file and parses the lines that begin within its byte range.
+    void readTextFileParallel(const std::string& textFileName,
+                              std::vector<double>& coordinates,
+                              std::vector<int>& blockIds,
+                              std::vector<double>& volumes);
+
   protected:
 
     template<class T>
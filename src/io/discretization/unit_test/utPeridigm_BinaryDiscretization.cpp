@@ -0,0 +1,282 @@
+/*! \file utPeridigm_BinaryDiscretization.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <Teuchos_ParameterList.hpp>
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_GlobalMPISession.hpp"
+#include <vector>
+#include <set>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include <Epetra_ConfigDefs.h> // used to define HAVE_MPI
+#ifdef HAVE_MPI
+  #include <Epetra_MpiComm.h>
+#else
+  #include <Epetra_SerialComm.h>
+#endif
+#include "Peridigm_BinaryDiscretization.hpp"
+#include "Peridigm_TextFileDiscretization.hpp"
+#include "Peridigm_HorizonManager.hpp"
+
+using namespace Teuchos;
+using namespace PeridigmNS;
+
+RCP<const Epetra_Comm> getComm()
+{
+  RCP<const Epetra_Comm> comm;
+  #ifdef HAVE_MPI
+    comm = rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+  #else
+    comm = rcp(new Epetra_SerialComm);
+  #endif
+  return comm;
+}
+
+//! Point i of the 4x4x4 grid, with global id 16*i + 4*j + k, is in block_1 for i < 2 and in block_2 otherwise.
+void gridIndices(int globalId, int& i, int& j, int& k)
+{
+  i = globalId/16;
+  j = (globalId/4)%4;
+  k = globalId%4;
+}
+
+//! Creates a 4x4x4 grid of points with two blocks from a text file, and adds two node sets.
+RCP<Discretization> createTextFileDiscretization(const Epetra_Comm& comm)
+{
+  if(comm.MyPID() == 0){
+    std::ofstream textFile("utPeridigm_BinaryDiscretization.txt");
+    textFile << std::setprecision(17);
+    for(int globalId=0 ; globalId<64 ; ++globalId){
+      int i, j, k;
+      gridIndices(globalId, i, j, k);
+      textFile << 0.125 + 0.25*i << " " << 0.125 + 0.25*j << " " << 0.125 + 0.25*k << " "
+               << (i < 2 ? 1 : 2) << " " << 0.015625 + 1.0e-7*globalId << std::endl;
+    }
+    textFile.close();
+  }
+  comm.Barrier();
+
+  // the horizon includes face neighbors only
+  ParameterList blockParameterList;
+  ParameterList& blockParams = blockParameterList.sublist("My Blocks");
+  blockParams.set("Block Names", "block_1 block_2");
+  blockParams.set("Horizon", 0.251);
+  PeridigmNS::HorizonManager::self().loadHorizonInformationFromBlockParameters(blockParameterList);
+
+  RCP<ParameterList> discParams = rcp(new ParameterList);
+  discParams->set("Type", "Text File");
+  discParams->set("Input Mesh File", "utPeridigm_BinaryDiscretization.txt");
+  RCP<const Epetra_Comm> epetraComm = rcp(&comm, false);
+  RCP<Discretization> discretization = rcp(new TextFileDiscretization(epetraComm, discParams));
+
+  // node set LOW_X contains the points with i == 0, node set TOP contains the points with k == 3
+  RCP< std::map< std::string, std::vector<int> > > nodeSets = discretization->getNodeSets();
+  (*nodeSets)["LOW_X"] = std::vector<int>();
+  (*nodeSets)["TOP"] = std::vector<int>();
+  RCP<const Epetra_BlockMap> map = discretization->getGlobalOwnedMap(1);
+  for(int iLID=0 ; iLID<map->NumMyElements() ; ++iLID){
+    int i, j, k;
+    gridIndices(map->GID(iLID), i, j, k);
+    if(i == 0)
+      (*nodeSets)["LOW_X"].push_back(map->GID(iLID));
+    if(k == 3)
+      (*nodeSets)["TOP"].push_back(map->GID(iLID));
+  }
+  return discretization;
+}
+
+RCP<BinaryDiscretization> readBinaryDiscretization(RCP<const Epetra_Comm> comm, const std::string& fileName)
+{
+  RCP<ParameterList> discParams = rcp(new ParameterList);
+  discParams->set("Type", "Binary");
+  discParams->set("Input Mesh File", fileName);
+  return rcp(new BinaryDiscretization(comm, discParams));
+}
+
+TEUCHOS_UNIT_TEST(BinaryDiscretization, WriteReadTest) {
+
+  RCP<const Epetra_Comm> comm = getComm();
+  RCP<Discretization> textDiscretization = createTextFileDiscretization(*comm);
+
+  // the file written without a neighbor list is read with a proximity search
+  BinaryDiscretization::write(textDiscretization, comm, "utPeridigm_BinaryDiscretization.pdb", true);
+  BinaryDiscretization::write(textDiscretization, comm, "utPeridigm_BinaryDiscretization_NoNeighbors.pdb", false);
+
+  std::vector< RCP<BinaryDiscretization> > discretizations;
+  discretizations.push_back( readBinaryDiscretization(comm, "utPeridigm_BinaryDiscretization.pdb") );
+  discretizations.push_back( readBinaryDiscretization(comm, "utPeridigm_BinaryDiscretization_NoNeighbors.pdb") );
+
+  for(unsigned int iDisc=0 ; iDisc<discretizations.size() ; ++iDisc){
+
+    RCP<BinaryDiscretization> discretization = discretizations[iDisc];
+
+    RCP<const Epetra_BlockMap> map = discretization->getGlobalOwnedMap(1);
+    TEST_ASSERT(map->NumGlobalElements() == 64);
+    TEST_ASSERT(map->UniqueGIDs() == true);
+    TEST_ASSERT(map->MinAllGID() == 0);
+    TEST_ASSERT(map->MaxAllGID() == 63);
+
+    // the point data is identified by global id
+    RCP<Epetra_Vector> initialX = discretization->getInitialX();
+    RCP<Epetra_Vector> cellVolume = discretization->getCellVolume();
+    RCP<Epetra_Vector> blockID = discretization->getBlockID();
+    RCP<Epetra_Vector> horizon = discretization->getHorizon();
+    for(int iLID=0 ; iLID<map->NumMyElements() ; ++iLID){
+      int globalId = map->GID(iLID);
+      int i, j, k;
+      gridIndices(globalId, i, j, k);
+      TEST_FLOATING_EQUALITY((*initialX)[3*iLID],   0.125 + 0.25*i, 1.0e-15);
+      TEST_FLOATING_EQUALITY((*initialX)[3*iLID+1], 0.125 + 0.25*j, 1.0e-15);
+      TEST_FLOATING_EQUALITY((*initialX)[3*iLID+2], 0.125 + 0.25*k, 1.0e-15);
+      TEST_FLOATING_EQUALITY((*cellVolume)[iLID], 0.015625 + 1.0e-7*globalId, 1.0e-15);
+      TEST_FLOATING_EQUALITY((*blockID)[iLID], (i < 2 ? 1.0 : 2.0), 1.0e-15);
+      TEST_FLOATING_EQUALITY((*horizon)[iLID], 0.251, 1.0e-15);
+    }
+
+    // the neighbors of each point are its face neighbors
+    RCP<const Epetra_BlockMap> overlapMap = discretization->getGlobalOverlapMap(1);
+    RCP<NeighborhoodData> neighborhoodData = discretization->getNeighborhoodData();
+    TEST_EQUALITY(neighborhoodData->NumOwnedPoints(), map->NumMyElements());
+    const int* neighborhoodList = neighborhoodData->NeighborhoodList();
+    int neighborhoodListIndex(0);
+    for(int iLID=0 ; iLID<map->NumMyElements() ; ++iLID){
+      int i, j, k;
+      gridIndices(map->GID(iLID), i, j, k);
+      std::set<int> expectedNeighbors;
+      if(i > 0) expectedNeighbors.insert(map->GID(iLID) - 16);
+      if(i < 3) expectedNeighbors.insert(map->GID(iLID) + 16);
+      if(j > 0) expectedNeighbors.insert(map->GID(iLID) - 4);
+      if(j < 3) expectedNeighbors.insert(map->GID(iLID) + 4);
+      if(k > 0) expectedNeighbors.insert(map->GID(iLID) - 1);
+      if(k < 3) expectedNeighbors.insert(map->GID(iLID) + 1);
+      std::set<int> neighbors;
+      int numNeighbors = neighborhoodList[neighborhoodListIndex++];
+      for(int n=0 ; n<numNeighbors ; ++n)
+        neighbors.insert(overlapMap->GID(neighborhoodList[neighborhoodListIndex++]));
+      TEST_ASSERT(neighbors == expectedNeighbors);
+    }
+    int localNumBonds = static_cast<int>(discretization->getNumBonds());
+    int globalNumBonds;
+    comm->SumAll(&localNumBonds, &globalNumBonds, 1);
+    TEST_EQUALITY(globalNumBonds, 288);
+
+    // both blocks are known on all processors, and each processor owns its points in each block
+    std::vector<std::string> blockNames = discretization->getBlockNames();
+    TEST_EQUALITY(static_cast<int>(blockNames.size()), 2);
+    TEST_EQUALITY(blockNames[0], "block_1");
+    TEST_EQUALITY(blockNames[1], "block_2");
+    RCP< std::map< std::string, std::vector<int> > > elementBlocks = discretization->getElementBlocks();
+    int localBlockSize = static_cast<int>((*elementBlocks)["block_1"].size());
+    int globalBlockSize;
+    comm->SumAll(&localBlockSize, &globalBlockSize, 1);
+    TEST_EQUALITY(globalBlockSize, 32);
+
+    // both node sets are known on all processors, each processor retains its owned points in each set
+    RCP< std::map< std::string, std::vector<int> > > nodeSets = discretization->getNodeSets();
+    TEST_EQUALITY(static_cast<int>(nodeSets->size()), 2);
+    TEST_ASSERT(nodeSets->find("LOW_X") != nodeSets->end());
+    TEST_ASSERT(nodeSets->find("TOP") != nodeSets->end());
+    int localNodeSetSizes[2] = {static_cast<int>((*nodeSets)["LOW_X"].size()), static_cast<int>((*nodeSets)["TOP"].size())};
+    int globalNodeSetSizes[2];
+    comm->SumAll(localNodeSetSizes, globalNodeSetSizes, 2);
+    TEST_EQUALITY(globalNodeSetSizes[0], 16);
+    TEST_EQUALITY(globalNodeSetSizes[1], 16);
+    for(unsigned int n=0 ; n<(*nodeSets)["LOW_X"].size() ; ++n){
+      int i, j, k;
+      gridIndices((*nodeSets)["LOW_X"][n], i, j, k);
+      TEST_ASSERT(map->MyGID((*nodeSets)["LOW_X"][n]));
+      TEST_EQUALITY(i, 0);
+    }
+    for(unsigned int n=0 ; n<(*nodeSets)["TOP"].size() ; ++n){
+      int i, j, k;
+      gridIndices((*nodeSets)["TOP"][n], i, j, k);
+      TEST_ASSERT(map->MyGID((*nodeSets)["TOP"][n]));
+      TEST_EQUALITY(k, 3);
+    }
+  }
+
+  // a text file discretization with Input Mesh Format "Binary" reads the points of the same file, in file order
+  RCP<ParameterList> discParams = rcp(new ParameterList);
+  discParams->set("Type", "Text File");
+  discParams->set("Input Mesh File", "utPeridigm_BinaryDiscretization.pdb");
+  discParams->set("Input Mesh Format", "Binary");
+  RCP<TextFileDiscretization> textFromBinary = rcp(new TextFileDiscretization(comm, discParams));
+  TEST_EQUALITY(textFromBinary->getGlobalOwnedMap(1)->NumGlobalElements(), 64);
+  TEST_EQUALITY(textFromBinary->getNumBlocks(), 2);
+  double localVolume(0.0), globalVolume(0.0);
+  for(int i=0 ; i<textFromBinary->getCellVolume()->MyLength() ; ++i)
+    localVolume += (*textFromBinary->getCellVolume())[i];
+  comm->SumAll(&localVolume, &globalVolume, 1);
+  TEST_FLOATING_EQUALITY(globalVolume, 64*0.015625 + 1.0e-7*63*32, 1.0e-14);
+}
+
+TEUCHOS_UNIT_TEST(BinaryDiscretization, InconsistentNamesTest) {
+
+  RCP<const Epetra_Comm> comm = getComm();
+  if(comm->NumProc() == 1)
+    return;
+
+  // each processor has the same number of node sets, but the names differ
+  RCP<Discretization> textDiscretization = createTextFileDiscretization(*comm);
+  RCP< std::map< std::string, std::vector<int> > > nodeSets = textDiscretization->getNodeSets();
+  std::ostringstream nodeSetName;
+  nodeSetName << "PROCESSOR_" << comm->MyPID();
+  (*nodeSets)[nodeSetName.str()] = (*nodeSets)["TOP"];
+  nodeSets->erase("TOP");
+
+  TEST_THROW(BinaryDiscretization::write(textDiscretization, comm, "utPeridigm_BinaryDiscretization_Inconsistent.pdb", true), std::logic_error);
+}
+
+int main
+(int argc, char* argv[])
+{
+  Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+  return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
@@ -49,6 +49,7 @@
 #include <Teuchos_UnitTestHarness.hpp>
 #include "Teuchos_GlobalMPISession.hpp"
 #include <vector>
+#include <set>
 
 #include <Epetra_ConfigDefs.h> // used to define HAVE_MPI
 #ifdef HAVE_MPI
@@ -58,6 +59,7 @@
 #endif
 #include "Peridigm_ExodusDiscretization.hpp"
 #include "Peridigm_HorizonManager.hpp"
+#include "Peridigm_GeometryUtils.hpp"
 
 using namespace Teuchos;
 using namespace PeridigmNS;
@@ -603,6 +605,142 @@ TEUCHOS_UNIT_TEST(ExodusDiscretization, Exodus2x2x2Test) {
   TEST_FLOATING_EQUALITY(exodusNodePositions[23], 0.5, 1.0e-16);    
 }
 
+//! Check the refined neighbor lists against the exact element-sphere intersection routines applied to every element in the mesh
+void checkNeighborListsAgainstExactIntersections(RCP<ExodusDiscretization> discretization,
+                                                 const Epetra_Comm& comm,
+                                                 Teuchos::FancyOStream& out,
+                                                 bool& success)
+{
+  // Gather the corner node positions of every element onto every processor
+  Teuchos::RCP<const Epetra_BlockMap> map = discretization->getGlobalOwnedMap(1);
+  int numGlobalElements = map->MaxAllGID() + 1;
+  std::vector<double> localNumNodes(numGlobalElements, 0.0), numNodes(numGlobalElements);
+  std::vector<double> localNodePositions(3*8*numGlobalElements, 0.0), nodePositions(3*8*numGlobalElements);
+  std::vector<double> exodusNodePositions;
+  for(int i=0 ; i<map->NumMyElements() ; ++i){
+    int globalId = map->GID(i);
+    discretization->getExodusMeshNodePositions(globalId, exodusNodePositions);
+    int numElementNodes = static_cast<int>(exodusNodePositions.size()/3);
+    numElementNodes = (numElementNodes == 8 || numElementNodes == 20) ? 8 : 4;
+    localNumNodes[globalId] = numElementNodes;
+    for(int j=0 ; j<3*numElementNodes ; ++j)
+      localNodePositions[3*8*globalId + j] = exodusNodePositions[j];
+  }
+  comm.SumAll(&localNumNodes[0], &numNodes[0], numGlobalElements);
+  comm.SumAll(&localNodePositions[0], &nodePositions[0], 3*8*numGlobalElements);
+
+  Teuchos::RCP<const Epetra_BlockMap> overlapMap = discretization->getGlobalOverlapMap(1);
+  Teuchos::RCP<Epetra_Vector> initialX = discretization->getInitialX();
+  Teuchos::RCP<Epetra_Vector> horizon = discretization->getHorizon();
+  Teuchos::RCP<NeighborhoodData> neighborhoodData = discretization->getNeighborhoodData();
+  int* neighborhoodList = neighborhoodData->NeighborhoodList();
+  int neighborhoodListIndex = 0;
+  std::vector<double> sphereCenter(3);
+  for(int i=0 ; i<neighborhoodData->NumOwnedPoints() ; ++i){
+    std::set<int> neighbors;
+    int numNeighbors = neighborhoodList[neighborhoodListIndex++];
+    for(int j=0 ; j<numNeighbors ; ++j)
+      neighbors.insert(overlapMap->GID(neighborhoodList[neighborhoodListIndex++]));
+
+    std::set<int> intersectingElements;
+    for(int dof=0 ; dof<3 ; ++dof)
+      sphereCenter[dof] = (*initialX)[3*i+dof];
+    for(int globalId=0 ; globalId<numGlobalElements ; ++globalId){
+      if(globalId == map->GID(i) || numNodes[globalId] == 0.0)
+        continue;
+      SphereIntersection sphereIntersection;
+      if(numNodes[globalId] == 8.0)
+        sphereIntersection = hexahedronSphereIntersection(&nodePositions[3*8*globalId], sphereCenter, (*horizon)[i]);
+      else
+        sphereIntersection = tetrahedronSphereIntersection(&nodePositions[3*8*globalId], sphereCenter, (*horizon)[i]);
+      if(sphereIntersection != OUTSIDE_SPHERE)
+        intersectingElements.insert(globalId);
+    }
+    TEST_EQUALITY(neighbors.size(), intersectingElements.size());
+    TEST_ASSERT(neighbors == intersectingElements);
+  }
+}
+
+TEUCHOS_UNIT_TEST(ExodusDiscretization, ElementHorizonIntersections2x2x2Test) {
+
+  Teuchos::RCP<const Epetra_Comm> comm;
+  #ifdef HAVE_MPI
+    comm = rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+  #else
+    comm = rcp(new Epetra_SerialComm);
+  #endif
+
+  // This test is set up for either 1 or 2 processors
+  int numProc = comm->NumProc();
+  TEST_ASSERT(numProc == 1 || numProc == 2);
+
+  RCP<ParameterList> discParams = rcp(new ParameterList);
+  discParams->set("Type", "Exodus");
+  discParams->set("Input Mesh File", "utPeridigm_ExodusDiscretization_2x2x2.g");
+  discParams->set("Compute Element-Horizon Intersections", true);
+
+  // The elements are cubes with edge length 0.5, the distance from an element centroid to the
+  // nearest face, edge, and corner of its neighbors is 0.25, 0.354, and 0.433, respectively
+  // None of the face-, edge-, or corner-neighbors have their centroid within these horizons, so
+  // the neighbors that are not rejected by the bounding-box test are resolved with the exact hex test
+  double horizons[] = {0.2, 0.3, 0.4, 0.501};
+  int numNeighborsTruth[] = {0, 3, 6, 7};
+  for(int iHorizon=0 ; iHorizon<4 ; ++iHorizon){
+
+    ParameterList blockParameterList;
+    ParameterList& blockParams = blockParameterList.sublist("My Block");
+    blockParams.set("Block Names", "block_1");
+    blockParams.set("Horizon", horizons[iHorizon]);
+    PeridigmNS::HorizonManager::self().loadHorizonInformationFromBlockParameters(blockParameterList);
+
+    RCP<ExodusDiscretization> discretization = rcp(new ExodusDiscretization(comm, discParams));
+
+    Teuchos::RCP<NeighborhoodData> neighborhoodData = discretization->getNeighborhoodData();
+    int* neighborhoodList = neighborhoodData->NeighborhoodList();
+    int neighborhoodListIndex = 0;
+    for(int i=0 ; i<neighborhoodData->NumOwnedPoints() ; ++i){
+      int numNeighbors = neighborhoodList[neighborhoodListIndex];
+      TEST_EQUALITY(numNeighbors, numNeighborsTruth[iHorizon]);
+      neighborhoodListIndex += numNeighbors + 1;
+    }
+
+    checkNeighborListsAgainstExactIntersections(discretization, *comm, out, success);
+  }
+}
+
+TEUCHOS_UNIT_TEST(ExodusDiscretization, ElementHorizonIntersectionsHexTetTest) {
+
+  Teuchos::RCP<const Epetra_Comm> comm;
+  #ifdef HAVE_MPI
+    comm = rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+  #else
+    comm = rcp(new Epetra_SerialComm);
+  #endif
+
+  // The mesh contains a block of 64 hexahedra and a block of 70 irregular tetrahedra
+  RCP<ParameterList> discParams = rcp(new ParameterList);
+  discParams->set("Type", "Exodus");
+  discParams->set("Input Mesh File", "utPeridigm_ExodusDiscretization_HexTet.g");
+  discParams->set("Single Input Mesh File", true);
+  discParams->set("Compute Element-Horizon Intersections", true);
+
+  double horizons[] = {1.3, 3.1};
+  for(int iHorizon=0 ; iHorizon<2 ; ++iHorizon){
+
+    ParameterList blockParameterList;
+    ParameterList& blockParams = blockParameterList.sublist("My Block");
+    blockParams.set("Block Names", "block_1 block_2");
+    blockParams.set("Horizon", horizons[iHorizon]);
+    PeridigmNS::HorizonManager::self().loadHorizonInformationFromBlockParameters(blockParameterList);
+
+    RCP<ExodusDiscretization> discretization = rcp(new ExodusDiscretization(comm, discParams));
+
+    TEST_EQUALITY(discretization->getGlobalOwnedMap(1)->NumGlobalElements(), 134);
+
+    checkNeighborListsAgainstExactIntersections(discretization, *comm, out, success);
+  }
+}
+
 int main
 (int argc, char* argv[])
 {
@@ -770,6 +770,37 @@ TEUCHOS_UNIT_TEST(GeometryUtils, HexahedronSphereIntersection) {
   TEST_EQUALITY(sphereIntersection, PeridigmNS::INSIDE_SPHERE);
 }
 
+//! Exercise cellSphereVolumeFraction()
+TEUCHOS_UNIT_TEST(GeometryUtils, CellSphereVolumeFraction) {
+
+  double relTolerance = 1.0e-12;
+  double pi = 3.14159265358979323846;
+
+  // A cell with unit radius when treated as a ball
+  double cellVolume = 4.0*pi/3.0;
+  double fraction;
+
+  // Cell entirely within the sphere
+  fraction = cellSphereVolumeFraction(cellVolume, 1.0, 2.5);
+  TEST_FLOATING_EQUALITY(fraction, 1.0, relTolerance);
+
+  // Cell entirely outside the sphere
+  fraction = cellSphereVolumeFraction(cellVolume, 3.5, 2.5);
+  TEST_EQUALITY(fraction, 0.0);
+
+  // Sphere entirely within the cell
+  fraction = cellSphereVolumeFraction(cellVolume, 0.2, 0.5);
+  TEST_FLOATING_EQUALITY(fraction, 0.125, relTolerance);
+
+  // Equal radii with the center of the cell on the surface of the sphere, the lens volume is 5 pi r^3 / 12
+  fraction = cellSphereVolumeFraction(cellVolume, 1.0, 1.0);
+  TEST_FLOATING_EQUALITY(fraction, 5.0/16.0, relTolerance);
+
+  // A sphere of large radius approaches a half space through the center of the cell
+  fraction = cellSphereVolumeFraction(cellVolume, 1.0e6, 1.0e6);
+  TEST_FLOATING_EQUALITY(fraction, 0.5, 1.0e-5);
+}
+
 int main( int argc, char* argv[] ) {
 
     int numProcs = 1;
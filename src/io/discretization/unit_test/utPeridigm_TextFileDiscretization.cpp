@@ -0,0 +1,213 @@
+/*! \file utPeridigm_TextFileDiscretization.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <Teuchos_ParameterList.hpp>
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_GlobalMPISession.hpp"
+#include <vector>
+#include <fstream>
+#include <iomanip>
+
+#include <Epetra_ConfigDefs.h> // used to define HAVE_MPI
+#ifdef HAVE_MPI
+  #include <Epetra_MpiComm.h>
+#else
+  #include <Epetra_SerialComm.h>
+#endif
+#include "Peridigm_TextFileDiscretization.hpp"
+#include "Peridigm_HorizonManager.hpp"
+
+using namespace Teuchos;
+using namespace PeridigmNS;
+
+//! Writes a 4x4x4 grid of points with two blocks in both the text and binary formats.
+void writeDiscretizationFiles(const Epetra_Comm& comm)
+{
+  if(comm.MyPID() == 0){
+    std::vector<double> coordinates;
+    std::vector<int> blockIds;
+    std::vector<double> volumes;
+    for(int i=0 ; i<4 ; ++i){
+      for(int j=0 ; j<4 ; ++j){
+        for(int k=0 ; k<4 ; ++k){
+          coordinates.push_back(0.125 + 0.25*i);
+          coordinates.push_back(0.125 + 0.25*j);
+          coordinates.push_back(-0.1 + 0.25*k);
+          blockIds.push_back(i < 2 ? 1 : 2);
+          volumes.push_back(0.015625 + 1.0e-7*k);
+        }
+      }
+    }
+    long long numPoints = static_cast<long long>(blockIds.size());
+
+    std::ofstream textFile("utPeridigm_TextFileDiscretization.txt");
+    textFile << "# x y z block_id volume" << std::endl;
+    textFile << std::setprecision(17);
+    for(long long i=0 ; i<numPoints ; ++i){
+      textFile << coordinates[3*i] << " " << coordinates[3*i+1] << " " << coordinates[3*i+2] << " "
+               << blockIds[i] << " " << volumes[i] << std::endl;
+      if(i == numPoints/2)
+        textFile << std::endl << "// comment in the middle of the file" << std::endl;
+    }
+    textFile.close();
+
+    // binary discretization file with the sections read by a text file discretization:
+    // header, offset table (COORDINATES, VOLUMES, BLOCK_IDS), and the sections, each aligned on a 64-byte boundary
+    int version(1), numSections(3), sectionIds[3] = {2, 3, 4}, elementSizes[3] = {8, 8, 4};
+    long long numNeighborEntries(0);
+    long long lengths[3] = {static_cast<long long>(3*numPoints*sizeof(double)),
+                            static_cast<long long>(numPoints*sizeof(double)),
+                            static_cast<long long>(numPoints*sizeof(int))};
+    const char* data[3] = {reinterpret_cast<const char*>(&coordinates[0]),
+                           reinterpret_cast<const char*>(&volumes[0]),
+                           reinterpret_cast<const char*>(&blockIds[0])};
+    long long offsets[3];
+    offsets[0] = 128;
+    offsets[1] = offsets[0] + ((lengths[0] + 63)/64)*64;
+    offsets[2] = offsets[1] + ((lengths[1] + 63)/64)*64;
+    std::ofstream binaryFile("utPeridigm_TextFileDiscretization.bin", std::ios::out | std::ios::binary);
+    binaryFile.write("PDBINDSC", 8);
+    binaryFile.write(reinterpret_cast<const char*>(&version), sizeof(int));
+    binaryFile.write(reinterpret_cast<const char*>(&numSections), sizeof(int));
+    binaryFile.write(reinterpret_cast<const char*>(&numPoints), sizeof(long long));
+    binaryFile.write(reinterpret_cast<const char*>(&numNeighborEntries), sizeof(long long));
+    for(int i=0 ; i<3 ; ++i){
+      binaryFile.write(reinterpret_cast<const char*>(&sectionIds[i]), sizeof(int));
+      binaryFile.write(reinterpret_cast<const char*>(&elementSizes[i]), sizeof(int));
+      binaryFile.write(reinterpret_cast<const char*>(&offsets[i]), sizeof(long long));
+      binaryFile.write(reinterpret_cast<const char*>(&lengths[i]), sizeof(long long));
+    }
+    for(int i=0 ; i<3 ; ++i){
+      binaryFile.seekp(offsets[i]);
+      binaryFile.write(data[i], lengths[i]);
+    }
+    binaryFile.close();
+  }
+  comm.Barrier();
+}
+
+RCP<TextFileDiscretization> createDiscretization(RCP<const Epetra_Comm> comm,
+                                                 const std::string& fileName,
+                                                 const std::string& format,
+                                                 bool parallelRead)
+{
+  RCP<ParameterList> discParams = rcp(new ParameterList);
+  discParams->set("Type", "Text File");
+  discParams->set("Input Mesh File", fileName);
+  discParams->set("Input Mesh Format", format);
+  discParams->set("Parallel Read", parallelRead);
+  return rcp(new TextFileDiscretization(comm, discParams));
+}
+
+TEUCHOS_UNIT_TEST(TextFileDiscretization, ParallelReadTest) {
+
+  Teuchos::RCP<const Epetra_Comm> comm;
+  #ifdef HAVE_MPI
+    comm = rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+  #else
+    comm = rcp(new Epetra_SerialComm);
+  #endif
+
+  writeDiscretizationFiles(*comm);
+
+  // initialize the horizon manager and set the horizon to include face neighbors only
+  ParameterList blockParameterList;
+  ParameterList& blockParams = blockParameterList.sublist("My Blocks");
+  blockParams.set("Block Names", "block_1 block_2");
+  blockParams.set("Horizon", 0.251);
+  PeridigmNS::HorizonManager::self().loadHorizonInformationFromBlockParameters(blockParameterList);
+
+  // the discretization read on the root processor is the reference
+  std::vector< RCP<TextFileDiscretization> > discretizations;
+  discretizations.push_back( createDiscretization(comm, "utPeridigm_TextFileDiscretization.txt", "Text", false) );
+  discretizations.push_back( createDiscretization(comm, "utPeridigm_TextFileDiscretization.txt", "Text", true) );
+  discretizations.push_back( createDiscretization(comm, "utPeridigm_TextFileDiscretization.bin", "Binary", false) );
+
+  for(unsigned int iDisc=0 ; iDisc<discretizations.size() ; ++iDisc){
+
+    RCP<TextFileDiscretization> discretization = discretizations[iDisc];
+
+    Teuchos::RCP<const Epetra_BlockMap> map = discretization->getGlobalOwnedMap(1);
+    TEST_ASSERT(map->NumGlobalElements() == 64);
+    TEST_ASSERT(map->UniqueGIDs() == true);
+    TEST_ASSERT(map->MinAllGID() == 0);
+    TEST_ASSERT(map->MaxAllGID() == 63);
+
+    // point i in the file has global id i, so each point can be checked against its known location
+    Teuchos::RCP<Epetra_Vector> initialX = discretization->getInitialX();
+    Teuchos::RCP<Epetra_Vector> cellVolume = discretization->getCellVolume();
+    Teuchos::RCP<Epetra_Vector> blockID = discretization->getBlockID();
+    for(int iLID=0 ; iLID<map->NumMyElements() ; ++iLID){
+      int globalId = map->GID(iLID);
+      int i = globalId/16;
+      int j = (globalId/4)%4;
+      int k = globalId%4;
+      TEST_FLOATING_EQUALITY((*initialX)[3*iLID],   0.125 + 0.25*i, 1.0e-15);
+      TEST_FLOATING_EQUALITY((*initialX)[3*iLID+1], 0.125 + 0.25*j, 1.0e-15);
+      TEST_FLOATING_EQUALITY((*initialX)[3*iLID+2], -0.1 + 0.25*k, 1.0e-15);
+      TEST_FLOATING_EQUALITY((*cellVolume)[iLID], 0.015625 + 1.0e-7*k, 1.0e-15);
+      TEST_FLOATING_EQUALITY((*blockID)[iLID], (i < 2 ? 1.0 : 2.0), 1.0e-15);
+    }
+
+    // each of the 64 points has between three and six face neighbors
+    // 4x4x4 grid:  3 directions * 4*4 lines * 3 bonds per line * 2 (each bond is stored twice) = 288
+    int localNumBonds = static_cast<int>(discretization->getNumBonds());
+    int globalNumBonds;
+    comm->SumAll(&localNumBonds, &globalNumBonds, 1);
+    TEST_EQUALITY(globalNumBonds, 288);
+
+    // both blocks are known on all processors
+    TEST_EQUALITY(discretization->getNumBlocks(), 2);
+  }
+}
+
+int main
+(int argc, char* argv[])
+{
+  Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+  return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
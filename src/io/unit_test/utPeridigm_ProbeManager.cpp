@@ -0,0 +1,346 @@
+/*! \file utPeridigm_ProbeManager.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <Epetra_ConfigDefs.h> // used to define HAVE_MPI
+#ifdef HAVE_MPI
+  #include <Epetra_MpiComm.h>
+#endif
+#include <Epetra_SerialComm.h>
+#include <Teuchos_ParameterList.hpp>
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_UnitTestRepository.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+#include <Peridigm_Discretization.hpp>
+#include "Peridigm.hpp"
+#include "Peridigm_ProbeManager.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+using namespace Teuchos;
+using namespace PeridigmNS;
+using namespace std;
+
+//! Create a four-point bar, 6.0 x 1.0 x 1.0, with a node set containing the two points at the positive x end.
+Teuchos::RCP<Peridigm> createFourPointModel() {
+
+  Teuchos::RCP<Teuchos::ParameterList> peridigmParams = rcp(new Teuchos::ParameterList());
+
+  // material parameters
+  Teuchos::ParameterList& materialParams = peridigmParams->sublist("Materials");
+  Teuchos::ParameterList& linearElasticMaterialParams = materialParams.sublist("My Elastic Material");
+  linearElasticMaterialParams.set("Material Model", "Elastic");
+  linearElasticMaterialParams.set("Density", 7800.0);
+  linearElasticMaterialParams.set("Bulk Modulus", 130.0e9);
+  linearElasticMaterialParams.set("Shear Modulus", 78.0e9);
+
+  // blocks
+  Teuchos::ParameterList& blockParams = peridigmParams->sublist("Blocks");
+  Teuchos::ParameterList& blockOneParams = blockParams.sublist("My Group of Blocks");
+  blockOneParams.set("Block Names", "block_1");
+  blockOneParams.set("Material", "My Elastic Material");
+  blockOneParams.set("Horizon", 5.0);
+
+  // a stored elastic energy probe, so that the energy density field is allocated in the blocks
+  Teuchos::ParameterList& timeHistoryParams = peridigmParams->sublist("Time History");
+  timeHistoryParams.set("Output Filename", "utPeridigm_ProbeManager_Model");
+  timeHistoryParams.sublist("Probes").sublist("Elastic Energy").set("Type", "Stored Elastic Energy");
+
+  // node sets
+  Teuchos::ParameterList& bcParams = peridigmParams->sublist("Boundary Conditions");
+  bcParams.set("End Node Set", "3 4");
+
+  // discretization
+  Teuchos::ParameterList& discretizationParams = peridigmParams->sublist("Discretization");
+  discretizationParams.set("Type", "PdQuickGrid");
+  Teuchos::ParameterList& pdQuickGridParams = discretizationParams.sublist("TensorProduct3DMeshGenerator");
+  pdQuickGridParams.set("Type", "PdQuickGrid");
+  pdQuickGridParams.set("X Origin",  0.0);
+  pdQuickGridParams.set("Y Origin",  0.0);
+  pdQuickGridParams.set("Z Origin",  0.0);
+  pdQuickGridParams.set("X Length",  6.0);
+  pdQuickGridParams.set("Y Length",  1.0);
+  pdQuickGridParams.set("Z Length",  1.0);
+  pdQuickGridParams.set("Number Points X", 4);
+  pdQuickGridParams.set("Number Points Y", 1);
+  pdQuickGridParams.set("Number Points Z", 1);
+
+  Teuchos::RCP<Discretization> nullDiscretization;
+  Teuchos::RCP<Peridigm> peridigm = Teuchos::rcp(new Peridigm(MPI_COMM_WORLD, peridigmParams, nullDiscretization));
+
+  return peridigm;
+}
+
+//! Fill the displacement, velocity, and force density with values that depend on the global id of each point.
+void setMothershipData(Teuchos::RCP<Peridigm> peridigm, double scale) {
+
+  Epetra_Vector& u = *peridigm->getU();
+  Epetra_Vector& v = *peridigm->getV();
+  Epetra_Vector& force = *peridigm->getForce();
+  for(int i=0 ; i<u.Map().NumMyElements() ; ++i){
+    int globalId = u.Map().GID(i);
+    for(int dof=0 ; dof<3 ; ++dof){
+      u[3*i+dof] = scale*(2.0*globalId + 0.01*dof);
+      v[3*i+dof] = scale*globalId;
+      force[3*i+dof] = scale*(globalId + 0.1*dof);
+    }
+  }
+}
+
+//! Record probes of each type on a four-point bar and check the values written to the CSV and BINARY files.
+
+TEUCHOS_UNIT_TEST(ProbeManager, FourPointTest) {
+
+  Teuchos::RCP<Epetra_Comm> comm;
+#ifdef HAVE_MPI
+  comm = Teuchos::rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+#else
+  comm = Teuchos::rcp(new Epetra_SerialComm);
+#endif
+
+  TEST_COMPARE(comm->NumProc(), <=, 4);
+  if(comm->NumProc() > 4){
+    std::cerr << "Unit test runtime ERROR: utPeridigm_ProbeManager only makes sense on 1 to 4 processors." << std::endl;
+    return;
+  }
+
+  Teuchos::RCP<Peridigm> peridigm = createFourPointModel();
+  double density = peridigm->getBlocks()->begin()->getMaterialModel()->Density();
+  double volume = 1.5;
+
+  // The points are at x = 0.75, 2.25, 3.75, 5.25; the node set contains global ids 2 and 3
+  {
+    Teuchos::RCP<Teuchos::ParameterList> params = rcp(new Teuchos::ParameterList());
+    params->set("Output Filename", "utPeridigm_ProbeManager");
+    params->set("Output Frequency", 2);
+    Teuchos::ParameterList& probeParams = params->sublist("Probes");
+    Teuchos::ParameterList& endForceParams = probeParams.sublist("End Force");
+    endForceParams.set("Type", "Node Set Resultant");
+    endForceParams.set("Node Set", "End Node Set");
+    Teuchos::ParameterList& endDisplacementParams = probeParams.sublist("End Displacement");
+    endDisplacementParams.set("Type", "Node Set Average");
+    endDisplacementParams.set("Node Set", "End Node Set");
+    endDisplacementParams.set("Variable", "Displacement");
+    Teuchos::ParameterList& kineticEnergyParams = probeParams.sublist("Kinetic Energy");
+    kineticEnergyParams.set("Type", "Kinetic Energy");
+    Teuchos::ParameterList& tipParams = probeParams.sublist("Tip Displacement");
+    tipParams.set("Type", "Nearest Point");
+    tipParams.set("X", 5.0);
+    tipParams.set("Y", 0.5);
+    tipParams.set("Z", 0.5);
+
+    // With an output frequency of two, only the first and third calls to record() write a sample
+    Teuchos::RCP<ProbeManager> probeManager = rcp(new ProbeManager(params, peridigm.get()));
+    setMothershipData(peridigm, 1.0);
+    probeManager->record(0.0);
+    setMothershipData(peridigm, 2.0);
+    probeManager->record(1.0);
+    setMothershipData(peridigm, 3.0);
+    probeManager->record(2.0);
+
+    // The destructor flushes the buffered samples
+    probeManager = Teuchos::null;
+  }
+  comm->Barrier();
+
+  if(comm->MyPID() == 0){
+    ifstream inFile("utPeridigm_ProbeManager.csv");
+    TEST_ASSERT(inFile.is_open());
+
+    string line;
+    getline(inFile, line);
+    TEST_EQUALITY(line, "Time,End Force_X,End Force_Y,End Force_Z,End Displacement_X,End Displacement_Y,End Displacement_Z,Kinetic Energy,Tip Displacement_X,Tip Displacement_Y,Tip Displacement_Z");
+
+    double time[2] = {0.0, 2.0};
+    double scale[2] = {1.0, 3.0};
+    int numRows = 0;
+    while(getline(inFile, line) && line.size() > 0){
+      TEST_COMPARE(numRows, <, 2);
+      if(numRows >= 2)
+        break;
+      vector<double> values;
+      stringstream ss(line);
+      string value;
+      while(getline(ss, value, ','))
+        values.push_back(atof(value.c_str()));
+      TEST_EQUALITY((int)values.size(), 11);
+      if(values.size() != 11)
+        break;
+      double s = scale[numRows];
+      TEST_FLOATING_EQUALITY(values[0] + 1.0, time[numRows] + 1.0, 1.0e-12);
+      for(int dof=0 ; dof<3 ; ++dof){
+        TEST_FLOATING_EQUALITY(values[1+dof], volume*s*(5.0 + 0.2*dof), 1.0e-12);
+        TEST_FLOATING_EQUALITY(values[4+dof], s*(5.0 + 0.01*dof), 1.0e-12);
+        TEST_FLOATING_EQUALITY(values[8+dof], s*(6.0 + 0.01*dof), 1.0e-12);
+      }
+      // sum over the four points of 0.5 * density * volume * |v|^2, with |v|^2 = 3 (s * globalId)^2
+      TEST_FLOATING_EQUALITY(values[7], 0.5*density*volume*3.0*s*s*(0.0 + 1.0 + 4.0 + 9.0), 1.0e-12);
+      numRows++;
+    }
+    TEST_EQUALITY(numRows, 2);
+    inFile.close();
+  }
+
+  // BINARY output with a buffer of a single row, so that every sample is flushed as soon as it is recorded
+  {
+    Teuchos::RCP<Teuchos::ParameterList> params = rcp(new Teuchos::ParameterList());
+    params->set("Output Filename", "utPeridigm_ProbeManager");
+    params->set("Output Format", "BINARY");
+    params->set("Buffer Size", 1);
+    Teuchos::ParameterList& probeParams = params->sublist("Probes");
+    Teuchos::ParameterList& endForceParams = probeParams.sublist("End Force");
+    endForceParams.set("Type", "Node Set Resultant");
+    endForceParams.set("Node Set", "End Node Set");
+
+    Teuchos::RCP<ProbeManager> probeManager = rcp(new ProbeManager(params, peridigm.get()));
+    setMothershipData(peridigm, 1.0);
+    probeManager->record(0.5);
+    setMothershipData(peridigm, 2.0);
+    probeManager->record(1.5);
+    probeManager = Teuchos::null;
+  }
+  comm->Barrier();
+
+  if(comm->MyPID() == 0){
+    ifstream inFile("utPeridigm_ProbeManager.bin", ios::in | ios::binary);
+    TEST_ASSERT(inFile.is_open());
+
+    int numColumns(0);
+    inFile.read(reinterpret_cast<char*>(&numColumns), sizeof(int));
+    TEST_EQUALITY(numColumns, 4);
+    string expectedNames[4] = {"Time", "End Force_X", "End Force_Y", "End Force_Z"};
+    for(int i=0 ; i<numColumns && i<4 ; ++i){
+      string name;
+      getline(inFile, name, '\0');
+      TEST_EQUALITY(name, expectedNames[i]);
+    }
+
+    double time[2] = {0.5, 1.5};
+    double scale[2] = {1.0, 2.0};
+    for(int iRow=0 ; iRow<2 ; ++iRow){
+      double row[4];
+      inFile.read(reinterpret_cast<char*>(row), 4*sizeof(double));
+      TEST_ASSERT(inFile.good());
+      TEST_FLOATING_EQUALITY(row[0], time[iRow], 1.0e-15);
+      for(int dof=0 ; dof<3 ; ++dof)
+        TEST_FLOATING_EQUALITY(row[1+dof], volume*scale[iRow]*(5.0 + 0.2*dof), 1.0e-15);
+    }
+    double extra;
+    inFile.read(reinterpret_cast<char*>(&extra), sizeof(double));
+    TEST_ASSERT(inFile.eof());
+    inFile.close();
+  }
+
+  // Stored elastic energy, reduced together with the kinetic energy, for the reference configuration and a uniform stretch
+  double bulkModulus = 130.0e9;
+  double strain = 1.0e-3;
+  {
+    Teuchos::RCP<Teuchos::ParameterList> params = rcp(new Teuchos::ParameterList());
+    params->set("Output Filename", "utPeridigm_ProbeManager_Energy");
+    Teuchos::ParameterList& probeParams = params->sublist("Probes");
+    probeParams.sublist("Kinetic Energy").set("Type", "Kinetic Energy");
+    probeParams.sublist("Elastic Energy").set("Type", "Stored Elastic Energy");
+
+    Teuchos::RCP<ProbeManager> probeManager = rcp(new ProbeManager(params, peridigm.get()));
+    Epetra_Vector& x = *peridigm->getX();
+    Epetra_Vector& u = *peridigm->getU();
+    Epetra_Vector& y = *peridigm->getY();
+    Epetra_Vector& v = *peridigm->getV();
+    double stretch[2] = {0.0, strain};
+    for(int iSample=0 ; iSample<2 ; ++iSample){
+      for(int i=0 ; i<x.MyLength() ; ++i){
+        u[i] = (i%3 == 0) ? stretch[iSample]*x[i] : 0.0;
+        y[i] = x[i] + u[i];
+        v[i] = 1.0;
+      }
+      // Load the block data and evaluate the dilatation, as is done prior to output
+      peridigm->computeInternalForce();
+      probeManager->record(static_cast<double>(iSample));
+    }
+    probeManager = Teuchos::null;
+  }
+  comm->Barrier();
+
+  if(comm->MyPID() == 0){
+    ifstream inFile("utPeridigm_ProbeManager_Energy.csv");
+    TEST_ASSERT(inFile.is_open());
+
+    string line;
+    getline(inFile, line);
+    TEST_EQUALITY(line, "Time,Kinetic Energy,Elastic Energy");
+
+    // Under a uniform stretch the deviatoric extension vanishes and the dilatation is 3 * strain at every point,
+    // so the energy is the sum over the four points of 0.5 * bulkModulus * (3 * strain)^2 * volume
+    double expectedElasticEnergy = 4.0*0.5*bulkModulus*9.0*strain*strain*volume;
+    int numRows = 0;
+    while(getline(inFile, line) && line.size() > 0 && numRows < 2){
+      vector<double> values;
+      stringstream ss(line);
+      string value;
+      while(getline(ss, value, ','))
+        values.push_back(atof(value.c_str()));
+      TEST_EQUALITY((int)values.size(), 3);
+      if(values.size() != 3)
+        break;
+      TEST_FLOATING_EQUALITY(values[1], 0.5*density*volume*3.0*4.0, 1.0e-12);
+      if(numRows == 0)
+        TEST_COMPARE(std::abs(values[2]), <, 1.0e-12);
+      else
+        TEST_FLOATING_EQUALITY(values[2], expectedElasticEnergy, 1.0e-8);
+      numRows++;
+    }
+    TEST_EQUALITY(numRows, 2);
+    inFile.close();
+  }
+}
+
+int main(int argc, char *argv[]) {
+  Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+  return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
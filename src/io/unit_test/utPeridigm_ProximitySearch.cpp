@@ -452,6 +452,90 @@ TEUCHOS_UNIT_TEST(ProximitySearch, FivePointProblem) {
 
 }
 
+TEUCHOS_UNIT_TEST(ProximitySearch, LoadBalancedFivePointProblem) {
+
+  Teuchos::RCP<Epetra_Comm> comm;
+#ifdef HAVE_MPI
+  comm = Teuchos::rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+#else
+  comm = Teuchos::rcp(new Epetra_SerialComm);
+#endif
+  int numProc = comm->NumProc();
+
+  // This test cannot be run on more than 5 processors
+  if(numProc > 5){
+    std::cerr << "Unit test runtime ERROR: utPeridigm_ProximitySearch only makes sense on 1 to 5 processors." << std::endl;
+    return;
+  }
+
+  Epetra_BlockMap map(5, 3, 0, *comm);
+  Teuchos::RCP<Epetra_Vector> x = Teuchos::rcp(new Epetra_Vector(map));
+  int numMyElements = map.NumMyElements();
+
+  vector<double> node(3);
+  std::map<int, vector<double> > nodes;
+  node[0] = 0.0 ; node[1] = 0.0 ; node[2] = 0.0 ; nodes[0] = node;
+  node[0] = 1.0 ; node[1] = 0.0 ; node[2] = 0.0 ; nodes[1] = node;
+  node[0] = 0.0 ; node[1] = 1.0 ; node[2] = 0.0 ; nodes[2] = node;
+  node[0] = 0.0 ; node[1] = 0.0 ; node[2] = 1.0 ; nodes[3] = node;
+  node[0] = 1.0 ; node[1] = 1.0 ; node[2] = 1.0 ; nodes[4] = node;
+
+  for(int i=0 ; i<numMyElements ; ++i){
+    int globalId = map.GID(i);
+    (*x)[3*i]   = nodes[globalId][0];
+    (*x)[3*i+1] = nodes[globalId][1];
+    (*x)[3*i+2] = nodes[globalId][2];
+  }
+
+  // These are filled by the proximity search
+  Teuchos::RCP<Epetra_BlockMap> ownedMap;
+  Teuchos::RCP<Epetra_BlockMap> overlapMap;
+  int neighborListSize(0);
+  int* neighborList(0);
+
+  Epetra_BlockMap oneDimensionalMap(map.NumGlobalElements(), map.NumMyElements(), map.MyGlobalElements(), 1, 0, *comm);
+  Teuchos::RCP<Epetra_Vector> searchRadii = Teuchos::rcp(new Epetra_Vector(oneDimensionalMap));
+  searchRadii->PutScalar(1.1);
+
+  ProximitySearch::LoadBalancedGlobalProximitySearch(x, searchRadii, ownedMap, overlapMap, neighborListSize, neighborList);
+
+  // Every point is owned by exactly one processor, and the owned points lead the overlap map
+  TEST_ASSERT(ownedMap->NumGlobalElements() == 5);
+  TEST_ASSERT(ownedMap->IsOneToOne());
+  for(int i=0 ; i<ownedMap->NumMyElements() ; ++i)
+    TEST_ASSERT(overlapMap->GID(i) == ownedMap->GID(i));
+
+  int neighborListIndex = 0;
+  for(int i=0 ; i<ownedMap->NumMyElements() ; ++i){
+    int nodeGlobalId = ownedMap->GID(i);
+    TEST_ASSERT(neighborListIndex < neighborListSize);
+    int numNeighbors = neighborList[neighborListIndex++];
+    vector<int> neighborGlobalIds;
+    for(int j=0 ; j<numNeighbors ; ++j){
+      TEST_ASSERT(neighborListIndex < neighborListSize);
+      neighborGlobalIds.push_back(overlapMap->GID(neighborList[neighborListIndex++]));
+    }
+    sort(neighborGlobalIds.begin(), neighborGlobalIds.end());
+
+    if(nodeGlobalId == 0){
+      TEST_ASSERT(neighborGlobalIds.size() == 3);
+      TEST_ASSERT(neighborGlobalIds[0] == 1);
+      TEST_ASSERT(neighborGlobalIds[1] == 2);
+      TEST_ASSERT(neighborGlobalIds[2] == 3);
+    }
+    else if(nodeGlobalId == 1 || nodeGlobalId == 2 || nodeGlobalId == 3){
+      TEST_ASSERT(neighborGlobalIds.size() == 1);
+      TEST_ASSERT(neighborGlobalIds[0] == 0);
+    }
+    else if(nodeGlobalId == 4){
+      TEST_ASSERT(neighborGlobalIds.size() == 0);
+    }
+  }
+  TEST_ASSERT(neighborListIndex == neighborListSize);
+
+  delete[] neighborList;
+}
+
 int main( int argc, char* argv[] ) {
   Teuchos::GlobalMPISession mpiSession(&argc, &argv);
   return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
@@ -50,6 +50,7 @@
 #include "elastic.h"
 #include "correspondence.h"
 #include <Teuchos_Assert.hpp>
+#include <boost/math/constants/constants.hpp>
 
 using namespace std;
 
@@ -57,6 +58,7 @@ PeridigmNS::CorrespondenceMaterial::CorrespondenceMaterial(const Teuchos::Parame
   : Material(params),
     m_density(0.0), m_hourglassCoefficient(0.0),
     m_OMEGA(PeridigmNS::InfluenceFunction::self().getInfluenceFunction()),
+    m_usePartialVolume(false),
     m_horizonFieldId(-1), m_volumeFieldId(-1),
     m_modelCoordinatesFieldId(-1), m_coordinatesFieldId(-1), m_velocitiesFieldId(-1), 
     m_hourglassForceDensityFieldId(-1), m_forceDensityFieldId(-1), m_bondDamageFieldId(-1),
@@ -67,7 +69,8 @@ PeridigmNS::CorrespondenceMaterial::CorrespondenceMaterial(const Teuchos::Parame
     m_unrotatedCauchyStressFieldId(-1),
     m_cauchyStressFieldId(-1), 
     m_unrotatedRateOfDeformationFieldId(-1),
-    m_partialStressFieldId(-1)
+    m_partialStressFieldId(-1),
+    m_selfVolumeFieldId(-1), m_neighborVolumeFieldId(-1)
 {
   //! \todo Add meaningful asserts on material properties.
   m_bulkModulus = calculateBulkModulus(params);
@@ -79,6 +82,9 @@ PeridigmNS::CorrespondenceMaterial::CorrespondenceMaterial(const Teuchos::Parame
   TEUCHOS_TEST_FOR_EXCEPT_MSG(params.isParameter("Apply Shear Correction Factor"), "**** Error:  Shear Correction Factor is not supported for the ElasticCorrespondence material model.\n");
   TEUCHOS_TEST_FOR_EXCEPT_MSG(params.isParameter("Thermal Expansion Coefficient"), "**** Error:  Thermal expansion is not currently supported for the ElasticCorrespondence material model.\n");
 
+  if(params.isParameter("Use Partial Volume"))
+    m_usePartialVolume = params.get<bool>("Use Partial Volume");
+
   PeridigmNS::FieldManager& fieldManager = PeridigmNS::FieldManager::self();
   m_horizonFieldId                    = fieldManager.getFieldId(PeridigmField::ELEMENT, PeridigmField::SCALAR, PeridigmField::CONSTANT, "Horizon");
   m_volumeFieldId                     = fieldManager.getFieldId(PeridigmField::ELEMENT, PeridigmField::SCALAR, PeridigmField::CONSTANT, "Volume");
@@ -113,6 +119,13 @@ PeridigmNS::CorrespondenceMaterial::CorrespondenceMaterial(const Teuchos::Parame
   m_fieldIds.push_back(m_cauchyStressFieldId);
   m_fieldIds.push_back(m_unrotatedRateOfDeformationFieldId);
   m_fieldIds.push_back(m_partialStressFieldId);
+
+  if(m_usePartialVolume){
+    m_selfVolumeFieldId     = fieldManager.getFieldId(PeridigmField::BOND, PeridigmField::SCALAR, PeridigmField::CONSTANT, "Self_Volume");
+    m_neighborVolumeFieldId = fieldManager.getFieldId(PeridigmField::BOND, PeridigmField::SCALAR, PeridigmField::CONSTANT, "Neighbor_Volume");
+    m_fieldIds.push_back(m_selfVolumeFieldId);
+    m_fieldIds.push_back(m_neighborVolumeFieldId);
+  }
 }
 
 PeridigmNS::CorrespondenceMaterial::~CorrespondenceMaterial()
@@ -167,6 +180,10 @@ PeridigmNS::CorrespondenceMaterial::initialize(const double dt,
   dataManager.getData(m_shapeTensorInverseFieldId, PeridigmField::STEP_NONE)->ExtractView(&shapeTensorInverse);
   dataManager.getData(m_deformationGradientFieldId, PeridigmField::STEP_NONE)->ExtractView(&deformationGradient);
 
+  double *neighborVolume(0);
+  if(m_usePartialVolume)
+    dataManager.getData(m_neighborVolumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&neighborVolume);
+
   int shapeTensorReturnCode = 
     CORRESPONDENCE::computeShapeTensorInverseAndApproximateDeformationGradient(volume,
                                                                                horizon,
@@ -175,7 +192,8 @@ PeridigmNS::CorrespondenceMaterial::initialize(const double dt,
                                                                                shapeTensorInverse,
                                                                                deformationGradient,
                                                                                neighborhoodList,
-                                                                               numOwnedPoints);
+                                                                               numOwnedPoints,
+                                                                               neighborVolume);
 
   string shapeTensorErrorMessage =
     "**** Error:  CorrespondenceMaterial::initialize() failed to compute shape tensor.\n";
@@ -205,25 +223,6 @@ PeridigmNS::CorrespondenceMaterial::computeForce(const double dt,
   dataManager.getData(m_shapeTensorInverseFieldId, PeridigmField::STEP_NONE)->ExtractView(&shapeTensorInverse);
   dataManager.getData(m_deformationGradientFieldId, PeridigmField::STEP_NONE)->ExtractView(&deformationGradient);
   
-  // Compute the inverse of the shape tensor and the approximate deformation gradient
-  // The approximate deformation gradient will be used by the derived class (specific correspondence material model)
-  // to compute the Cauchy stress.
-  // The inverse of the shape tensor is stored for later use after the Cauchy stress calculation
-  int shapeTensorReturnCode = 
-    CORRESPONDENCE::computeShapeTensorInverseAndApproximateDeformationGradient(volume,
-                                                                               horizon,
-                                                                               modelCoordinates,
-                                                                               coordinates,
-                                                                               shapeTensorInverse,
-                                                                               deformationGradient,
-                                                                               neighborhoodList,
-                                                                               numOwnedPoints);
-  string shapeTensorErrorMessage =
-    "**** Error:  CorrespondenceMaterial::computeForce() failed to compute shape tensor.\n";
-  shapeTensorErrorMessage +=
-    "****         Note that all nodes must have a minimum of three neighbors.  Is the horizon too small?\n";
-  TEUCHOS_TEST_FOR_EXCEPT_MSG(shapeTensorReturnCode != 0, shapeTensorErrorMessage);
-
   double *leftStretchTensorN, *leftStretchTensorNP1, *rotationTensorN, *rotationTensorNP1, *unrotatedRateOfDeformation;
   dataManager.getData(m_leftStretchTensorFieldId, PeridigmField::STEP_N)->ExtractView(&leftStretchTensorN);
   dataManager.getData(m_leftStretchTensorFieldId, PeridigmField::STEP_NP1)->ExtractView(&leftStretchTensorNP1);
@@ -231,27 +230,44 @@ PeridigmNS::CorrespondenceMaterial::computeForce(const double dt,
   dataManager.getData(m_rotationTensorFieldId, PeridigmField::STEP_NP1)->ExtractView(&rotationTensorNP1);
   dataManager.getData(m_unrotatedRateOfDeformationFieldId, PeridigmField::STEP_NONE)->ExtractView(&unrotatedRateOfDeformation);
 
-  // Compute left stretch tensor, rotation tensor, and unrotated rate-of-deformation.
-  // Performs a polar decomposition via Flanagan & Taylor (1987) algorithm.
-  int rotationTensorReturnCode = CORRESPONDENCE::computeUnrotatedRateOfDeformationAndRotationTensor(volume,
-                                                                                                    horizon,
-                                                                                                    modelCoordinates, 
-                                                                                                    velocities, 
-                                                                                                    deformationGradient,
-                                                                                                    shapeTensorInverse,
-                                                                                                    leftStretchTensorN,
-                                                                                                    rotationTensorN,
-                                                                                                    leftStretchTensorNP1,
-                                                                                                    rotationTensorNP1,
-                                                                                                    unrotatedRateOfDeformation,
-                                                                                                    neighborhoodList, 
-                                                                                                    numOwnedPoints, 
-                                                                                                    dt);
+  double *selfVolume(0), *neighborVolume(0);
+  if(m_usePartialVolume){
+    dataManager.getData(m_selfVolumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&selfVolume);
+    dataManager.getData(m_neighborVolumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&neighborVolume);
+  }
+
+  // Compute the inverse of the shape tensor, the approximate deformation gradient, the left stretch tensor,
+  // the rotation tensor, and the unrotated rate-of-deformation in a single sweep over the neighborhoods.
+  // The approximate deformation gradient and unrotated rate-of-deformation will be used by the derived class
+  // (specific correspondence material model) to compute the Cauchy stress.
+  // The polar decomposition follows the Flanagan & Taylor (1987) algorithm.
+  int kinematicsReturnCode =
+    CORRESPONDENCE::computeShapeTensorInverseAndUnrotatedRateOfDeformation(volume,
+                                                                           horizon,
+                                                                           modelCoordinates,
+                                                                           coordinates,
+                                                                           velocities,
+                                                                           shapeTensorInverse,
+                                                                           deformationGradient,
+                                                                           leftStretchTensorN,
+                                                                           rotationTensorN,
+                                                                           leftStretchTensorNP1,
+                                                                           rotationTensorNP1,
+                                                                           unrotatedRateOfDeformation,
+                                                                           neighborhoodList,
+                                                                           numOwnedPoints,
+                                                                           dt,
+                                                                           neighborVolume);
+  string shapeTensorErrorMessage =
+    "**** Error:  CorrespondenceMaterial::computeForce() failed to compute shape tensor.\n";
+  shapeTensorErrorMessage +=
+    "****         Note that all nodes must have a minimum of three neighbors.  Is the horizon too small?\n";
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(kinematicsReturnCode == 1, shapeTensorErrorMessage);
   string rotationTensorErrorMessage =
     "**** Error:  CorrespondenceMaterial::computeForce() failed to compute rotation tensor.\n";
   rotationTensorErrorMessage +=
     "****         Note that all nodes must have a minimum of three neighbors.  Is the horizon too small?\n";
-  TEUCHOS_TEST_FOR_EXCEPT_MSG(rotationTensorReturnCode != 0, rotationTensorErrorMessage);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(kinematicsReturnCode != 0, rotationTensorErrorMessage);
 
   // Evaluate the Cauchy stress using the routine implemented in the derived class (specific correspondence material model)
   // The general idea is to compute the stress based on:
@@ -293,17 +309,31 @@ PeridigmNS::CorrespondenceMaterial::computeForce(const double dt,
   double *modelCoordinatesPtr, *neighborModelCoordinatesPtr, *forceDensityPtr, *neighborForceDensityPtr, *partialStressPtr;
   double undeformedBondX, undeformedBondY, undeformedBondZ, undeformedBondLength;
   double TX, TY, TZ, omega, vol, neighborVol, jacobianDeterminant;
-  int numNeighbors, neighborIndex;
+  int numNeighbors, neighborIndex, bondIndex(0);
 
   string matrixInversionErrorMessage =
     "**** Error:  CorrespondenceMaterial::computeForce() failed to invert deformation gradient.\n";
   matrixInversionErrorMessage +=
     "****         Note that all nodes must have a minimum of three neighbors.  Is the horizon too small?\n";
 
-  vector<double> defGradInvVector(9), piolaStressVector(9), tempVector(9);
-  double* defGradInv = &defGradInvVector[0];
-  double* piolaStress = &piolaStressVector[0];
-  double* temp = &tempVector[0];
+  double defGradInv[9], piolaStress[9], temp[9];
+
+  // Hourglass forces for stabilization of low-energy and/or zero-energy modes are computed in the same
+  // neighborhood sweep as the force state and summed directly into the force densities
+  dataManager.getData(m_hourglassForceDensityFieldId, PeridigmField::STEP_NP1)->PutScalar(0.0);
+
+  double *hourglassForceDensity;
+  dataManager.getData(m_hourglassForceDensityFieldId, PeridigmField::STEP_NP1)->ExtractView(&hourglassForceDensity);
+
+  // \todo HOURGLASS FORCES ARE NOT OUTPUT TO EXODUS CORRECTLY BECAUSE THEY ARE NOT ASSEMBLED ACROSS PROCESSORS.
+  //       They are summed into the force vector below, and the force vector is assembled across processors,
+  //       so the calculation runs correctly, but the hourglass output is off.
+
+  double *coordinatesPtr, *neighborCoordinatesPtr, *hourglassForceDensityPtr, *neighborHourglassForceDensityPtr;
+  double deformedBondX, deformedBondY, deformedBondZ, deformedBondLength;
+  double hourglassVectorX, hourglassVectorY, hourglassVectorZ, hourglassMagnitude, hourglassConstant;
+  const double pi = boost::math::constants::pi<double>();
+  const double hourglassConstantFirstPart = 18.0*m_hourglassCoefficient*m_bulkModulus/pi;
 
   // Loop over the material points and convert the Cauchy stress into pairwise peridynamic force densities
   const int *neighborListPtr = neighborhoodList;
@@ -325,9 +355,11 @@ PeridigmNS::CorrespondenceMaterial::computeForce(const double dt,
 
     // Loop over the neighbors and compute contribution to force densities
     modelCoordinatesPtr = modelCoordinates + 3*iID;
+    coordinatesPtr = coordinates + 3*iID;
+    hourglassConstant = hourglassConstantFirstPart/( (*delta)*(*delta)*(*delta)*(*delta) );
     numNeighbors = *neighborListPtr; neighborListPtr++;
 
-    for(int n=0; n<numNeighbors; n++, neighborListPtr++){
+    for(int n=0; n<numNeighbors; n++, neighborListPtr++, bondIndex++){
 
       neighborIndex = *neighborListPtr;
       neighborModelCoordinatesPtr = modelCoordinates + 3*neighborIndex;
@@ -344,8 +376,14 @@ PeridigmNS::CorrespondenceMaterial::computeForce(const double dt,
       TY = omega * ( *(temp+3) * undeformedBondX + *(temp+4) * undeformedBondY + *(temp+5) * undeformedBondZ );
       TZ = omega * ( *(temp+6) * undeformedBondX + *(temp+7) * undeformedBondY + *(temp+8) * undeformedBondZ );
 
-      vol = volume[iID];
-      neighborVol = volume[neighborIndex];
+      if(m_usePartialVolume){
+        vol = selfVolume[bondIndex];
+        neighborVol = neighborVolume[bondIndex];
+      }
+      else{
+        vol = volume[iID];
+        neighborVol = volume[neighborIndex];
+      }
 
       forceDensityPtr = forceDensity + 3*iID;
       neighborForceDensityPtr = forceDensity + 3*neighborIndex;
@@ -367,32 +405,40 @@ PeridigmNS::CorrespondenceMaterial::computeForce(const double dt,
       *(partialStressPtr+6) += TZ*undeformedBondX*neighborVol;
       *(partialStressPtr+7) += TZ*undeformedBondY*neighborVol;
       *(partialStressPtr+8) += TZ*undeformedBondZ*neighborVol;
+
+      // Hourglass force, based on the difference between the actual neighbor location
+      // and the location predicted by the deformation gradient
+      neighborCoordinatesPtr = coordinates + 3*neighborIndex;
+      deformedBondX = *(neighborCoordinatesPtr)   - *(coordinatesPtr);
+      deformedBondY = *(neighborCoordinatesPtr+1) - *(coordinatesPtr+1);
+      deformedBondZ = *(neighborCoordinatesPtr+2) - *(coordinatesPtr+2);
+      deformedBondLength = sqrt(deformedBondX*deformedBondX +
+                                deformedBondY*deformedBondY +
+                                deformedBondZ*deformedBondZ);
+
+      hourglassVectorX = *(defGrad)   * undeformedBondX + *(defGrad+1) * undeformedBondY + *(defGrad+2) * undeformedBondZ - deformedBondX;
+      hourglassVectorY = *(defGrad+3) * undeformedBondX + *(defGrad+4) * undeformedBondY + *(defGrad+5) * undeformedBondZ - deformedBondY;
+      hourglassVectorZ = *(defGrad+6) * undeformedBondX + *(defGrad+7) * undeformedBondY + *(defGrad+8) * undeformedBondZ - deformedBondZ;
+
+      hourglassMagnitude = -1.0 * (hourglassVectorX*deformedBondX + hourglassVectorY*deformedBondY + hourglassVectorZ*deformedBondZ);
+      hourglassMagnitude *= hourglassConstant / (undeformedBondLength * deformedBondLength);
+
+      hourglassForceDensityPtr = hourglassForceDensity + 3*iID;
+      neighborHourglassForceDensityPtr = hourglassForceDensity + 3*neighborIndex;
+
+      *(hourglassForceDensityPtr)   += hourglassMagnitude * deformedBondX * neighborVol;
+      *(hourglassForceDensityPtr+1) += hourglassMagnitude * deformedBondY * neighborVol;
+      *(hourglassForceDensityPtr+2) += hourglassMagnitude * deformedBondZ * neighborVol;
+      *(neighborHourglassForceDensityPtr)   -= hourglassMagnitude * deformedBondX * vol;
+      *(neighborHourglassForceDensityPtr+1) -= hourglassMagnitude * deformedBondY * vol;
+      *(neighborHourglassForceDensityPtr+2) -= hourglassMagnitude * deformedBondZ * vol;
+
+      *(forceDensityPtr)   += hourglassMagnitude * deformedBondX * neighborVol;
+      *(forceDensityPtr+1) += hourglassMagnitude * deformedBondY * neighborVol;
+      *(forceDensityPtr+2) += hourglassMagnitude * deformedBondZ * neighborVol;
+      *(neighborForceDensityPtr)   -= hourglassMagnitude * deformedBondX * vol;
+      *(neighborForceDensityPtr+1) -= hourglassMagnitude * deformedBondY * vol;
+      *(neighborForceDensityPtr+2) -= hourglassMagnitude * deformedBondZ * vol;
     }
   }
-
-  // Compute hourglass forces for stabilization of low-energy and/or zero-energy modes
-  dataManager.getData(m_hourglassForceDensityFieldId, PeridigmField::STEP_NP1)->PutScalar(0.0);
-
-  double *hourglassForceDensity;
-  dataManager.getData(m_hourglassForceDensityFieldId, PeridigmField::STEP_NP1)->ExtractView(&hourglassForceDensity);
-
-  // \todo HOURGLASS FORCES ARE NOT OUTPUT TO EXODUS CORRECTLY BECAUSE THEY ARE NOT ASSEMBLED ACROSS PROCESSORS.
-  //       They are summed into the force vector below, and the force vector is assembled across processors,
-  //       so the calculation runs correctly, but the hourglass output is off.
-
-  CORRESPONDENCE::computeHourglassForce(volume,
-                                        horizon,
-                                        modelCoordinates,
-                                        coordinates,
-                                        deformationGradient,
-                                        hourglassForceDensity,
-                                        neighborhoodList,
-                                        numOwnedPoints,
-                                        m_bulkModulus,
-                                        m_hourglassCoefficient);
-
-  // Sum the hourglass force densities into the force densities
-  Teuchos::RCP<Epetra_Vector> forceDensityVector = dataManager.getData(m_forceDensityFieldId, PeridigmField::STEP_NP1);
-  Teuchos::RCP<Epetra_Vector> hourglassForceDensityVector = dataManager.getData(m_hourglassForceDensityFieldId, PeridigmField::STEP_NP1);
-  forceDensityVector->Update(1.0, *hourglassForceDensityVector, 1.0);
 }
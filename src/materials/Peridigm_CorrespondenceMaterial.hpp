@@ -104,6 +104,7 @@ namespace PeridigmNS {
     double m_density;
     double m_hourglassCoefficient;
     PeridigmNS::InfluenceFunction::functionPointer m_OMEGA;
+    bool m_usePartialVolume;
 
     // field spec ids for all relevant data
     std::vector<int> m_fieldIds;
@@ -123,6 +124,8 @@ namespace PeridigmNS {
     int m_cauchyStressFieldId;
     int m_unrotatedRateOfDeformationFieldId;
     int m_partialStressFieldId;
+    int m_selfVolumeFieldId;
+    int m_neighborVolumeFieldId;
   };
 }
 
@@ -52,7 +52,7 @@
 
 PeridigmNS::ElasticBondBasedMaterial::ElasticBondBasedMaterial(const Teuchos::ParameterList& params)
   : Material(params),
-    m_bulkModulus(0.0), m_density(0.0), m_horizon(0.0), m_volumeFieldId(-1), m_damageFieldId(-1),
+    m_bulkModulus(0.0), m_density(0.0), m_horizon(0.0), m_useHalfNeighborList(false), m_useStructureOfArrays(false), m_applyAnalyticJacobian(true), m_volumeFieldId(-1), m_damageFieldId(-1),
     m_modelCoordinatesFieldId(-1), m_coordinatesFieldId(-1), m_forceDensityFieldId(-1), m_bondDamageFieldId(-1)
 {
   //! \todo Add meaningful asserts on material properties.
@@ -62,6 +62,15 @@ PeridigmNS::ElasticBondBasedMaterial::ElasticBondBasedMaterial(const Teuchos::Pa
   if(params.isParameter("Young's Modulus") || params.isParameter("Poisson's Ratio") || params.isParameter("Shear Modulus")){
     TEUCHOS_TEST_FOR_EXCEPT_MSG(true, "**** Error:  The Elastic bond based material model supports only one elastic constant, the bulk modulus.");
   }
+  if(params.isParameter("Use Half Neighbor List"))
+    m_useHalfNeighborList = params.get<bool>("Use Half Neighbor List");
+  if(params.isParameter("Use Structure Of Arrays"))
+    m_useStructureOfArrays = params.get<bool>("Use Structure Of Arrays");
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(m_useHalfNeighborList && m_useStructureOfArrays,
+                              "**** Error:  The Elastic bond based material model does not support \"Use Half Neighbor List\" and \"Use Structure Of Arrays\" together.");
+  // If the analytic jacobian is disabled, the jacobian is computed by finite difference
+  if(params.isParameter("Apply Analytic Jacobian"))
+    m_applyAnalyticJacobian = params.get<bool>("Apply Analytic Jacobian");
 
   PeridigmNS::FieldManager& fieldManager = PeridigmNS::FieldManager::self();
   m_volumeFieldId                  = fieldManager.getFieldId(PeridigmField::ELEMENT, PeridigmField::SCALAR,      PeridigmField::CONSTANT, "Volume");
@@ -99,17 +108,134 @@ PeridigmNS::ElasticBondBasedMaterial::computeForce(const double dt,
                                           const int* neighborhoodList,
                                           PeridigmNS::DataManager& dataManager) const
 {
+  // Extract pointers to the underlying data
+  double *x, *y, *cellVolume, *bondDamage, *force;
+
+  dataManager.getData(m_volumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&cellVolume);
+  dataManager.getData(m_bondDamageFieldId, PeridigmField::STEP_NP1)->ExtractView(&bondDamage);
+
+  if(m_useStructureOfArrays){
+    // The structure-of-arrays copies persist in the DataManager; the model coordinates are copied only after a rebalance,
+    // the current coordinates are copied on each evaluation, and the forces are zeroed in place and written back once
+    Teuchos::RCP<const SoAVectorData> xSoA = dataManager.getSoAData(m_modelCoordinatesFieldId, PeridigmField::STEP_NONE);
+    Teuchos::RCP<const SoAVectorData> ySoA = dataManager.getSoAData(m_coordinatesFieldId, PeridigmField::STEP_NP1);
+    Teuchos::RCP<SoAVectorData> forceSoA = dataManager.getSoAData(m_forceDensityFieldId, PeridigmField::STEP_NP1, false);
+    forceSoA->PutScalar(0.0);
+    MATERIAL_EVALUATION::computeInternalForceElasticBondBasedSoA(xSoA->X(),xSoA->Y(),xSoA->Z(),
+                                                                 ySoA->X(),ySoA->Y(),ySoA->Z(),
+                                                                 cellVolume,bondDamage,
+                                                                 forceSoA->X(),forceSoA->Y(),forceSoA->Z(),
+                                                                 neighborhoodList,numOwnedPoints,m_bulkModulus,m_horizon);
+    dataManager.scatterSoAData(m_forceDensityFieldId, PeridigmField::STEP_NP1);
+    return;
+  }
+
   // Zero out the forces
   dataManager.getData(m_forceDensityFieldId, PeridigmField::STEP_NP1)->PutScalar(0.0);
 
-  // Extract pointers to the underlying data
-  double *x, *y, *cellVolume, *bondDamage, *force;
+  dataManager.getData(m_modelCoordinatesFieldId, PeridigmField::STEP_NONE)->ExtractView(&x);
+  dataManager.getData(m_coordinatesFieldId, PeridigmField::STEP_NP1)->ExtractView(&y);
+  dataManager.getData(m_forceDensityFieldId, PeridigmField::STEP_NP1)->ExtractView(&force);
+
+  if(m_useHalfNeighborList){
+    m_halfNeighborhoodList.update(numOwnedPoints, 0, neighborhoodList, dataManager.getNeighborhoodVersion());
+    MATERIAL_EVALUATION::computeInternalForceElasticBondBasedHalfList(x,y,cellVolume,bondDamage,force,
+                                                                      m_halfNeighborhoodList.NeighborhoodList(),
+                                                                      m_halfNeighborhoodList.BondIndices(),
+                                                                      m_halfNeighborhoodList.ReverseBondIndices(),
+                                                                      numOwnedPoints,m_bulkModulus,m_horizon);
+    return;
+  }
+
+  MATERIAL_EVALUATION::computeInternalForceElasticBondBased(x,y,cellVolume,bondDamage,force,neighborhoodList,numOwnedPoints,m_bulkModulus,m_horizon);
+}
+
+void
+PeridigmNS::ElasticBondBasedMaterial::computeJacobian(const double dt,
+                                                      const int numOwnedPoints,
+                                                      const int* ownedIDs,
+                                                      const int* neighborhoodList,
+                                                      PeridigmNS::DataManager& dataManager,
+                                                      PeridigmNS::SerialMatrix& jacobian,
+                                                      PeridigmNS::Material::JacobianType jacobianType) const
+{
+  if(!m_applyAnalyticJacobian){
+    // Call the base class function, which computes the Jacobian by finite difference
+    PeridigmNS::Material::computeJacobian(dt, numOwnedPoints, ownedIDs, neighborhoodList, dataManager, jacobian, jacobianType);
+    return;
+  }
 
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(jacobianType != PeridigmNS::Material::FULL_MATRIX && jacobianType != PeridigmNS::Material::BLOCK_DIAGONAL,
+                              "**** Unknown Jacobian Type\n");
+
+  double *x, *y, *cellVolume, *bondDamage;
   dataManager.getData(m_modelCoordinatesFieldId, PeridigmField::STEP_NONE)->ExtractView(&x);
   dataManager.getData(m_coordinatesFieldId, PeridigmField::STEP_NP1)->ExtractView(&y);
   dataManager.getData(m_volumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&cellVolume);
   dataManager.getData(m_bondDamageFieldId, PeridigmField::STEP_NP1)->ExtractView(&bondDamage);
-  dataManager.getData(m_forceDensityFieldId, PeridigmField::STEP_NP1)->ExtractView(&force);
 
-  MATERIAL_EVALUATION::computeInternalForceElasticBondBased(x,y,cellVolume,bondDamage,force,neighborhoodList,numOwnedPoints,m_bulkModulus,m_horizon);
+  const Epetra_BlockMap& overlapScalarPointMap = *dataManager.getOverlapScalarPointMap();
+  std::vector<int> globalIndices;
+  std::vector<double> bondStiffness;
+
+  // Each bond contributes the 3x3 block K, scaled by the volumes of its endpoints, to the derivative of the force on the
+  // point with respect to the neighbor and -K to the derivative with respect to the point itself; the force on the neighbor
+  // is equal and opposite.  Only the rows of the point are full; the rows of each neighbor hold the columns of the point
+  // and the neighbor, which are passed in compressed form to SerialMatrix::addPairwiseValues().
+  int neighborhoodListIndex(0), bondIndex(0);
+  for(int iID=0 ; iID<numOwnedPoints ; ++iID){
+
+    int nodeId = ownedIDs[iID];
+    int numNeighbors = neighborhoodList[neighborhoodListIndex];
+    int numDof = 3*(numNeighbors+1);
+
+    if(scratchMatrix.Dimension() < numDof)
+      scratchMatrix.Resize(numDof);
+
+    globalIndices.resize(numDof);
+    int globalID = overlapScalarPointMap.GID(nodeId);
+    for(int j=0 ; j<3 ; ++j)
+      globalIndices[j] = 3*globalID+j;
+    for(int iNID=0 ; iNID<numNeighbors ; ++iNID){
+      globalID = overlapScalarPointMap.GID(neighborhoodList[neighborhoodListIndex+1+iNID]);
+      for(int j=0 ; j<3 ; ++j)
+        globalIndices[3*(iNID+1)+j] = 3*globalID+j;
+    }
+
+    bondStiffness.resize(9*numNeighbors);
+    if(numNeighbors > 0)
+      MATERIAL_EVALUATION::computeBondStiffnessElasticBondBased(x, y, cellVolume, &bondDamage[bondIndex], &bondStiffness[0],
+                                                                nodeId, &neighborhoodList[neighborhoodListIndex], m_bulkModulus, m_horizon);
+
+    neighborhoodListIndex += numNeighbors+1;
+    bondIndex += numNeighbors;
+
+    for(int i=0 ; i<3 ; ++i)
+      for(int j=0 ; j<3 ; ++j)
+        scratchMatrix(i, j) = 0.0;
+    for(int n=0 ; n<numNeighbors ; ++n){
+      const double* K = &bondStiffness[9*n];
+      int neighborRow = 3*(n+1);
+      for(int i=0 ; i<3 ; ++i){
+        for(int j=0 ; j<3 ; ++j){
+          scratchMatrix(i, j) -= K[3*i+j];
+          if(jacobianType == PeridigmNS::Material::FULL_MATRIX){
+            scratchMatrix(i, neighborRow+j) = K[3*i+j];
+            scratchMatrix(neighborRow+i, j) = K[3*i+j];
+            scratchMatrix(neighborRow+i, 3+j) = -K[3*i+j];
+          }
+          else{
+            // Only the diagonal block of the neighbor, in the dense layout read by addBlockDiagonalValues()
+            scratchMatrix(neighborRow+i, neighborRow+j) = -K[3*i+j];
+          }
+        }
+      }
+    }
+
+    // Sum the values into the global tangent matrix
+    if (jacobianType == PeridigmNS::Material::FULL_MATRIX)
+      jacobian.addPairwiseValues(numDof, &globalIndices[0], scratchMatrix.Data());
+    else
+      jacobian.addBlockDiagonalValues(numDof, &globalIndices[0], scratchMatrix.Data());
+  }
 }
@@ -49,6 +49,7 @@
 #define PERIDIGM_ELASTICBONDBASEDMATERIAL_HPP
 
 #include "Peridigm_Material.hpp"
+#include "Peridigm_HalfNeighborhoodList.hpp"
 
 namespace PeridigmNS {
 
@@ -97,6 +98,19 @@ namespace PeridigmNS {
                  const int* neighborhoodList,
                  PeridigmNS::DataManager& dataManager) const;
 
+    //! Evaluate the jacobian, from the closed-form stiffness of each bond unless the analytic jacobian is disabled.
+    virtual void
+    computeJacobian(const double dt,
+                    const int numOwnedPoints,
+                    const int* ownedIDs,
+                    const int* neighborhoodList,
+                    PeridigmNS::DataManager& dataManager,
+                    PeridigmNS::SerialMatrix& jacobian,
+                    PeridigmNS::Material::JacobianType jacobianType = PeridigmNS::Material::FULL_MATRIX) const;
+
+    //! The analytic jacobian couples only the two endpoints of each bond.
+    virtual bool HasPairwiseJacobian() const { return m_applyAnalyticJacobian; }
+
   protected:
 	
     //! Computes the distance between nodes (a1, a2, a3) and (b1, b2, b3).
@@ -110,6 +124,9 @@ namespace PeridigmNS {
     double m_bulkModulus;
     double m_density;
     double m_horizon;
+    bool m_useHalfNeighborList;
+    bool m_useStructureOfArrays;
+    bool m_applyAnalyticJacobian;
 
     // field spec ids for all relevant data
     std::vector<int> m_fieldIds;
@@ -119,6 +136,9 @@ namespace PeridigmNS {
     int m_coordinatesFieldId;
     int m_forceDensityFieldId;
     int m_bondDamageFieldId;
+
+    //! Half neighbor list, in which each pair of owned points is evaluated once
+    mutable PeridigmNS::HalfNeighborhoodList m_halfNeighborhoodList;
   };
 }
 
@@ -48,9 +48,6 @@
 #include "Peridigm_ElasticMaterial.hpp"
 #include "Peridigm_Field.hpp"
 #include "elastic.h"
-#ifdef PERIDIGM_KOKKOS
-  #include "elastic_kokkos.h"
-#endif
 #include "material_utilities.h"
 #include <Teuchos_Assert.hpp>
 #include <Epetra_SerialComm.h>
@@ -62,21 +59,28 @@ using namespace std;
 PeridigmNS::ElasticMaterial::ElasticMaterial(const Teuchos::ParameterList& params)
   : Material(params),
     m_bulkModulus(0.0), m_shearModulus(0.0), m_density(0.0), m_alpha(0.0), m_horizon(0.0),
+    m_applyAnalyticJacobian(true),
     m_applyAutomaticDifferentiationJacobian(true),
     m_applyThermalStrains(false),
     m_computePartialStress(false),
+    m_usePartialVolume(false),
     m_OMEGA(PeridigmNS::InfluenceFunction::self().getInfluenceFunction()),
     m_volumeFieldId(-1), m_damageFieldId(-1), m_weightedVolumeFieldId(-1), m_dilatationFieldId(-1), m_modelCoordinatesFieldId(-1),
     m_coordinatesFieldId(-1), m_forceDensityFieldId(-1), m_partialStressFieldId(-1), m_bondDamageFieldId(-1),
-    m_deltaTemperatureFieldId(-1)
+    m_deltaTemperatureFieldId(-1), m_selfVolumeFieldId(-1), m_neighborVolumeFieldId(-1)
 {
   //! \todo Add meaningful asserts on material properties.
   m_bulkModulus = calculateBulkModulus(params);
   m_shearModulus = calculateShearModulus(params);
   m_density = params.get<double>("Density");
   m_horizon = params.get<double>("Horizon");
-  if(params.isParameter("Apply Automatic Differentiation Jacobian"))
+  // The closed-form tangent is used unless automatic differentiation or finite difference is requested explicitly
+  if(params.isParameter("Apply Automatic Differentiation Jacobian")){
     m_applyAutomaticDifferentiationJacobian = params.get<bool>("Apply Automatic Differentiation Jacobian");
+    m_applyAnalyticJacobian = false;
+  }
+  if(params.isParameter("Apply Analytic Jacobian"))
+    m_applyAnalyticJacobian = params.get<bool>("Apply Analytic Jacobian");
 
   if(params.isParameter("Thermal Expansion Coefficient")){
     m_alpha = params.get<double>("Thermal Expansion Coefficient");
@@ -86,6 +90,9 @@ PeridigmNS::ElasticMaterial::ElasticMaterial(const Teuchos::ParameterList& param
   if(params.isParameter("Compute Partial Stress"))
     m_computePartialStress = params.get<bool>("Compute Partial Stress");
 
+  if(params.isParameter("Use Partial Volume"))
+    m_usePartialVolume = params.get<bool>("Use Partial Volume");
+
   PeridigmNS::FieldManager& fieldManager = PeridigmNS::FieldManager::self();
   m_volumeFieldId                  = fieldManager.getFieldId(PeridigmField::ELEMENT, PeridigmField::SCALAR,      PeridigmField::CONSTANT, "Volume");
   m_damageFieldId                  = fieldManager.getFieldId(PeridigmField::ELEMENT, PeridigmField::SCALAR,      PeridigmField::TWO_STEP, "Damage");
@@ -99,6 +106,10 @@ PeridigmNS::ElasticMaterial::ElasticMaterial(const Teuchos::ParameterList& param
     m_deltaTemperatureFieldId      = fieldManager.getFieldId(PeridigmField::NODE,    PeridigmField::SCALAR,      PeridigmField::TWO_STEP, "Temperature_Change");
   if(m_computePartialStress)
     m_partialStressFieldId         = fieldManager.getFieldId(PeridigmField::ELEMENT, PeridigmField::FULL_TENSOR, PeridigmField::TWO_STEP, "Partial_Stress");
+  if(m_usePartialVolume){
+    m_selfVolumeFieldId            = fieldManager.getFieldId(PeridigmField::BOND,    PeridigmField::SCALAR,      PeridigmField::CONSTANT, "Self_Volume");
+    m_neighborVolumeFieldId        = fieldManager.getFieldId(PeridigmField::BOND,    PeridigmField::SCALAR,      PeridigmField::CONSTANT, "Neighbor_Volume");
+  }
 
   m_fieldIds.push_back(m_volumeFieldId);
   m_fieldIds.push_back(m_damageFieldId);
@@ -112,6 +123,10 @@ PeridigmNS::ElasticMaterial::ElasticMaterial(const Teuchos::ParameterList& param
     m_fieldIds.push_back(m_deltaTemperatureFieldId);
   if(m_computePartialStress)
     m_fieldIds.push_back(m_partialStressFieldId);
+  if(m_usePartialVolume){
+    m_fieldIds.push_back(m_selfVolumeFieldId);
+    m_fieldIds.push_back(m_neighborVolumeFieldId);
+  }
 }
 
 PeridigmNS::ElasticMaterial::~ElasticMaterial()
@@ -131,7 +146,14 @@ PeridigmNS::ElasticMaterial::initialize(const double dt,
   dataManager.getData(m_volumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&cellVolumeOverlap);
   dataManager.getData(m_weightedVolumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&weightedVolume);
 
-  MATERIAL_EVALUATION::computeWeightedVolume(xOverlap,cellVolumeOverlap,weightedVolume,numOwnedPoints,neighborhoodList,m_horizon);
+  if(m_usePartialVolume){
+    double *neighborVolume;
+    dataManager.getData(m_neighborVolumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&neighborVolume);
+    MATERIAL_EVALUATION::WITH_BOND_VOLUME::computeWeightedVolume(xOverlap,neighborVolume,weightedVolume,numOwnedPoints,neighborhoodList,m_horizon);
+  }
+  else{
+    MATERIAL_EVALUATION::computeWeightedVolume(xOverlap,cellVolumeOverlap,weightedVolume,numOwnedPoints,neighborhoodList,m_horizon);
+  }
 
 }
 
@@ -163,13 +185,25 @@ PeridigmNS::ElasticMaterial::computeForce(const double dt,
   partialStress = NULL;
   if(m_computePartialStress)
     dataManager.getData(m_partialStressFieldId, PeridigmField::STEP_NP1)->ExtractView(&partialStress);
+  double *selfVolume(0), *neighborVolume(0);
+  if(m_usePartialVolume){
+    dataManager.getData(m_selfVolumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&selfVolume);
+    dataManager.getData(m_neighborVolumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&neighborVolume);
+  }
 
-  MATERIAL_EVALUATION::computeDilatation(x,y,weightedVolume,cellVolume,bondDamage,dilatation,neighborhoodList,numOwnedPoints,m_horizon,m_OMEGA,m_alpha,deltaTemperature);
 #ifdef PERIDIGM_KOKKOS
-  MATERIAL_EVALUATION::computeInternalForceLinearElasticKokkos(x,y,weightedVolume,cellVolume,dilatation,bondDamage,scf,force,neighborhoodList,numOwnedPoints,m_bulkModulus,m_shearModulus,m_horizon,m_alpha,deltaTemperature);
-#else
-  MATERIAL_EVALUATION::computeInternalForceLinearElastic(x,y,weightedVolume,cellVolume,dilatation,bondDamage,force,partialStress,neighborhoodList,numOwnedPoints,m_bulkModulus,m_shearModulus,m_horizon,m_alpha,deltaTemperature);
+  // The Kokkos kernels do not compute the partial stress or use partial volumes
+  if(!m_computePartialStress && !m_usePartialVolume){
+    int numOverlapPoints = dataManager.getData(m_volumeFieldId, PeridigmField::STEP_NONE)->MyLength();
+    MATERIAL_EVALUATION::updateNeighborhoodCRS(m_neighborhoodCRS,neighborhoodList,numOwnedPoints,dataManager.getNeighborhoodVersion());
+    MATERIAL_EVALUATION::computeDilatationKokkos(x,y,weightedVolume,cellVolume,bondDamage,dilatation,m_neighborhoodCRS,numOverlapPoints,m_horizon,m_OMEGA,m_alpha,deltaTemperature);
+    MATERIAL_EVALUATION::computeInternalForceLinearElasticKokkos(x,y,weightedVolume,cellVolume,dilatation,bondDamage,force,m_neighborhoodCRS,numOverlapPoints,m_bulkModulus,m_shearModulus,m_horizon,m_alpha,deltaTemperature);
+    return;
+  }
 #endif
+
+  MATERIAL_EVALUATION::computeDilatation(x,y,weightedVolume,cellVolume,bondDamage,dilatation,neighborhoodList,numOwnedPoints,m_horizon,m_OMEGA,m_alpha,deltaTemperature,neighborVolume);
+  MATERIAL_EVALUATION::computeInternalForceLinearElastic(x,y,weightedVolume,cellVolume,dilatation,bondDamage,force,partialStress,neighborhoodList,numOwnedPoints,m_bulkModulus,m_shearModulus,m_horizon,m_alpha,deltaTemperature,selfVolume,neighborVolume);
 }
 
 void
@@ -245,7 +279,11 @@ PeridigmNS::ElasticMaterial::computeJacobian(const double dt,
                                              PeridigmNS::SerialMatrix& jacobian,
                                              PeridigmNS::Material::JacobianType jacobianType) const
 {
-  if(m_applyAutomaticDifferentiationJacobian){
+  if(m_applyAnalyticJacobian){
+    // Compute the Jacobian from the closed-form tangent
+    computeAnalyticJacobian(dt, numOwnedPoints, ownedIDs, neighborhoodList, dataManager, jacobian, jacobianType);
+  }
+  else if(m_applyAutomaticDifferentiationJacobian){
     // Compute the Jacobian via automatic differentiation
     computeAutomaticDifferentiationJacobian(dt, numOwnedPoints, ownedIDs, neighborhoodList, dataManager, jacobian, jacobianType);  
   }
@@ -338,6 +376,11 @@ PeridigmNS::ElasticMaterial::computeAutomaticDifferentiationJacobian(const doubl
     deltaTemperature = NULL;
     if(m_applyThermalStrains)
       tempDataManager.getData(m_deltaTemperatureFieldId, PeridigmField::STEP_NP1)->ExtractView(&deltaTemperature);
+    double *selfVolume(0), *neighborVolume(0);
+    if(m_usePartialVolume){
+      tempDataManager.getData(m_selfVolumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&selfVolume);
+      tempDataManager.getData(m_neighborVolumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&neighborVolume);
+    }
     // Create arrays of Fad objects for the current coordinates, dilatation, and force density
     // Modify the existing vector of Fad objects for the current coordinates
     if((int)y_AD.size() < numDof)
@@ -358,8 +401,8 @@ PeridigmNS::ElasticMaterial::computeAutomaticDifferentiationJacobian(const doubl
     }
 
     // Evaluate the constitutive model using the AD types
-    MATERIAL_EVALUATION::computeDilatation(x,&y_AD[0],weightedVolume,cellVolume,bondDamage,&dilatation_AD[0],&tempNeighborhoodList[0],tempNumOwnedPoints,m_horizon,m_OMEGA,m_alpha,deltaTemperature);
-    MATERIAL_EVALUATION::computeInternalForceLinearElastic(x,&y_AD[0],weightedVolume,cellVolume,&dilatation_AD[0],bondDamage,&force_AD[0],partialStress_AD_Ptr,&tempNeighborhoodList[0],tempNumOwnedPoints,m_bulkModulus,m_shearModulus,m_horizon,m_alpha,deltaTemperature);
+    MATERIAL_EVALUATION::computeDilatation(x,&y_AD[0],weightedVolume,cellVolume,bondDamage,&dilatation_AD[0],&tempNeighborhoodList[0],tempNumOwnedPoints,m_horizon,m_OMEGA,m_alpha,deltaTemperature,neighborVolume);
+    MATERIAL_EVALUATION::computeInternalForceLinearElastic(x,&y_AD[0],weightedVolume,cellVolume,&dilatation_AD[0],bondDamage,&force_AD[0],partialStress_AD_Ptr,&tempNeighborhoodList[0],tempNumOwnedPoints,m_bulkModulus,m_shearModulus,m_horizon,m_alpha,deltaTemperature,selfVolume,neighborVolume);
 
     // Load derivative values into scratch matrix
     // Multiply by volume along the way to convert force density to force
@@ -382,3 +425,74 @@ PeridigmNS::ElasticMaterial::computeAutomaticDifferentiationJacobian(const doubl
       TEUCHOS_TEST_FOR_EXCEPT_MSG(true, "**** Unknown Jacobian Type\n");
   }
 }
+
+void
+PeridigmNS::ElasticMaterial::computeAnalyticJacobian(const double dt,
+                                                     const int numOwnedPoints,
+                                                     const int* ownedIDs,
+                                                     const int* neighborhoodList,
+                                                     PeridigmNS::DataManager& dataManager,
+                                                     PeridigmNS::SerialMatrix& jacobian,
+                                                     PeridigmNS::Material::JacobianType jacobianType) const
+{
+  // Compute contributions to the tangent matrix on an element-by-element basis, directly from the overlap data
+
+  double *x, *y, *cellVolume, *weightedVolume, *bondDamage, *deltaTemperature;
+  dataManager.getData(m_modelCoordinatesFieldId, PeridigmField::STEP_NONE)->ExtractView(&x);
+  dataManager.getData(m_coordinatesFieldId, PeridigmField::STEP_NP1)->ExtractView(&y);
+  dataManager.getData(m_volumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&cellVolume);
+  dataManager.getData(m_weightedVolumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&weightedVolume);
+  dataManager.getData(m_bondDamageFieldId, PeridigmField::STEP_NP1)->ExtractView(&bondDamage);
+  deltaTemperature = NULL;
+  if(m_applyThermalStrains)
+    dataManager.getData(m_deltaTemperatureFieldId, PeridigmField::STEP_NP1)->ExtractView(&deltaTemperature);
+  double *selfVolume(0), *neighborVolume(0);
+  if(m_usePartialVolume){
+    dataManager.getData(m_selfVolumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&selfVolume);
+    dataManager.getData(m_neighborVolumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&neighborVolume);
+  }
+
+  const Epetra_BlockMap& overlapScalarPointMap = *dataManager.getOverlapScalarPointMap();
+  vector<int> globalIndices;
+
+  int neighborhoodListIndex(0), bondIndex(0);
+  for(int iID=0 ; iID<numOwnedPoints ; ++iID){
+
+    int nodeId = ownedIDs[iID];
+    int numNeighbors = neighborhoodList[neighborhoodListIndex];
+    int numDof = 3*(numNeighbors+1);
+
+    // Use the scratchMatrix as sub-matrix for storing tangent values prior to loading them into the global tangent matrix.
+    if(scratchMatrix.Dimension() < numDof)
+      scratchMatrix.Resize(numDof);
+
+    // Global indices for the rows/columns in the scratch matrix, with the point itself at the beginning of the list
+    globalIndices.resize(numDof);
+    int globalID = overlapScalarPointMap.GID(nodeId);
+    for(int j=0 ; j<3 ; ++j)
+      globalIndices[j] = 3*globalID+j;
+    for(int iNID=0 ; iNID<numNeighbors ; ++iNID){
+      globalID = overlapScalarPointMap.GID(neighborhoodList[neighborhoodListIndex+1+iNID]);
+      for(int j=0 ; j<3 ; ++j)
+        globalIndices[3*(iNID+1)+j] = 3*globalID+j;
+    }
+
+    MATERIAL_EVALUATION::computeTangentLinearElastic(x, y, weightedVolume[nodeId], cellVolume, &bondDamage[bondIndex], scratchMatrix.Rows(),
+                                                     nodeId, &neighborhoodList[neighborhoodListIndex], m_bulkModulus, m_shearModulus, m_horizon,
+                                                     m_alpha, m_applyThermalStrains ? deltaTemperature[nodeId] : 0.0,
+                                                     m_usePartialVolume ? &selfVolume[bondIndex] : 0,
+                                                     m_usePartialVolume ? &neighborVolume[bondIndex] : 0);
+
+    neighborhoodListIndex += numNeighbors+1;
+    bondIndex += numNeighbors;
+
+    // Sum the values into the global tangent matrix
+    if (jacobianType == PeridigmNS::Material::FULL_MATRIX)
+      jacobian.addValues(numDof, &globalIndices[0], scratchMatrix.Data());
+    else if (jacobianType == PeridigmNS::Material::BLOCK_DIAGONAL) {
+      jacobian.addBlockDiagonalValues(numDof, &globalIndices[0], scratchMatrix.Data());
+    }
+    else // unknown jacobian type
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(true, "**** Unknown Jacobian Type\n");
+  }
+}
@@ -50,6 +50,9 @@
 
 #include "Peridigm_Material.hpp"
 #include "Peridigm_InfluenceFunction.hpp"
+#ifdef PERIDIGM_KOKKOS
+  #include "elastic_kokkos.h"
+#endif
 
 namespace PeridigmNS {
 
@@ -165,6 +168,16 @@ namespace PeridigmNS {
                                             PeridigmNS::SerialMatrix& jacobian,
                                             PeridigmNS::Material::JacobianType jacobianType = PeridigmNS::Material::FULL_MATRIX) const;
 
+    //! Evaluate the jacobian from the closed-form tangent of the linear peridynamic solid.
+    virtual void
+    computeAnalyticJacobian(const double dt,
+                            const int numOwnedPoints,
+                            const int* ownedIDs,
+                            const int* neighborhoodList,
+                            PeridigmNS::DataManager& dataManager,
+                            PeridigmNS::SerialMatrix& jacobian,
+                            PeridigmNS::Material::JacobianType jacobianType = PeridigmNS::Material::FULL_MATRIX) const;
+
   protected:
 	
     //! Computes the distance between nodes (a1, a2, a3) and (b1, b2, b3).
@@ -180,9 +193,11 @@ namespace PeridigmNS {
     double m_density;
     double m_alpha;
     double m_horizon;
+    bool m_applyAnalyticJacobian;
     bool m_applyAutomaticDifferentiationJacobian;
     bool m_applyThermalStrains;
     bool m_computePartialStress;
+    bool m_usePartialVolume;
     PeridigmNS::InfluenceFunction::functionPointer m_OMEGA;
 
     // field spec ids for all relevant data
@@ -197,6 +212,13 @@ namespace PeridigmNS {
     int m_partialStressFieldId;
     int m_bondDamageFieldId;
     int m_deltaTemperatureFieldId;
+    int m_selfVolumeFieldId;
+    int m_neighborVolumeFieldId;
+
+#ifdef PERIDIGM_KOKKOS
+    //! Neighborhood list in CRS form for the Kokkos kernels, rebuilt only when the neighborhood list changes
+    mutable MATERIAL_EVALUATION::NeighborhoodCRS m_neighborhoodCRS;
+#endif
   };
 }
 
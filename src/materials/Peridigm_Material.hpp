@@ -147,6 +147,9 @@ namespace PeridigmNS {
                     PeridigmNS::SerialMatrix& jacobian,
                     PeridigmNS::Material::JacobianType jacobianType = PeridigmNS::Material::FULL_MATRIX) const;
 
+    //! Returns true if the jacobian couples only the two endpoints of each bond, in which case the global tangent needs no entries for pairs of neighbors of a point.
+    virtual bool HasPairwiseJacobian() const { return false; }
+
     //! Compute stored elastic energy density
     virtual void
     computeStoredElasticEnergyDensity(const double dt,
@@ -223,7 +223,8 @@ const ScalarT* coordinates,
 ScalarT* shapeTensorInverse,
 ScalarT* deformationGradient,
 const int* neighborhoodList,
-int numPoints
+int numPoints,
+const double* bondVolume
 )
 {
   int returnCode = 0;
@@ -240,13 +241,9 @@ int numPoints
   ScalarT deformedBondX, deformedBondY, deformedBondZ;
   double neighborVolume, omega, temp;
 
-  std::vector<ScalarT> shapeTensorVector(9);
-  ScalarT* shapeTensor = &shapeTensorVector[0];
+  ScalarT shapeTensor[9], defGradFirstTerm[9];
   ScalarT shapeTensorDeterminant;
 
-  std::vector<ScalarT> defGradFirstTermVector(9);
-  ScalarT* defGradFirstTerm = &defGradFirstTermVector[0];
-
   // placeholder for bond damage
   double bondDamage = 0.0;
 
@@ -254,6 +251,7 @@ int numPoints
 
   int neighborIndex, numNeighbors;
   const int *neighborListPtr = neighborhoodList;
+  const double *bondVol = bondVolume;
   for(int iID=0 ; iID<numPoints ; ++iID, delta++, modelCoord+=3, coord+=3,
         shapeTensorInv+=9, defGrad+=9){
 
@@ -269,7 +267,7 @@ int numPoints
     for(int n=0; n<numNeighbors; n++, neighborListPtr++){
 
       neighborIndex = *neighborListPtr;
-      neighborVolume = volume[neighborIndex];
+      neighborVolume = bondVol != 0 ? *(bondVol++) : volume[neighborIndex];
       neighborModelCoord = modelCoordinates + 3*neighborIndex;
       neighborCoord = coordinates + 3*neighborIndex;
 
@@ -321,6 +319,185 @@ int numPoints
   return returnCode;
 }
 
+//! Flanagan & Taylor (1987) update of the rotation and left stretch tensors at a single point, given Fdot and F.
+template<typename ScalarT>
+int updateRotationAndStretchTensors
+(
+const ScalarT* Fdot,
+const ScalarT* defGrad,
+const ScalarT* leftStretchN,
+const ScalarT* rotTensorN,
+ScalarT* leftStretchNP1,
+ScalarT* rotTensorNP1,
+ScalarT* unrotRateOfDef,
+double dt
+)
+{
+  int returnCode = 0;
+
+  ScalarT Finverse[9], eulerianVelGrad[9], rateOfDef[9], spin[9], temp[9], tempInv[9];
+  ScalarT OmegaTensor[9], QMatrix[9], OmegaTensorSq[9], tempA[9], tempB[9], rateOfStretch[9];
+
+  ScalarT determinant;
+  ScalarT omegaX, omegaY, omegaZ;
+  ScalarT zX, zY, zZ;
+  ScalarT wX, wY, wZ;
+  ScalarT traceV, Omega, OmegaSq, scaleFactor1, scaleFactor2;
+  int inversionReturnCode(0);
+
+
+  // Compute the inverse of the deformation gradient, Finverse
+  inversionReturnCode = Invert3by3Matrix(defGrad, determinant, Finverse);
+  if(inversionReturnCode > 0)
+    returnCode = inversionReturnCode;
+
+  // Compute the Eulerian velocity gradient L = Fdot * Finv
+  MatrixMultiply(false, false, 1.0, Fdot, Finverse, eulerianVelGrad);
+
+  // Compute rate-of-deformation tensor, D = 1/2 * (L + Lt)
+  *(rateOfDef)   = *(eulerianVelGrad);
+  *(rateOfDef+1) = 0.5 * ( *(eulerianVelGrad+1) + *(eulerianVelGrad+3) );
+  *(rateOfDef+2) = 0.5 * ( *(eulerianVelGrad+2) + *(eulerianVelGrad+6) );
+  *(rateOfDef+3) = *(rateOfDef+1);
+  *(rateOfDef+4) = *(eulerianVelGrad+4);
+  *(rateOfDef+5) = 0.5 * ( *(eulerianVelGrad+5) + *(eulerianVelGrad+7) );
+  *(rateOfDef+6) = *(rateOfDef+2);
+  *(rateOfDef+7) = *(rateOfDef+5);
+  *(rateOfDef+8) = *(eulerianVelGrad+8);
+
+  // Compute spin tensor, W = 1/2 * (L - Lt)
+  *(spin)   = 0.0;
+  *(spin+1) = 0.5 * ( *(eulerianVelGrad+1) - *(eulerianVelGrad+3) );
+  *(spin+2) = 0.5 * ( *(eulerianVelGrad+2) - *(eulerianVelGrad+6) );
+  *(spin+3) = -1.0 * *(spin+1);
+  *(spin+4) = 0.0;
+  *(spin+5) = 0.5 * ( *(eulerianVelGrad+5) - *(eulerianVelGrad+7) );
+  *(spin+6) = -1.0 * *(spin+2);
+  *(spin+7) = -1.0 * *(spin+5);
+  *(spin+8) = 0.0;
+ 
+  //Following Flanagan & Taylor (T&F) 
+  //
+  //Find the vector z_i = \epsilon_{ikj} * D_{jm} * V_{mk} (T&F Eq. 13)
+  //
+  //where \epsilon_{ikj} is the alternator tensor.
+  //
+  //Components below copied from computer algebra solution to the expansion
+  //above
+  
+  
+  zX = - *(leftStretchN+2) *  *(rateOfDef+3) -  *(leftStretchN+5) *  *(rateOfDef+4) - 
+         *(leftStretchN+8) *  *(rateOfDef+5) +  *(leftStretchN+1) *  *(rateOfDef+6) + 
+         *(leftStretchN+4) *  *(rateOfDef+7) +  *(leftStretchN+7) *  *(rateOfDef+8);
+  zY =   *(leftStretchN+2) *  *(rateOfDef)   +  *(leftStretchN+5) *  *(rateOfDef+1) + 
+         *(leftStretchN+8) *  *(rateOfDef+2) -  *(leftStretchN)   *  *(rateOfDef+6) - 
+         *(leftStretchN+3) *  *(rateOfDef+7) -  *(leftStretchN+6) *  *(rateOfDef+8);
+  zZ = - *(leftStretchN+1) *  *(rateOfDef)   -  *(leftStretchN+4) *  *(rateOfDef+1) - 
+         *(leftStretchN+7) *  *(rateOfDef+2) +  *(leftStretchN)   *  *(rateOfDef+3) + 
+         *(leftStretchN+3) *  *(rateOfDef+4) +  *(leftStretchN+6) *  *(rateOfDef+5);
+
+  //Find the vector w_i = -1/2 * \epsilon_{ijk} * W_{jk} (T&F Eq. 11)
+  wX = 0.5 * ( *(spin+7) - *(spin+5) );
+  wY = 0.5 * ( *(spin+2) - *(spin+6) );
+  wZ = 0.5 * ( *(spin+3) - *(spin+1) );
+
+  //Find trace(V)
+  traceV = *(leftStretchN) + *(leftStretchN+4) + *(leftStretchN+8);
+
+  // Compute (trace(V) * I - V) store in temp
+  *(temp)   = traceV - *(leftStretchN);
+  *(temp+1) = - *(leftStretchN+1);
+  *(temp+2) = - *(leftStretchN+2);
+  *(temp+3) = - *(leftStretchN+3);
+  *(temp+4) = traceV - *(leftStretchN+4);
+  *(temp+5) = - *(leftStretchN+5);
+  *(temp+6) = - *(leftStretchN+6);
+  *(temp+7) = - *(leftStretchN+7);
+  *(temp+8) = traceV - *(leftStretchN+8);
+
+  // Compute the inverse of the temp matrix
+  inversionReturnCode = Invert3by3Matrix(temp, determinant, tempInv);
+  if(inversionReturnCode > 0)
+    returnCode = inversionReturnCode;
+
+  //Find omega vector, i.e. \omega = w +  (trace(V) I - V)^(-1) * z (T&F Eq. 12)
+  omegaX =  wX + *(tempInv)   * zX + *(tempInv+1) * zY + *(tempInv+2) * zZ;
+  omegaY =  wY + *(tempInv+3) * zX + *(tempInv+4) * zY + *(tempInv+5) * zZ;
+  omegaZ =  wZ + *(tempInv+6) * zX + *(tempInv+7) * zY + *(tempInv+8) * zZ;
+
+  //Find the tensor \Omega_{ij} = \epsilon_{ikj} * w_k (T&F Eq. 10)
+  *(OmegaTensor) = 0.0;
+  *(OmegaTensor+1) = -omegaZ;
+  *(OmegaTensor+2) = omegaY;
+  *(OmegaTensor+3) = omegaZ;
+  *(OmegaTensor+4) = 0.0;
+  *(OmegaTensor+5) = -omegaX;
+  *(OmegaTensor+6) = -omegaY;
+  *(OmegaTensor+7) = omegaX;
+  *(OmegaTensor+8) = 0.0;
+
+  //Increment R with (T&F Eq. 36 and 44) as opposed to solving (T&F 39) this
+  //is desirable for accuracy in implicit solves and has no effect on
+  //explicit solves (other than a slight decrease in speed).
+  //
+  // Compute Q with (T&F Eq. 44)
+  //
+  // Omega^2 = w_i * w_i (T&F Eq. 42)
+  OmegaSq = omegaX*omegaX + omegaY*omegaY + omegaZ*omegaZ;
+  // Omega = \sqrt{OmegaSq}
+  Omega = sqrt(OmegaSq);
+
+  // Avoid a potential divide-by-zero
+  if ( OmegaSq > 1.e-30){
+
+    // Compute Q = I + sin( dt * Omega ) * OmegaTensor / Omega - (1. - cos(dt * Omega)) * omegaTensor^2 / OmegaSq
+    //           = I + scaleFactor1 * OmegaTensor + scaleFactor2 * OmegaTensorSq
+    scaleFactor1 = sin(dt*Omega) / Omega;
+    scaleFactor2 = -(1.0 - cos(dt*Omega)) / OmegaSq;
+    MatrixMultiply(false, false, 1.0, OmegaTensor, OmegaTensor, OmegaTensorSq);
+    *(QMatrix)   = 1.0 + scaleFactor1 * *(OmegaTensor)   + scaleFactor2 * *(OmegaTensorSq)   ;
+    *(QMatrix+1) =       scaleFactor1 * *(OmegaTensor+1) + scaleFactor2 * *(OmegaTensorSq+1) ;
+    *(QMatrix+2) =       scaleFactor1 * *(OmegaTensor+2) + scaleFactor2 * *(OmegaTensorSq+2) ;
+    *(QMatrix+3) =       scaleFactor1 * *(OmegaTensor+3) + scaleFactor2 * *(OmegaTensorSq+3) ;
+    *(QMatrix+4) = 1.0 + scaleFactor1 * *(OmegaTensor+4) + scaleFactor2 * *(OmegaTensorSq+4) ;
+    *(QMatrix+5) =       scaleFactor1 * *(OmegaTensor+5) + scaleFactor2 * *(OmegaTensorSq+5) ;
+    *(QMatrix+6) =       scaleFactor1 * *(OmegaTensor+6) + scaleFactor2 * *(OmegaTensorSq+6) ;
+    *(QMatrix+7) =       scaleFactor1 * *(OmegaTensor+7) + scaleFactor2 * *(OmegaTensorSq+7) ;
+    *(QMatrix+8) = 1.0 + scaleFactor1 * *(OmegaTensor+8) + scaleFactor2 * *(OmegaTensorSq+8) ;
+
+  } else {
+    *(QMatrix)   = 1.0 ; *(QMatrix+1) = 0.0 ; *(QMatrix+2) = 0.0 ;
+    *(QMatrix+3) = 0.0 ; *(QMatrix+4) = 1.0 ; *(QMatrix+5) = 0.0 ;
+    *(QMatrix+6) = 0.0 ; *(QMatrix+7) = 0.0 ; *(QMatrix+8) = 1.0 ;
+  };
+
+  // Compute R_STEP_NP1 = QMatrix * R_STEP_N (T&F Eq. 36)
+  MatrixMultiply(false, false, 1.0, QMatrix, rotTensorN, rotTensorNP1);
+
+  // Compute rate of stretch, Vdot = L*V - V*Omega
+  // First tempA = L*V, 
+  MatrixMultiply(false, false, 1.0, eulerianVelGrad, leftStretchN, tempA);
+
+  // tempB = V*Omega
+  MatrixMultiply(false, false, 1.0, leftStretchN, OmegaTensor, tempB);
+
+  //Vdot = tempA - tempB
+  for(int i=0 ; i<9 ; ++i)
+    *(rateOfStretch+i) = *(tempA+i) - *(tempB+i);
+
+  //V_STEP_NP1 = V_STEP_N + dt*Vdot
+  for(int i=0 ; i<9 ; ++i)
+    *(leftStretchNP1+i) = *(leftStretchN+i) + dt * *(rateOfStretch+i);
+
+  // Compute the unrotated rate-of-deformation, d, i.e., temp = D * R
+  MatrixMultiply(false, false, 1.0, rateOfDef, rotTensorNP1, temp);
+
+  // d = Rt * temp
+  MatrixMultiply(true, false, 1.0, rotTensorNP1, temp, unrotRateOfDef);
+
+  return returnCode;
+}
+
 //Performs kinematic computations following Flanagan and Taylor (1987), returns
 //unrotated rate-of-deformation and rotation tensors
 template<typename ScalarT>
@@ -357,27 +534,8 @@ double dt
   ScalarT* rotTensorNP1 = rotationTensorNP1;
   ScalarT* unrotRateOfDef = unrotatedRateOfDeformation;
 
-  std::vector<ScalarT> FdotFirstTermVector(9) ; ScalarT* FdotFirstTerm = &FdotFirstTermVector[0];
-  std::vector<ScalarT> FdotVector(9) ; ScalarT* Fdot = &FdotVector[0];
-  std::vector<ScalarT> FinverseVector(9) ; ScalarT* Finverse = &FinverseVector[0];
-  std::vector<ScalarT> eulerianVelGradVector(9) ; ScalarT* eulerianVelGrad = &eulerianVelGradVector[0];
-  std::vector<ScalarT> rateOfDefVector(9) ; ScalarT* rateOfDef = &rateOfDefVector[0];
-  std::vector<ScalarT> spinVector(9) ; ScalarT* spin = &spinVector[0];
-  std::vector<ScalarT> tempVector(9) ; ScalarT* temp = &tempVector[0];
-  std::vector<ScalarT> tempInvVector(9) ; ScalarT* tempInv = &tempInvVector[0];
-  std::vector<ScalarT> OmegaTensorVector(9) ; ScalarT* OmegaTensor = &OmegaTensorVector[0];
-  std::vector<ScalarT> QMatrixVector(9) ; ScalarT* QMatrix = &QMatrixVector[0];
-  std::vector<ScalarT> OmegaTensorSqVector(9) ; ScalarT* OmegaTensorSq = &OmegaTensorSqVector[0];
-  std::vector<ScalarT> tempAVector(9) ; ScalarT* tempA = &tempAVector[0];
-  std::vector<ScalarT> tempBVector(9) ; ScalarT* tempB = &tempBVector[0];
-  std::vector<ScalarT> rateOfStretchVector(9) ; ScalarT* rateOfStretch = &rateOfStretchVector[0];
-
-  ScalarT determinant;
-  ScalarT omegaX, omegaY, omegaZ;
-  ScalarT zX, zY, zZ;
-  ScalarT wX, wY, wZ;
+  ScalarT FdotFirstTerm[9], Fdot[9];
   ScalarT velStateX, velStateY, velStateZ;
-  ScalarT traceV, Omega, OmegaSq, scaleFactor1, scaleFactor2;
   double undeformedBondX, undeformedBondY, undeformedBondZ, undeformedBondLength;
   double neighborVolume, omega, scalarTemp; 
   int inversionReturnCode(0);
@@ -436,154 +594,162 @@ double dt
     // Compute Fdot
     MatrixMultiply(false, false, 1.0, FdotFirstTerm, shapeTensorInv, Fdot);
 
-    // Compute the inverse of the deformation gradient, Finverse
-    inversionReturnCode = Invert3by3Matrix(defGrad, determinant, Finverse);
+    // Polar decomposition and rate-of-deformation update
+    inversionReturnCode = updateRotationAndStretchTensors(Fdot, defGrad, leftStretchN, rotTensorN,
+                                                          leftStretchNP1, rotTensorNP1, unrotRateOfDef, dt);
     if(inversionReturnCode > 0)
       returnCode = inversionReturnCode;
+  }
 
-    // Compute the Eulerian velocity gradient L = Fdot * Finv
-    MatrixMultiply(false, false, 1.0, Fdot, Finverse, eulerianVelGrad);
-
-    // Compute rate-of-deformation tensor, D = 1/2 * (L + Lt)
-    *(rateOfDef)   = *(eulerianVelGrad);
-    *(rateOfDef+1) = 0.5 * ( *(eulerianVelGrad+1) + *(eulerianVelGrad+3) );
-    *(rateOfDef+2) = 0.5 * ( *(eulerianVelGrad+2) + *(eulerianVelGrad+6) );
-    *(rateOfDef+3) = *(rateOfDef+1);
-    *(rateOfDef+4) = *(eulerianVelGrad+4);
-    *(rateOfDef+5) = 0.5 * ( *(eulerianVelGrad+5) + *(eulerianVelGrad+7) );
-    *(rateOfDef+6) = *(rateOfDef+2);
-    *(rateOfDef+7) = *(rateOfDef+5);
-    *(rateOfDef+8) = *(eulerianVelGrad+8);
-
-    // Compute spin tensor, W = 1/2 * (L - Lt)
-    *(spin)   = 0.0;
-    *(spin+1) = 0.5 * ( *(eulerianVelGrad+1) - *(eulerianVelGrad+3) );
-    *(spin+2) = 0.5 * ( *(eulerianVelGrad+2) - *(eulerianVelGrad+6) );
-    *(spin+3) = -1.0 * *(spin+1);
-    *(spin+4) = 0.0;
-    *(spin+5) = 0.5 * ( *(eulerianVelGrad+5) - *(eulerianVelGrad+7) );
-    *(spin+6) = -1.0 * *(spin+2);
-    *(spin+7) = -1.0 * *(spin+5);
-    *(spin+8) = 0.0;
-   
-    //Following Flanagan & Taylor (T&F) 
-    //
-    //Find the vector z_i = \epsilon_{ikj} * D_{jm} * V_{mk} (T&F Eq. 13)
-    //
-    //where \epsilon_{ikj} is the alternator tensor.
-    //
-    //Components below copied from computer algebra solution to the expansion
-    //above
-    
-    
-    zX = - *(leftStretchN+2) *  *(rateOfDef+3) -  *(leftStretchN+5) *  *(rateOfDef+4) - 
-           *(leftStretchN+8) *  *(rateOfDef+5) +  *(leftStretchN+1) *  *(rateOfDef+6) + 
-           *(leftStretchN+4) *  *(rateOfDef+7) +  *(leftStretchN+7) *  *(rateOfDef+8);
-    zY =   *(leftStretchN+2) *  *(rateOfDef)   +  *(leftStretchN+5) *  *(rateOfDef+1) + 
-           *(leftStretchN+8) *  *(rateOfDef+2) -  *(leftStretchN)   *  *(rateOfDef+6) - 
-           *(leftStretchN+3) *  *(rateOfDef+7) -  *(leftStretchN+6) *  *(rateOfDef+8);
-    zZ = - *(leftStretchN+1) *  *(rateOfDef)   -  *(leftStretchN+4) *  *(rateOfDef+1) - 
-           *(leftStretchN+7) *  *(rateOfDef+2) +  *(leftStretchN)   *  *(rateOfDef+3) + 
-           *(leftStretchN+3) *  *(rateOfDef+4) +  *(leftStretchN+6) *  *(rateOfDef+5);
-
-    //Find the vector w_i = -1/2 * \epsilon_{ijk} * W_{jk} (T&F Eq. 11)
-    wX = 0.5 * ( *(spin+7) - *(spin+5) );
-    wY = 0.5 * ( *(spin+2) - *(spin+6) );
-    wZ = 0.5 * ( *(spin+3) - *(spin+1) );
-
-    //Find trace(V)
-    traceV = *(leftStretchN) + *(leftStretchN+4) + *(leftStretchN+8);
-
-    // Compute (trace(V) * I - V) store in temp
-    *(temp)   = traceV - *(leftStretchN);
-    *(temp+1) = - *(leftStretchN+1);
-    *(temp+2) = - *(leftStretchN+2);
-    *(temp+3) = - *(leftStretchN+3);
-    *(temp+4) = traceV - *(leftStretchN+4);
-    *(temp+5) = - *(leftStretchN+5);
-    *(temp+6) = - *(leftStretchN+6);
-    *(temp+7) = - *(leftStretchN+7);
-    *(temp+8) = traceV - *(leftStretchN+8);
-
-    // Compute the inverse of the temp matrix
-    Invert3by3Matrix(temp, determinant, tempInv);
-    if(inversionReturnCode > 0)
-      returnCode = inversionReturnCode;
+  return returnCode;
+}
 
-    //Find omega vector, i.e. \omega = w +  (trace(V) I - V)^(-1) * z (T&F Eq. 12)
-    omegaX =  wX + *(tempInv)   * zX + *(tempInv+1) * zY + *(tempInv+2) * zZ;
-    omegaY =  wY + *(tempInv+3) * zX + *(tempInv+4) * zY + *(tempInv+5) * zZ;
-    omegaZ =  wZ + *(tempInv+6) * zX + *(tempInv+7) * zY + *(tempInv+8) * zZ;
-
-    //Find the tensor \Omega_{ij} = \epsilon_{ikj} * w_k (T&F Eq. 10)
-    *(OmegaTensor) = 0.0;
-    *(OmegaTensor+1) = -omegaZ;
-    *(OmegaTensor+2) = omegaY;
-    *(OmegaTensor+3) = omegaZ;
-    *(OmegaTensor+4) = 0.0;
-    *(OmegaTensor+5) = -omegaX;
-    *(OmegaTensor+6) = -omegaY;
-    *(OmegaTensor+7) = omegaX;
-    *(OmegaTensor+8) = 0.0;
-
-    //Increment R with (T&F Eq. 36 and 44) as opposed to solving (T&F 39) this
-    //is desirable for accuracy in implicit solves and has no effect on
-    //explicit solves (other than a slight decrease in speed).
-    //
-    // Compute Q with (T&F Eq. 44)
-    //
-    // Omega^2 = w_i * w_i (T&F Eq. 42)
-    OmegaSq = omegaX*omegaX + omegaY*omegaY + omegaZ*omegaZ;
-    // Omega = \sqrt{OmegaSq}
-    Omega = sqrt(OmegaSq);
-
-    // Avoid a potential divide-by-zero
-    if ( OmegaSq > 1.e-30){
-
-      // Compute Q = I + sin( dt * Omega ) * OmegaTensor / Omega - (1. - cos(dt * Omega)) * omegaTensor^2 / OmegaSq
-      //           = I + scaleFactor1 * OmegaTensor + scaleFactor2 * OmegaTensorSq
-      scaleFactor1 = sin(dt*Omega) / Omega;
-      scaleFactor2 = -(1.0 - cos(dt*Omega)) / OmegaSq;
-      MatrixMultiply(false, false, 1.0, OmegaTensor, OmegaTensor, OmegaTensorSq);
-      *(QMatrix)   = 1.0 + scaleFactor1 * *(OmegaTensor)   + scaleFactor2 * *(OmegaTensorSq)   ;
-      *(QMatrix+1) =       scaleFactor1 * *(OmegaTensor+1) + scaleFactor2 * *(OmegaTensorSq+1) ;
-      *(QMatrix+2) =       scaleFactor1 * *(OmegaTensor+2) + scaleFactor2 * *(OmegaTensorSq+2) ;
-      *(QMatrix+3) =       scaleFactor1 * *(OmegaTensor+3) + scaleFactor2 * *(OmegaTensorSq+3) ;
-      *(QMatrix+4) = 1.0 + scaleFactor1 * *(OmegaTensor+4) + scaleFactor2 * *(OmegaTensorSq+4) ;
-      *(QMatrix+5) =       scaleFactor1 * *(OmegaTensor+5) + scaleFactor2 * *(OmegaTensorSq+5) ;
-      *(QMatrix+6) =       scaleFactor1 * *(OmegaTensor+6) + scaleFactor2 * *(OmegaTensorSq+6) ;
-      *(QMatrix+7) =       scaleFactor1 * *(OmegaTensor+7) + scaleFactor2 * *(OmegaTensorSq+7) ;
-      *(QMatrix+8) = 1.0 + scaleFactor1 * *(OmegaTensor+8) + scaleFactor2 * *(OmegaTensorSq+8) ;
-
-    } else {
-      *(QMatrix)   = 1.0 ; *(QMatrix+1) = 0.0 ; *(QMatrix+2) = 0.0 ;
-      *(QMatrix+3) = 0.0 ; *(QMatrix+4) = 1.0 ; *(QMatrix+5) = 0.0 ;
-      *(QMatrix+6) = 0.0 ; *(QMatrix+7) = 0.0 ; *(QMatrix+8) = 1.0 ;
-    };
-
-    // Compute R_STEP_NP1 = QMatrix * R_STEP_N (T&F Eq. 36)
-    MatrixMultiply(false, false, 1.0, QMatrix, rotTensorN, rotTensorNP1);
-
-    // Compute rate of stretch, Vdot = L*V - V*Omega
-    // First tempA = L*V, 
-    MatrixMultiply(false, false, 1.0, eulerianVelGrad, leftStretchN, tempA);
-
-    // tempB = V*Omega
-    MatrixMultiply(false, false, 1.0, leftStretchN, OmegaTensor, tempB);
-
-    //Vdot = tempA - tempB
-    for(int i=0 ; i<9 ; ++i)
-      *(rateOfStretch+i) = *(tempA+i) - *(tempB+i);
+//Fused kinematics for correspondence materials: a single sweep over each neighborhood accumulates
+//the shape tensor, the deformation gradient, and the rate of the deformation gradient, after which
+//the per-point 3x3 algebra (inversion and Flanagan & Taylor polar decomposition) is performed
+//immediately, while the point's data are still in cache.
+template<typename ScalarT>
+int computeShapeTensorInverseAndUnrotatedRateOfDeformation
+(
+const double* volume,
+const double* horizon,
+const double* modelCoordinates,
+const ScalarT* coordinates,
+const ScalarT* velocities,
+ScalarT* shapeTensorInverse,
+ScalarT* deformationGradient,
+const ScalarT* leftStretchTensorN,
+const ScalarT* rotationTensorN,
+ScalarT* leftStretchTensorNP1,
+ScalarT* rotationTensorNP1,
+ScalarT* unrotatedRateOfDeformation,
+const int* neighborhoodList,
+int numPoints,
+double dt,
+const double* bondVolume
+)
+{
+  int returnCode = 0;
 
-    //V_STEP_NP1 = V_STEP_N + dt*Vdot
+  const double* delta = horizon;
+  const double* modelCoord = modelCoordinates;
+  const double* neighborModelCoord;
+  const ScalarT* coord = coordinates;
+  const ScalarT* neighborCoord;
+  const ScalarT* vel = velocities;
+  const ScalarT* neighborVel;
+  ScalarT* shapeTensorInv = shapeTensorInverse;
+  ScalarT* defGrad = deformationGradient;
+  const ScalarT* leftStretchN = leftStretchTensorN;
+  const ScalarT* rotTensorN = rotationTensorN;
+  ScalarT* leftStretchNP1 = leftStretchTensorNP1;
+  ScalarT* rotTensorNP1 = rotationTensorNP1;
+  ScalarT* unrotRateOfDef = unrotatedRateOfDeformation;
+
+  double undeformedBondX, undeformedBondY, undeformedBondZ, undeformedBondLength;
+  double neighborVolume, omega, temp;
+  ScalarT deformedBondX, deformedBondY, deformedBondZ;
+  ScalarT velStateX, velStateY, velStateZ;
+
+  double shapeTensor[9];
+  ScalarT defGradFirstTerm[9], FdotFirstTerm[9], Fdot[9];
+  double shapeTensorDeterminant;
+
+  // placeholder for bond damage
+  double bondDamage = 0.0;
+
+  int neighborIndex, numNeighbors;
+  const int *neighborListPtr = neighborhoodList;
+  const double *bondVol = bondVolume;
+  for(int iID=0 ; iID<numPoints ; ++iID, delta++, modelCoord+=3, coord+=3, vel+=3,
+        shapeTensorInv+=9, defGrad+=9, rotTensorN+=9, rotTensorNP1+=9, leftStretchN+=9, leftStretchNP1+=9,
+        unrotRateOfDef+=9){
+
+    for(int i=0 ; i<9 ; ++i){
+      shapeTensor[i] = 0.0;
+      defGradFirstTerm[i] = 0.0;
+      FdotFirstTerm[i] = 0.0;
+    }
+
+    numNeighbors = *neighborListPtr; neighborListPtr++;
+    for(int n=0; n<numNeighbors; n++, neighborListPtr++){
+
+      neighborIndex = *neighborListPtr;
+      neighborVolume = bondVol != 0 ? *(bondVol++) : volume[neighborIndex];
+      neighborModelCoord = modelCoordinates + 3*neighborIndex;
+      neighborCoord = coordinates + 3*neighborIndex;
+      neighborVel = velocities + 3*neighborIndex;
+
+      undeformedBondX = *(neighborModelCoord)   - *(modelCoord);
+      undeformedBondY = *(neighborModelCoord+1) - *(modelCoord+1);
+      undeformedBondZ = *(neighborModelCoord+2) - *(modelCoord+2);
+      undeformedBondLength = sqrt(undeformedBondX*undeformedBondX +
+                                  undeformedBondY*undeformedBondY +
+                                  undeformedBondZ*undeformedBondZ);
+
+      deformedBondX = *(neighborCoord)   - *(coord);
+      deformedBondY = *(neighborCoord+1) - *(coord+1);
+      deformedBondZ = *(neighborCoord+2) - *(coord+2);
+
+      velStateX = *(neighborVel)   - *(vel);
+      velStateY = *(neighborVel+1) - *(vel+1);
+      velStateZ = *(neighborVel+2) - *(vel+2);
+
+      omega = MATERIAL_EVALUATION::scalarInfluenceFunction(undeformedBondLength, *delta);
+
+      temp = (1.0 - bondDamage) * omega * neighborVolume;
+
+      // The shape tensor depends only on the reference configuration
+      shapeTensor[0] += temp * undeformedBondX * undeformedBondX;
+      shapeTensor[1] += temp * undeformedBondX * undeformedBondY;
+      shapeTensor[2] += temp * undeformedBondX * undeformedBondZ;
+      shapeTensor[3] += temp * undeformedBondY * undeformedBondX;
+      shapeTensor[4] += temp * undeformedBondY * undeformedBondY;
+      shapeTensor[5] += temp * undeformedBondY * undeformedBondZ;
+      shapeTensor[6] += temp * undeformedBondZ * undeformedBondX;
+      shapeTensor[7] += temp * undeformedBondZ * undeformedBondY;
+      shapeTensor[8] += temp * undeformedBondZ * undeformedBondZ;
+
+      defGradFirstTerm[0] += temp * deformedBondX * undeformedBondX;
+      defGradFirstTerm[1] += temp * deformedBondX * undeformedBondY;
+      defGradFirstTerm[2] += temp * deformedBondX * undeformedBondZ;
+      defGradFirstTerm[3] += temp * deformedBondY * undeformedBondX;
+      defGradFirstTerm[4] += temp * deformedBondY * undeformedBondY;
+      defGradFirstTerm[5] += temp * deformedBondY * undeformedBondZ;
+      defGradFirstTerm[6] += temp * deformedBondZ * undeformedBondX;
+      defGradFirstTerm[7] += temp * deformedBondZ * undeformedBondY;
+      defGradFirstTerm[8] += temp * deformedBondZ * undeformedBondZ;
+
+      FdotFirstTerm[0] += temp * velStateX * undeformedBondX;
+      FdotFirstTerm[1] += temp * velStateX * undeformedBondY;
+      FdotFirstTerm[2] += temp * velStateX * undeformedBondZ;
+      FdotFirstTerm[3] += temp * velStateY * undeformedBondX;
+      FdotFirstTerm[4] += temp * velStateY * undeformedBondY;
+      FdotFirstTerm[5] += temp * velStateY * undeformedBondZ;
+      FdotFirstTerm[6] += temp * velStateZ * undeformedBondX;
+      FdotFirstTerm[7] += temp * velStateZ * undeformedBondY;
+      FdotFirstTerm[8] += temp * velStateZ * undeformedBondZ;
+    }
+
+    // The shape tensor is real-valued, so invert it in double precision and promote the result
+    double shapeTensorInvDouble[9];
+    int inversionReturnCode = Invert3by3Matrix(shapeTensor, shapeTensorDeterminant, shapeTensorInvDouble);
     for(int i=0 ; i<9 ; ++i)
-      *(leftStretchNP1+i) = *(leftStretchN+i) + dt * *(rateOfStretch+i);
+      shapeTensorInv[i] = shapeTensorInvDouble[i];
+
+    // F = defGradFirstTerm * K^-1 and Fdot = FdotFirstTerm * K^-1
+    MatrixMultiply(false, false, ScalarT(1.0), defGradFirstTerm, shapeTensorInv, defGrad);
+    MatrixMultiply(false, false, ScalarT(1.0), FdotFirstTerm, shapeTensorInv, Fdot);
 
-    // Compute the unrotated rate-of-deformation, d, i.e., temp = D * R
-    MatrixMultiply(false, false, 1.0, rateOfDef, rotTensorNP1, temp);
+    if(inversionReturnCode > 0){
+      returnCode = 1;
+      continue;
+    }
 
-    // d = Rt * temp
-    MatrixMultiply(true, false, 1.0, rotTensorNP1, temp, unrotRateOfDef);
+    inversionReturnCode = updateRotationAndStretchTensors(Fdot, defGrad, leftStretchN, rotTensorN,
+                                                          leftStretchNP1, rotTensorNP1, unrotRateOfDef, dt);
+    if(inversionReturnCode > 0 && returnCode == 0)
+      returnCode = 2;
   }
 
   return returnCode;
@@ -823,7 +989,8 @@ const double* coordinates,
 double* shapeTensorInverse,
 double* deformationGradient,
 const int* neighborhoodList,
-int numPoints
+int numPoints,
+const double* bondVolume
 );
 
 template int computeUnrotatedRateOfDeformationAndRotationTensor<double>
@@ -844,6 +1011,26 @@ int numPoints,
 double dt
 );
 
+template int computeShapeTensorInverseAndUnrotatedRateOfDeformation<double>
+(
+const double* volume,
+const double* horizon,
+const double* modelCoordinates,
+const double* coordinates,
+const double* velocities,
+double* shapeTensorInverse,
+double* deformationGradient,
+const double* leftStretchTensorN,
+const double* rotationTensorN,
+double* leftStretchTensorNP1,
+double* rotationTensorNP1,
+double* unrotatedRateOfDeformation,
+const int* neighborhoodList,
+int numPoints,
+double dt,
+const double* bondVolume
+);
+
 template void computeGreenLagrangeStrain<double>
 (
   const double* deformationGradientXX,
@@ -98,7 +98,8 @@ const ScalarT* coordinates,
 ScalarT* shapeTensorInverse,
 ScalarT* deformationGradient,
 const int* neighborhoodList,
-int numPoints
+int numPoints,
+const double* bondVolume = 0
 );
 
 // Calculation of stretch rates following Flanagan & Taylor
@@ -120,6 +121,29 @@ int numPoints,
 double dt
 );
 
+//! Single neighborhood sweep computing the shape tensor inverse, deformation gradient, rotation tensor, left stretch tensor,
+//! and unrotated rate-of-deformation; returns 1 if the shape tensor is singular, 2 if the deformation gradient is singular.
+template<typename ScalarT>
+int computeShapeTensorInverseAndUnrotatedRateOfDeformation
+(
+const double* volume,
+const double* horizon,
+const double* modelCoordinates,
+const ScalarT* coordinates,
+const ScalarT* velocities,
+ScalarT* shapeTensorInverse,
+ScalarT* deformationGradient,
+const ScalarT* leftStretchTensorN,
+const ScalarT* rotationTensorN,
+ScalarT* leftStretchTensorNP1,
+ScalarT* rotationTensorNP1,
+ScalarT* unrotatedRateOfDeformation,
+const int* neighborhoodList,
+int numPoints,
+double dt,
+const double* bondVolume = 0
+);
+
 //! Green-Lagrange Strain E = 0.5*(F^T F - I).
 template<typename ScalarT>
 void computeGreenLagrangeStrain
@@ -46,6 +46,7 @@
 //@HEADER
 
 #include <cmath>
+#include <vector>
 #include <Sacado.hpp>
 #include "elastic.h"
 #include "material_utilities.h"
@@ -69,7 +70,9 @@ void computeInternalForceLinearElastic
 		double SHEAR_MODULUS,
         double horizon,
         double thermalExpansionCoefficient,
-        const double* deltaTemperature
+        const double* deltaTemperature,
+        const double* selfVolume,
+        const double* neighborVolume
 )
 {
 
@@ -84,6 +87,8 @@ void computeInternalForceLinearElastic
     const double *deltaT = deltaTemperature;
 	const double *m = mOwned;
 	const double *v = volumeOverlap;
+	const double *selfBondVolume = selfVolume;
+	const double *neighborBondVolume = neighborVolume;
 	const ScalarT *theta = dilatationOwned;
 	ScalarT *fOwned = fInternalOverlap;
 	ScalarT *psOwned = partialStressOverlap;
@@ -101,6 +106,10 @@ void computeInternalForceLinearElastic
 		for(int n=0;n<numNeigh;n++,neighPtr++,bondDamage++){
 			int localId = *neighPtr;
 			cellVolume = v[localId];
+			if(selfVolume != 0 && neighborVolume != 0){
+				selfCellVolume = *(selfBondVolume++);
+				cellVolume = *(neighborBondVolume++);
+			}
 			const double *XP = &xOverlap[3*localId];
 			const ScalarT *YP = &yOverlap[3*localId];
 			X_dx = XP[0]-X[0];
@@ -162,7 +171,9 @@ template void computeInternalForceLinearElastic<double>
 		double SHEAR_MODULUS,
         double horizon,
         double thermalExpansionCoefficient,
-        const double* deltaTemperature
+        const double* deltaTemperature,
+        const double* selfVolume,
+        const double* neighborVolume
  );
 
 /** Explicit template instantiation for Sacado::Fad::DFad<double>. */
@@ -182,7 +193,122 @@ template void computeInternalForceLinearElastic<Sacado::Fad::DFad<double> >
 		double SHEAR_MODULUS,
         double horizon,
         double thermalExpansionCoefficient,
-        const double* deltaTemperature
+        const double* deltaTemperature,
+        const double* selfVolume,
+        const double* neighborVolume
 );
 
+
+void computeTangentLinearElastic
+(
+		const double* xOverlap,
+		const double* yOverlap,
+		double weightedVolume,
+		const double* volumeOverlap,
+		const double* bondDamage,
+		double* const* tangent,
+		int ownedId,
+		const int* neighborList,
+		double BULK_MODULUS,
+		double SHEAR_MODULUS,
+		double horizon,
+		double thermalExpansionCoefficient,
+		double deltaTemperature,
+		const double* selfVolume,
+		const double* neighborVolume
+)
+{
+	/*
+	 * The force density of each bond is t*u, with u the unit vector along the deformed bond and
+	 * t = (1-d)*(c*theta*zeta + (1-d)*omega*alpha*e).  Differentiating gives a 3x3 block for the two
+	 * endpoints of each bond,
+	 *   (1-d)^2*omega*alpha*u.u^T + t/|Y|*(I - u.u^T),
+	 * plus a rank-one coupling through the dilatation theta of the owned point to every point of the neighborhood.
+	 */
+	const double K = BULK_MODULUS;
+	const double MU = SHEAR_MODULUS;
+	const double m = weightedVolume;
+	const double alpha = 15.0*MU/m;
+	const double c = 3.0*K/m - alpha/3.0;
+	const bool usePartialVolume = (selfVolume != 0 && neighborVolume != 0);
+
+	const int numNeigh = *neighborList;
+	const int *neighPtr = neighborList + 1;
+	const int dim = 3*(numNeigh+1);
+	for(int row=0 ; row<dim ; ++row)
+		for(int col=0 ; col<dim ; ++col)
+			tangent[row][col] = 0.0;
+
+	const double *X = &xOverlap[3*ownedId];
+	const double *Y = &yOverlap[3*ownedId];
+
+	// Dilatation and its gradient with respect to the coordinates of the neighborhood
+	std::vector<double> u(3*numNeigh), dY(numNeigh), e(numNeigh), zeta(numNeigh), omega(numNeigh);
+	std::vector<double> dTheta(dim, 0.0);
+	double theta = 0.0;
+	for(int n=0 ; n<numNeigh ; ++n){
+		int localId = neighPtr[n];
+		const double *XP = &xOverlap[3*localId];
+		const double *YP = &yOverlap[3*localId];
+		double X_dx = XP[0]-X[0];
+		double X_dy = XP[1]-X[1];
+		double X_dz = XP[2]-X[2];
+		zeta[n] = sqrt(X_dx*X_dx+X_dy*X_dy+X_dz*X_dz);
+		double Y_dx = YP[0]-Y[0];
+		double Y_dy = YP[1]-Y[1];
+		double Y_dz = YP[2]-Y[2];
+		dY[n] = sqrt(Y_dx*Y_dx+Y_dy*Y_dy+Y_dz*Y_dz);
+		u[3*n+0] = Y_dx/dY[n];
+		u[3*n+1] = Y_dy/dY[n];
+		u[3*n+2] = Y_dz/dY[n];
+		e[n] = dY[n] - zeta[n] - thermalExpansionCoefficient*deltaTemperature*zeta[n];
+		omega[n] = scalarInfluenceFunction(zeta[n],horizon);
+		double cellVolume = usePartialVolume ? neighborVolume[n] : volumeOverlap[localId];
+		double dThetaDe = 3.0*omega[n]*(1.0-bondDamage[n])*zeta[n]*cellVolume/m;
+		theta += dThetaDe*e[n];
+		for(int i=0 ; i<3 ; ++i){
+			dTheta[3*(n+1)+i] += dThetaDe*u[3*n+i];
+			dTheta[i] -= dThetaDe*u[3*n+i];
+		}
+	}
+
+	// Bond-pair and dilatation-coupling terms for each bond
+	for(int n=0 ; n<numNeigh ; ++n){
+		int localId = neighPtr[n];
+		double cellVolume = usePartialVolume ? neighborVolume[n] : volumeOverlap[localId];
+		double selfCellVolume = usePartialVolume ? selfVolume[n] : volumeOverlap[ownedId];
+		double damage = 1.0-bondDamage[n];
+		double t = damage*(omega[n]*theta*c*zeta[n] + damage*omega[n]*alpha*e[n]);
+		double dTdE = damage*damage*omega[n]*alpha;
+		double dTdTheta = damage*omega[n]*c*zeta[n];
+		const double *U = &u[3*n];
+		double *const *ownedRows = &tangent[0];
+		double *const *neighborRows = &tangent[3*(n+1)];
+		int neighborCol = 3*(n+1);
+		for(int i=0 ; i<3 ; ++i){
+			for(int j=0 ; j<3 ; ++j){
+				double k = dTdE*U[i]*U[j] + t/dY[n]*((i==j ? 1.0 : 0.0) - U[i]*U[j]);
+				ownedRows[i][neighborCol+j] += cellVolume*k;
+				ownedRows[i][j] -= cellVolume*k;
+				neighborRows[i][neighborCol+j] -= selfCellVolume*k;
+				neighborRows[i][j] += selfCellVolume*k;
+			}
+			double coupling = dTdTheta*U[i];
+			for(int col=0 ; col<dim ; ++col){
+				ownedRows[i][col] += cellVolume*coupling*dTheta[col];
+				neighborRows[i][col] -= selfCellVolume*coupling*dTheta[col];
+			}
+		}
+	}
+
+	// Convert force density to force
+	for(int row=0 ; row<3 ; ++row)
+		for(int col=0 ; col<dim ; ++col)
+			tangent[row][col] *= volumeOverlap[ownedId];
+	for(int n=0 ; n<numNeigh ; ++n)
+		for(int row=3*(n+1) ; row<3*(n+2) ; ++row)
+			for(int col=0 ; col<dim ; ++col)
+				tangent[row][col] *= volumeOverlap[neighPtr[n]];
+}
+
 }
@@ -67,8 +67,31 @@ void computeInternalForceLinearElastic
 		double SHEAR_MODULUS,
         double horizon,
         double thermalExpansionCoefficient = 0,
-        const double* deltaTemperature = 0
+        const double* deltaTemperature = 0,
+        const double* selfVolume = 0,
+        const double* neighborVolume = 0
+);
 
+//! Computes the tangent of the internal force with respect to the current coordinates for a single owned point.
+//! The rows and columns of the tangent are ordered as the owned point followed by its neighbors, three per point,
+//! and the rows are scaled by the volume of the corresponding point to convert force density to force.
+void computeTangentLinearElastic
+(
+		const double* xOverlap,
+		const double* yOverlap,
+		double weightedVolume,
+		const double* volumeOverlap,
+		const double* bondDamage,
+		double* const* tangent,
+		int ownedId,
+		const int* neighborList,
+		double BULK_MODULUS,
+		double SHEAR_MODULUS,
+		double horizon,
+		double thermalExpansionCoefficient = 0,
+		double deltaTemperature = 0,
+		const double* selfVolume = 0,
+		const double* neighborVolume = 0
 );
 
 }
@@ -46,6 +46,7 @@
 //@HEADER
 
 #include <cmath>
+#include <vector>
 #include <Sacado.hpp>
 #include <boost/math/constants/constants.hpp>
 #include "elastic_bond_based.h"
@@ -118,6 +119,193 @@ void computeInternalForceElasticBondBased
   }
 }
 
+void computeInternalForceElasticBondBasedHalfList
+(
+		const double* xOverlap,
+		const double* yOverlap,
+		const double* volumeOverlap,
+		const double* bondDamage,
+		double* fInternalOverlap,
+		const int* halfNeighborList,
+		const int* bondIndices,
+		const int* reverseBondIndices,
+		int numOwnedPoints,
+		double BULK_MODULUS,
+        double horizon
+)
+{
+  double volume, neighborVolume, X[3], neighborX[3], initialBondLength, damageOnBond;
+  double Y[3], neighborY[3], currentBondLength, stretch, t, fx, fy, fz;
+  int neighborhoodIndex(0), bondIndex(0), neighborId;
+
+  const double pi = boost::math::constants::pi<double>();
+  double constant = 18.0*BULK_MODULUS/(pi*horizon*horizon*horizon*horizon);
+
+  for(int p=0 ; p<numOwnedPoints ; p++){
+
+    X[0] = xOverlap[p*3];
+    X[1] = xOverlap[p*3+1];
+    X[2] = xOverlap[p*3+2];
+    Y[0] = yOverlap[p*3];
+    Y[1] = yOverlap[p*3+1];
+    Y[2] = yOverlap[p*3+2];
+    volume = volumeOverlap[p];
+
+    int numNeighbors = halfNeighborList[neighborhoodIndex++];
+	for(int n=0; n<numNeighbors; n++, bondIndex++){
+
+      neighborId = halfNeighborList[neighborhoodIndex++];
+      neighborX[0] = xOverlap[neighborId*3];
+      neighborX[1] = xOverlap[neighborId*3+1];
+      neighborX[2] = xOverlap[neighborId*3+2];
+      neighborY[0] = yOverlap[neighborId*3];
+      neighborY[1] = yOverlap[neighborId*3+1];
+      neighborY[2] = yOverlap[neighborId*3+2];
+      neighborVolume = volumeOverlap[neighborId];
+
+      initialBondLength = std::sqrt( (neighborX[0]-X[0])*(neighborX[0]-X[0]) + (neighborX[1]-X[1])*(neighborX[1]-X[1]) + (neighborX[2]-X[2])*(neighborX[2]-X[2]) );
+      currentBondLength = std::sqrt( (neighborY[0]-Y[0])*(neighborY[0]-Y[0]) + (neighborY[1]-Y[1])*(neighborY[1]-Y[1]) + (neighborY[2]-Y[2])*(neighborY[2]-Y[2]) );
+      stretch = (currentBondLength - initialBondLength)/initialBondLength;
+
+      // A pair stored once accounts for both the bond and its reverse bond, each of which
+      // contributes half of the pairwise force, as in computeInternalForceElasticBondBased()
+      damageOnBond = bondDamage[bondIndices[bondIndex]];
+      if(reverseBondIndices[bondIndex] != -1)
+        t = (1.0 - 0.5*(damageOnBond + bondDamage[reverseBondIndices[bondIndex]]))*stretch*constant;
+      else
+        t = 0.5*(1.0 - damageOnBond)*stretch*constant;
+
+      fx = t * (neighborY[0] - Y[0]) / currentBondLength;
+      fy = t * (neighborY[1] - Y[1]) / currentBondLength;
+      fz = t * (neighborY[2] - Y[2]) / currentBondLength;
+
+      fInternalOverlap[3*p+0] += fx*neighborVolume;
+      fInternalOverlap[3*p+1] += fy*neighborVolume;
+      fInternalOverlap[3*p+2] += fz*neighborVolume;
+      fInternalOverlap[3*neighborId+0] -= fx*volume;
+      fInternalOverlap[3*neighborId+1] -= fy*volume;
+      fInternalOverlap[3*neighborId+2] -= fz*volume;
+    }
+  }
+}
+
+void computeInternalForceElasticBondBasedSoA
+(
+		const double* xOverlapX,
+		const double* xOverlapY,
+		const double* xOverlapZ,
+		const double* yOverlapX,
+		const double* yOverlapY,
+		const double* yOverlapZ,
+		const double* volumeOverlap,
+		const double* bondDamage,
+		double* fInternalOverlapX,
+		double* fInternalOverlapY,
+		double* fInternalOverlapZ,
+		const int* localNeighborList,
+		int numOwnedPoints,
+		double BULK_MODULUS,
+        double horizon
+)
+{
+  const double pi = boost::math::constants::pi<double>();
+  double constant = 18.0*BULK_MODULUS/(pi*horizon*horizon*horizon*horizon);
+
+  // Pairwise force per bond for the current point, sized for the largest neighborhood
+  int maxNumNeighbors(0), neighborhoodIndex(0);
+  for(int p=0 ; p<numOwnedPoints ; p++){
+    int numNeighbors = localNeighborList[neighborhoodIndex];
+    if(numNeighbors > maxNumNeighbors)
+      maxNumNeighbors = numNeighbors;
+    neighborhoodIndex += numNeighbors + 1;
+  }
+  std::vector<double> bondForceX(maxNumNeighbors), bondForceY(maxNumNeighbors), bondForceZ(maxNumNeighbors);
+
+  neighborhoodIndex = 0;
+  int bondDamageIndex(0);
+  for(int p=0 ; p<numOwnedPoints ; p++){
+
+    const double X0 = xOverlapX[p], X1 = xOverlapY[p], X2 = xOverlapZ[p];
+    const double Y0 = yOverlapX[p], Y1 = yOverlapY[p], Y2 = yOverlapZ[p];
+    const double volume = volumeOverlap[p];
+
+    const int numNeighbors = localNeighborList[neighborhoodIndex++];
+    const int* neighbors = &localNeighborList[neighborhoodIndex];
+    const double* damage = &bondDamage[bondDamageIndex];
+    neighborhoodIndex += numNeighbors;
+    bondDamageIndex += numNeighbors;
+
+    // The pairwise forces are computed in a loop without loop-carried dependences, which can be
+    // vectorized with gathers from the component arrays, and are then summed into the force density
+    for(int n=0; n<numNeighbors; n++){
+      const int neighborId = neighbors[n];
+      const double dX0 = xOverlapX[neighborId] - X0, dX1 = xOverlapY[neighborId] - X1, dX2 = xOverlapZ[neighborId] - X2;
+      const double dY0 = yOverlapX[neighborId] - Y0, dY1 = yOverlapY[neighborId] - Y1, dY2 = yOverlapZ[neighborId] - Y2;
+      const double initialBondLength = std::sqrt(dX0*dX0 + dX1*dX1 + dX2*dX2);
+      const double currentBondLength = std::sqrt(dY0*dY0 + dY1*dY1 + dY2*dY2);
+      const double stretch = (currentBondLength - initialBondLength)/initialBondLength;
+      const double t = 0.5*(1.0 - damage[n])*stretch*constant;
+      bondForceX[n] = t * dY0 / currentBondLength;
+      bondForceY[n] = t * dY1 / currentBondLength;
+      bondForceZ[n] = t * dY2 / currentBondLength;
+    }
+
+    for(int n=0; n<numNeighbors; n++){
+      const int neighborId = neighbors[n];
+      const double neighborVolume = volumeOverlap[neighborId];
+      fInternalOverlapX[p] += bondForceX[n]*neighborVolume;
+      fInternalOverlapY[p] += bondForceY[n]*neighborVolume;
+      fInternalOverlapZ[p] += bondForceZ[n]*neighborVolume;
+      fInternalOverlapX[neighborId] -= bondForceX[n]*volume;
+      fInternalOverlapY[neighborId] -= bondForceY[n]*volume;
+      fInternalOverlapZ[neighborId] -= bondForceZ[n]*volume;
+    }
+  }
+}
+
+void computeBondStiffnessElasticBondBased
+(
+		const double* xOverlap,
+		const double* yOverlap,
+		const double* volumeOverlap,
+		const double* bondDamage,
+		double* bondStiffness,
+		int ownedId,
+		const int* neighborList,
+		double BULK_MODULUS,
+        double horizon
+)
+{
+  const double pi = boost::math::constants::pi<double>();
+  double constant = 18.0*BULK_MODULUS/(pi*horizon*horizon*horizon*horizon);
+
+  const double* X = &xOverlap[3*ownedId];
+  const double* Y = &yOverlap[3*ownedId];
+  const double volume = volumeOverlap[ownedId];
+
+  // The pairwise force t*u, with u the unit vector along the deformed bond, has the derivative
+  // dt/dL*u.u^T + t/L*(I - u.u^T) with respect to the coordinates of the neighbor
+  const int numNeighbors = neighborList[0];
+  for(int n=0; n<numNeighbors; n++){
+    const int neighborId = neighborList[n+1];
+    const double dX0 = xOverlap[3*neighborId] - X[0], dX1 = xOverlap[3*neighborId+1] - X[1], dX2 = xOverlap[3*neighborId+2] - X[2];
+    const double dY[3] = {yOverlap[3*neighborId] - Y[0], yOverlap[3*neighborId+1] - Y[1], yOverlap[3*neighborId+2] - Y[2]};
+    const double initialBondLength = std::sqrt(dX0*dX0 + dX1*dX1 + dX2*dX2);
+    const double currentBondLength = std::sqrt(dY[0]*dY[0] + dY[1]*dY[1] + dY[2]*dY[2]);
+    const double stretch = (currentBondLength - initialBondLength)/initialBondLength;
+    const double t = 0.5*(1.0 - bondDamage[n])*stretch*constant;
+    const double dTdL = 0.5*(1.0 - bondDamage[n])*constant/initialBondLength;
+    const double volumes = volume*volumeOverlap[neighborId];
+    double* K = &bondStiffness[9*n];
+    for(int i=0 ; i<3 ; ++i){
+      for(int j=0 ; j<3 ; ++j){
+        double uu = dY[i]*dY[j]/(currentBondLength*currentBondLength);
+        K[3*i+j] = volumes*(dTdL*uu + t/currentBondLength*((i==j ? 1.0 : 0.0) - uu));
+      }
+    }
+  }
+}
+
 /** Explicit template instantiation for double. */
 template void computeInternalForceElasticBondBased<double>
 (
@@ -64,6 +64,58 @@ void computeInternalForceElasticBondBased
         double horizon
 );
 
+//! Computes the internal force using a half neighbor list, in which each pair of owned points is evaluated once.
+//! Bond damage is stored in the layout of the full neighbor list and is accessed through bondIndices and reverseBondIndices.
+void computeInternalForceElasticBondBasedHalfList
+(
+		const double* xOverlapPtr,
+		const double* yOverlapPtr,
+		const double* volumeOverlapPtr,
+		const double* bondDamage,
+		double* fInternalOverlapPtr,
+		const int* halfNeighborList,
+		const int* bondIndices,
+		const int* reverseBondIndices,
+		int numOwnedPoints,
+		double BULK_MODULUS,
+        double horizon
+);
+
+//! Computes the internal force with coordinates and forces stored as separate x, y, and z arrays (see PeridigmNS::SoAVectorData).
+void computeInternalForceElasticBondBasedSoA
+(
+		const double* xOverlapX,
+		const double* xOverlapY,
+		const double* xOverlapZ,
+		const double* yOverlapX,
+		const double* yOverlapY,
+		const double* yOverlapZ,
+		const double* volumeOverlapPtr,
+		const double* bondDamage,
+		double* fInternalOverlapX,
+		double* fInternalOverlapY,
+		double* fInternalOverlapZ,
+		const int* localNeighborList,
+		int numOwnedPoints,
+		double BULK_MODULUS,
+        double horizon
+);
+
+//! Computes the stiffness of each bond of a single owned point, i.e., the derivative of the pairwise force on the point with respect to
+//! the coordinates of the neighbor, scaled by the volumes of both points.  The 3x3 block for each bond is stored by rows in bondStiffness.
+void computeBondStiffnessElasticBondBased
+(
+		const double* xOverlapPtr,
+		const double* yOverlapPtr,
+		const double* volumeOverlapPtr,
+		const double* bondDamage,
+		double* bondStiffness,
+		int ownedId,
+		const int* neighborList,
+		double BULK_MODULUS,
+        double horizon
+);
+
 }
 
 #endif // ELASTIC_BOND_BASED_H
@@ -47,136 +47,99 @@
 #ifndef ELASTIC_KOKKOS_H
 #define ELASTIC_KOKKOS_H
 
+#include "material_utilities.h"
 
-// TODO: (DZT) Move most of this to a typedefs file
+// The kernels operate directly on the host-resident Epetra_Vector storage owned by the
+// DataManager (zero-copy), so only host execution spaces are supported.
 
 #ifdef _OPENMP
   #include <Kokkos_OpenMP.hpp>
+  typedef Kokkos::OpenMP device_type;
 #else
   #include <Kokkos_Threads.hpp>
+  typedef Kokkos::Threads device_type;
 #endif
 
-#ifdef KOKKOS_HAVE_CUDA
-  #include <Kokkos_Cuda.hpp>
-  #include <cuda.h>
-  #include <cuda_runtime.h>
-  typedef Kokkos::Cuda device_type;
-#else
-  #ifdef _OPENMP
-    typedef Kokkos::OpenMP device_type;
-  #else
-    typedef Kokkos::Threads device_type;
-  #endif
-
-#endif
-
-
 #include <Kokkos_View.hpp>
 #include <Kokkos_Macros.hpp>
-#include <impl/Kokkos_Timer.hpp>
 
 /* Define types used throughout the code */
 
-//Position arrays
-typedef Kokkos::View<double*[3], Kokkos::LayoutRight, device_type>                                   t_x_array ;
-typedef t_x_array::HostMirror                                                                        t_x_array_host ;
-typedef Kokkos::View<const double*[3], Kokkos::LayoutRight, device_type>                             t_x_array_const ;
-typedef Kokkos::View<const double*[3], Kokkos::LayoutRight, device_type, Kokkos::MemoryRandomAccess >  t_x_array_randomread ;
-
-//Force array
-//typedef Kokkos::View<double*[3],  device_type>                                                       t_f_array ;
-
-// TODO REMove unneccesary typdefs
-
-
-//Neighborlist
-typedef Kokkos::View<int**, device_type >                                                            t_neighbors ;
-typedef Kokkos::View<const int**, device_type >                                                      t_neighbors_const ;
-typedef Kokkos::View<int*, device_type, Kokkos::MemoryUnmanaged >                                    t_neighbors_sub ;
-typedef Kokkos::View<const int*, device_type, Kokkos::MemoryUnmanaged >                              t_neighbors_const_sub ;
-
 //1d int array
 typedef Kokkos::View<int*, device_type >                                                             t_int_1d ;
-typedef t_int_1d::HostMirror                                                                         t_int_1d_host ;
 typedef Kokkos::View<const int*, device_type >                                                       t_int_1d_const ;
-typedef Kokkos::View<int*, device_type , Kokkos::MemoryUnmanaged>                                    t_int_1d_um ;
-typedef Kokkos::View<const int* , device_type , Kokkos::MemoryUnmanaged>                             t_int_1d_const_um ;
 
-//2d int array
-typedef Kokkos::View<int**, Kokkos::LayoutRight, device_type >                                       t_int_2d ;
-typedef t_int_2d::HostMirror                                                                         t_int_2d_host ;
-
-//Scalar ints
-typedef Kokkos::View<int[1], Kokkos::LayoutLeft, device_type>                                        t_int_scalar ;
-typedef t_int_scalar::HostMirror                                                                     t_int_scalar_host ;
-
-typedef Kokkos::View<double*, device_type>                                                           t_double_1d ;
-typedef t_double_1d::HostMirror                                                                      t_double_1d_host ;
-typedef Kokkos::View<const double*, device_type, Kokkos::MemoryRandomAccess >                        t_double_1d_randomread ;
+//1d double arrays wrapping existing (unmanaged) storage
+typedef Kokkos::View<double*, device_type, Kokkos::MemoryUnmanaged >                                 t_double_1d_um ;
+typedef Kokkos::View<const double*, device_type, Kokkos::MemoryUnmanaged >                           t_double_1d_const_um ;
 
 
 namespace MATERIAL_EVALUATION {
 
-struct System {
-  int nlocal;
-  int noverlap;
-  //double horizon;
-  double thermal_coef;
-  double K;
-  double MU;
-
-  // TODO change t_double to be generic
-  t_double_1d d_x;
-  t_double_1d d_y;
-  t_double_1d d_theta;
-  t_double_1d d_delta_t;
-  t_double_1d d_vol;
-  t_double_1d d_m;
-  t_double_1d_host h_x;
-  t_double_1d_host h_y;
-  t_double_1d_host h_theta;
-  t_double_1d_host h_delta_t;
-  t_double_1d_host h_vol;
-  t_double_1d_host h_m;
-
-  t_double_1d d_f;
-  t_double_1d_host h_f;
-
-  t_neighbors neighbors;
-  t_neighbors bond_damage;
-  t_int_1d numneigh;
+//! Initializes the Kokkos execution space; called once at startup.  If numThreads is not positive, all available hardware threads are used.
+void initializeKokkos(int numThreads);
+
+//! Finalizes the Kokkos execution space, if it was initialized.
+void finalizeKokkos();
+
+//! Compressed row storage (CRS) copy of a neighborhood list, built once and reused across force evaluations.
+struct NeighborhoodCRS {
+  NeighborhoodCRS() : numOwnedPoints(-1), numBonds(0), neighborhoodVersion(0) {}
+  int numOwnedPoints;
+  int numBonds;
+  //! Version of the neighborhood list the CRS was built from, see PeridigmNS::NeighborhoodData::Version()
+  int neighborhoodVersion;
+  //! Offset of the first bond of each point; size numOwnedPoints+1
+  t_int_1d offsets;
+  //! Neighbor local ids; size numBonds
+  t_int_1d neighbors;
 };
 
+//! Rebuilds the CRS neighborhood if the version of the neighborhood list has changed; a version of zero is unknown and always triggers a rebuild.
+void updateNeighborhoodCRS
+(
+    NeighborhoodCRS& crs,
+    const int* localNeighborList,
+    int numOwnedPoints,
+    int neighborhoodVersion
+);
 
+//! Computes the dilatation of the owned points.
+void computeDilatationKokkos
+(
+    const double* xOverlapPtr,
+    const double* yOverlapPtr,
+    const double* mOwned,
+    const double* volumeOverlapPtr,
+    const double* bondDamage,
+    double* dilatationOwned,
+    const NeighborhoodCRS& neighborhood,
+    int numOverlapPoints,
+    double horizon,
+    const FunctionPointer OMEGA,
+    double thermalExpansionCoefficient = 0,
+    const double* deltaTemperature = 0
+);
 
-int create_system(System &system, int nx, int ny, int nz, double rho);
-void neigh_setup(System &system);
-void neigh_build(System &system);
-void force(System &system);
-
-
-template<typename ScalarT>
+//! Computes contributions to the internal force resulting from owned points; fInternalOverlapPtr must be zeroed by the caller.
 void computeInternalForceLinearElasticKokkos
 (
     const double* xOverlapPtr,
-    const ScalarT* yOverlapPtr,
+    const double* yOverlapPtr,
     const double* mOwned,
     const double* volumeOverlapPtr,
-    const ScalarT* dilatationOwned,
+    const double* dilatationOwned,
     const double* bondDamage,
-    const double* dsfOwned,
-    ScalarT* fInternalOverlapPtr,
-    const int*  localNeighborList,
-    int numOwnedPoints,
+    double* fInternalOverlapPtr,
+    const NeighborhoodCRS& neighborhood,
+    int numOverlapPoints,
     double BULK_MODULUS,
     double SHEAR_MODULUS,
-        double horizon,
-        double thermalExpansionCoefficient = 0,
-        const double* deltaTemperature = 0
-
+    double horizon,
+    double thermalExpansionCoefficient = 0,
+    const double* deltaTemperature = 0
 );
 
-
 } // MATERIAL_EVALUATION
 
 
@@ -246,7 +246,8 @@ void computeDilatation
         double horizon,
 		const FunctionPointer OMEGA,
         double thermalExpansionCoefficient,
-        const double* deltaTemperature
+        const double* deltaTemperature,
+        const double* neighborVolume
 )
 {
 	const double *xOwned = xOverlap;
@@ -254,6 +255,7 @@ void computeDilatation
 	const double *deltaT = deltaTemperature;
 	const double *m = mOwned;
 	const double *v = volumeOverlap;
+	const double *bondVolume = neighborVolume;
 	ScalarT *theta = dilatationOwned;
 	double cellVolume;
 	const int *neighPtr = localNeighborList;
@@ -264,7 +266,10 @@ void computeDilatation
 		*theta = ScalarT(0.0);
 		for(int n=0;n<numNeigh;n++,neighPtr++,bondDamage++){
 			int localId = *neighPtr;
-			cellVolume = v[localId];
+			if(neighborVolume != 0)
+				cellVolume = *(bondVolume++);
+			else
+				cellVolume = v[localId];
 			const double *XP = &xOverlap[3*localId];
 			const ScalarT *YP = &yOverlap[3*localId];
 			double X_dx = XP[0]-X[0];
@@ -302,7 +307,8 @@ void computeDilatation<double>
         double horizon,
 		const FunctionPointer OMEGA,
         double thermalExpansionCoefficient,
-        const double* deltaTemperature
+        const double* deltaTemperature,
+        const double* neighborVolume
  );
 
 
@@ -321,7 +327,8 @@ void computeDilatation<Sacado::Fad::DFad<double> >
         double horizon,
 		const FunctionPointer OMEGA,
         double thermalExpansionCoefficient,
-        const double* deltaTemperature
+        const double* deltaTemperature,
+        const double* neighborVolume
  );
 
 /**
@@ -522,6 +529,29 @@ void computeWeightedVolume
 
 namespace WITH_BOND_VOLUME {
 
+void computeWeightedVolume
+(
+		const double* xOverlap,
+		const double* bondVolume,
+		double *mOwned,
+		int myNumPoints,
+		const int* localNeighborList,
+		double horizon,
+		const FunctionPointer OMEGA
+){
+	double *m = mOwned;
+	const double *xOwned = xOverlap;
+	const double *bond_volume = bondVolume;
+	const int *neighPtr = localNeighborList;
+	for(int p=0;p<myNumPoints;p++, xOwned+=3, m++){
+		int numNeigh = *neighPtr;
+		const double *X = xOwned;
+		*m=MATERIAL_EVALUATION::WITH_BOND_VOLUME::computeWeightedVolume(X,xOverlap,bond_volume,neighPtr,horizon,OMEGA);
+		neighPtr+=(numNeigh+1);
+		bond_volume+=numNeigh;
+	}
+}
+
 /**
  * Call this function on a single point 'X'
  * NOTE: neighPtr to should point to 'numNeigh' for 'X'
@@ -206,11 +206,28 @@ void computeDilatation
         double horizon,
         const FunctionPointer OMEGA=PeridigmNS::InfluenceFunction::self().getInfluenceFunction(),
         double thermalExpansionCoefficient = 0,
-        const double* deltaTemperature = 0
+        const double* deltaTemperature = 0,
+        const double* neighborVolume = 0
  );
 
 namespace WITH_BOND_VOLUME {
 
+/**
+ * Computes the weighted volume for each owned point.
+ * NOTE: bondVolume is layed out like the neighborhood list, less the
+ * number of neighbors for each point
+ */
+void computeWeightedVolume
+(
+		const double* xOverlap,
+		const double* bondVolume,
+		double *mOwned,
+		int myNumPoints,
+		const int* localNeighborList,
+		double horizon,
+        const FunctionPointer OMEGA=PeridigmNS::InfluenceFunction::self().getInfluenceFunction()
+);
+
 /**
  * Call this function on a single point 'X'
  * NOTE: neighPtr to should point to 'numNeigh' for 'X'
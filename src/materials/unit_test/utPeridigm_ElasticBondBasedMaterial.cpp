@@ -0,0 +1,191 @@
+/*! \file utPeridigm_ElasticBondBasedMaterial.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <Teuchos_ParameterList.hpp>
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_UnitTestRepository.hpp"
+#include "Peridigm_ElasticBondBasedMaterial.hpp"
+#include "Peridigm_SerialMatrix.hpp"
+#include "Peridigm_Field.hpp"
+#include <Epetra_SerialComm.h>
+#include <vector>
+#include <cmath>
+
+using namespace std;
+using namespace PeridigmNS;
+using namespace Teuchos;
+
+//! Computes the Jacobian of the given material for a three-point system in which all cells are neighbors of each other.
+RCP<Epetra_FECrsMatrix> computeThreePointJacobian(const ElasticBondBasedMaterial& material,
+                                                  DataManager& dataManager,
+                                                  const Epetra_Map& tangentMap,
+                                                  Material::JacobianType jacobianType)
+{
+  double dt = 1.0;
+  int numOwnedPoints = 3;
+  int ownedIDs[3] = {0, 1, 2};
+  int neighborhoodList[9] = {2, 1, 2, 2, 0, 2, 2, 0, 1};
+
+  // the graph of the tangent holds every entry, so the Jacobians of both methods have the same layout
+  RCP<Epetra_FECrsMatrix> tangent = rcp(new Epetra_FECrsMatrix(Copy, tangentMap, 9, false));
+  vector<double> zeros(9);
+  vector<int> indices(9);
+  for(unsigned int i=0 ; i<indices.size() ; ++i)
+    indices[i] = i;
+  for(int i=0 ; i<9 ; ++i){
+    int err = tangent->InsertGlobalValues(i, 9, (const double*)&zeros[0], (const int*)&indices[0]);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(err < 0, "**** InsertGlobalValues() returned negative error code.\n");
+  }
+  int err = tangent->GlobalAssemble();
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(err != 0, "**** GlobalAssemble() returned nonzero error code.\n");
+
+  SerialMatrix tangentSerialMatrix(tangent);
+  material.computeJacobian(dt, numOwnedPoints, ownedIDs, neighborhoodList, dataManager, tangentSerialMatrix, jacobianType);
+  tangentSerialMatrix.sumIntoNonlocalRows();
+  return tangent;
+}
+
+//! Tests the analytic Jacobian against the finite-difference Jacobian for a three-point system with a partially damaged bond.
+TEUCHOS_UNIT_TEST(ElasticBondBasedMaterial, threePointAnalyticTangentStiffnessMatrix) {
+
+  // instantiate the material model with the analytic and the finite-difference Jacobian
+  ParameterList params;
+  params.set("Density", 7800.0);
+  params.set("Bulk Modulus", 130.0e9);
+  params.set("Horizon", 10.0);
+  params.set("Finite Difference Probe Length", 1.0e-7);
+  ElasticBondBasedMaterial analyticMat(params);
+  params.set("Apply Analytic Jacobian", false);
+  ElasticBondBasedMaterial finiteDifferenceMat(params);
+
+  // only the analytic Jacobian couples just the two endpoints of each bond
+  TEST_ASSERT(analyticMat.HasPairwiseJacobian());
+  TEST_ASSERT(!finiteDifferenceMat.HasPairwiseJacobian());
+
+  // arguments for calls to material model
+  Epetra_SerialComm comm;
+  Epetra_BlockMap scalarPointMap(3, 1, 0, comm);
+  Epetra_BlockMap vectorPointMap(3, 3, 0, comm);
+  std::vector<int> myGlobalElements(3), elementSizes(3);
+  for(int i=0 ; i<3 ; ++i){
+    myGlobalElements[i] = i;
+    elementSizes[i] = 2;
+  }
+  Epetra_BlockMap bondMap(3, 3, &myGlobalElements[0], &elementSizes[0], 0, comm);
+  Epetra_Map tangentMap(9, 0, comm);
+
+  // create the data manager
+  // in serial, the overlap and non-overlap maps are the same
+  PeridigmNS::DataManager dataManager;
+  dataManager.setMaps(Teuchos::rcp(&scalarPointMap, false),
+                      Teuchos::rcp(&scalarPointMap, false),
+                      Teuchos::rcp(&vectorPointMap, false),
+                      Teuchos::rcp(&vectorPointMap, false),
+                      Teuchos::rcp(&bondMap, false));
+  // the finite-difference Jacobian also perturbs the velocity
+  PeridigmNS::FieldManager& fieldManager = PeridigmNS::FieldManager::self();
+  vector<int> fieldIds = analyticMat.FieldIds();
+  fieldIds.push_back(fieldManager.getFieldId(PeridigmField::NODE, PeridigmField::VECTOR, PeridigmField::TWO_STEP, "Velocity"));
+  dataManager.allocateData(fieldIds);
+
+  Epetra_Vector& x = *dataManager.getData(fieldManager.getFieldId("Model_Coordinates"), PeridigmField::STEP_NONE);
+  Epetra_Vector& y = *dataManager.getData(fieldManager.getFieldId("Coordinates"), PeridigmField::STEP_NP1);
+  Epetra_Vector& cellVolume = *dataManager.getData(fieldManager.getFieldId("Volume"), PeridigmField::STEP_NONE);
+  Epetra_Vector& bondDamage = *dataManager.getData(fieldManager.getFieldId("Bond_Damage"), PeridigmField::STEP_NP1);
+
+  // initial positions
+  x[0] =  1.1; x[1] = 2.6;  x[2] = -0.1;
+  x[3] = -2.0; x[4] = 0.9;  x[5] = -0.3;
+  x[6] =  0.0; x[7] = 0.01; x[8] =  1.8;
+
+  // current positions
+  y[0] = 1.2;  y[1] = 2.4;  y[2] = -0.1;
+  y[3] = -1.9; y[4] = 0.7;  y[5] = -0.8;
+  y[6] = 0.1;  y[7] = 0.21; y[8] =  1.6;
+
+  // cell volumes
+  cellVolume[0] = 0.9;
+  cellVolume[1] = 1.1;
+  cellVolume[2] = 0.8;
+
+  // partially damage one of the bonds
+  bondDamage.PutScalar(0.0);
+  bondDamage[1] = 0.3;
+
+  // compare the analytic Jacobian against the finite-difference Jacobian, for the full matrix and for its block diagonal
+  Material::JacobianType jacobianTypes[2] = {Material::FULL_MATRIX, Material::BLOCK_DIAGONAL};
+  for(int iType=0 ; iType<2 ; ++iType){
+    RCP<Epetra_FECrsMatrix> analyticTangent = computeThreePointJacobian(analyticMat, dataManager, tangentMap, jacobianTypes[iType]);
+    RCP<Epetra_FECrsMatrix> finiteDifferenceTangent = computeThreePointJacobian(finiteDifferenceMat, dataManager, tangentMap, jacobianTypes[iType]);
+
+    double analyticNorm = analyticTangent->NormInf();
+    TEST_COMPARE(analyticNorm, >, 0.0);
+    double tolerance = 1.0e-5*analyticNorm;
+    vector<double> analyticValues(9), values(9);
+    vector<int> analyticIndices(9), valueIndices(9);
+    for(int row=0 ; row<9 ; ++row){
+      int numEntries, numAnalyticEntries;
+      analyticTangent->ExtractGlobalRowCopy(row, 9, numAnalyticEntries, &analyticValues[0], &analyticIndices[0]);
+      finiteDifferenceTangent->ExtractGlobalRowCopy(row, 9, numEntries, &values[0], &valueIndices[0]);
+      TEST_EQUALITY(numAnalyticEntries, 9);
+      TEST_EQUALITY(numEntries, 9);
+      for(int k=0 ; k<numEntries ; ++k){
+        TEST_EQUALITY(valueIndices[k], analyticIndices[k]);
+        TEST_COMPARE(std::abs(values[k] - analyticValues[k]), <=, tolerance);
+        // the block diagonal has no entries outside the 3x3 block of each point
+        if(jacobianTypes[iType] == Material::BLOCK_DIAGONAL && row/3 != analyticIndices[k]/3)
+          TEST_EQUALITY(analyticValues[k], 0.0);
+      }
+    }
+  }
+}
+
+int main
+(int argc, char* argv[])
+{
+  return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
@@ -53,6 +53,7 @@
 #include "Peridigm_Field.hpp"
 #include <Epetra_SerialComm.h>
 #include <iostream>
+#include <cmath>
 
 
 using namespace std;
@@ -662,6 +663,79 @@ TEUCHOS_UNIT_TEST(ElasticMaterial, testThreePts) {
   delete[] neighborhoodList;
 }
 
+//! Tests that the weighted volume and dilatation are computed with the partial volumes when "Use Partial Volume" is set.
+TEUCHOS_UNIT_TEST(ElasticMaterial, testThreePtsPartialVolume) {
+
+  // instantiate the material model
+  ParameterList params;
+  params.set("Density", 7800.0);
+  params.set("Bulk Modulus", 130.0e9);
+  params.set("Shear Modulus", 78.0e9);
+  params.set("Horizon", 10.0);
+  params.set("Use Partial Volume", true);
+  ElasticMaterial mat(params);
+
+  // arguments for calls to material model
+  Epetra_SerialComm comm;
+  Epetra_Map nodeMap(3, 0, comm);
+  Epetra_Map unknownMap(9, 0, comm);
+  Epetra_Map bondMap(6, 0, comm);
+  double dt = 1.0;
+  int numOwnedPoints = 3;
+  int ownedIDs[] = {0, 1, 2};
+  int neighborhoodList[] = {2, 1, 2, 2, 0, 2, 2, 0, 1};
+
+  // create the data manager
+  // in serial, the overlap and non-overlap maps are the same
+  PeridigmNS::DataManager dataManager;
+  dataManager.setMaps(Teuchos::rcp(&nodeMap, false),
+                      Teuchos::rcp(&nodeMap, false),
+                      Teuchos::rcp(&unknownMap, false),
+                      Teuchos::rcp(&unknownMap, false),
+                      Teuchos::rcp(&bondMap, false));
+  dataManager.allocateData(mat.FieldIds());
+
+  PeridigmNS::FieldManager& fieldManager = PeridigmNS::FieldManager::self();
+  Epetra_Vector& x = *dataManager.getData(fieldManager.getFieldId("Model_Coordinates"), PeridigmField::STEP_NONE);
+  Epetra_Vector& y = *dataManager.getData(fieldManager.getFieldId("Coordinates"), PeridigmField::STEP_NP1);
+  Epetra_Vector& cellVolume = *dataManager.getData(fieldManager.getFieldId("Volume"), PeridigmField::STEP_NONE);
+  Epetra_Vector& neighborVolume = *dataManager.getData(fieldManager.getFieldId("Neighbor_Volume"), PeridigmField::STEP_NONE);
+  Epetra_Vector& selfVolume = *dataManager.getData(fieldManager.getFieldId("Self_Volume"), PeridigmField::STEP_NONE);
+  Epetra_Vector& weightedVolume = *dataManager.getData(fieldManager.getFieldId("Weighted_Volume"), PeridigmField::STEP_NONE);
+  Epetra_Vector& dilatation = *dataManager.getData(fieldManager.getFieldId("Dilatation"), PeridigmField::STEP_NP1);
+  dataManager.getData(fieldManager.getFieldId("Bond_Damage"), PeridigmField::STEP_NP1)->PutScalar(0.0);
+
+  // three collinear points at x = 0, 1, 3, the middle point is displaced by 1 and the others are fixed
+  x.PutScalar(0.0);
+  y.PutScalar(0.0);
+  x[3] = 1.0; y[3] = 2.0;
+  x[6] = 3.0; y[6] = 3.0;
+
+  // the full cell volumes are unity, the partial volumes differ for every bond
+  // the self volume of each bond is the neighbor volume of the reverse bond
+  cellVolume.PutScalar(1.0);
+  neighborVolume[0] = 0.5;  neighborVolume[1] = 0.25;
+  neighborVolume[2] = 0.75; neighborVolume[3] = 0.5;
+  neighborVolume[4] = 1.0;  neighborVolume[5] = 0.25;
+  selfVolume[0] = 0.75;     selfVolume[1] = 1.0;
+  selfVolume[2] = 0.5;      selfVolume[3] = 0.25;
+  selfVolume[4] = 0.25;     selfVolume[5] = 0.5;
+
+  mat.initialize(dt, numOwnedPoints, ownedIDs, neighborhoodList, dataManager);
+  mat.computeForce(dt, numOwnedPoints, ownedIDs, neighborhoodList, dataManager);
+
+  // m = sum omega |xi|^2 V_bond, with the full cell volumes the weighted volumes would be 10, 5, and 13
+  TEST_FLOATING_EQUALITY(weightedVolume[0], 1.0*0.5 + 9.0*0.25, 1.0e-15);
+  TEST_FLOATING_EQUALITY(weightedVolume[1], 1.0*0.75 + 4.0*0.5, 1.0e-15);
+  TEST_FLOATING_EQUALITY(weightedVolume[2], 9.0*1.0 + 4.0*0.25, 1.0e-15);
+
+  // theta = 3/m sum omega |xi| e V_bond, with the full cell volumes the dilatations would be 0.3, -0.6, and -6/13
+  TEST_FLOATING_EQUALITY(dilatation[0], 3.0/2.75*(1.0*1.0*0.5), 1.0e-14);
+  TEST_FLOATING_EQUALITY(dilatation[1], 3.0/2.75*(1.0*1.0*0.75 - 2.0*1.0*0.5), 1.0e-14);
+  TEST_FLOATING_EQUALITY(dilatation[2], 3.0/10.0*(-2.0*1.0*0.25), 1.0e-14);
+}
+
+
 //! Tests the finite-difference Jacobian for a two-point system.
 TEUCHOS_UNIT_TEST(ElasticMaterial, twoPointTangentStiffnessMatrix) {
 
@@ -766,6 +840,122 @@ TEUCHOS_UNIT_TEST(ElasticMaterial, twoPointTangentStiffnessMatrix) {
   // cout << *tangentFECrsMatrix << endl;
 }
 
+//! Tests the analytic Jacobian against the automatic-differentiation and finite-difference Jacobians for a three-point system.
+TEUCHOS_UNIT_TEST(ElasticMaterial, threePointAnalyticTangentStiffnessMatrix) {
+
+  // instantiate the material model with each of the three methods for computing the Jacobian
+  ParameterList params;
+  params.set("Density", 7800.0);
+  params.set("Bulk Modulus", 130.0e9);
+  params.set("Shear Modulus", 78.0e9);
+  params.set("Horizon", 10.0);
+  params.set("Finite Difference Probe Length", 1.0e-7);
+  ElasticMaterial analyticMat(params);
+  params.set("Apply Automatic Differentiation Jacobian", true);
+  ElasticMaterial automaticDifferentiationMat(params);
+  params.set("Apply Automatic Differentiation Jacobian", false);
+  ElasticMaterial finiteDifferenceMat(params);
+
+  // arguments for calls to material model
+  Epetra_SerialComm comm;
+  Epetra_BlockMap scalarPointMap(3, 1, 0, comm);
+  Epetra_BlockMap vectorPointMap(3, 3, 0, comm);
+  std::vector<int> myGlobalElements(3), elementSizes(3);
+  for(int i=0 ; i<3 ; ++i){
+    myGlobalElements[i] = i;
+    elementSizes[i] = 2;
+  }
+  Epetra_BlockMap bondMap(3, 3, &myGlobalElements[0], &elementSizes[0], 0, comm);
+  Epetra_Map tangentMap(9, 0, comm);
+  double dt = 1.0;
+
+  // set up discretization
+  // all cells are neighbors of each other
+  int numOwnedPoints = 3;
+  int ownedIDs[3] = {0, 1, 2};
+  int neighborhoodList[9] = {2, 1, 2, 2, 0, 2, 2, 0, 1};
+
+  // create the data manager
+  // in serial, the overlap and non-overlap maps are the same
+  PeridigmNS::DataManager dataManager;
+  dataManager.setMaps(Teuchos::rcp(&scalarPointMap, false),
+                      Teuchos::rcp(&scalarPointMap, false),
+                      Teuchos::rcp(&vectorPointMap, false),
+                      Teuchos::rcp(&vectorPointMap, false),
+                      Teuchos::rcp(&bondMap, false));
+  // the finite-difference Jacobian also perturbs the velocity
+  PeridigmNS::FieldManager& fieldManager = PeridigmNS::FieldManager::self();
+  vector<int> fieldIds = analyticMat.FieldIds();
+  fieldIds.push_back(fieldManager.getFieldId(PeridigmField::NODE, PeridigmField::VECTOR, PeridigmField::TWO_STEP, "Velocity"));
+  dataManager.allocateData(fieldIds);
+
+  Epetra_Vector& x = *dataManager.getData(fieldManager.getFieldId("Model_Coordinates"), PeridigmField::STEP_NONE);
+  Epetra_Vector& y = *dataManager.getData(fieldManager.getFieldId("Coordinates"), PeridigmField::STEP_NP1);
+  Epetra_Vector& cellVolume = *dataManager.getData(fieldManager.getFieldId("Volume"), PeridigmField::STEP_NONE);
+  Epetra_Vector& bondDamage = *dataManager.getData(fieldManager.getFieldId("Bond_Damage"), PeridigmField::STEP_NP1);
+
+  // initial positions
+  x[0] =  1.1; x[1] = 2.6;  x[2] = -0.1;
+  x[3] = -2.0; x[4] = 0.9;  x[5] = -0.3;
+  x[6] =  0.0; x[7] = 0.01; x[8] =  1.8;
+
+  // current positions
+  y[0] = 1.2;  y[1] = 2.4;  y[2] = -0.1;
+  y[3] = -1.9; y[4] = 0.7;  y[5] = -0.8;
+  y[6] = 0.1;  y[7] = 0.21; y[8] =  1.6;
+
+  // cell volumes
+  cellVolume[0] = 0.9;
+  cellVolume[1] = 1.1;
+  cellVolume[2] = 0.8;
+
+  // partially damage one of the bonds
+  bondDamage.PutScalar(0.0);
+  bondDamage[1] = 0.3;
+
+  analyticMat.initialize(dt, numOwnedPoints, ownedIDs, neighborhoodList, dataManager);
+
+  // Compute the Jacobian with each method
+  vector< Teuchos::RCP<Epetra_FECrsMatrix> > tangents;
+  const ElasticMaterial* materials[3] = {&analyticMat, &automaticDifferentiationMat, &finiteDifferenceMat};
+  vector<double> zeros(9);
+  vector<int> indices(9);
+  for(unsigned int i=0 ; i<indices.size() ; ++i)
+    indices[i] = i;
+  for(int iMat=0 ; iMat<3 ; ++iMat){
+    Teuchos::RCP<Epetra_FECrsMatrix> tangentFECrsMatrix = Teuchos::rcp(new Epetra_FECrsMatrix(Copy, tangentMap, 9, false));
+    for(int i=0 ; i<9 ; ++i){
+      int err = tangentFECrsMatrix->InsertGlobalValues(i, 9, (const double*)&zeros[0], (const int*)&indices[0]);
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(err < 0, "**** InsertGlobalValues() returned negative error code.\n");
+    }
+    int err = tangentFECrsMatrix->GlobalAssemble();
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(err != 0, "**** GlobalAssemble() returned nonzero error code.\n");
+    PeridigmNS::SerialMatrix tangentSerialMatrix(tangentFECrsMatrix);
+    materials[iMat]->computeJacobian(dt, numOwnedPoints, ownedIDs, neighborhoodList, dataManager, tangentSerialMatrix);
+    tangentSerialMatrix.sumIntoNonlocalRows();
+    tangents.push_back(tangentFECrsMatrix);
+  }
+
+  // Compare the analytic Jacobian against the other two
+  double analyticNorm = tangents[0]->NormInf();
+  TEST_COMPARE(analyticNorm, >, 0.0);
+  vector<double> analyticValues(9), values(9);
+  vector<int> analyticIndices(9), valueIndices(9);
+  for(int row=0 ; row<9 ; ++row){
+    int numEntries;
+    tangents[0]->ExtractGlobalRowCopy(row, 9, numEntries, &analyticValues[0], &analyticIndices[0]);
+    TEST_EQUALITY(numEntries, 9);
+    for(int iMat=1 ; iMat<3 ; ++iMat){
+      tangents[iMat]->ExtractGlobalRowCopy(row, 9, numEntries, &values[0], &valueIndices[0]);
+      double tolerance = (iMat == 1 ? 1.0e-12 : 1.0e-5)*analyticNorm;
+      for(int k=0 ; k<numEntries ; ++k){
+        TEST_EQUALITY(valueIndices[k], analyticIndices[k]);
+        TEST_COMPARE(std::abs(values[k] - analyticValues[k]), <=, tolerance);
+      }
+    }
+  }
+}
+
 //! Tests the finite-difference Jacobian for a two-point system.
 
 TEUCHOS_UNIT_TEST(ElasticMaterial, twoPointTangentStiffnessMatrixJAM) {
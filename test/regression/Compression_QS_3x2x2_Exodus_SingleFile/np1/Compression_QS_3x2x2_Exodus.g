@@ -0,0 +1 @@
+../../Compression_QS_3x2x2_Exodus/Compression_QS_3x2x2_Exodus.g
\ No newline at end of file
@@ -0,0 +1,75 @@
+#! /usr/bin/env python
+
+import sys
+import os
+import re
+from subprocess import Popen
+
+test_dir = "Compression_QS_3x2x2_Exodus_SingleFile/np1"
+base_name = "Compression_QS_3x2x2_Exodus_SingleFile"
+
+# the undecomposed genesis file is read with "Single Input Mesh File", the results match those obtained from the decomposed files
+gold_file = "../../Compression_QS_3x2x2_Exodus/Compression_QS_3x2x2_Exodus_gold.e"
+
+if __name__ == "__main__":
+
+    result = 0
+
+    # log file will be dumped if verbose option is given
+    verbose = False
+    if "-verbose" in sys.argv:
+        verbose = True
+
+    # change to the specified test directory
+    os.chdir(test_dir)
+
+    # open log file
+    log_file_name = base_name + ".log"
+    if os.path.exists(log_file_name):
+        os.remove(log_file_name)
+    logfile = open(log_file_name, 'w')
+
+    # remove old output files, if any
+    files_to_remove = base_name + ".e"
+    for file in os.listdir(os.getcwd()):
+      if file in files_to_remove:
+        os.remove(file)
+
+    # run Peridigm
+    command = ["../../../../src/Peridigm", "../"+base_name+".xml"]
+    p = Popen(command, stdout=logfile, stderr=logfile)
+    return_code = p.wait()
+    if return_code != 0:
+        result = return_code
+
+    # compare output files against gold files
+    command = ["../../../../scripts/exodiff", \
+               "-stat", \
+               "-f", \
+               "../"+base_name+".comp", \
+               base_name+".e", \
+               gold_file]
+    p = Popen(command, stdout=logfile, stderr=logfile)
+    return_code = p.wait()
+    if return_code != 0:
+        result = return_code
+
+    # a pre-decomposed genesis file, which carries original_global_id maps, must be rejected
+    command = ["../../../../src/Peridigm", "../"+base_name+"_Decomposed.xml"]
+    logfile.flush()
+    log_size = os.path.getsize(log_file_name)
+    p = Popen(command, stdout=logfile, stderr=logfile)
+    return_code = p.wait()
+    logfile.flush()
+    log = open(log_file_name).read()[log_size:]
+    if return_code == 0 or "requires an undecomposed mesh" not in log:
+        logfile.write("\nError:  the pre-decomposed genesis file was not rejected.\n")
+        result = 1
+
+    logfile.close()
+
+    # dump the output if the user requested verbose
+    if verbose == True:
+        os.system("cat " + log_file_name)
+
+    sys.exit(result)
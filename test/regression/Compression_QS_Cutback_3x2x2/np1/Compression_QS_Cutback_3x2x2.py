@@ -0,0 +1,77 @@
+#! /usr/bin/env python
+
+import sys
+import os
+import re
+from subprocess import Popen
+
+test_dir = "Compression_QS_Cutback_3x2x2/np1"
+base_name = "Compression_QS_Cutback_3x2x2"
+
+# the load steps are subdivided, but output is written only at the scheduled times,
+# so the solution is compared against the gold file for the same problem solved
+# without subdividing the load steps
+gold_file = "../../Compression_QS_3x2x2/Compression_QS_3x2x2_gold.e"
+
+if __name__ == "__main__":
+
+    result = 0
+
+    # log file will be dumped if verbose option is given
+    verbose = False
+    if "-verbose" in sys.argv:
+        verbose = True
+
+    # change to the specified test directory
+    os.chdir(test_dir)
+
+    # open log file
+    log_file_name = base_name + ".log"
+    if os.path.exists(log_file_name):
+        os.remove(log_file_name)
+    logfile = open(log_file_name, 'w')
+
+    # remove old output files, if any
+    files_to_remove = base_name + ".e"
+    for file in os.listdir(os.getcwd()):
+      if file in files_to_remove:
+        os.remove(file)
+
+    # run Peridigm
+    command = ["../../../../src/Peridigm", "../"+base_name+".xml"]
+    p = Popen(command, stdout=logfile, stderr=logfile)
+    return_code = p.wait()
+    if return_code != 0:
+        result = return_code
+
+    # check that at least one load step was cut back, and that the load step number, which advances only when
+    # the scheduled time is reached and output is written, ran through the twenty scheduled load steps
+    logfile.flush()
+    log = open(log_file_name).read()
+    if "reducing load step size" not in log:
+        logfile.write("\nError:  no load step was cut back.\n")
+        result = 1
+    load_steps = [int(n) for n in re.findall(r"Load step (\d+), initial time", log)]
+    if sorted(set(load_steps)) != list(range(1, 21)) or len(load_steps) <= 20:
+        logfile.write("\nError:  unexpected sequence of load steps.\n")
+        result = 1
+
+    # compare output files against gold files; the time steps must match the scheduled times
+    command = ["../../../../scripts/exodiff", \
+               "-stat", \
+               "-f", \
+               "../"+base_name+".comp", \
+               base_name+".e", \
+               gold_file]
+    p = Popen(command, stdout=logfile, stderr=logfile)
+    return_code = p.wait()
+    if return_code != 0:
+        result = return_code
+
+    logfile.close()
+
+    # dump the output if the user requested verbose
+    if verbose == True:
+        os.system("cat " + log_file_name)
+
+    sys.exit(result)